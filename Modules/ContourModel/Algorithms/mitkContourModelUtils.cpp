@@ -12,13 +12,82 @@ found in the LICENSE file.
 
 #include <mitkContourModelUtils.h>
 
-#include <mitkContourModelToSurfaceFilter.h>
 #include <mitkLabelSetImage.h>
-#include <mitkSurface.h>
-#include <vtkImageStencil.h>
 #include <vtkPointData.h>
-#include <vtkPolyData.h>
-#include <vtkPolyDataToImageStencil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  /**
+   * \brief Writes the painting value into the pixels of a slice, following the rules of LabelSet images.
+   *
+   * For images other than LabelSetImage every painted pixel is set. For LabelSetImage, pixels of locked labels are
+   * kept, and erasing (painting the exterior label) only affects pixels of the active label.
+   */
+  class SlicePainter
+  {
+  public:
+    SlicePainter(vtkImageData *slice, mitk::Image *image, int paintingPixelValue)
+      : m_Scalars(slice->GetPointData()->GetScalars()),
+        m_LabelImage(dynamic_cast<mitk::LabelSetImage *>(image)),
+        m_PaintingPixelValue(paintingPixelValue),
+        m_Erasing(false),
+        m_ActivePixelValue(0),
+        m_LastPixelValue(0),
+        m_LastPixelValueLocked(false),
+        m_LastPixelValueValid(false)
+    {
+      if (nullptr != m_LabelImage)
+      {
+        m_Erasing = paintingPixelValue == m_LabelImage->GetExteriorLabel()->GetValue();
+        m_ActivePixelValue = m_LabelImage->GetActiveLabel(m_LabelImage->GetActiveLayer())->GetValue();
+      }
+    }
+
+    void Paint(vtkIdType i)
+    {
+      if (nullptr != m_LabelImage)
+      {
+        const auto existingValue = m_Scalars->GetTuple1(i);
+
+        if (m_Erasing ? existingValue != m_ActivePixelValue : this->IsLocked(existingValue))
+          return;
+      }
+
+      m_Scalars->SetTuple1(i, m_PaintingPixelValue);
+    }
+
+  private:
+    /** The label of neighboring pixels is mostly the same, so the last lookup is cached */
+    bool IsLocked(double pixelValue)
+    {
+      const auto value = static_cast<mitk::Label::PixelType>(pixelValue);
+
+      if (!m_LastPixelValueValid || value != m_LastPixelValue)
+      {
+        auto label = m_LabelImage->GetLabel(value, m_LabelImage->GetActiveLayer());
+        m_LastPixelValue = value;
+        m_LastPixelValueLocked = nullptr != label && label->GetLocked();
+        m_LastPixelValueValid = true;
+      }
+
+      return m_LastPixelValueLocked;
+    }
+
+    vtkDataArray *m_Scalars;
+    mitk::LabelSetImage *m_LabelImage;
+    int m_PaintingPixelValue;
+    bool m_Erasing;
+    double m_ActivePixelValue;
+    mitk::Label::PixelType m_LastPixelValue;
+    bool m_LastPixelValueLocked;
+    bool m_LastPixelValueValid;
+  };
+}
 
 mitk::ContourModelUtils::ContourModelUtils()
 {
@@ -104,99 +173,111 @@ void mitk::ContourModelUtils::FillContourInSlice(
 void mitk::ContourModelUtils::FillContourInSlice(
   ContourModel *projectedContour, unsigned int t, Image *sliceImage, Image::Pointer workingImage, int paintingPixelValue)
 {
-  auto contourModelFilter = mitk::ContourModelToSurfaceFilter::New();
-  contourModelFilter->SetInput(projectedContour);
-  contourModelFilter->Update();
+  if (nullptr == projectedContour || nullptr == sliceImage)
+    return;
 
-  auto surface = mitk::Surface::New();
-  surface = contourModelFilter->GetOutput();
+  // the contour is in index coordinates of the slice, pixel centers are at integer coordinates
+  std::vector<double> xs;
+  std::vector<double> ys;
 
-  if (nullptr == surface->GetVtkPolyData(t))
+  for (auto iter = projectedContour->Begin(t); iter != projectedContour->End(t); ++iter)
   {
-    MITK_WARN << "Could not create surface from contour model.";
+    xs.push_back((*iter)->Coordinates[0]);
+    ys.push_back((*iter)->Coordinates[1]);
+  }
+
+  // open contours are closed implicitly
+  const auto numberOfVertices = xs.size();
+  if (numberOfVertices < 3)
+    return;
+
+  vtkSmartPointer<vtkImageData> resultImage = sliceImage->GetVtkImageData();
+  if (nullptr == resultImage)
+  {
+    MITK_WARN << "Could not fill contour in slice without image data.";
     return;
   }
 
-  auto surface2D = vtkSmartPointer<vtkPolyData>::New();
-  surface2D->SetPoints(surface->GetVtkPolyData(t)->GetPoints());
-  surface2D->SetLines(surface->GetVtkPolyData(t)->GetLines());
+  int dimensions[3];
+  resultImage->GetDimensions(dimensions);
 
-  auto image = vtkSmartPointer<vtkImageData>::New();
-  image->DeepCopy(sliceImage->GetVtkImageData());
+  // only the rows within the bounding box of the contour are scanned
+  const auto minMaxY = std::minmax_element(ys.begin(), ys.end());
+  const int firstRow = std::max(0, static_cast<int>(std::ceil(*minMaxY.first - mitk::eps)));
+  const int lastRow = std::min(dimensions[1] - 1, static_cast<int>(std::floor(*minMaxY.second + mitk::eps)));
 
-  const double FOREGROUND_VALUE = 255.0;
-  const double BACKGROUND_VALUE = 0.0;
+  if (firstRow > lastRow)
+    return;
 
-  vtkIdType count = image->GetNumberOfPoints();
-  for (decltype(count) i = 0; i < count; ++i)
-    image->GetPointData()->GetScalars()->SetTuple1(i, FOREGROUND_VALUE);
+  SlicePainter painter(resultImage, workingImage, paintingPixelValue);
+  std::vector<double> crossings;
+  std::vector<std::pair<double, double>> spans;
 
-  auto polyDataToImageStencil = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
+  for (int y = firstRow; y <= lastRow; ++y)
+  {
+    crossings.clear();
+    spans.clear();
 
-  // Set a minimal tolerance, so that clipped pixels will be added to contour as well.
-  polyDataToImageStencil->SetTolerance(mitk::eps);
-  polyDataToImageStencil->SetInputData(surface2D);
-  polyDataToImageStencil->Update();
+    for (std::size_t i = 0, j = numberOfVertices - 1; i < numberOfVertices; j = i++)
+    {
+      // half-open rule, so that a vertex on the scanline is counted once
+      if ((ys[i] <= y) != (ys[j] <= y))
+        crossings.push_back(xs[i] + (y - ys[i]) * (xs[j] - xs[i]) / (ys[j] - ys[i]));
+
+      // The half-open rule misses the contour where it touches the scanline from below, i.e. at the topmost
+      // vertices and along horizontal edges. Therefore, the part of each edge within mitk::eps of the
+      // scanline is filled as well.
+      if (std::min(ys[i], ys[j]) > y + mitk::eps || std::max(ys[i], ys[j]) < y - mitk::eps)
+        continue;
+
+      const double dy = ys[j] - ys[i];
+      if (std::abs(dy) <= mitk::eps)
+      {
+        spans.emplace_back(std::min(xs[i], xs[j]), std::max(xs[i], xs[j]));
+      }
+      else
+      {
+        const double t0 = std::max(0.0, std::min(1.0, (y - mitk::eps - ys[i]) / dy));
+        const double t1 = std::max(0.0, std::min(1.0, (y + mitk::eps - ys[i]) / dy));
+        const double x0 = xs[i] + t0 * (xs[j] - xs[i]);
+        const double x1 = xs[i] + t1 * (xs[j] - xs[i]);
+        spans.emplace_back(std::min(x0, x1), std::max(x0, x1));
+      }
+    }
 
-  auto imageStencil = vtkSmartPointer<vtkImageStencil>::New();
+    std::sort(crossings.begin(), crossings.end());
 
-  imageStencil->SetInputData(image);
-  imageStencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
-  imageStencil->ReverseStencilOff();
-  imageStencil->SetBackgroundValue(BACKGROUND_VALUE);
-  imageStencil->Update();
+    // even-odd rule for the interior
+    for (std::size_t i = 0; i + 1 < crossings.size(); i += 2)
+      spans.emplace_back(crossings[i], crossings[i + 1]);
 
-  vtkSmartPointer<vtkImageData> filledImage = imageStencil->GetOutput();
-  vtkSmartPointer<vtkImageData> resultImage = sliceImage->GetVtkImageData();
-  FillSliceInSlice(filledImage, resultImage, workingImage, paintingPixelValue);
+    // pixels on the contour are filled as well
+    const vtkIdType rowOffset = static_cast<vtkIdType>(y) * dimensions[0];
+    for (const auto &span : spans)
+    {
+      const int firstColumn = std::max(0, static_cast<int>(std::ceil(span.first - mitk::eps)));
+      const int lastColumn = std::min(dimensions[0] - 1, static_cast<int>(std::floor(span.second + mitk::eps)));
 
+      for (int x = firstColumn; x <= lastColumn; ++x)
+        painter.Paint(rowOffset + x);
+    }
+  }
+
+  resultImage->Modified();
   sliceImage->SetVolume(resultImage->GetScalarPointer());
 }
 
 void mitk::ContourModelUtils::FillSliceInSlice(
   vtkSmartPointer<vtkImageData> filledImage, vtkSmartPointer<vtkImageData> resultImage, mitk::Image::Pointer image, int paintingPixelValue)
 {
-  auto labelImage = dynamic_cast<LabelSetImage *>(image.GetPointer());
+  SlicePainter painter(resultImage, image, paintingPixelValue);
+  auto filledScalars = filledImage->GetPointData()->GetScalars();
   auto numberOfPoints = filledImage->GetNumberOfPoints();
 
-  if (nullptr == labelImage)
+  for (decltype(numberOfPoints) i = 0; i < numberOfPoints; ++i)
   {
-    for (decltype(numberOfPoints) i = 0; i < numberOfPoints; ++i)
-    {
-      if (1 < filledImage->GetPointData()->GetScalars()->GetTuple1(i))
-        resultImage->GetPointData()->GetScalars()->SetTuple1(i, paintingPixelValue);
-    }
-  }
-  else
-  {
-    auto backgroundValue = labelImage->GetExteriorLabel()->GetValue();
-
-    if (paintingPixelValue != backgroundValue)
-    {
-      for (decltype(numberOfPoints) i = 0; i < numberOfPoints; ++i)
-      {
-        if (1 < filledImage->GetPointData()->GetScalars()->GetTuple1(i))
-        {
-          auto existingValue = resultImage->GetPointData()->GetScalars()->GetTuple1(i);
-
-          if (!labelImage->GetLabel(existingValue, labelImage->GetActiveLayer())->GetLocked())
-            resultImage->GetPointData()->GetScalars()->SetTuple1(i, paintingPixelValue);
-        }
-      }
-    }
-    else
-    {
-      auto activePixelValue = labelImage->GetActiveLabel(labelImage->GetActiveLayer())->GetValue();
-
-      for (decltype(numberOfPoints) i = 0; i < numberOfPoints; ++i)
-      {
-        if (1 < filledImage->GetPointData()->GetScalars()->GetTuple1(i))
-        {
-          if (resultImage->GetPointData()->GetScalars()->GetTuple1(i) == activePixelValue)
-            resultImage->GetPointData()->GetScalars()->SetTuple1(i, paintingPixelValue);
-        }
-      }
-    }
+    if (1 < filledScalars->GetTuple1(i))
+      painter.Paint(i);
   }
 }
 
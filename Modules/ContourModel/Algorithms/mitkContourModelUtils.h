@@ -67,6 +67,10 @@ namespace mitk
 
     /**
     \brief Fill a contour in a 2D slice with a specified pixel value at a given time step.
+
+    The contour is expected in index coordinates of the slice and is closed implicitly. Pixels whose centers lie
+    inside of or on the contour are painted following the rules of FillSliceInSlice(). Only the rows within the
+    bounding box of the contour are visited, so the costs depend on the size of the contour, not of the slice.
     */
     static void FillContourInSlice(ContourModel *projectedContour,
                                    unsigned int timeStep,
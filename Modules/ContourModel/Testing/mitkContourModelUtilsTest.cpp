@@ -0,0 +1,242 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkContourModelToSurfaceFilter.h>
+#include <mitkContourModelUtils.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkSurface.h>
+
+#include <vtkImageStencil.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataToImageStencil.h>
+
+#include <itkMath.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+/** Compares the scanline fill of ContourModelUtils with the former stencil based fill and reports the latency of
+ *  both for a small brush on a large slice. */
+class mitkContourModelUtilsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkContourModelUtilsTestSuite);
+  MITK_TEST(FillContourInSlice_Square_FillsEnclosedPixels);
+  MITK_TEST(FillContourInSlice_IntegerSquare_FillsBoundaryPixels);
+  MITK_TEST(FillContourInSlice_Polygons_EqualsStencilFill);
+  MITK_TEST(FillContourInSlice_ContourOutsideOfSlice_KeepsSlice);
+  MITK_TEST(FillContourInSlice_SmallBrush_Benchmark);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static mitk::Image::Pointer CreateSlice(unsigned int size)
+  {
+    unsigned int dimensions[] = {size, size, 1};
+
+    auto slice = mitk::Image::New();
+    slice->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(slice);
+    std::fill_n(static_cast<unsigned char *>(accessor.GetData()), size * size, 0);
+
+    return slice;
+  }
+
+  /** A regular polygon approximating a circle, like the contour of the paintbrush */
+  static mitk::ContourModel::Pointer CreateCircle(double x, double y, double radius, unsigned int numberOfVertices)
+  {
+    auto contour = mitk::ContourModel::New();
+
+    for (unsigned int i = 0; i < numberOfVertices; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfVertices;
+
+      mitk::Point3D vertex;
+      mitk::FillVector3D(vertex, x + radius * std::cos(angle), y + radius * std::sin(angle), 0.0);
+      contour->AddVertex(vertex);
+    }
+
+    contour->Close();
+    return contour;
+  }
+
+  static mitk::ContourModel::Pointer CreatePolygon(const std::vector<std::pair<double, double>> &vertices)
+  {
+    auto contour = mitk::ContourModel::New();
+
+    for (const auto &xy : vertices)
+    {
+      mitk::Point3D vertex;
+      mitk::FillVector3D(vertex, xy.first, xy.second, 0.0);
+      contour->AddVertex(vertex);
+    }
+
+    contour->Close();
+    return contour;
+  }
+
+  /** The fill of ContourModelUtils before the scanline rasterization, used as reference */
+  static void StencilFillContourInSlice(mitk::ContourModel *contour, mitk::Image *slice, int paintingPixelValue)
+  {
+    auto contourModelFilter = mitk::ContourModelToSurfaceFilter::New();
+    contourModelFilter->SetInput(contour);
+    contourModelFilter->Update();
+
+    mitk::Surface::Pointer surface = contourModelFilter->GetOutput();
+
+    auto surface2D = vtkSmartPointer<vtkPolyData>::New();
+    surface2D->SetPoints(surface->GetVtkPolyData()->GetPoints());
+    surface2D->SetLines(surface->GetVtkPolyData()->GetLines());
+
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->DeepCopy(slice->GetVtkImageData());
+    vtkIdType count = image->GetNumberOfPoints();
+    for (decltype(count) i = 0; i < count; ++i)
+      image->GetPointData()->GetScalars()->SetTuple1(i, 255.0);
+
+    auto polyDataToImageStencil = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
+    polyDataToImageStencil->SetTolerance(mitk::eps);
+    polyDataToImageStencil->SetInputData(surface2D);
+    polyDataToImageStencil->Update();
+
+    auto imageStencil = vtkSmartPointer<vtkImageStencil>::New();
+    imageStencil->SetInputData(image);
+    imageStencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
+    imageStencil->ReverseStencilOff();
+    imageStencil->SetBackgroundValue(0.0);
+    imageStencil->Update();
+
+    vtkSmartPointer<vtkImageData> resultImage = slice->GetVtkImageData();
+    mitk::ContourModelUtils::FillSliceInSlice(imageStencil->GetOutput(), resultImage, slice, paintingPixelValue);
+    slice->SetVolume(resultImage->GetScalarPointer());
+  }
+
+  static unsigned int CountPixels(mitk::Image *slice, unsigned char value)
+  {
+    mitk::ImagePixelReadAccessor<unsigned char, 3> accessor(slice);
+    const unsigned int numberOfPixels = slice->GetDimension(0) * slice->GetDimension(1);
+
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < numberOfPixels; ++i)
+    {
+      if (accessor.GetData()[i] == value)
+        ++count;
+    }
+
+    return count;
+  }
+
+  static void CheckEqualsStencilFill(mitk::ContourModel *contour)
+  {
+    auto slice = CreateSlice(64);
+    auto referenceSlice = CreateSlice(64);
+
+    mitk::ContourModelUtils::FillContourInSlice(contour, slice, slice, 1);
+    StencilFillContourInSlice(contour, referenceSlice, 1);
+
+    mitk::ImagePixelReadAccessor<unsigned char, 3> accessor(slice);
+    mitk::ImagePixelReadAccessor<unsigned char, 3> referenceAccessor(referenceSlice);
+
+    CPPUNIT_ASSERT(CountPixels(referenceSlice, 1) > 0);
+
+    for (unsigned int i = 0; i < 64 * 64; ++i)
+      CPPUNIT_ASSERT_EQUAL(referenceAccessor.GetData()[i], accessor.GetData()[i]);
+  }
+
+public:
+  void FillContourInSlice_Square_FillsEnclosedPixels()
+  {
+    auto slice = CreateSlice(20);
+    auto square = CreatePolygon({{4.5, 4.5}, {9.5, 4.5}, {9.5, 9.5}, {4.5, 9.5}});
+
+    mitk::ContourModelUtils::FillContourInSlice(square, slice, slice, 3);
+
+    CPPUNIT_ASSERT_EQUAL(25u, CountPixels(slice, 3));
+
+    mitk::ImagePixelReadAccessor<unsigned char, 3> accessor(slice);
+    const auto *data = accessor.GetData();
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(3), data[5 * 20 + 5]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(3), data[9 * 20 + 9]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(0), data[4 * 20 + 5]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(0), data[5 * 20 + 10]);
+  }
+
+  void FillContourInSlice_IntegerSquare_FillsBoundaryPixels()
+  {
+    auto slice = CreateSlice(20);
+    auto square = CreatePolygon({{5.0, 5.0}, {9.0, 5.0}, {9.0, 9.0}, {5.0, 9.0}});
+
+    mitk::ContourModelUtils::FillContourInSlice(square, slice, slice, 3);
+
+    // the pixel centers on the contour, including the topmost row and the horizontal edges, are filled
+    CPPUNIT_ASSERT_EQUAL(25u, CountPixels(slice, 3));
+
+    mitk::ImagePixelReadAccessor<unsigned char, 3> accessor(slice);
+    const auto *data = accessor.GetData();
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(3), data[9 * 20 + 5]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(3), data[9 * 20 + 9]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(0), data[10 * 20 + 7]);
+  }
+
+  void FillContourInSlice_Polygons_EqualsStencilFill()
+  {
+    CheckEqualsStencilFill(CreateCircle(31.3, 27.6, 10.2, 32));
+    CheckEqualsStencilFill(CreateCircle(0.4, 60.1, 8.7, 24));
+    CheckEqualsStencilFill(CreatePolygon({{3.2, 4.1}, {40.7, 10.3}, {20.4, 25.6}, {50.3, 55.2}, {6.1, 40.9}}));
+
+    // vertices on pixel centers, with horizontal edges and extrema on the scanlines
+    CheckEqualsStencilFill(CreatePolygon({{5.0, 5.0}, {9.0, 5.0}, {9.0, 9.0}, {5.0, 9.0}}));
+    CheckEqualsStencilFill(CreatePolygon({{10.0, 10.0}, {40.0, 10.0}, {25.0, 40.0}}));
+    CheckEqualsStencilFill(CreatePolygon({{8.0, 8.0}, {30.0, 8.0}, {30.0, 20.0}, {18.0, 20.0}, {18.0, 35.0}, {8.0, 35.0}}));
+    CheckEqualsStencilFill(CreatePolygon({{20.0, 5.0}, {35.0, 20.0}, {20.0, 35.0}, {5.0, 20.0}}));
+  }
+
+  void FillContourInSlice_ContourOutsideOfSlice_KeepsSlice()
+  {
+    auto slice = CreateSlice(20);
+
+    mitk::ContourModelUtils::FillContourInSlice(CreateCircle(40.0, 40.0, 5.0, 16), slice, slice, 1);
+    mitk::ContourModelUtils::FillContourInSlice(CreateCircle(-10.0, 5.0, 5.0, 16), slice, slice, 1);
+
+    CPPUNIT_ASSERT_EQUAL(0u, CountPixels(slice, 1));
+  }
+
+  void FillContourInSlice_SmallBrush_Benchmark()
+  {
+    const unsigned int strokeLength = 50;
+    auto slice = CreateSlice(1024);
+    auto referenceSlice = CreateSlice(1024);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < strokeLength; ++i)
+      StencilFillContourInSlice(CreateCircle(300.3 + 2.0 * i, 500.6, 5.1, 40), referenceSlice, 1);
+    const double stencilSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < strokeLength; ++i)
+      mitk::ContourModelUtils::FillContourInSlice(CreateCircle(300.3 + 2.0 * i, 500.6, 5.1, 40), slice, slice, 1);
+    const double scanlineSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    MITK_INFO << "Brush stroke of " << strokeLength << " fills on a 1024x1024 slice: stencil fill "
+              << 1000.0 * stencilSeconds / strokeLength << " ms per fill, scanline fill "
+              << 1000.0 * scanlineSeconds / strokeLength << " ms per fill";
+
+    CPPUNIT_ASSERT_EQUAL(CountPixels(referenceSlice, 1), CountPixels(slice, 1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkContourModelUtils)
@@ -159,6 +159,9 @@ namespace mitk
     /// To be called by a toolkit specific CallbackFromGUIThreadImplementation.
     static void RegisterImplementation(CallbackFromGUIThreadImplementation *implementation);
 
+    /// Returns if a toolkit specific implementation is registered, i.e. if there is a GUI thread at all.
+    static bool HasImplementation();
+
     /// Change the current application cursor
     void CallThisFromGUIThread(itk::Command *, itk::EventObject *e = nullptr);
 
@@ -422,6 +422,14 @@ namespace mitk
     //## @brief Filters a SetOfObjects by the condition. If no condition is provided, the original set is returned
     SetOfObjects::ConstPointer FilterSetOfObjects(const SetOfObjects *set, const NodePredicateBase *condition) const;
 
+    //##Documentation
+    //## @brief Returns a subset of all nodes which contains every node that fulfills the condition, in the order
+    //## of GetAll(), or nullptr if all nodes have to be checked.
+    //##
+    //## GetSubset() checks the condition only for these candidates. Subclasses may override this method to
+    //## answer common conditions from an index. The default implementation returns nullptr.
+    virtual SetOfObjects::ConstPointer GetSubsetCandidates(const NodePredicateBase *condition) const;
+
     //##Documentation
     //## @brief Prints the contents of the DataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
@@ -32,10 +32,17 @@ namespace mitk
    * faster by several orders of magnitude as long as the input image was
    * neither changed nor modified.
    *
+   * The sampling steps of the output grid in index space of the input image
+   * are cached as long as the input geometry and the orientation and spacing
+   * of the output geometry stay the same. Consecutive parallel slices, e.g.
+   * while scrolling, only differ by the continuous index of their origin.
+   * Nearest neighbor and linear interpolation sample the input buffer row by
+   * row without per-pixel transformations; rows of slices that are aligned
+   * with the voxel grid are plain (strided) copies.
+   *
    * This filter is completely based on ITK compared to the VTK-based
    * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
-   * an mitk::Image with valid geometry. Generally it is not as fast as
-   * mitk::ExtractSliceFilter, though.
+   * an mitk::Image with valid geometry.
    */
   class MITKCORE_EXPORT ExtractSliceFilter2 final : public ImageToImageFilter
   {
@@ -31,6 +31,10 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+
 class vtkImageData;
 
 namespace itk
@@ -45,6 +49,8 @@ namespace mitk
   class ImageTimeSelector;
 
   class ImageStatisticsHolder;
+  class ImageMemoryManager;
+  class EvictedImageData;
 
   /**
     * @brief Image class for storing images
@@ -80,6 +86,7 @@ namespace mitk
     friend class ImageVtkWriteAccessor;
     friend class ImageReadAccessor;
     friend class ImageWriteAccessor;
+    friend class ImageMemoryManager;
 
   public:
     mitkClassMacro(Image, SlicedData);
@@ -133,7 +140,9 @@ namespace mitk
     If you only want to access a slice, volume at a specific time or single channel
     use one of the SubImageSelector classes.
      \deprecatedSince{2012_09} Please use image accessors instead: See Doxygen/Related-Pages/Concepts/Image. This method
-    can be replaced by ImageWriteAccessor::GetData() or ImageReadAccessor::GetData() */
+    can be replaced by ImageWriteAccessor::GetData() or ImageReadAccessor::GetData()
+
+    The data of the image is pinned, i.e. never evicted by EvictData() afterwards. */
     DEPRECATED(virtual void *GetData());
 
   public:
@@ -562,6 +571,20 @@ namespace mitk
                                                 void *data = nullptr,
                                                 ImportMemoryManagementType importMemoryManagement = CopyMemory) const;
 
+    /**
+    \brief Returns the number of bytes of voxel memory that is owned by the data items of the image
+
+    Memory that has been imported by reference is not included. The size of an evicted image is 0.
+    */
+    std::size_t GetAllocatedDataSize() const;
+
+    /**
+    \brief Whether the voxel data has been moved out of memory by the ImageMemoryManager
+
+    The data is restored transparently with the next access, e.g. by an image accessor or GetVtkImageData().
+    */
+    bool IsDataEvicted() const;
+
     /**
     \brief (DEPRECATED) Get the minimum for scalar images
     */
@@ -690,12 +713,44 @@ namespace mitk
     /** @warning Has to be called by every Initialize method! */
     void Initialize() override;
 
+    /**
+     * \brief Exchanges the data of this image with the data of \a other without copying any voxel.
+     *
+     * Both images need the same pixel type, dimensions and number of channels (see CanSwapImageData()).
+     * Geometries and properties are not exchanged. Waits until all image accessors of both images are
+     * released, so the calling thread must not hold an accessor of one of the images.
+     * \throws mitk::Exception if the images are not compatible
+     */
+    void SwapImageData(Image *other);
+
+    /** \brief Returns whether SwapImageData() can exchange the data of this image with the data of \a other */
+    bool CanSwapImageData(const Image *other) const;
+
+    /**
+     * \brief Moves the voxel data of all channels to \a evictedData and releases the data items.
+     *
+     * The data is not evicted if it is incomplete, not owned by the image or still referenced outside of
+     * the image, i.e. by image accessors, data items or vtkImageData. Data that has been handed out as raw
+     * pointer by GetData() or ImageDataItem::GetData() is pinned and not evicted either. Used by
+     * ImageMemoryManager.
+     * \return whether the data has been evicted
+     */
+    bool EvictData(std::unique_ptr<EvictedImageData> evictedData);
+
+    /** \brief Sequence number of the last request of a slice, volume or channel, see ImageMemoryManager */
+    unsigned long long GetLastDataAccessTime() const;
+
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
 
     mutable ImageDataItemPointerArray m_Channels;
     mutable ImageDataItemPointerArray m_Volumes;
     mutable ImageDataItemPointerArray m_Slices;
+    /** Serializes the materialization of slices, volumes and channels (recursive, see ImageDataArraysWriteHolder) */
     mutable itk::SimpleFastMutexLock m_ImageDataArraysLock;
+    /** Allows concurrent lookups of already materialized slices, volumes and channels */
+    mutable std::shared_timed_mutex m_ImageDataArraysSharedLock;
+    /** Nesting depth of ImageDataArraysWriteHolder in the thread owning m_ImageDataArraysLock */
+    mutable unsigned int m_ImageDataArraysWriteDepth;
 
     unsigned int m_Dimension;
 
@@ -711,6 +766,21 @@ namespace mitk
     StatisticsHolderPointer m_ImageStatistics;
 
   private:
+    /** \brief Gives exclusive access to the image data arrays.
+     *
+     * Locks m_ImageDataArraysLock and, on the outermost nesting level, m_ImageDataArraysSharedLock
+     * exclusively. The nesting is needed because updating the source of the image may call back
+     * into the locked methods from the same thread. */
+    class ImageDataArraysWriteHolder;
+
+    /** \brief Returns the slice if it is already materialized, without waiting for other threads.
+     * Returns nullptr if the slice has to be created or if the arrays are currently modified. */
+    ImageDataItemPointer GetExistingSliceData(int s, int t, int n) const;
+    /** \brief Returns the complete volume if it is already materialized, see GetExistingSliceData() */
+    ImageDataItemPointer GetExistingVolumeData(int t, int n) const;
+    /** \brief Returns the complete channel if it is already materialized, see GetExistingSliceData() */
+    ImageDataItemPointer GetExistingChannelData(int n) const;
+
     ImageDataItemPointer GetSliceData_unlocked(
       int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const;
     ImageDataItemPointer GetVolumeData_unlocked(int t,
@@ -735,6 +805,16 @@ namespace mitk
     bool IsVolumeSet_unlocked(int t, int n) const;
     bool IsChannelSet_unlocked(int n) const;
 
+    /** Whether all data items are referenced only by the image itself and own their memory */
+    bool IsDataExclusivelyOwned_unlocked() const;
+    /** Reallocates the channels from m_EvictedData, if the image has been evicted */
+    void RestoreEvictedData_unlocked() const;
+    void UpdateLastDataAccessTime() const;
+
+    /** The voxel data while the image is evicted, nullptr otherwise (guarded by m_ImageDataArraysLock) */
+    mutable std::unique_ptr<EvictedImageData> m_EvictedData;
+    mutable std::atomic<unsigned long long> m_LastDataAccessTime;
+
     /** Stores all existing ImageReadAccessors */
     mutable std::vector<ImageAccessorBase *> m_Readers;
     /** Stores all existing ImageWriteAccessors */
@@ -79,10 +79,28 @@ namespace mitk
       IgnoreLock = 4
     };
 
+    /** \brief Region type of sub regions, always represented in maximal possible dimension */
+    typedef itk::ImageRegion<4> RegionType;
+
     virtual ~ImageAccessorBase();
 
     /** \brief Gives const access to the data. */
-    inline const void *GetData() const { return m_AddressBegin; }
+    inline const void *GetData() const
+    {
+      return m_SubRegionBuffer != nullptr ? static_cast<const void *>(m_SubRegionBuffer) : m_AddressBegin;
+    }
+
+    /** \brief Returns if the access is restricted to a sub region of the image part. */
+    inline bool HasSubRegion() const { return m_SubRegion != nullptr; }
+
+    /** \brief Returns the distance in bytes between two neighboring pixels along the given
+      * dimension (0..3) of the data returned by GetData().
+      *
+      * The data is densely packed unless a sub region that does not lie coherently in memory
+      * is accessed without ForceCoherentMemory. In that case GetData() points to the first pixel
+      * of the sub region inside the image part and the strides of the image part apply.
+      */
+    inline size_t GetStride(unsigned int dimension) const { return m_Strides[dimension]; }
   protected:
 // Define type of thread id
 #ifdef ITK_USE_SPROC
@@ -99,7 +117,10 @@ namespace mitk
 
     /** \brief Checks validity of given parameters from inheriting classes and stores those parameters in member
      * variables. */
-    ImageAccessorBase(ImageConstPointer iP, const ImageDataItem *iDI = nullptr, int OptionFlags = DefaultBehavior);
+    ImageAccessorBase(ImageConstPointer iP,
+                      const ImageDataItem *iDI = nullptr,
+                      int OptionFlags = DefaultBehavior,
+                      const RegionType *subRegion = nullptr);
 
     /** ImageAccessor has access to the image it belongs to. */
     // ImagePointer m_Image;
@@ -121,6 +142,18 @@ namespace mitk
     /** Defines if the accessed image part lies coherently in memory */
     bool m_CoherentMemory;
 
+    /** Size of one pixel in bytes */
+    size_t m_PixelSize;
+
+    /** Distances in bytes between neighboring pixels of the data returned by GetData() */
+    size_t m_Strides[4];
+
+    /** Distances in bytes between neighboring pixels of the accessed image part */
+    size_t m_SourceStrides[4];
+
+    /** Coherent copy of a sub region that does not lie coherently in memory (only with ForceCoherentMemory) */
+    unsigned char *m_SubRegionBuffer;
+
     /** \brief Pointer to a WaitLock struct, that allows other ImageAccessors to wait for this ImageAccessor */
     ImageAccessorWaitLock *m_WaitLock;
 
@@ -128,13 +161,18 @@ namespace mitk
      * mitk::Image class is Locked. */
     inline void Increment() { m_WaitLock->m_WaiterCount += 1; }
     /** \brief Computes if there is an Overlap of the image part between this instantiation and another ImageAccessor
-     * object
-      * \throws mitk::Exception if memory area is incoherent (not supported yet)
+     * object. Sub regions that do not lie coherently in memory are conservatively represented by the memory span
+     * between their first and last pixel.
       */
     bool Overlap(const ImageAccessorBase *iAB);
 
-    /** \brief Uses the WaitLock to wait for another ImageAccessor*/
-    void WaitForReleaseOf(ImageAccessorWaitLock *wL);
+    /** \brief Copies the sub region from the image part into m_SubRegionBuffer or back.
+     * Does nothing if there is no such buffer. A call of this method is only allowed while the accessed
+     * image part is locked by this accessor. */
+    void CopySubRegion(bool intoBuffer);
+
+    /** \brief Uses the WaitLock to wait for another ImageAccessor (also used by Image::SwapImageData)*/
+    static void WaitForReleaseOf(ImageAccessorWaitLock *wL);
 
     ThreadIDType m_Thread;
 
@@ -144,6 +182,9 @@ namespace mitk
     virtual const Image *GetImage() const = 0;
 
   private:
+    /** \brief Validates m_SubRegion and sets memory area and strides for it */
+    void InitializeSubRegion(const ImageDataItem *imageDataItem);
+
     /** \brief System dependend thread method, to prevent recursive mutex access */
     ThreadIDType CurrentThreadHandle();
     /** \brief System dependend thread method, to prevent recursive mutex access */
@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include "mitkImageDescriptor.h"
 //#include "mitkImageVtkAccessor.h"
 
+#include <atomic>
+
 class vtkImageData;
 
 namespace mitk
@@ -90,8 +92,22 @@ namespace mitk
 
     /**
     \deprecatedSince{2012_09} Please use image accessors instead: See Doxygen/Related-Pages/Concepts/Image. This method
-    can be replaced by ImageWriteAccessor::GetData() or ImageReadAccessor::GetData() */
-    DEPRECATED(void *GetData() const) { return m_Data; }
+    can be replaced by ImageWriteAccessor::GetData() or ImageReadAccessor::GetData()
+
+    The returned pointer is not tracked by the image, so the item and its parents are pinned (see IsDataPinned()). */
+    DEPRECATED(void *GetData() const)
+    {
+      this->PinData();
+      return m_Data;
+    }
+
+    /**
+     * @brief True if a raw pointer to the data of this item has been handed out by GetData().
+     *
+     * The memory of a pinned item may be in use anytime, Image::EvictData() does not release it.
+     */
+    bool IsDataPinned() const { return m_DataPinned; }
+
     bool IsComplete() const { return m_IsComplete; }
     void SetComplete(bool complete) { m_IsComplete = complete; }
     int GetOffset() const { return m_Offset; }
@@ -130,6 +146,16 @@ namespace mitk
     size_t GetSize() const { return m_Size; }
     virtual void Modified() const;
 
+    /**
+     * @brief Keeps @a owner alive as long as this item (or a copy of it) exists.
+     *
+     * Used for data that is neither owned by the item (ManageMemory) nor by the
+     * caller, e.g. a memory mapped file (see mitk::MemoryMappedFile). Sub-items
+     * (slices, volumes) keep their parent and thereby the owner alive.
+     */
+    void SetMemoryOwner(const itk::LightObject *owner) { m_MemoryOwner = owner; }
+    const itk::LightObject *GetMemoryOwner() const { return m_MemoryOwner.GetPointer(); }
+
   protected:
     unsigned char *m_Data;
 
@@ -149,13 +175,23 @@ namespace mitk
   private:
     void ComputeItemSize(const unsigned int *dimensions, unsigned int dimension);
 
+    /** Deletes the vtk accessors, which refer to the image owning this item (see Image::SwapImageData) */
+    void ReleaseVtkImageAccessors();
+
     ImageDataItem::ConstPointer m_Parent;
 
+    itk::LightObject::ConstPointer m_MemoryOwner;
+
     unsigned int m_Dimension;
 
     unsigned int m_Dimensions[MAX_IMAGE_DIMENSIONS];
 
     int m_Timestep;
+
+    mutable std::atomic<bool> m_DataPinned;
+
+    /** Pins this item and its parents, which own the memory of this item */
+    void PinData() const;
   };
 
 } // namespace mitk
@@ -0,0 +1,181 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageMemoryManager_h
+#define mitkImageMemoryManager_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkObject.h>
+#include <itkSmartPointer.h>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  class DataNode;
+  class DataStorage;
+  class Image;
+
+  /**
+   * \brief Storage of the voxel data of an evicted image.
+   *
+   * Holds the data of all channels of an image while it is evicted by the ImageMemoryManager, see
+   * Image::EvictData(). The data is released with the object.
+   */
+  class MITKCORE_EXPORT EvictedImageData
+  {
+  public:
+    virtual ~EvictedImageData();
+
+    /**
+     * \brief Stores the data of channel n. Called once per channel, in the order of the channels.
+     * \throws mitk::Exception if the data cannot be stored
+     */
+    virtual void Store(unsigned int n, const void *data, std::size_t size) = 0;
+
+    /**
+     * \brief Copies the stored data of channel n to data.
+     * \throws mitk::Exception if the data cannot be loaded
+     */
+    virtual void Load(unsigned int n, void *data, std::size_t size) const = 0;
+
+    /** \brief Number of bytes of main memory occupied by the stored data. */
+    virtual std::size_t GetMemorySize() const = 0;
+  };
+
+  /**
+   * \brief Keeps the voxel memory of the images in the registered data storages below a budget.
+   *
+   * The manager sums the memory owned by the data items of the images of all nodes in the registered
+   * data storages (see Image::GetAllocatedDataSize()). If the sum exceeds the budget, images are evicted
+   * until it fits again: their voxel data is moved to a spill file or compressed in memory (see
+   * SetEvictionMode()) and their data items are released. Images of hidden nodes are evicted first,
+   * followed by the images of visible nodes, each in the order of their last data access.
+   *
+   * Images whose data is currently in use, i.e. referenced by image accessors, data items or the
+   * vtkImageData of mappers, are skipped. So are images whose data has been handed out as raw pointer by the
+   * deprecated GetData() methods of Image and ImageDataItem. An evicted image restores its data transparently with the
+   * next access to it, e.g. by an image accessor, GetVtkImageData() or GetVolumeData().
+   *
+   * The budget is checked by EnforceMemoryBudget() and in a worker thread of the manager whenever a node
+   * is added to one of the registered data storages, a data storage is registered or the budget is changed
+   * (see RequestMemoryBudgetEnforcement()). This keeps the compression or writing of evicted data off the
+   * thread that adds the nodes, usually the GUI thread. A budget of 0 (default) disables the eviction.
+   */
+  class MITKCORE_EXPORT ImageMemoryManager : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ImageMemoryManager, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Returns the manager of the application. Further instances may be created for separate budgets. */
+    static ImageMemoryManager *GetInstance();
+
+    enum EvictionMode
+    {
+      /** The data is written to a temporary file in the spill directory */
+      SpillToFile,
+      /** The data is compressed with zlib and kept in memory */
+      CompressInMemory
+    };
+
+    /**
+     * \brief Sets the number of bytes the images may occupy, 0 disables the eviction.
+     *
+     * A lower budget is enforced asynchronously, see RequestMemoryBudgetEnforcement().
+     */
+    void SetMemoryBudget(std::size_t bytes);
+    std::size_t GetMemoryBudget() const;
+
+    void SetEvictionMode(EvictionMode mode);
+    EvictionMode GetEvictionMode() const;
+
+    /** \brief Sets the directory of the spill files. Defaults to IOUtil::GetTempPath(). */
+    void SetSpillDirectory(const std::string &directory);
+    std::string GetSpillDirectory() const;
+
+    /** \brief Registers a data storage whose images are managed. */
+    void AddDataStorage(DataStorage *dataStorage);
+    void RemoveDataStorage(DataStorage *dataStorage);
+
+    /** \brief Number of bytes occupied by the images of the registered data storages that are not evicted. */
+    std::size_t GetResidentMemorySize() const;
+
+    /** \brief Evicts images until the resident memory fits into the budget. */
+    void EnforceMemoryBudget();
+
+    /**
+     * \brief Evicts images in the worker thread of the manager until the resident memory fits into the budget.
+     *
+     * The images and their visibility are determined in the calling thread. Requests that arrive while the
+     * worker is busy are merged into one.
+     */
+    void RequestMemoryBudgetEnforcement();
+
+    /** \brief Waits until the worker thread has processed all requests. */
+    void WaitForMemoryBudgetEnforcement();
+
+    /**
+     * \brief Evicts the image using the current eviction mode.
+     * \return false if the image is already evicted or its data cannot be evicted currently
+     */
+    bool EvictImage(Image *image);
+
+  protected:
+    ImageMemoryManager();
+    ~ImageMemoryManager() override;
+
+  private:
+    struct EvictionCandidate
+    {
+      itk::SmartPointer<Image> m_Image;
+      bool m_Visible;
+    };
+
+    void OnNodeAdded(const DataNode *node);
+    void OnDataStorageDeleted(const itk::Object *caller, const itk::EventObject &event);
+
+    /** \brief Returns the images of the registered data storages, which are visible if one of their nodes is */
+    std::vector<EvictionCandidate> GetEvictionCandidates() const;
+    void EvictCandidates(std::vector<EvictionCandidate> &candidates);
+    void RunEnforcementThread();
+
+    /** \brief Registered data storages and the tags of their delete observers */
+    std::map<DataStorage *, unsigned long> m_DataStorages;
+
+    std::size_t m_MemoryBudget;
+    EvictionMode m_EvictionMode;
+    std::string m_SpillDirectory;
+
+    mutable std::mutex m_Mutex;
+    /** \brief Serializes the enforcement of the budget */
+    std::mutex m_EnforceMutex;
+
+    /** \brief Worker of RequestMemoryBudgetEnforcement(), started with the first request */
+    std::thread m_EnforcementThread;
+    std::mutex m_EnforcementMutex;
+    std::condition_variable m_EnforcementCondition;
+    std::vector<EvictionCandidate> m_RequestedCandidates;
+    bool m_EnforcementRequested;
+    bool m_Enforcing;
+    bool m_StopEnforcement;
+  };
+}
+
+#endif
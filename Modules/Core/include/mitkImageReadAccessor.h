@@ -53,6 +53,22 @@ namespace mitk
 
     ImageReadAccessor(const Image *image, const ImageDataItem *iDI = nullptr);
 
+    /** \brief Orders read access for a sub region of a slice, volume or 4D-Image
+     *  \param image specifies the associated Image
+     *  \param subRegion specifies the accessed region in index coordinates of the image part
+     *  \param iDI specifies the allocated image part, the first channel is used if nullptr
+     *  \param OptionFlags properties from mitk::ImageAccessorBase::Options. With ForceCoherentMemory, a sub region that
+     * does not lie coherently in memory is copied into a separate buffer. Otherwise GetStride() has to be used to
+     * traverse the data.
+     *  \throws mitk::Exception if the sub region exceeds the image part
+     *  \throws mitk::MemoryIsLockedException if requested image area is exclusively locked and
+     * mitk::ImageAccessorBase::ExceptionIfLocked is set in OptionFlags
+     */
+    ImageReadAccessor(ImageConstPointer image,
+                      const RegionType &subRegion,
+                      const ImageDataItem *iDI = nullptr,
+                      int OptionFlags = ImageAccessorBase::DefaultBehavior);
+
     /** Destructor informs Image to unlock memory. */
     ~ImageReadAccessor() override;
 
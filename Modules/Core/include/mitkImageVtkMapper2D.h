@@ -25,6 +25,9 @@ found in the LICENSE file.
 #include <vtkPropAssembly.h>
 #include <vtkSmartPointer.h>
 
+// STL
+#include <memory>
+
 class vtkActor;
 class vtkPolyDataMapper;
 class vtkPlaneSource;
@@ -88,6 +91,9 @@ namespace mitk
    *   - \b "texture interpolation": (BoolProperty) texture interpolation of the image
    *   - \b "reslice interpolation": (VtkResliceInterpolationProperty) reslice interpolation of the image
    *   - \b "in plane resample extent by geometry": (BoolProperty) Do it or not
+   *   - \b "Image Rendering.Asynchronous": (BoolProperty) Generate the slices on worker threads. The previous
+   *          slice is displayed until the new one is ready, slices of positions which are left before they are
+   *          ready are dropped. Binary images with outline rendering are always generated synchronously.
    *   - \b "bounding box": (BoolProperty) Is the Bounding Box of the image shown or not
    *   - \b "layer": (IntProperty) Layer of the image
    *   - \b "volume annotation color": (ColorProperty) color of the volume annotation, TODO has to be reimplemented
@@ -134,6 +140,9 @@ namespace mitk
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
     //### end of methods of MITK-VTK rendering pipeline
 
+    /** \brief A slice which is generated on a worker thread, see "Image Rendering.Asynchronous". */
+    struct AsyncSliceJob;
+
     /** \brief Internal class holding the mapper, actor, etc. for each of the 3 2D render windows */
     /**
        * To render transveral, coronal, and sagittal, the mapper is called three times.
@@ -181,6 +190,9 @@ namespace mitk
       vtkSmartPointer<vtkLookupTable> m_ColorLookupTable;
       /** \brief The actual reslicer (one per renderer) */
       mitk::ExtractSliceFilter::Pointer m_Reslicer;
+      /** \brief The volume whose memory the input of m_Reslicer references, if it was taken from an
+            asynchronous slice; kept alive together with the reslicer. */
+      mitk::Image::ImageDataItemPointer m_ReslicerVolumeData;
       /** \brief Filter for thick slices */
       vtkSmartPointer<vtkMitkThickSlicesFilter> m_TSFilter;
       /** \brief PolyData object containg all lines/points needed for outlining the contour.
@@ -197,6 +209,9 @@ namespace mitk
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
 
+      /** \brief The slice which is generated asynchronously and replaces the displayed one once it is ready. */
+      std::shared_ptr<AsyncSliceJob> m_PendingSlice;
+
       /** \brief Default constructor of the local storage. */
       LocalStorage();
       /** \brief Default deconstructor of the local storage. */
@@ -267,6 +282,29 @@ namespace mitk
       */
     void GenerateDataForRenderer(mitk::BaseRenderer *renderer) override;
 
+    /** \brief Sets up a reslicer for the world geometry and the properties of the renderer.
+      * \return The thick slices mode, 0 if thick slices are disabled, or -1 if the world geometry is not supported.
+      */
+    int ConfigureReslicer(mitk::BaseRenderer *renderer,
+                          ExtractSliceFilter *reslicer,
+                          Image *input,
+                          int timeStep,
+                          const PlaneGeometry *worldGeometry,
+                          const BaseGeometry *imageGeometry);
+
+    /** \brief Queues the generation of the slice on a worker thread. A pending slice of the renderer is canceled.
+      *
+      * The reslicing, the thick slices and the level window are executed by the worker. The rendering manager
+      * is requested to update the render window once the slice is ready, it is displayed by the next Update().
+      */
+    void StartAsyncSlice(mitk::BaseRenderer *renderer, Image *image, const PlaneGeometry *worldGeometry);
+
+    /** \brief Displays the finished slice of the renderer instead of the previous one. */
+    void FinishAsyncSlice(mitk::BaseRenderer *renderer);
+
+    /** \brief Cancels the pending slice, if any. */
+    void CancelAsyncSlice(LocalStorage *localStorage);
+
     /** \brief This method uses the vtkCamera clipping range and the layer property
       * to calcualte the depth of the object (e.g. image or contour). The depth is used
       * to keep the correct order for the final VTK rendering.*/
@@ -29,6 +29,11 @@ namespace mitk
    * For all ITK ImageIOs that support the serialization of MetaData
    * (e.g. nrrd or mhd) the ItkImageIO ensures the serialization
    * of Identification UID.
+   *
+   * If the reader option OPTION_MEMORY_MAPPED_READING() is enabled, uncompressed
+   * NRRD, MetaImage and NIfTI files in native byte order are not read but memory
+   * mapped (copy-on-write). Pixel data is then paged in on first access only.
+   * Files that cannot be mapped as they are silently fall back to regular reading.
    */
   class MITKCORE_EXPORT ItkImageIO : public AbstractFileIO
   {
@@ -36,6 +41,9 @@ namespace mitk
     ItkImageIO(itk::ImageIOBase::Pointer imageIO);
     ItkImageIO(const CustomMimeType &mimeType, itk::ImageIOBase::Pointer imageIO, int rank);
 
+    /** Reader option (bool, default: false) to memory map the pixel data instead of reading it. */
+    static std::string OPTION_MEMORY_MAPPED_READING();
+
     // -------------- AbstractFileReader -------------
 
     using AbstractFileReader::Read;
@@ -54,6 +62,8 @@ namespace mitk
     // Fills the m_DefaultMetaDataKeys vector with default values
     virtual void InitializeDefaultMetaDataKeys();
 
+    void InitializeDefaultReaderOptions();
+
     // -------------- AbstractFileReader -------------
     std::vector<itk::SmartPointer<BaseData>> DoRead() override;
 
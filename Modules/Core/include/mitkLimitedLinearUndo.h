@@ -100,6 +100,43 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo history in bytes.
+    //## If the value is 0 that means that there is no limit.
+    //## Initially, the limit is GetDefaultUndoMemoryLimit() of the time the model was created.
+    std::size_t GetUndoMemoryLimit() const;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo history in bytes.
+    //## If the limit is exceeded, the oldest undo items will be dropped
+    //## from the bottom of the undo stack. All items of an ObjectEventId
+    //## are dropped together, the items of the newest ObjectEventId are
+    //## always kept. Items whose memory usage is still pending (e.g. while
+    //## their data is compressed in the background) are not counted until
+    //## their memory usage is final.
+    //## The 0 value means that there is no limit.
+    //## @param limit the maximum number of bytes held by the undo stack
+    void SetUndoMemoryLimit(std::size_t limit);
+
+    //##Documentation
+    //## @brief Returns the memory limit of new undo models in bytes.
+    //## Initially 0, i.e. the memory of the undo history is not limited.
+    static std::size_t GetDefaultUndoMemoryLimit();
+
+    //##Documentation
+    //## @brief Sets the memory limit of undo models created afterwards in bytes.
+    //## Applications set it from their preferences before the first undo model
+    //## is created (see UndoController). Existing models keep their limit.
+    static void SetDefaultUndoMemoryLimit(std::size_t limit);
+
+    //##Documentation
+    //## @brief Returns the approximate number of bytes held by the undo stack
+    std::size_t GetUndoMemoryUsage() const;
+
+    //##Documentation
+    //## @brief Returns the approximate number of bytes held by the redo stack
+    std::size_t GetRedoMemoryUsage() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +165,13 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Drops the oldest undo items until the undo stack fits into the memory limit
+    void ApplyUndoMemoryLimit();
+
+    //## @brief Sums up the memory usage of all items in the list
+    //## @param includePending if false, items whose memory usage is still pending are skipped
+    static std::size_t GetMemoryUsage(const UndoContainer &list, bool includePending = true);
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -137,6 +181,8 @@ namespace mitk
 
     std::size_t m_UndoLimit;
 
+    std::size_t m_UndoMemoryLimit;
+
   };
 
 #pragma GCC visibility push(default)
@@ -0,0 +1,86 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryMappedFile_h
+#define mitkMemoryMappedFile_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkLightObject.h>
+
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @brief Private, copy-on-write memory mapping of a byte range of a file.
+   *
+   * The mapped range is not read on construction. Pages are faulted in by the
+   * operating system when they are accessed for the first time, so the cost of
+   * a mapping is proportional to the amount of data that is actually touched.
+   * Writes into the mapped memory are never propagated back to the file.
+   *
+   * Instances are usually handed to ImageDataItem::SetMemoryOwner() to keep
+   * the mapping alive as long as image data items reference it.
+   *
+   * @ingroup Data
+   */
+  class MITKCORE_EXPORT MemoryMappedFile : public itk::LightObject
+  {
+  public:
+    mitkClassMacroItkParent(MemoryMappedFile, itk::LightObject);
+    itkFactorylessNewMacro(Self);
+
+    /**
+     * @brief Maps @a length bytes of the file @a path starting at byte @a offset.
+     *
+     * An existing mapping is released first.
+     * @throw mitk::Exception if the file cannot be opened or mapped or if the
+     *        requested range exceeds the file size.
+     */
+    void Map(const std::string &path, size_t offset, size_t length);
+
+    /** @brief Releases the mapping. Does nothing if nothing is mapped. */
+    void Unmap();
+
+    bool IsMapped() const { return m_Data != nullptr; }
+
+    /** @brief Returns the first byte of the mapped range (not of the mapped pages). */
+    void *GetData() const { return m_Data; }
+
+    /** @brief Returns the number of bytes of the mapped range. */
+    size_t GetSize() const { return m_Size; }
+
+    /** @brief Returns the size of the file @a path in bytes or 0 if it cannot be determined. */
+    static size_t GetFileSize(const std::string &path);
+
+  protected:
+    MemoryMappedFile();
+    ~MemoryMappedFile() override;
+
+  private:
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    void *m_MappedPages;
+    size_t m_MappedLength;
+    void *m_Data;
+    size_t m_Size;
+#ifdef _WIN32
+    void *m_FileHandle;
+    void *m_MappingHandle;
+#endif
+  };
+}
+
+#endif
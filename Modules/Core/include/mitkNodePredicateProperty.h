@@ -44,6 +44,18 @@ namespace mitk
     //## @brief Checks, if the nodes contains a property that is equal to m_ValidProperty
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    //##Documentation
+    //## @brief Name of the checked property
+    const std::string &GetValidPropertyName() const { return m_ValidPropertyName; }
+
+    //##Documentation
+    //## @brief Property the checked property has to be equal to, nullptr if only its existence is checked
+    const mitk::BaseProperty *GetValidProperty() const { return m_ValidProperty; }
+
+    //##Documentation
+    //## @brief Renderer whose specific property is checked, nullptr for the non-renderer-specific property
+    const mitk::BaseRenderer *GetRenderer() const { return m_Renderer; }
+
   protected:
     //##Documentation
     //## @brief Constructor to check for a named property
@@ -39,6 +39,18 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Returns the approximate number of bytes held by this operation.
+    //## Used by undo models to limit the memory of the undo history.
+    //## Operations holding large data (e.g. image slices) should override it.
+    virtual std::size_t GetMemoryUsage() const;
+
+    //##Documentation
+    //## @brief Returns true while GetMemoryUsage() is not final yet,
+    //## e.g. because the data of the operation is still compressed in the background.
+    //## Undo models do not count such operations against their memory limit.
+    virtual bool IsMemoryUsagePending() const;
+
   protected:
     OperationType m_OperationType;
   };
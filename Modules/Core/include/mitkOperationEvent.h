@@ -74,6 +74,14 @@ namespace mitk
     virtual void ReverseOperations();
     virtual void ReverseAndExecute();
 
+    //##Documentation
+    //## @brief Returns the approximate number of bytes held by this item
+    virtual std::size_t GetMemoryUsage() const;
+
+    //##Documentation
+    //## @brief Returns true while the memory usage of this item is not final yet
+    virtual bool IsMemoryUsagePending() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -170,6 +178,12 @@ namespace mitk
     //## and false if it already has been deleted
     virtual bool IsValid();
 
+    //## @brief Returns the approximate number of bytes held by this item including both operations
+    std::size_t GetMemoryUsage() const override;
+
+    //## @brief Returns true while the memory usage of one of both operations is not final yet
+    bool IsMemoryUsagePending() const override;
+
   protected:
     void OnObjectDeleted();
 
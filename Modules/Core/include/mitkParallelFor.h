@@ -0,0 +1,44 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelFor_h
+#define mitkParallelFor_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace mitk
+{
+  /**
+   * \brief Calls function(i) for all i in [0, count) using the threads of ITK (itk::MultiThreader).
+   *
+   * At most maximumNumberOfWorkUnits calls run concurrently, each thread takes the next index when it has
+   * finished a call. A value of 0 uses the global default number of threads of ITK, 1 calls function for
+   * all indices in the calling thread. The calling thread takes part in the calls and waits until all calls
+   * are finished.
+   *
+   * If reportProgress is set, it is called in the calling thread with the number of newly finished calls
+   * (e.g. to advance the mitk::ProgressBar, which must not be used from other threads). The reported numbers
+   * always sum up to count.
+   *
+   * If function throws, the remaining calls are skipped and the first exception is rethrown after all
+   * running calls are finished.
+   */
+  MITKCORE_EXPORT void ParallelFor(std::size_t count,
+                                   const std::function<void(std::size_t)> &function,
+                                   unsigned int maximumNumberOfWorkUnits = 0,
+                                   const std::function<void(std::size_t)> &reportProgress = nullptr);
+}
+
+#endif
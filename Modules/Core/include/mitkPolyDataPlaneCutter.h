@@ -0,0 +1,114 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPolyDataPlaneCutter_h
+#define mitkPolyDataPlaneCutter_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+#include <mitkNumericTypes.h>
+
+#include <itkObject.h>
+
+#include <vtkSmartPointer.h>
+
+#include <list>
+#include <vector>
+
+class vtkCutter;
+class vtkPlane;
+class vtkPolyData;
+
+namespace mitk
+{
+  /**
+   * \brief Cuts vtkPolyData with planes, using a bounding volume hierarchy of its cells.
+   *
+   * The hierarchy is built on the first cut after the input has been set or modified. A cut only
+   * passes the cells whose bounds intersect the plane to a vtkCutter, so its cost depends on the size
+   * of the contour instead of the size of the input. The contours of the most recent planes are
+   * cached, so that scrolling back and forth between slices does not cut the input again.
+   *
+   * The contours are equivalent to the output of a vtkCutter with a vtkPlane applied to the whole
+   * input, including the interpolated point and cell data.
+   */
+  class MITKCORE_EXPORT PolyDataPlaneCutter : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(PolyDataPlaneCutter, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Set the poly data to cut. */
+    void SetInput(vtkPolyData *input);
+    vtkPolyData *GetInput() const;
+
+    /** \brief Number of contours that are cached. Default is 16, 0 disables the cache. */
+    void SetContourCacheSize(unsigned int size);
+    itkGetConstMacro(ContourCacheSize, unsigned int);
+
+    /** \brief Returns the contour of the input in the plane given by origin and normal.
+     *
+     * The returned poly data must not be modified, as it may be returned again by subsequent cuts.
+     */
+    vtkSmartPointer<vtkPolyData> Cut(const Point3D &origin, const Vector3D &normal);
+
+    /** \brief Number of cells that have been passed to the vtkCutter by the last cut which was not
+     * answered from the cache. */
+    itkGetConstMacro(NumberOfCandidateCells, vtkIdType);
+
+  protected:
+    PolyDataPlaneCutter();
+    ~PolyDataPlaneCutter() override;
+
+  private:
+    struct Node
+    {
+      float Bounds[6];
+      std::size_t First;
+      std::size_t Count;
+      int Left;
+      int Right;
+    };
+
+    struct CachedContour
+    {
+      double Plane[4];
+      vtkSmartPointer<vtkPolyData> Contour;
+    };
+
+    void BuildIndex();
+    int BuildNode(std::size_t first, std::size_t count, const std::vector<float> &centers);
+    void CollectCandidateCells(const double plane[4], std::vector<vtkIdType> &candidates) const;
+    vtkSmartPointer<vtkPolyData> ExtractCells(const std::vector<vtkIdType> &cellIds);
+
+    vtkSmartPointer<vtkPolyData> m_Input;
+    vtkSmartPointer<vtkCutter> m_Cutter;
+    vtkSmartPointer<vtkPlane> m_CuttingPlane;
+
+    /** \brief Modification time of the input the index was built for. */
+    vtkMTimeType m_IndexTime;
+    std::vector<Node> m_Nodes;
+    std::vector<vtkIdType> m_CellIds;
+    std::vector<float> m_CellBounds;
+    float m_Tolerance;
+
+    /** \brief Maps point ids of the input to the extracted cells, -1 for points not extracted. */
+    std::vector<vtkIdType> m_PointMap;
+
+    std::list<CachedContour> m_ContourCache;
+    unsigned int m_ContourCacheSize;
+
+    vtkIdType m_NumberOfCandidateCells;
+  };
+} // namespace mitk
+
+#endif
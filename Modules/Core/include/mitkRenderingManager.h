@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include <itkObject.h>
 #include <itkObjectFactory.h>
+#include <chrono>
+#include <mutex>
 #include <string>
 
 #include "mitkProperties.h"
@@ -64,6 +66,17 @@ namespace mitk
    * be used to force the RenderWindow update execution without any delay,
    * bypassing the request functionality.
    *
+   * Pending requests are scheduled by #ExecutePendingRequests(): all requests
+   * for a RenderWindow are merged into a single update, 2D windows are rendered
+   * before 3D windows, and a window is not rendered more often than
+   * #SetMaximumFrameRate() allows. Once the time spent in one execution exceeds
+   * the frame budget (see #SetFrameBudget()), the remaining windows are deferred
+   * to the next execution, so that interaction events can be processed in between.
+   * 3D windows rendered together with 2D windows (i.e. during interaction) use
+   * the lowest level of detail; the high resolution rendering follows once the
+   * interaction has stopped. The frame times of each window are available by
+   * #GetRenderWindowStatistics().
+   *
    * The interface of RenderingManager is platform independent. Platform
    * specific subclasses have to be implemented, though, to supply an
    * appropriate event issueing for controlling the update execution process.
@@ -91,6 +104,31 @@ namespace mitk
       REQUEST_UPDATE_3DWINDOWS
     };
 
+    /** \brief Rendering statistics of a RenderWindow. Times are given in milliseconds. */
+    struct RenderWindowStatistics
+    {
+      RenderWindowStatistics()
+        : NumberOfFrames(0),
+          NumberOfMergedRequests(0),
+          NumberOfDeferredUpdates(0),
+          LastFrameTime(0.0),
+          AverageFrameTime(0.0),
+          MaximumFrameTime(0.0)
+      {
+      }
+
+      /** Number of rendered frames */
+      unsigned long NumberOfFrames;
+      /** Number of requests that were merged with an already pending request */
+      unsigned long NumberOfMergedRequests;
+      /** Number of times a pending update was deferred by the frame budget or the maximum frame rate */
+      unsigned long NumberOfDeferredUpdates;
+      double LastFrameTime;
+      /** Exponential moving average of the frame times */
+      double AverageFrameTime;
+      double MaximumFrameTime;
+    };
+
     static Pointer New();
 
     /** Set the object factory which produces the desired platform specific
@@ -124,6 +162,12 @@ namespace mitk
    * soon as the main loop is ready for rendering. */
     void RequestUpdate(vtkRenderWindow *renderWindow);
 
+    /** Like RequestUpdate(), but may be called from any thread, e.g. by a worker
+     * whose results are to be displayed. The request is handed over to the GUI
+     * thread by #GenerateRenderingRequestEvent(), which therefore has to be
+     * callable from any thread as well. */
+    void RequestUpdateFromWorkerThread(vtkRenderWindow *renderWindow);
+
     /** Immediately executes an update of the specified RenderWindow. */
     void ForceImmediateUpdate(vtkRenderWindow *renderWindow);
 
@@ -293,6 +337,24 @@ namespace mitk
 
     void SetAntiAliasing(AntiAliasing antiAliasing);
 
+    /** Time in milliseconds that #ExecutePendingRequests() may spend on rendering
+     * before it defers the remaining windows. At least one window is rendered per
+     * execution. A value of 0 disables the budget. Default is 1000/30 ms. */
+    itkSetMacro(FrameBudget, double);
+    itkGetConstMacro(FrameBudget, double);
+
+    /** Maximum number of frames per second rendered by #ExecutePendingRequests()
+     * for each window. A value of 0 disables the limit. Default is 60.
+     * #ForceImmediateUpdate() is not limited. */
+    itkSetMacro(MaximumFrameRate, double);
+    itkGetConstMacro(MaximumFrameRate, double);
+
+    /** Returns the rendering statistics of a registered RenderWindow. */
+    RenderWindowStatistics GetRenderWindowStatistics(vtkRenderWindow *renderWindow) const;
+
+    /** Resets the rendering statistics of all RenderWindows. */
+    void ResetRenderWindowStatistics();
+
   protected:
     enum
     {
@@ -307,10 +369,21 @@ namespace mitk
      * request. This method is called whenever an update is requested */
     virtual void GenerateRenderingRequestEvent() = 0;
 
+    /** Method for generating a system specific event for rendering request
+     * after the given delay. This method is called if #ExecutePendingRequests()
+     * deferred an update because of the maximum frame rate. The default
+     * implementation generates the event immediately. */
+    virtual void GenerateDelayedRenderingRequestEvent(unsigned int milliseconds);
+
     virtual void InitializePropertyList();
 
     bool m_UpdatePending;
 
+    /** Render windows requested by RequestUpdateFromWorkerThread(), taken over by
+     * #ExecutePendingRequests(). */
+    std::vector<vtkRenderWindow *> m_WorkerThreadRequests;
+    std::mutex m_WorkerThreadRequestsMutex;
+
     typedef std::map<BaseRenderer *, unsigned int> RendererIntMap;
     typedef std::map<BaseRenderer *, bool> RendererBoolMap;
 
@@ -359,6 +432,22 @@ namespace mitk
 
     bool m_ConstrainedPanningZooming;
 
+    double m_FrameBudget;
+
+    double m_MaximumFrameRate;
+
+    typedef std::chrono::steady_clock Clock;
+
+    struct RenderWindowSchedule
+    {
+      RenderWindowStatistics Statistics;
+      Clock::time_point LastFrameStart;
+    };
+
+    typedef std::map<vtkRenderWindow *, RenderWindowSchedule> RenderWindowScheduleMap;
+
+    RenderWindowScheduleMap m_RenderWindowSchedules;
+
   private:
     void InternalViewInitialization(mitk::BaseRenderer *baseRenderer,
                                     const mitk::TimeGeometry *geometry,
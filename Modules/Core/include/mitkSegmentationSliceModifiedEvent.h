@@ -0,0 +1,62 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSegmentationSliceModifiedEvent_h
+#define mitkSegmentationSliceModifiedEvent_h
+
+#include <mitkImage.h>
+#include <MitkCoreExports.h>
+
+#include <itkEventObject.h>
+
+namespace mitk
+{
+  /** \brief Event that a segmentation invokes after one of its slices has been overwritten, e.g. by a segmentation
+    tool or by undoing/redoing the change of a slice.
+
+    It carries the content of the slice before and after the change, which allows observers to update data derived
+    from the segmentation incrementally (e.g. the image statistics). Both slices have the geometry of the changed
+    slice within the segmentation.
+  */
+  class MITKCORE_EXPORT SegmentationSliceModifiedEvent : public itk::AnyEvent
+  {
+  public:
+    typedef SegmentationSliceModifiedEvent Self;
+    typedef itk::AnyEvent Superclass;
+
+    SegmentationSliceModifiedEvent(const Image *previousSlice = nullptr,
+                                   const Image *currentSlice = nullptr,
+                                   unsigned int timeStep = 0);
+    SegmentationSliceModifiedEvent(const Self &s);
+    ~SegmentationSliceModifiedEvent() override;
+
+    const char *GetEventName() const override;
+    bool CheckEvent(const ::itk::EventObject *e) const override;
+    ::itk::EventObject *MakeObject() const override;
+
+    /** \brief The slice before the change; nullptr if it is unknown.*/
+    const Image *GetPreviousSlice() const;
+    /** \brief The slice after the change.*/
+    const Image *GetCurrentSlice() const;
+    unsigned int GetTimeStep() const;
+
+  protected:
+    itk::SmartPointer<const Image> m_PreviousSlice;
+    itk::SmartPointer<const Image> m_CurrentSlice;
+    unsigned int m_TimeStep;
+
+  private:
+    void operator=(const Self &);
+  };
+}
+
+#endif
@@ -14,9 +14,11 @@ found in the LICENSE file.
 #define MITKSTANDALONEDATASTORAGE_H_HEADER_INCLUDED_
 
 #include "itkVectorContainer.h"
+#include "mitkBaseProperty.h"
 #include "mitkDataStorage.h"
 #include "mitkMessage.h"
 #include <map>
+#include <set>
 
 namespace mitk
 {
@@ -32,6 +34,11 @@ namespace mitk
   //## Thus, nodes are stored in a noncyclical directed graph data structure.
   //## It is derived from mitk::DataStorage and implements its interface,
   //## including AddNodeEvent and RemoveNodeEvent.
+  //##
+  //## The nodes are indexed by their name, the type of their data and the UID of their data. GetSubset(),
+  //## GetNode() and GetNamedNode() check only the indexed candidates for NodePredicateProperty conditions
+  //## on the non-renderer-specific "name" property, NodePredicateDataType and NodePredicateDataUID
+  //## conditions, and for conjunctions and disjunctions of them. Other conditions are checked for all nodes.
   //## @ingroup StandaloneDataStorage
   class MITKCORE_EXPORT StandaloneDataStorage : public mitk::DataStorage
   {
@@ -88,6 +95,13 @@ namespace mitk
     //##
     SetOfObjects::ConstPointer GetAll() const override;
 
+    //##Documentation
+    //## @brief Enables or disables the indexes of the nodes (enabled by default)
+    //##
+    //## Disabling the indexes saves the effort of keeping them up to date if GetSubset() is rarely used.
+    void SetIndexEnabled(bool enabled);
+    bool GetIndexEnabled() const;
+
     /*ITK Mutex */
     mutable itk::SimpleFastMutexLock m_Mutex;
 
@@ -114,16 +128,64 @@ namespace mitk
     //## @brief deletes all references to a node in a given relation (used in Remove() and TreeListener)
     void RemoveFromRelation(const mitk::DataNode *node, AdjacencyList &relation);
 
+    //##Documentation
+    //## @brief Removes node from both relations, touching only the relation lists of its sources and derivations
+    void RemoveFromRelations(const mitk::DataNode *node);
+
     //##Documentation
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
 
+    //##Documentation
+    //## @brief Answers the conditions described in the class documentation from the indexes
+    SetOfObjects::ConstPointer GetSubsetCandidates(const NodePredicateBase *condition) const override;
+
     //##Documentation
     //## @brief Nodes and their relation are stored in m_SourceNodes
     AdjacencyList m_SourceNodes;
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+
+  private:
+    typedef std::set<const mitk::DataNode *> NodeSet;
+    typedef std::map<std::string, NodeSet> NodeIndex;
+
+    //##Documentation
+    //## @brief Keys of a node in the indexes and the observers keeping them up to date
+    struct IndexEntry
+    {
+      //## The "name" of the node, if it is a StringProperty of the node itself. Otherwise the node is
+      //## a candidate for every name.
+      bool HasName = false;
+      std::string Name;
+      mitk::BaseProperty::ConstPointer NameProperty;
+      unsigned long NamePropertyObserverTag = 0;
+      std::string DataType;
+      mutable std::string DataUID;
+      unsigned long ModifiedObserverTag = 0;
+    };
+
+    void AddToIndex(const mitk::DataNode *node);
+    void RemoveFromIndex(const mitk::DataNode *node);
+    void UpdateIndex(const mitk::DataNode *node);
+    void RebuildDataUIDIndex() const;
+
+    //##Documentation
+    //## @brief Collects the candidates of the condition, returns false if the condition is not indexed
+    bool CollectCandidates(const NodePredicateBase *condition, NodeSet &candidates) const;
+
+    void OnIndexedNodeModified(const itk::Object *caller, const itk::EventObject &event);
+    void OnNamePropertyModified(const itk::Object *caller, const itk::EventObject &event);
+
+    bool m_IndexEnabled;
+    std::map<const mitk::DataNode *, IndexEntry> m_IndexEntries;
+    std::map<const mitk::BaseProperty *, NodeSet> m_NamePropertyNodes;
+    NodeIndex m_NameIndex;
+    NodeSet m_UnnamedNodes;
+    NodeIndex m_DataTypeIndex;
+    //## The UID of data may be changed without notification, so this index is rebuilt when it turns out to be stale
+    mutable NodeIndex m_DataUIDIndex;
   };
 } // namespace mitk
 #endif /* MITKSTANDALONEDATASTORAGE_H_HEADER_INCLUDED_ */
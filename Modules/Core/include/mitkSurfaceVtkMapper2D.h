@@ -15,18 +15,19 @@ found in the LICENSE file.
 
 #include "mitkBaseRenderer.h"
 #include "mitkLocalStorageHandler.h"
+#include "mitkPolyDataPlaneCutter.h"
 #include "mitkVtkMapper.h"
 #include <MitkCoreExports.h>
 
 // VTK
 #include <vtkSmartPointer.h>
 class vtkAssembly;
-class vtkCutter;
-class vtkPlane;
 class vtkLookupTable;
+class vtkPolyData;
 class vtkGlyph3D;
 class vtkArrowSource;
 class vtkReverseSense;
+class vtkTransformPolyDataFilter;
 
 namespace mitk
 {
@@ -35,10 +36,11 @@ namespace mitk
   /**
     * @brief Vtk-based mapper for cutting 2D slices out of Surfaces.
     *
-    * The mapper uses a vtkCutter filter to cut out slices (contours) of the 3D
+    * The mapper uses a PolyDataPlaneCutter to cut out slices (contours) of the 3D
     * volume and render these slices as vtkPolyData. The data is transformed
     * according to its geometry before cutting, to support the geometry concept
-    * of MITK.
+    * of MITK. The transformed data and the index of the cutter are shared by all
+    * renderers and only rebuilt if the data or its geometry are modified.
     *
     * Properties:
     * \b Surface.2D.Line Width: Thickness of the rendered lines in 2D.
@@ -102,13 +104,9 @@ namespace mitk
          */
       vtkSmartPointer<vtkPolyDataMapper> m_Mapper;
       /**
-         * @brief m_Cutter Filter to cut out the 2D slice.
+         * @brief m_Contour The cut out 2D slice.
          */
-      vtkSmartPointer<vtkCutter> m_Cutter;
-      /**
-         * @brief m_CuttingPlane The plane where to cut off the 2D slice.
-         */
-      vtkSmartPointer<vtkPlane> m_CuttingPlane;
+      vtkSmartPointer<vtkPolyData> m_Contour;
 
       /**
        * @brief m_NormalMapper Mapper for the normals.
@@ -210,6 +208,16 @@ namespace mitk
        * @param renderer The respective renderer of the mitkRenderWindow.
        */
     void Update(BaseRenderer *renderer) override;
+
+    /**
+     * @brief m_TransformFilter Transforms the data according to its geometry before it is cut.
+     */
+    vtkSmartPointer<vtkTransformPolyDataFilter> m_TransformFilter;
+
+    /**
+     * @brief m_PlaneCutter Cuts the transformed data, shared by all renderers.
+     */
+    PolyDataPlaneCutter::Pointer m_PlaneCutter;
   };
 } // namespace mitk
 #endif /* mitkSurfaceVtkMapper2D_h */
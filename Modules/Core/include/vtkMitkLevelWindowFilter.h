@@ -52,11 +52,11 @@ public:
 
   /** \brief Get/Set the lower window opacity for the alpha level window */
   void SetMinOpacity(double minOpacity);
-  inline double GetMinOpacity() const;
+  double GetMinOpacity() const;
 
   /** \brief Get/Set the upper window opacity for the alpha level window */
   void SetMaxOpacity(double maxOpacity);
-  inline double GetMaxOpacity() const;
+  double GetMaxOpacity() const;
 
   /** \brief Set clipping bounds for the opaque part of the resliced 2d image */
   void SetClippingBounds(double *);
@@ -19,8 +19,50 @@ found in the LICENSE file.
 #include <itkLinearInterpolateImageFunction.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 
+namespace
+{
+  /** \brief Sampling grid of the output image in the continuous index space of the input image.
+   *
+   * The steps between neighboring output pixels only depend on the input geometry and on the orientation and
+   * spacing of the output geometry. They are kept while e.g. scrolling through parallel slices, so that only the
+   * continuous index of the output origin is computed per update. All other samples are reached by a
+   * constant-offset walk instead of transforming every output pixel from world to index coordinates.
+   */
+  struct ReslicePlan
+  {
+    bool IsValidFor(const mitk::BaseGeometry* inputGeometry, const mitk::Vector3D& xAxis, const mitk::Vector3D& yAxis) const
+    {
+      return InputGeometry.GetPointer() == inputGeometry && InputGeometryTime == inputGeometry->GetMTime() &&
+             XAxis == xAxis && YAxis == yAxis;
+    }
+
+    // key: input geometry and output pixel axes in world coordinates, scaled by the output spacing
+    mitk::BaseGeometry::ConstPointer InputGeometry;
+    itk::ModifiedTimeType InputGeometryTime = 0;
+    mitk::Vector3D XAxis;
+    mitk::Vector3D YAxis;
+
+    // continuous index steps from one output pixel to the next one along x and y
+    mitk::Vector3D XStep;
+    mitk::Vector3D YStep;
+    // true if both steps are whole voxels, i.e. nearest neighbor sampling is a strided copy
+    bool IntegralSteps = false;
+
+    // continuous index of the output origin, updated for every output geometry
+    mitk::Point3D Origin;
+  };
+
+  bool IsIntegral(double value)
+  {
+    return std::abs(value - std::round(value)) < 1e-6;
+  }
+}
+
 struct mitk::ExtractSliceFilter2::Impl
 {
   Impl();
@@ -29,10 +71,15 @@ struct mitk::ExtractSliceFilter2::Impl
   PlaneGeometry::Pointer OutputGeometry;
   mitk::ExtractSliceFilter2::Interpolator Interpolator;
   itk::Object::Pointer InterpolateImageFunction;
+  itk::ModifiedTimeType InterpolateImageFunctionTime;
+  ReslicePlan Plan;
+
+  void UpdatePlan(const BaseGeometry* inputGeometry);
 };
 
 mitk::ExtractSliceFilter2::Impl::Impl()
-  : Interpolator(NearestNeighbor)
+  : Interpolator(NearestNeighbor),
+    InterpolateImageFunctionTime(0)
 {
 }
 
@@ -40,6 +87,35 @@ mitk::ExtractSliceFilter2::Impl::~Impl()
 {
 }
 
+void mitk::ExtractSliceFilter2::Impl::UpdatePlan(const BaseGeometry* inputGeometry)
+{
+  auto spacing = OutputGeometry->GetSpacing();
+  auto xAxis = OutputGeometry->GetAxisVector(0);
+  auto yAxis = OutputGeometry->GetAxisVector(1);
+
+  xAxis.Normalize();
+  yAxis.Normalize();
+  xAxis *= spacing[0];
+  yAxis *= spacing[1];
+
+  if (!Plan.IsValidFor(inputGeometry, xAxis, yAxis))
+  {
+    Plan.InputGeometry = inputGeometry;
+    Plan.InputGeometryTime = inputGeometry->GetMTime();
+    Plan.XAxis = xAxis;
+    Plan.YAxis = yAxis;
+
+    inputGeometry->WorldToIndex(xAxis, Plan.XStep);
+    inputGeometry->WorldToIndex(yAxis, Plan.YStep);
+
+    Plan.IntegralSteps = true;
+    for (int d = 0; d < 3; ++d)
+      Plan.IntegralSteps = Plan.IntegralSteps && IsIntegral(Plan.XStep[d]) && IsIntegral(Plan.YStep[d]);
+  }
+
+  inputGeometry->WorldToIndex(OutputGeometry->GetOrigin(), Plan.Origin);
+}
+
 namespace
 {
   template <class TInputImage>
@@ -74,60 +150,233 @@ namespace
     result = interpolateImageFunction.GetPointer();
   }
 
+  /// Size and strides of the input buffer
+  struct InputBuffer
+  {
+    std::ptrdiff_t Size[3];
+    std::ptrdiff_t Stride[3];
+  };
+
+  /// Matches the bounds check of itk::Image::TransformPhysicalPointToContinuousIndex
+  inline bool IsInside(const double index[3], const InputBuffer& buffer)
+  {
+    for (int d = 0; d < 3; ++d)
+    {
+      const double rounded = std::floor(index[d] + 0.5);
+      if (!(rounded >= 0 && rounded < buffer.Size[d]))
+        return false;
+    }
+    return true;
+  }
+
+  /// Nearest neighbor sampling of a row with whole voxel steps: every sample is the voxel at a constant offset
+  /// from the previous one, so the row is a (strided) copy of the voxels within the input.
+  template <typename TPixel>
+  void SampleRowByCopy(const TPixel* input, const InputBuffer& buffer, const double start[3], const double step[3], std::ptrdiff_t count, TPixel background, TPixel* output)
+  {
+    std::ptrdiff_t first = 0;
+    std::ptrdiff_t last = count;
+    std::ptrdiff_t offset = 0;
+    std::ptrdiff_t stride = 0;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      const auto index = static_cast<std::ptrdiff_t>(std::floor(start[d] + 0.5));
+      const auto voxelStep = static_cast<std::ptrdiff_t>(std::round(step[d]));
+      offset += index * buffer.Stride[d];
+      stride += voxelStep * buffer.Stride[d];
+
+      // samples i with 0 <= index + i * voxelStep < size
+      if (0 == voxelStep)
+      {
+        if (index < 0 || index >= buffer.Size[d])
+          last = first;
+      }
+      else
+      {
+        const double a = static_cast<double>(-index) / voxelStep;
+        const double b = static_cast<double>(buffer.Size[d] - 1 - index) / voxelStep;
+        first = std::max(first, static_cast<std::ptrdiff_t>(std::ceil(std::min(a, b))));
+        last = std::min(last, static_cast<std::ptrdiff_t>(std::floor(std::max(a, b))) + 1);
+      }
+    }
+
+    last = std::max(first, last);
+    std::fill(output, output + std::min(first, count), background);
+    std::fill(output + last, output + count, background);
+
+    if (1 == stride)
+    {
+      std::memcpy(output + first, input + offset + first, (last - first) * sizeof(TPixel));
+    }
+    else
+    {
+      const TPixel* voxel = input + offset + first * stride;
+      for (std::ptrdiff_t i = first; i < last; ++i, voxel += stride)
+        output[i] = *voxel;
+    }
+  }
+
+  /// Nearest neighbor sampling of a row with arbitrary steps. The sample positions are derived from the loop
+  /// counter instead of being accumulated, which keeps the index arithmetic free of dependencies between
+  /// iterations and allows the compiler to vectorize it.
+  template <typename TPixel>
+  void SampleRowNearest(const TPixel* input, const InputBuffer& buffer, const double start[3], const double step[3], std::ptrdiff_t count, TPixel background, TPixel* output)
+  {
+    for (std::ptrdiff_t i = 0; i < count; ++i)
+    {
+      const double index[3] = { start[0] + step[0] * i, start[1] + step[1] * i, start[2] + step[2] * i };
+
+      if (IsInside(index, buffer))
+      {
+        const auto x = static_cast<std::ptrdiff_t>(std::floor(index[0] + 0.5));
+        const auto y = static_cast<std::ptrdiff_t>(std::floor(index[1] + 0.5));
+        const auto z = static_cast<std::ptrdiff_t>(std::floor(index[2] + 0.5));
+        output[i] = input[x * buffer.Stride[0] + y * buffer.Stride[1] + z * buffer.Stride[2]];
+      }
+      else
+      {
+        output[i] = background;
+      }
+    }
+  }
+
+  /// Trilinear sampling of a row with the boundary handling of itk::LinearInterpolateImageFunction: neighbors
+  /// beyond the last voxel along an axis are not taken into account.
+  template <typename TPixel>
+  void SampleRowLinear(const TPixel* input, const InputBuffer& buffer, const double start[3], const double step[3], std::ptrdiff_t count, TPixel background, TPixel* output)
+  {
+    for (std::ptrdiff_t i = 0; i < count; ++i)
+    {
+      const double index[3] = { start[0] + step[0] * i, start[1] + step[1] * i, start[2] + step[2] * i };
+
+      if (!IsInside(index, buffer))
+      {
+        output[i] = background;
+        continue;
+      }
+
+      std::ptrdiff_t lower[3];
+      std::ptrdiff_t upperOffset[3];
+      double weight[3];
+
+      for (int d = 0; d < 3; ++d)
+      {
+        lower[d] = std::max<std::ptrdiff_t>(0, static_cast<std::ptrdiff_t>(std::floor(index[d])));
+        weight[d] = std::max(0.0, index[d] - lower[d]);
+
+        if (lower[d] + 1 < buffer.Size[d])
+        {
+          upperOffset[d] = buffer.Stride[d];
+        }
+        else
+        {
+          upperOffset[d] = 0;
+          weight[d] = 0.0;
+        }
+      }
+
+      const TPixel* v000 = input + lower[0] * buffer.Stride[0] + lower[1] * buffer.Stride[1] + lower[2] * buffer.Stride[2];
+      const TPixel* v010 = v000 + upperOffset[1];
+      const TPixel* v001 = v000 + upperOffset[2];
+      const TPixel* v011 = v001 + upperOffset[1];
+
+      const double c00 = v000[0] + (v000[upperOffset[0]] - static_cast<double>(v000[0])) * weight[0];
+      const double c10 = v010[0] + (v010[upperOffset[0]] - static_cast<double>(v010[0])) * weight[0];
+      const double c01 = v001[0] + (v001[upperOffset[0]] - static_cast<double>(v001[0])) * weight[0];
+      const double c11 = v011[0] + (v011[upperOffset[0]] - static_cast<double>(v011[0])) * weight[0];
+      const double c0 = c00 + (c10 - c00) * weight[1];
+      const double c1 = c01 + (c11 - c01) * weight[1];
+
+      output[i] = static_cast<TPixel>(c0 + (c1 - c0) * weight[2]);
+    }
+  }
+
+  /// Sampling of a row by an ITK interpolate image function, used for cubic interpolation
+  template <typename TInputImage>
+  void SampleRowByFunction(const itk::InterpolateImageFunction<TInputImage>* interpolator, const InputBuffer& buffer, const double start[3], const double step[3], std::ptrdiff_t count, typename TInputImage::PixelType background, typename TInputImage::PixelType* output)
+  {
+    typedef typename TInputImage::PixelType TPixel;
+    itk::ContinuousIndex<mitk::ScalarType, 3> continuousIndex;
+
+    for (std::ptrdiff_t i = 0; i < count; ++i)
+    {
+      const double index[3] = { start[0] + step[0] * i, start[1] + step[1] * i, start[2] + step[2] * i };
+
+      if (IsInside(index, buffer))
+      {
+        for (int d = 0; d < 3; ++d)
+          continuousIndex[d] = index[d];
+        output[i] = static_cast<TPixel>(interpolator->EvaluateAtContinuousIndex(continuousIndex));
+      }
+      else
+      {
+        output[i] = background;
+      }
+    }
+  }
+
   template <typename TPixel, unsigned int VImageDimension>
-  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
+  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, const ReslicePlan* plan, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object* interpolateImageFunction)
   {
     typedef itk::Image<TPixel, VImageDimension> TInputImage;
     typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
 
     auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
-    auto interpolator = static_cast<TInterpolateImageFunction*>(interpolateImageFunction);
-
-    auto origin = outputGeometry->GetOrigin();
-    auto spacing = outputGeometry->GetSpacing();
-    auto xDirection = outputGeometry->GetAxisVector(0);
-    auto yDirection = outputGeometry->GetAxisVector(1);
-
-    xDirection.Normalize();
-    yDirection.Normalize();
-
-    auto spacingAlongXDirection = xDirection * spacing[0];
-    auto spacingAlongYDirection = yDirection * spacing[1];
 
-    const std::size_t pixelSize = outputImage->GetPixelType().GetSize();
     const std::size_t width = outputGeometry->GetExtent(0);
     const std::size_t xBegin = outputRegion.GetIndex(0);
     const std::size_t yBegin = outputRegion.GetIndex(1);
-    const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
+    const auto count = static_cast<std::ptrdiff_t>(outputRegion.GetSize(0));
     const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
 
     mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
-    auto data = static_cast<char*>(writeAccess.GetData());
+    auto data = static_cast<TPixel*>(writeAccess.GetData());
 
     const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
-    TPixel pixel;
 
-    itk::ContinuousIndex<mitk::ScalarType, 3> index;
-    mitk::Point3D yPoint;
-    mitk::Point3D point;
+    InputBuffer buffer;
+    const auto bufferSize = inputImage->GetBufferedRegion().GetSize();
+    for (int d = 0; d < 3; ++d)
+    {
+      buffer.Size[d] = static_cast<std::ptrdiff_t>(bufferSize[d]);
+      buffer.Stride[d] = 0 == d ? 1 : buffer.Stride[d - 1] * buffer.Size[d - 1];
+    }
+    const TPixel* input = inputImage->GetBufferPointer();
+
+    const double xStep[3] = { plan->XStep[0], plan->XStep[1], plan->XStep[2] };
+
+    // samples that hit voxel centers make linear interpolation a copy, too
+    bool copyRows = plan->IntegralSteps && mitk::ExtractSliceFilter2::Cubic != interpolator;
+    if (copyRows && mitk::ExtractSliceFilter2::Linear == interpolator)
+      copyRows = IsIntegral(plan->Origin[0]) && IsIntegral(plan->Origin[1]) && IsIntegral(plan->Origin[2]);
 
     for (std::size_t y = yBegin; y < yEnd; ++y)
     {
-      yPoint = origin + spacingAlongYDirection * y;
+      double start[3];
+      for (int d = 0; d < 3; ++d)
+        start[d] = plan->Origin[d] + plan->YStep[d] * y + plan->XStep[d] * xBegin;
 
-      for (std::size_t x = xBegin; x < xEnd; ++x)
+      TPixel* row = data + width * y + xBegin;
+
+      if (copyRows)
       {
-        point = yPoint + spacingAlongXDirection * x;
+        SampleRowByCopy(input, buffer, start, xStep, count, backgroundPixel, row);
+        continue;
+      }
 
-        if (inputImage->TransformPhysicalPointToContinuousIndex(point, index))
-        {
-          pixel = interpolator->EvaluateAtContinuousIndex(index);
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&pixel), pixelSize);
-        }
-        else
-        {
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&backgroundPixel), pixelSize);
-        }
+      switch (interpolator)
+      {
+        case mitk::ExtractSliceFilter2::NearestNeighbor:
+          SampleRowNearest(input, buffer, start, xStep, count, backgroundPixel, row);
+          break;
+
+        case mitk::ExtractSliceFilter2::Linear:
+          SampleRowLinear(input, buffer, start, xStep, count, backgroundPixel, row);
+          break;
+
+        default:
+          SampleRowByFunction(static_cast<TInterpolateImageFunction*>(interpolateImageFunction), buffer, start, xStep, count, backgroundPixel, row);
       }
     }
   }
@@ -213,17 +462,24 @@ void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType
 
 void mitk::ExtractSliceFilter2::GenerateData()
 {
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
   const auto* inputImage = this->GetInput();
 
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+  // the interpolate image function is only needed for cubic interpolation. It is kept as long as the input image is
+  // not modified, since its creation is expensive.
+  if (Cubic == m_Impl->Interpolator &&
+      (nullptr == m_Impl->InterpolateImageFunction || inputImage->GetMTime() > m_Impl->InterpolateImageFunctionTime))
+  {
+    AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+    m_Impl->InterpolateImageFunctionTime = inputImage->GetMTime();
+  }
 
   this->AllocateOutputs();
   auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
 
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
+  m_Impl->UpdatePlan(inputImage->GetGeometry());
+  const ReslicePlan* plan = &m_Impl->Plan;
+
+  AccessFixedDimensionByItk_n(inputImage, ::GenerateData, 3, (this->GetOutput(), outputRegion, plan, m_Impl->Interpolator, m_Impl->InterpolateImageFunction.GetPointer()));
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelFor.h"
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  /** State of one loop, shared by its threads */
+  struct Loop
+  {
+    std::atomic<std::size_t> Next;
+    std::atomic<std::size_t> NumberOfFinishedCalls;
+    std::size_t Count;
+    const std::function<void(std::size_t)> *Call;
+
+    /** Only used by the calling thread */
+    std::thread::id CallingThread;
+    std::size_t NumberOfReportedCalls;
+    const std::function<void(std::size_t)> *ReportProgress;
+
+    void ReportFinishedCalls()
+    {
+      const std::size_t numberOfFinishedCalls = NumberOfFinishedCalls;
+
+      if (numberOfFinishedCalls > NumberOfReportedCalls)
+      {
+        (*ReportProgress)(numberOfFinishedCalls - NumberOfReportedCalls);
+        NumberOfReportedCalls = numberOfFinishedCalls;
+      }
+    }
+  };
+
+  ITK_THREAD_RETURN_TYPE ProcessLoop(void *param)
+  {
+    // itk::MultiThreader provides an itk::MultiThreader::ThreadInfoStruct as parameter
+    auto *threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct *>(param);
+    auto *loop = static_cast<Loop *>(threadInfo->UserData);
+
+    // itk::MultiThreader executes one of the threads in the calling thread, which reports the progress
+    const bool reportProgress = *loop->ReportProgress && std::this_thread::get_id() == loop->CallingThread;
+
+    for (auto i = loop->Next++; i < loop->Count; i = loop->Next++)
+    {
+      (*loop->Call)(i);
+      ++loop->NumberOfFinishedCalls;
+
+      if (reportProgress)
+        loop->ReportFinishedCalls();
+    }
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+}
+
+void mitk::ParallelFor(std::size_t count,
+                       const std::function<void(std::size_t)> &function,
+                       unsigned int maximumNumberOfWorkUnits,
+                       const std::function<void(std::size_t)> &reportProgress)
+{
+  if (0 == count)
+    return;
+
+  if (0 == maximumNumberOfWorkUnits)
+    maximumNumberOfWorkUnits = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+
+  const auto numberOfWorkUnits =
+    static_cast<unsigned int>(std::min<std::size_t>(count, std::max(1u, maximumNumberOfWorkUnits)));
+
+  std::atomic<bool> failed(false);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+
+  const std::function<void(std::size_t)> call = [&](std::size_t i) {
+    if (failed)
+      return;
+
+    try
+    {
+      function(i);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+
+      if (!exception)
+        exception = std::current_exception();
+
+      failed = true;
+    }
+  };
+
+  Loop loop;
+  loop.Next = 0;
+  loop.NumberOfFinishedCalls = 0;
+  loop.Count = count;
+  loop.Call = &call;
+  loop.CallingThread = std::this_thread::get_id();
+  loop.NumberOfReportedCalls = 0;
+  loop.ReportProgress = &reportProgress;
+
+  if (1 == numberOfWorkUnits)
+  {
+    itk::MultiThreader::ThreadInfoStruct threadInfo;
+    threadInfo.ThreadID = 0;
+    threadInfo.NumberOfThreads = 1;
+    threadInfo.UserData = &loop;
+    ProcessLoop(&threadInfo);
+  }
+  else
+  {
+    auto multiThreader = itk::MultiThreader::New();
+    multiThreader->SetNumberOfThreads(numberOfWorkUnits);
+    multiThreader->SetSingleMethod(&ProcessLoop, &loop);
+    multiThreader->SingleMethodExecute();
+  }
+
+  // the calls finished by the other threads after the calling thread ran out of indices, and the skipped
+  // calls, are reported as well, so that the progress always sums up to count
+  if (reportProgress && loop.NumberOfReportedCalls < count)
+    reportProgress(count - loop.NumberOfReportedCalls);
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
@@ -34,6 +34,8 @@ namespace mitk
     m_Implementation = implementation;
   }
 
+  bool CallbackFromGUIThread::HasImplementation() { return nullptr != m_Implementation; }
+
   void CallbackFromGUIThread::CallThisFromGUIThread(itk::Command *cmd, itk::EventObject *e)
   {
     if (m_Implementation)
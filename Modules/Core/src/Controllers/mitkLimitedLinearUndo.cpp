@@ -13,8 +13,17 @@ found in the LICENSE file.
 #include "mitkLimitedLinearUndo.h"
 #include <mitkRenderingManager.h>
 
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+  std::atomic<std::size_t> DefaultUndoMemoryLimit(0);
+}
+
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0),
+  m_UndoMemoryLimit(GetDefaultUndoMemoryLimit())
 {
   // nothing to do
 }
@@ -56,6 +65,7 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     delete item;
   }
   m_UndoList.push_back(operationEvent);
+  this->ApplyUndoMemoryLimit();
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -190,6 +200,87 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetUndoMemoryLimit() const
+{
+  return m_UndoMemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetUndoMemoryLimit(std::size_t limit)
+{
+  if (limit != m_UndoMemoryLimit)
+  {
+    m_UndoMemoryLimit = limit;
+    this->ApplyUndoMemoryLimit();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetDefaultUndoMemoryLimit()
+{
+  return DefaultUndoMemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetDefaultUndoMemoryLimit(std::size_t limit)
+{
+  DefaultUndoMemoryLimit = limit;
+}
+
+std::size_t mitk::LimitedLinearUndo::GetUndoMemoryUsage() const
+{
+  return GetMemoryUsage(m_UndoList);
+}
+
+std::size_t mitk::LimitedLinearUndo::GetRedoMemoryUsage() const
+{
+  return GetMemoryUsage(m_RedoList);
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemoryUsage(const UndoContainer &list, bool includePending)
+{
+  std::size_t memoryUsage = 0;
+  for (auto item : list)
+  {
+    if (includePending || !item->IsMemoryUsagePending())
+      memoryUsage += item->GetMemoryUsage();
+  }
+  return memoryUsage;
+}
+
+void mitk::LimitedLinearUndo::ApplyUndoMemoryLimit()
+{
+  if (0 == m_UndoMemoryLimit)
+    return;
+
+  // pending items are counted by a later call, as soon as their memory usage is final
+  std::size_t memoryUsage = GetMemoryUsage(m_UndoList, false);
+  std::size_t droppedItems = 0;
+
+  // the items of one ObjectEventId are undone together, so they are dropped together as well
+  while (memoryUsage > m_UndoMemoryLimit && !m_UndoList.empty() &&
+         m_UndoList.front()->GetObjectEventId() != m_UndoList.back()->GetObjectEventId())
+  {
+    const int objectEventId = m_UndoList.front()->GetObjectEventId();
+
+    while (m_UndoList.front()->GetObjectEventId() == objectEventId)
+    {
+      auto item = m_UndoList.front();
+      m_UndoList.pop_front();
+
+      // the compression may have finished since memoryUsage was measured
+      if (!item->IsMemoryUsagePending())
+        memoryUsage -= std::min(memoryUsage, item->GetMemoryUsage());
+
+      delete item;
+      ++droppedItems;
+    }
+  }
+
+  if (droppedItems > 0)
+  {
+    MITK_DEBUG << "Dropped " << droppedItems << " undo items to meet the memory limit of " << m_UndoMemoryLimit
+               << " bytes. The undo stack now holds " << memoryUsage << " bytes.";
+  }
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
@@ -72,6 +72,16 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemoryUsage() const
+{
+  return sizeof(UndoStackItem) + m_Description.capacity();
+}
+
+bool mitk::UndoStackItem::IsMemoryUsagePending() const
+{
+  return false;
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -148,3 +158,22 @@ bool mitk::OperationEvent::IsValid()
 {
   return !m_Invalid;
 }
+
+std::size_t mitk::OperationEvent::GetMemoryUsage() const
+{
+  std::size_t memoryUsage = UndoStackItem::GetMemoryUsage() + sizeof(OperationEvent) - sizeof(UndoStackItem);
+
+  if (m_Operation != nullptr)
+    memoryUsage += m_Operation->GetMemoryUsage();
+
+  if (m_UndoOperation != nullptr)
+    memoryUsage += m_UndoOperation->GetMemoryUsage();
+
+  return memoryUsage;
+}
+
+bool mitk::OperationEvent::IsMemoryUsagePending() const
+{
+  return (m_Operation != nullptr && m_Operation->IsMemoryUsagePending()) ||
+         (m_UndoOperation != nullptr && m_UndoOperation->IsMemoryUsagePending());
+}
@@ -45,6 +45,8 @@ namespace mitk
       m_TimeNavigationController(SliceNavigationController::New()),
       m_DataStorage(nullptr),
       m_ConstrainedPanningZooming(true),
+      m_FrameBudget(1000.0 / 30.0),
+      m_MaximumFrameRate(60.0),
       m_FocusedRenderWindow(nullptr),
       m_AntiAliasing(AntiAliasing::FastApproximate)
   {
@@ -122,6 +124,7 @@ namespace mitk
     if (renderWindow && (m_RenderWindowList.find(renderWindow) == m_RenderWindowList.end()))
     {
       m_RenderWindowList[renderWindow] = RENDERING_INACTIVE;
+      m_RenderWindowSchedules[renderWindow] = RenderWindowSchedule();
       m_AllRenderWindows.push_back(renderWindow);
 
       if (m_DataStorage.IsNotNull())
@@ -162,6 +165,8 @@ namespace mitk
   {
     if (m_RenderWindowList.erase(renderWindow))
     {
+      m_RenderWindowSchedules.erase(renderWindow);
+
       auto callbacks_it = this->m_RenderWindowCallbacksList.find(renderWindow);
       if (callbacks_it != this->m_RenderWindowCallbacksList.end())
       {
@@ -202,6 +207,9 @@ namespace mitk
       return;
     }
 
+    if (m_RenderWindowList[renderWindow] == RENDERING_REQUESTED)
+      ++m_RenderWindowSchedules[renderWindow].Statistics.NumberOfMergedRequests;
+
     m_RenderWindowList[renderWindow] = RENDERING_REQUESTED;
 
     if (!m_UpdatePending)
@@ -211,6 +219,20 @@ namespace mitk
     }
   }
 
+  void RenderingManager::RequestUpdateFromWorkerThread(vtkRenderWindow *renderWindow)
+  {
+    bool firstRequest = false;
+    {
+      std::lock_guard<std::mutex> lock(m_WorkerThreadRequestsMutex);
+      firstRequest = m_WorkerThreadRequests.empty();
+      m_WorkerThreadRequests.push_back(renderWindow);
+    }
+
+    // further requests are taken over together with the first one
+    if (firstRequest)
+      this->GenerateRenderingRequestEvent();
+  }
+
   void RenderingManager::ForceImmediateUpdate(vtkRenderWindow *renderWindow)
   {
     // If the renderWindow is not valid, we do not want to inadvertantly create
@@ -235,6 +257,8 @@ namespace mitk
     int *size = renderWindow->GetSize();
     if (0 != size[0] && 0 != size[1])
     {
+      const auto frameStart = Clock::now();
+
       // prepare the camera etc. before rendering
       // Note: this is a very important step which should be called before the VTK render!
       // If you modify the camera anywhere else or after the render call, the scene cannot be seen.
@@ -243,6 +267,18 @@ namespace mitk
         vPR->PrepareRender();
       // Execute rendering
       renderWindow->Render();
+
+      RenderWindowSchedule &schedule = m_RenderWindowSchedules[renderWindow];
+      const double frameTime = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+
+      RenderWindowStatistics &statistics = schedule.Statistics;
+      statistics.AverageFrameTime = 0 == statistics.NumberOfFrames
+                                      ? frameTime
+                                      : 0.9 * statistics.AverageFrameTime + 0.1 * frameTime;
+      statistics.LastFrameTime = frameTime;
+      statistics.MaximumFrameTime = std::max(statistics.MaximumFrameTime, frameTime);
+      ++statistics.NumberOfFrames;
+      schedule.LastFrameStart = frameStart;
     }
   }
 
@@ -520,16 +556,124 @@ namespace mitk
   {
     m_UpdatePending = false;
 
-    // Satisfy all pending update requests
-    RenderWindowList::const_iterator it;
-    int i = 0;
-    for (it = m_RenderWindowList.cbegin(); it != m_RenderWindowList.cend(); ++it, ++i)
+    std::vector<vtkRenderWindow *> workerThreadRequests;
+    {
+      std::lock_guard<std::mutex> lock(m_WorkerThreadRequestsMutex);
+      workerThreadRequests.swap(m_WorkerThreadRequests);
+    }
+
+    for (auto renderWindow : workerThreadRequests)
+    {
+      // the window might have been removed while the worker was busy
+      auto listIt = m_RenderWindowList.find(renderWindow);
+      if (listIt != m_RenderWindowList.end())
+        listIt->second = RENDERING_REQUESTED;
+    }
+
+    // Schedule 2D windows before 3D windows, since they usually are cheap to render and
+    // follow the interaction most directly. The focused window goes first within its kind.
+    std::vector<vtkRenderWindow *> requestedWindows;
+    for (auto it = m_RenderWindowList.cbegin(); it != m_RenderWindowList.cend(); ++it)
     {
       if (it->second == RENDERING_REQUESTED)
+        requestedWindows.push_back(it->first);
+    }
+
+    auto priority = [this](vtkRenderWindow *renderWindow) {
+      const bool is3D = BaseRenderer::GetInstance(renderWindow)->GetMapperID() == BaseRenderer::Standard3D;
+      return 2 * static_cast<int>(is3D) + static_cast<int>(renderWindow != m_FocusedRenderWindow);
+    };
+
+    std::stable_sort(requestedWindows.begin(),
+                     requestedWindows.end(),
+                     [&priority](vtkRenderWindow *a, vtkRenderWindow *b) { return priority(a) < priority(b); });
+
+    const auto executionStart = Clock::now();
+    const auto minimumFrameInterval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(m_MaximumFrameRate > 0.0 ? 1.0 / m_MaximumFrameRate : 0.0));
+
+    bool rendered = false;
+    bool rendered2D = false;
+    bool deferred = false;
+    Clock::duration delay = Clock::duration::max();
+
+    for (auto renderWindow : requestedWindows)
+    {
+      // a window might have been rendered or removed by an observer in the meantime
+      auto listIt = m_RenderWindowList.find(renderWindow);
+      if (listIt == m_RenderWindowList.end() || listIt->second != RENDERING_REQUESTED)
+        continue;
+
+      RenderWindowSchedule &schedule = m_RenderWindowSchedules[renderWindow];
+      const auto now = Clock::now();
+
+      // merge further requests until the window may be rendered again
+      const auto nextFrameStart = schedule.LastFrameStart + minimumFrameInterval;
+      if (now < nextFrameStart && 0 < schedule.Statistics.NumberOfFrames)
       {
-        this->ForceImmediateUpdate(it->first);
+        ++schedule.Statistics.NumberOfDeferredUpdates;
+        delay = std::min(delay, nextFrameStart - now);
+        continue;
+      }
+
+      // defer the remaining windows to the next execution once the budget is spent
+      if (rendered && m_FrameBudget > 0.0 &&
+          std::chrono::duration<double, std::milli>(now - executionStart).count() >= m_FrameBudget)
+      {
+        ++schedule.Statistics.NumberOfDeferredUpdates;
+        delay = Clock::duration::zero();
+        deferred = true;
+        continue;
       }
+
+      BaseRenderer *renderer = BaseRenderer::GetInstance(renderWindow);
+      const bool is3D = renderer->GetMapperID() == BaseRenderer::Standard3D;
+
+      // 2D windows are updated as well, so the user is interacting: postpone the high resolution
+      // rendering of 3D windows, which is requested again by the timer once the interaction stopped
+      if (is3D && rendered2D && 0 != m_NextLODMap[renderer])
+        m_NextLODMap[renderer] = 0;
+
+      this->ForceImmediateUpdate(renderWindow);
+
+      rendered = true;
+      rendered2D = rendered2D || !is3D;
     }
+
+    if (delay != Clock::duration::max() && !m_UpdatePending)
+    {
+      m_UpdatePending = true;
+
+      if (deferred)
+      {
+        this->GenerateRenderingRequestEvent();
+      }
+      else
+      {
+        // round up, so that the window may be rendered when the event arrives
+        const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(delay).count() + 1;
+        this->GenerateDelayedRenderingRequestEvent(static_cast<unsigned int>(milliseconds));
+      }
+    }
+  }
+
+  void RenderingManager::GenerateDelayedRenderingRequestEvent(unsigned int)
+  {
+    this->GenerateRenderingRequestEvent();
+  }
+
+  RenderingManager::RenderWindowStatistics RenderingManager::GetRenderWindowStatistics(
+    vtkRenderWindow *renderWindow) const
+  {
+    auto it = m_RenderWindowSchedules.find(renderWindow);
+
+    return it != m_RenderWindowSchedules.end() ? it->second.Statistics : RenderWindowStatistics();
+  }
+
+  void RenderingManager::ResetRenderWindowStatistics()
+  {
+    for (auto &schedule : m_RenderWindowSchedules)
+      schedule.second.Statistics = RenderWindowStatistics();
   }
 
   void RenderingManager::RenderingStartCallback(vtkObject *caller, unsigned long, void *, void *)
@@ -54,10 +54,19 @@ void mitk::DataStorage::Remove(const DataStorage::SetOfObjects *nodes)
 
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::DataStorage::GetSubset(const NodePredicateBase *condition) const
 {
-  DataStorage::SetOfObjects::ConstPointer result = this->FilterSetOfObjects(this->GetAll(), condition);
+  DataStorage::SetOfObjects::ConstPointer candidates = this->GetSubsetCandidates(condition);
+  if (candidates.IsNull())
+    candidates = this->GetAll();
+
+  DataStorage::SetOfObjects::ConstPointer result = this->FilterSetOfObjects(candidates, condition);
   return result;
 }
 
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::DataStorage::GetSubsetCandidates(const NodePredicateBase *) const
+{
+  return nullptr;
+}
+
 mitk::DataNode *mitk::DataStorage::GetNamedNode(const char *name) const
 
 {
@@ -13,6 +13,7 @@ found in the LICENSE file.
 // MITK
 #include "mitkImage.h"
 #include "mitkCompareImageDataFilter.h"
+#include "mitkImageMemoryManager.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
 #include "mitkImageVtkWriteAccessor.h"
@@ -20,13 +21,18 @@ found in the LICENSE file.
 #include <mitkProportionalTimeGeometry.h>
 
 // VTK
+#include <vtkDataArray.h>
 #include <vtkImageData.h>
+#include <vtkPointData.h>
 
 // ITK
 #include <itkMutexLockHolder.h>
 
 // Other
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <set>
 
 #define FILL_C_ARRAY(_arr, _size, _value)                                                                              \
   for (unsigned int i = 0u; i < _size; i++)                                                                            \
@@ -35,13 +41,45 @@ found in the LICENSE file.
     _arr[i] = _value;                                                                                                  \
   }
 
+class mitk::Image::ImageDataArraysWriteHolder
+{
+public:
+  explicit ImageDataArraysWriteHolder(const Image *image) : m_Image(image)
+  {
+    m_Image->m_ImageDataArraysLock.Lock();
+    if (m_Image->m_ImageDataArraysWriteDepth++ == 0)
+      m_Image->m_ImageDataArraysSharedLock.lock();
+  }
+
+  ~ImageDataArraysWriteHolder()
+  {
+    if (--m_Image->m_ImageDataArraysWriteDepth == 0)
+      m_Image->m_ImageDataArraysSharedLock.unlock();
+    m_Image->m_ImageDataArraysLock.Unlock();
+  }
+
+private:
+  ImageDataArraysWriteHolder(const ImageDataArraysWriteHolder &) = delete;
+  ImageDataArraysWriteHolder &operator=(const ImageDataArraysWriteHolder &) = delete;
+
+  const Image *m_Image;
+};
+
+namespace
+{
+  /** Source of the access sequence numbers of all images */
+  std::atomic<unsigned long long> DataAccessCounter(0);
+}
+
 mitk::Image::Image()
-  : m_Dimension(0),
+  : m_ImageDataArraysWriteDepth(0),
+    m_Dimension(0),
     m_Dimensions(nullptr),
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_LastDataAccessTime(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -51,12 +89,14 @@ mitk::Image::Image()
 
 mitk::Image::Image(const Image &other)
   : SlicedData(other),
+    m_ImageDataArraysWriteDepth(0),
     m_Dimension(0),
     m_Dimensions(nullptr),
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_LastDataAccessTime(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -76,14 +116,14 @@ mitk::Image::Image(const Image &other)
     {
       ImageDataItemPointer volume = other.GetVolumeData(i);
 
-      this->SetVolume(volume->GetData(), i);
+      this->SetVolume(volume->m_Data, i);
     }
   }
   else
   {
     ImageDataItemPointer volume = other.GetVolumeData(0);
 
-    this->SetVolume(volume->GetData(), 0);
+    this->SetVolume(volume->m_Data, 0);
   }
 }
 
@@ -129,8 +169,9 @@ void *mitk::Image::GetData()
   // update channel's data
   // if data was not available at creation point, the m_Data of channel descriptor is nullptr
   // if data present, it won't be overwritten
-  m_ImageDescriptor->GetChannelDescriptor(0).SetData(m_CompleteData->GetData());
+  m_ImageDescriptor->GetChannelDescriptor(0).SetData(m_CompleteData->m_Data);
 
+  // the caller keeps a raw pointer to the data
   return m_CompleteData->GetData();
 }
 
@@ -190,7 +231,9 @@ double mitk::Image::GetPixelValueByIndex(const itk::Index<3> &position, unsigned
                                                                  position[2] * imageDims[0] * imageDims[1] +
                                                                  timestep * imageDims[0] * imageDims[1] * imageDims[2]);
 
-    mitkPixelTypeMultiplex3(AccessPixel, ptype, this->GetData(), offset, value);
+    // the data is only read here, so the image is not pinned like by GetData()
+    ImageDataItemPointer channel = this->GetChannelData();
+    mitkPixelTypeMultiplex3(AccessPixel, ptype, channel->m_Data, offset, value);
   }
 
   return value;
@@ -240,10 +283,46 @@ const vtkImageData *mitk::Image::GetVtkImageData(int t, int n) const
   return volume.GetPointer() == nullptr ? nullptr : volume->GetVtkImageAccessor(this)->GetVtkImageData();
 }
 
+mitk::Image::ImageDataItemPointer mitk::Image::GetExistingSliceData(int s, int t, int n) const
+{
+  // try_to_lock: a writer may be the calling thread itself (e.g. while updating the source)
+  std::shared_lock<std::shared_timed_mutex> lock(m_ImageDataArraysSharedLock, std::try_to_lock);
+  if (!lock.owns_lock() || IsValidSlice(s, t, n) == false)
+    return nullptr;
+
+  return m_Slices[GetSliceIndex(s, t, n)];
+}
+
+mitk::Image::ImageDataItemPointer mitk::Image::GetExistingVolumeData(int t, int n) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(m_ImageDataArraysSharedLock, std::try_to_lock);
+  if (!lock.owns_lock() || IsValidVolume(t, n) == false)
+    return nullptr;
+
+  const ImageDataItemPointer &vol = m_Volumes[GetVolumeIndex(t, n)];
+  return (vol.GetPointer() != nullptr && vol->IsComplete()) ? vol : nullptr;
+}
+
+mitk::Image::ImageDataItemPointer mitk::Image::GetExistingChannelData(int n) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(m_ImageDataArraysSharedLock, std::try_to_lock);
+  if (!lock.owns_lock() || IsValidChannel(n) == false)
+    return nullptr;
+
+  const ImageDataItemPointer &ch = m_Channels[n];
+  return (ch.GetPointer() != nullptr && ch->IsComplete()) ? ch : nullptr;
+}
+
 mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData(
   int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  this->UpdateLastDataAccessTime();
+
+  ImageDataItemPointer existing = GetExistingSliceData(s, t, n);
+  if (existing.GetPointer() != nullptr)
+    return existing;
+
+  ImageDataArraysWriteHolder lock(this);
   return GetSliceData_unlocked(s, t, n, data, importMemoryManagement);
 }
 
@@ -253,6 +332,8 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData_unlocked(
   if (IsValidSlice(s, t, n) == false)
     return nullptr;
 
+  RestoreEvictedData_unlocked();
+
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
 
   // slice directly available?
@@ -328,7 +409,13 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData(int t,
                                                              void *data,
                                                              ImportMemoryManagementType importMemoryManagement) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  this->UpdateLastDataAccessTime();
+
+  ImageDataItemPointer existing = GetExistingVolumeData(t, n);
+  if (existing.GetPointer() != nullptr)
+    return existing;
+
+  ImageDataArraysWriteHolder lock(this);
   return GetVolumeData_unlocked(t, n, data, importMemoryManagement);
 }
 mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
@@ -337,6 +424,8 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
   if (IsValidVolume(t, n) == false)
     return nullptr;
 
+  RestoreEvictedData_unlocked();
+
   ImageDataItemPointer ch, vol;
 
   // volume directly available?
@@ -406,7 +495,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
         {
           // copy data of slices in volume
           size_t offset = ((size_t)s) * size;
-          std::memcpy(static_cast<char *>(vol->GetData()) + offset, sl->GetData(), size);
+          std::memcpy(vol->m_Data + offset, sl->m_Data, size);
 
           // FIXME mitkIpPicDescriptor * pic = sl->GetPicDescriptor();
 
@@ -458,7 +547,13 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData(int n,
                                                               void *data,
                                                               ImportMemoryManagementType importMemoryManagement) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  this->UpdateLastDataAccessTime();
+
+  ImageDataItemPointer existing = GetExistingChannelData(n);
+  if (existing.GetPointer() != nullptr)
+    return existing;
+
+  ImageDataArraysWriteHolder lock(this);
   return GetChannelData_unlocked(n, data, importMemoryManagement);
 }
 
@@ -467,6 +562,9 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
 {
   if (IsValidChannel(n) == false)
     return nullptr;
+
+  RestoreEvictedData_unlocked();
+
   ImageDataItemPointer ch, vol;
   ch = m_Channels[n];
   if ((ch.GetPointer() != nullptr) && (ch->IsComplete()))
@@ -511,7 +609,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
         {
           // copy data of volume in channel
           size_t offset = ((size_t)t) * m_OffsetTable[3] * (ptypeSize);
-          std::memcpy(static_cast<char *>(ch->GetData()) + offset, vol->GetData(), size);
+          std::memcpy(ch->m_Data + offset, vol->m_Data, size);
 
           // REVEIW FIX mitkIpPicDescriptor * pic = vol->GetPicDescriptor();
 
@@ -571,7 +669,10 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
 
 bool mitk::Image::IsSliceSet(int s, int t, int n) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  if (GetExistingSliceData(s, t, n).GetPointer() != nullptr)
+    return true;
+
+  ImageDataArraysWriteHolder lock(this);
   return IsSliceSet_unlocked(s, t, n);
 }
 
@@ -580,6 +681,10 @@ bool mitk::Image::IsSliceSet_unlocked(int s, int t, int n) const
   if (IsValidSlice(s, t, n) == false)
     return false;
 
+  // evicted images were complete
+  if (m_EvictedData != nullptr)
+    return true;
+
   if (m_Slices[GetSliceIndex(s, t, n)].GetPointer() != nullptr)
   {
     return true;
@@ -601,7 +706,10 @@ bool mitk::Image::IsSliceSet_unlocked(int s, int t, int n) const
 
 bool mitk::Image::IsVolumeSet(int t, int n) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  if (GetExistingVolumeData(t, n).GetPointer() != nullptr)
+    return true;
+
+  ImageDataArraysWriteHolder lock(this);
   return IsVolumeSet_unlocked(t, n);
 }
 
@@ -609,6 +717,10 @@ bool mitk::Image::IsVolumeSet_unlocked(int t, int n) const
 {
   if (IsValidVolume(t, n) == false)
     return false;
+
+  if (m_EvictedData != nullptr)
+    return true;
+
   ImageDataItemPointer ch, vol;
 
   // volume directly available?
@@ -635,7 +747,10 @@ bool mitk::Image::IsVolumeSet_unlocked(int t, int n) const
 
 bool mitk::Image::IsChannelSet(int n) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  if (GetExistingChannelData(n).GetPointer() != nullptr)
+    return true;
+
+  ImageDataArraysWriteHolder lock(this);
   return IsChannelSet_unlocked(n);
 }
 
@@ -643,6 +758,10 @@ bool mitk::Image::IsChannelSet_unlocked(int n) const
 {
   if (IsValidChannel(n) == false)
     return false;
+
+  if (m_EvictedData != nullptr)
+    return true;
+
   ImageDataItemPointer ch, vol;
   ch = m_Channels[n];
   if ((ch.GetPointer() != nullptr) && (ch->IsComplete()))
@@ -694,8 +813,8 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
       if (sl.GetPointer() == nullptr)
         return false;
     }
-    if (sl->GetData() != data)
-      std::memcpy(sl->GetData(), data, m_OffsetTable[2] * (ptypeSize));
+    if (sl->m_Data != data)
+      std::memcpy(sl->m_Data, data, m_OffsetTable[2] * (ptypeSize));
     sl->Modified();
     // we have changed the data: call Modified()!
     Modified();
@@ -705,8 +824,8 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
     sl = AllocateSliceData(s, t, n, data, importMemoryManagement);
     if (sl.GetPointer() == nullptr)
       return false;
-    if (sl->GetData() != data)
-      std::memcpy(sl->GetData(), data, m_OffsetTable[2] * (ptypeSize));
+    if (sl->m_Data != data)
+      std::memcpy(sl->m_Data, data, m_OffsetTable[2] * (ptypeSize));
     // we just added a missing slice, which is not regarded as modification.
     // Therefore, we do not call Modified()!
   }
@@ -729,8 +848,8 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
       if (vol.GetPointer() == nullptr)
         return false;
     }
-    if (vol->GetData() != data)
-      std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
+    if (vol->m_Data != data)
+      std::memcpy(vol->m_Data, data, m_OffsetTable[3] * (ptypeSize));
     vol->Modified();
     vol->SetComplete(true);
     // we have changed the data: call Modified()!
@@ -741,12 +860,12 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
     vol = AllocateVolumeData(t, n, data, importMemoryManagement);
     if (vol.GetPointer() == nullptr)
       return false;
-    if (vol->GetData() != data)
+    if (vol->m_Data != data)
     {
-      std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
+      std::memcpy(vol->m_Data, data, m_OffsetTable[3] * (ptypeSize));
     }
     vol->SetComplete(true);
-    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(vol->GetData());
+    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(vol->m_Data);
     // we just added a missing Volume, which is not regarded as modification.
     // Therefore, we do not call Modified()!
   }
@@ -777,8 +896,8 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
       if (ch.GetPointer() == nullptr)
         return false;
     }
-    if (ch->GetData() != data)
-      std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
+    if (ch->m_Data != data)
+      std::memcpy(ch->m_Data, data, m_OffsetTable[4] * (ptypeSize));
     ch->Modified();
     ch->SetComplete(true);
     // we have changed the data: call Modified()!
@@ -789,11 +908,11 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
     ch = AllocateChannelData(n, data, importMemoryManagement);
     if (ch.GetPointer() == nullptr)
       return false;
-    if (ch->GetData() != data)
-      std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
+    if (ch->m_Data != data)
+      std::memcpy(ch->m_Data, data, m_OffsetTable[4] * (ptypeSize));
     ch->SetComplete(true);
 
-    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(ch->GetData());
+    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(ch->m_Data);
     // we just added a missing Channel, which is not regarded as modification.
     // Therefore, we do not call Modified()!
   }
@@ -802,6 +921,8 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
 
 void mitk::Image::Initialize()
 {
+  ImageDataArraysWriteHolder lock(this);
+
   ImageDataItemPointerArray::iterator it, end;
   for (it = m_Slices.begin(), end = m_Slices.end(); it != end; ++it)
   {
@@ -816,6 +937,7 @@ void mitk::Image::Initialize()
     (*it) = nullptr;
   }
   m_CompleteData = nullptr;
+  m_EvictedData.reset();
 
   if (m_ImageStatistics == nullptr)
   {
@@ -825,6 +947,271 @@ void mitk::Image::Initialize()
   SetRequestedRegionToLargestPossibleRegion();
 }
 
+void mitk::Image::SwapImageData(Image *other)
+{
+  if (other == nullptr || other == this)
+    return;
+
+  if (!this->CanSwapImageData(other))
+  {
+    mitkThrow() << "Cannot swap the data of images with different pixel type or dimensions.";
+  }
+
+  // lock both images in a consistent order to prevent dead locks
+  Image *first = this < other ? this : other;
+  Image *second = this < other ? other : this;
+
+  // returns the wait lock of an accessor of the image, requires the lock of m_ReadWriteLock
+  auto getAccessorWaitLock = [](const Image *image) -> ImageAccessorWaitLock * {
+    if (!image->m_Writers.empty())
+      return image->m_Writers.front()->m_WaitLock;
+
+    if (!image->m_Readers.empty())
+      return image->m_Readers.front()->m_WaitLock;
+
+    return nullptr;
+  };
+
+  while (true)
+  {
+    ImageAccessorWaitLock *waitLock = nullptr;
+
+    {
+      ImageDataArraysWriteHolder firstLock(first);
+      ImageDataArraysWriteHolder secondLock(second);
+
+      first->m_ReadWriteLock.Lock();
+      second->m_ReadWriteLock.Lock();
+
+      waitLock = getAccessorWaitLock(first);
+      if (nullptr == waitLock)
+        waitLock = getAccessorWaitLock(second);
+
+      if (nullptr == waitLock)
+      {
+        std::swap(m_Channels, other->m_Channels);
+        std::swap(m_Volumes, other->m_Volumes);
+        std::swap(m_Slices, other->m_Slices);
+        std::swap(m_CompleteData, other->m_CompleteData);
+        std::swap(m_EvictedData, other->m_EvictedData);
+
+        // vtk accessors are bound to the image that created them
+        for (auto *image : {this, other})
+        {
+          for (auto *items : {&image->m_Channels, &image->m_Volumes, &image->m_Slices})
+          {
+            for (auto &item : *items)
+            {
+              if (item.GetPointer() != nullptr)
+                item->ReleaseVtkImageAccessors();
+            }
+          }
+        }
+      }
+      else
+      {
+        // like a waiting accessor, see ImageAccessorBase::WaitForReleaseOf()
+        waitLock->m_WaiterCount += 1;
+      }
+
+      second->m_ReadWriteLock.Unlock();
+      first->m_ReadWriteLock.Unlock();
+    }
+
+    if (nullptr == waitLock)
+      break;
+
+    // the accessor is released without the data arrays lock, which its thread might need before
+    ImageAccessorBase::WaitForReleaseOf(waitLock);
+  }
+
+  this->Modified();
+  other->Modified();
+}
+
+bool mitk::Image::CanSwapImageData(const Image *other) const
+{
+  return other != nullptr && this->GetPixelType() == other->GetPixelType() && m_Dimension == other->m_Dimension &&
+         std::equal(m_Dimensions, m_Dimensions + m_Dimension, other->m_Dimensions) &&
+         this->GetNumberOfChannels() == other->GetNumberOfChannels();
+}
+
+std::size_t mitk::Image::GetAllocatedDataSize() const
+{
+  ImageDataArraysWriteHolder lock(this);
+
+  // slices and volumes may share the memory of their parents
+  std::set<const ImageDataItem *> roots;
+  for (const auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+  {
+    for (const auto &item : *items)
+    {
+      const ImageDataItem *root = item.GetPointer();
+      while (root != nullptr && root->GetParent().IsNotNull())
+        root = root->GetParent().GetPointer();
+
+      if (root != nullptr && (root->GetManageMemory() || root->GetMemoryOwner() != nullptr))
+        roots.insert(root);
+    }
+  }
+
+  std::size_t size = 0;
+  for (const auto *root : roots)
+    size += root->GetSize();
+
+  return size;
+}
+
+bool mitk::Image::IsDataEvicted() const
+{
+  ImageDataArraysWriteHolder lock(this);
+  return m_EvictedData != nullptr;
+}
+
+unsigned long long mitk::Image::GetLastDataAccessTime() const
+{
+  return m_LastDataAccessTime.load(std::memory_order_relaxed);
+}
+
+void mitk::Image::UpdateLastDataAccessTime() const
+{
+  m_LastDataAccessTime.store(++DataAccessCounter, std::memory_order_relaxed);
+}
+
+bool mitk::Image::IsDataExclusivelyOwned_unlocked() const
+{
+  // count the references the image holds on its data items, including the references of items to their parents
+  std::map<const ImageDataItem *, int> references;
+  std::vector<const ImageDataItem *> openItems;
+
+  auto addReference = [&references, &openItems](const ImageDataItem *item) {
+    if (item != nullptr && references[item]++ == 0)
+      openItems.push_back(item);
+  };
+
+  for (const auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+  {
+    for (const auto &item : *items)
+      addReference(item.GetPointer());
+  }
+  addReference(m_CompleteData.GetPointer());
+
+  while (!openItems.empty())
+  {
+    const ImageDataItem *item = openItems.back();
+    openItems.pop_back();
+    addReference(item->GetParent().GetPointer());
+  }
+
+  for (const auto &reference : references)
+  {
+    const ImageDataItem *item = reference.first;
+
+    // raw pointers handed out by the deprecated GetData() methods may be used anytime
+    if (item->GetReferenceCount() != reference.second || item->IsDataPinned())
+      return false;
+
+    if (item->GetParent().IsNull() && !item->GetManageMemory() &&
+        (item->GetMemoryOwner() == nullptr || item->GetMemoryOwner()->GetReferenceCount() != 1))
+      return false;
+
+    // vtkImageData, e.g. the input of a mapper, and its scalars refer to the memory of the item
+    if (item->m_VtkImageData != nullptr)
+    {
+      if (item->m_VtkImageData->GetReferenceCount() != 1)
+        return false;
+
+      vtkDataArray *scalars = item->m_VtkImageData->GetPointData()->GetScalars();
+      if (scalars != nullptr && scalars->GetReferenceCount() != 1)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool mitk::Image::EvictData(std::unique_ptr<EvictedImageData> evictedData)
+{
+  if (evictedData == nullptr || !m_Initialized)
+    return false;
+
+  ImageDataArraysWriteHolder lock(this);
+
+  if (m_EvictedData != nullptr)
+    return false;
+
+  const unsigned int numberOfChannels = this->GetNumberOfChannels();
+  for (unsigned int n = 0; n < numberOfChannels; ++n)
+  {
+    if (!IsChannelSet_unlocked(n))
+      return false;
+  }
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> accessLock(m_ReadWriteLock);
+
+  if (!m_Readers.empty() || !m_Writers.empty() || !this->IsDataExclusivelyOwned_unlocked())
+    return false;
+
+  try
+  {
+    for (unsigned int n = 0; n < numberOfChannels; ++n)
+    {
+      // combines the volumes of the channel, if they are stored separately
+      ImageDataItemPointer ch = GetChannelData_unlocked(n, nullptr, CopyMemory);
+      const size_t size = m_OffsetTable[4] * this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+      evictedData->Store(n, ch->m_Data, size);
+    }
+  }
+  catch (const std::exception &e)
+  {
+    MITK_WARN << "Could not evict image data: " << e.what();
+    return false;
+  }
+
+  for (auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+  {
+    for (auto &item : *items)
+      item = nullptr;
+  }
+  m_CompleteData = nullptr;
+
+  for (unsigned int n = 0; n < numberOfChannels; ++n)
+    m_ImageDescriptor->GetChannelDescriptor(n).SetData(nullptr);
+
+  // the content of the image has not changed, so Modified() is not called
+  m_EvictedData = std::move(evictedData);
+  return true;
+}
+
+void mitk::Image::RestoreEvictedData_unlocked() const
+{
+  if (m_EvictedData == nullptr)
+    return;
+
+  // the channels are allocated below, which must not restore again
+  std::unique_ptr<EvictedImageData> evictedData = std::move(m_EvictedData);
+
+  try
+  {
+    const unsigned int numberOfChannels = this->GetNumberOfChannels();
+    for (unsigned int n = 0; n < numberOfChannels; ++n)
+    {
+      ImageDataItemPointer ch = AllocateChannelData_unlocked(n, nullptr, ManageMemory);
+      const size_t size = m_OffsetTable[4] * this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+      evictedData->Load(n, ch->m_Data, size);
+      ch->SetComplete(true);
+    }
+  }
+  catch (...)
+  {
+    for (auto &ch : m_Channels)
+      ch = nullptr;
+
+    m_EvictedData = std::move(evictedData);
+    throw;
+  }
+}
+
 void mitk::Image::Initialize(const mitk::ImageDescriptor::Pointer inDesc)
 {
   // store the descriptor
@@ -901,13 +1288,17 @@ void mitk::Image::Initialize(const mitk::PixelType &type,
   }
   SetTimeGeometry(timeGeometry);
 
-  ImageDataItemPointer dnull = nullptr;
+  {
+    ImageDataArraysWriteHolder lock(this);
 
-  m_Channels.assign(GetNumberOfChannels(), dnull);
+    ImageDataItemPointer dnull = nullptr;
 
-  m_Volumes.assign(GetNumberOfChannels() * m_Dimensions[3], dnull);
+    m_Channels.assign(GetNumberOfChannels(), dnull);
 
-  m_Slices.assign(GetNumberOfChannels() * m_Dimensions[3] * m_Dimensions[2], dnull);
+    m_Volumes.assign(GetNumberOfChannels() * m_Dimensions[3], dnull);
+
+    m_Slices.assign(GetNumberOfChannels() * m_Dimensions[3] * m_Dimensions[2], dnull);
+  }
 
   ComputeOffsetTable();
 
@@ -1169,13 +1560,15 @@ int mitk::Image::GetVolumeIndex(int t, int n) const
 mitk::Image::ImageDataItemPointer mitk::Image::AllocateSliceData(
   int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  ImageDataArraysWriteHolder lock(this);
   return AllocateSliceData_unlocked(s, t, n, data, importMemoryManagement);
 }
 
 mitk::Image::ImageDataItemPointer mitk::Image::AllocateSliceData_unlocked(
   int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
+  RestoreEvictedData_unlocked();
+
   int pos;
   pos = GetSliceIndex(s, t, n);
 
@@ -1234,13 +1627,15 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateSliceData_unlocked(
 mitk::Image::ImageDataItemPointer mitk::Image::AllocateVolumeData(
   int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  ImageDataArraysWriteHolder lock(this);
   return AllocateVolumeData_unlocked(t, n, data, importMemoryManagement);
 }
 
 mitk::Image::ImageDataItemPointer mitk::Image::AllocateVolumeData_unlocked(
   int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
+  RestoreEvictedData_unlocked();
+
   int pos;
   pos = GetVolumeIndex(t, n);
 
@@ -1268,7 +1663,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateVolumeData_unlocked(
   {
     vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true);
     if (data != nullptr)
-      std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
+      std::memcpy(vol->m_Data, data, m_OffsetTable[3] * (ptypeSize));
   }
   else
   {
@@ -1281,13 +1676,15 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateVolumeData_unlocked(
 mitk::Image::ImageDataItemPointer mitk::Image::AllocateChannelData(
   int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
-  MutexHolder lock(m_ImageDataArraysLock);
+  ImageDataArraysWriteHolder lock(this);
   return AllocateChannelData_unlocked(n, data, importMemoryManagement);
 }
 
 mitk::Image::ImageDataItemPointer mitk::Image::AllocateChannelData_unlocked(
   int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
+  RestoreEvictedData_unlocked();
+
   ImageDataItemPointer ch;
   // allocate new channel
   if (importMemoryManagement == CopyMemory)
@@ -1296,7 +1693,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateChannelData_unlocked(
 
     ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true);
     if (data != nullptr)
-      std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
+      std::memcpy(ch->m_Data, data, m_OffsetTable[4] * (ptypeSize));
   }
   else
   {
@@ -13,6 +13,9 @@ found in the LICENSE file.
 #include "mitkImageAccessorBase.h"
 #include "mitkImage.h"
 
+#include <algorithm>
+#include <cstring>
+
 mitk::ImageAccessorBase::ThreadIDType mitk::ImageAccessorBase::CurrentThreadHandle()
 {
 #ifdef ITK_USE_SPROC
@@ -36,16 +39,21 @@ bool mitk::ImageAccessorBase::CompareThreadHandles(mitk::ImageAccessorBase::Thre
 
 mitk::ImageAccessorBase::~ImageAccessorBase()
 {
+  delete m_SubRegion;
+  delete[] m_SubRegionBuffer;
 }
 
 mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
                                            const ImageDataItem *imageDataItem,
-                                           int OptionFlags)
+                                           int OptionFlags,
+                                           const RegionType *subRegion)
   : // m_Image(iP)
     //, imageDataItem(iDI)
-    m_SubRegion(nullptr),
+    m_SubRegion(subRegion != nullptr ? new RegionType(*subRegion) : nullptr),
     m_Options(OptionFlags),
-    m_CoherentMemory(false)
+    m_CoherentMemory(false),
+    m_PixelSize(0),
+    m_SubRegionBuffer(nullptr)
 {
   m_Thread = CurrentThreadHandle();
 
@@ -83,66 +91,138 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
 
   // Investigate 4 cases of possible image parts/regions
 
-  // Case 1: No ImageDataItem and no Subregion => Whole Image is accessed
-  if (imageDataItem == nullptr && m_SubRegion == nullptr)
+  // Case 1 and 3: No ImageDataItem => first image channel is accessed
+  if (imageDataItem == nullptr)
   {
-    m_CoherentMemory = true;
-
-    // Organize first image channel
-    image->m_ReadWriteLock.Lock();
+    // Organize first image channel (GetChannelData() synchronizes itself and returns
+    // an already materialized channel without waiting for other accessors)
     imageDataItem = image->GetChannelData();
-    image->m_ReadWriteLock.Unlock();
+  }
 
-    // Set memory area
-    m_AddressBegin = imageDataItem->m_Data;
-    m_AddressEnd = (unsigned char *)m_AddressBegin + imageDataItem->m_Size;
+  m_PixelSize = imageDataItem->GetPixelType().GetSize();
+  m_SourceStrides[0] = m_PixelSize;
+  for (unsigned int i = 1; i < 4; ++i)
+  {
+    m_SourceStrides[i] = m_SourceStrides[i - 1] * std::max(imageDataItem->GetDimension(i - 1), 1);
   }
 
-  // Case 2: ImageDataItem but no Subregion
-  if (imageDataItem && m_SubRegion == nullptr)
+  // Case 1 and 2: No Subregion => whole ImageDataItem is accessed
+  if (m_SubRegion == nullptr)
   {
     m_CoherentMemory = true;
+    std::copy(m_SourceStrides, m_SourceStrides + 4, m_Strides);
 
     // Set memory area
     m_AddressBegin = imageDataItem->m_Data;
     m_AddressEnd = (unsigned char *)m_AddressBegin + imageDataItem->m_Size;
   }
+  // Case 3 and 4: SubRegion of the ImageDataItem is accessed
+  else
+  {
+    this->InitializeSubRegion(imageDataItem);
+  }
+}
+
+void mitk::ImageAccessorBase::InitializeSubRegion(const ImageDataItem *imageDataItem)
+{
+  const RegionType::IndexType index = m_SubRegion->GetIndex();
+  const RegionType::SizeType size = m_SubRegion->GetSize();
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    const auto dimension = static_cast<RegionType::SizeValueType>(std::max(imageDataItem->GetDimension(i), 1));
+
+    if (index[i] < 0 || size[i] == 0 || index[i] + size[i] > dimension)
+    {
+      delete m_WaitLock;
+      delete m_SubRegion;
+      m_SubRegion = nullptr;
+      mitkThrow() << "Invalid ImageAccessor: The SubRegion (index " << index << ", size " << size
+                  << ") exceeds the accessed image part.";
+    }
+  }
+
+  // The SubRegion lies coherently in memory if every dimension after the first one
+  // that is not completely covered has a size of one.
+  m_CoherentMemory = true;
+  bool partiallyCovered = false;
+  size_t offsetBegin = 0;
+  size_t offsetLast = 0;
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (partiallyCovered && size[i] > 1)
+      m_CoherentMemory = false;
+
+    if (size[i] < static_cast<RegionType::SizeValueType>(std::max(imageDataItem->GetDimension(i), 1)))
+      partiallyCovered = true;
+
+    offsetBegin += index[i] * m_SourceStrides[i];
+    offsetLast += (size[i] - 1) * m_SourceStrides[i];
+  }
+
+  // Set memory area (for incoherent memory it is the span between first and last pixel)
+  m_AddressBegin = imageDataItem->m_Data + offsetBegin;
+  m_AddressEnd = (unsigned char *)m_AddressBegin + offsetLast + m_PixelSize;
+
+  if (m_CoherentMemory || (m_Options & ForceCoherentMemory))
+  {
+    m_Strides[0] = m_PixelSize;
+    for (unsigned int i = 1; i < 4; ++i)
+      m_Strides[i] = m_Strides[i - 1] * size[i - 1];
 
-  // Case 3: No ImageDataItem but a SubRegion
-  if (imageDataItem == nullptr && m_SubRegion)
+    // The data is copied by the inheriting accessor as soon as the memory is locked
+    if (!m_CoherentMemory)
+      m_SubRegionBuffer = new unsigned char[m_Strides[3] * size[3]];
+  }
+  else
   {
-    mitkThrow() << "Invalid ImageAccessor: The use of a SubRegion is not supported (yet).";
+    std::copy(m_SourceStrides, m_SourceStrides + 4, m_Strides);
   }
+}
+
+void mitk::ImageAccessorBase::CopySubRegion(bool intoBuffer)
+{
+  if (m_SubRegionBuffer == nullptr)
+    return;
+
+  const RegionType::SizeType size = m_SubRegion->GetSize();
+  const size_t rowLength = size[0] * m_PixelSize;
+  auto *buffer = m_SubRegionBuffer;
 
-  // Case 4: ImageDataItem and SubRegion
-  if (imageDataItem == nullptr && m_SubRegion)
+  for (RegionType::SizeValueType t = 0; t < size[3]; ++t)
   {
-    mitkThrow() << "Invalid ImageAccessor: The use of a SubRegion is not supported (yet).";
+    for (RegionType::SizeValueType z = 0; z < size[2]; ++z)
+    {
+      for (RegionType::SizeValueType y = 0; y < size[1]; ++y, buffer += rowLength)
+      {
+        auto *row = static_cast<unsigned char *>(m_AddressBegin) + t * m_SourceStrides[3] +
+                    z * m_SourceStrides[2] + y * m_SourceStrides[1];
+
+        if (intoBuffer)
+          std::memcpy(buffer, row, rowLength);
+        else
+          std::memcpy(row, buffer, rowLength);
+      }
+    }
   }
 }
 
 /** \brief Computes if there is an Overlap of the image part between this instantiation and another ImageAccessor object
- * \throws mitk::Exception if memory area is incoherent (not supported yet)
  */
 bool mitk::ImageAccessorBase::Overlap(const ImageAccessorBase *iAB)
 {
-  if (m_CoherentMemory)
+  // Incoherent sub regions are represented by the span between their first and last pixel.
+  // This may report overlaps of interleaved regions, which only leads to unnecessary waiting.
+  if ((iAB->m_AddressBegin >= m_AddressBegin && iAB->m_AddressBegin < m_AddressEnd) ||
+      (iAB->m_AddressEnd > m_AddressBegin && iAB->m_AddressEnd <= m_AddressEnd))
   {
-    if ((iAB->m_AddressBegin >= m_AddressBegin && iAB->m_AddressBegin < m_AddressEnd) ||
-        (iAB->m_AddressEnd > m_AddressBegin && iAB->m_AddressEnd <= m_AddressEnd))
-    {
-      return true;
-    }
-    if ((m_AddressBegin >= iAB->m_AddressBegin && m_AddressBegin < iAB->m_AddressEnd) ||
-        (m_AddressEnd > iAB->m_AddressBegin && m_AddressEnd <= iAB->m_AddressEnd))
-    {
-      return true;
-    }
+    return true;
   }
-  else
+  if ((m_AddressBegin >= iAB->m_AddressBegin && m_AddressBegin < iAB->m_AddressEnd) ||
+      (m_AddressEnd > iAB->m_AddressBegin && m_AddressEnd <= iAB->m_AddressEnd))
   {
-    GetImage()->m_ReadWriteLock.Unlock();
-    mitkThrow() << "ImageAccessor: incoherent memory area is not supported yet";
+    return true;
   }
 
   return false;
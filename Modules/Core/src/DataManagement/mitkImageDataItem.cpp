@@ -49,7 +49,8 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
     m_Size(0),
     m_Parent(&aParent),
     m_Dimension(dimension),
-    m_Timestep(timestep)
+    m_Timestep(timestep),
+    m_DataPinned(false)
 {
   // compute size
   // const unsigned int *dims = desc->GetDimensions();
@@ -109,7 +110,8 @@ mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
     m_IsComplete(false),
     m_Size(0),
     m_Dimension(desc->GetNumberOfDimensions()),
-    m_Timestep(timestep)
+    m_Timestep(timestep),
+    m_DataPinned(false)
 {
   // compute size
   const unsigned int *dimensions = desc->GetDimensions();
@@ -146,7 +148,8 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
     m_Size(0),
     m_Parent(nullptr),
     m_Dimension(dimension),
-    m_Timestep(timestep)
+    m_Timestep(timestep),
+    m_DataPinned(false)
 {
   for (unsigned int i = 0; i < m_Dimension; i++)
   {
@@ -176,14 +179,23 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_IsComplete(other.m_IsComplete),
     m_Size(other.m_Size),
     m_Parent(other.m_Parent),
+    m_MemoryOwner(other.m_MemoryOwner),
     m_Dimension(other.m_Dimension),
-    m_Timestep(other.m_Timestep)
+    m_Timestep(other.m_Timestep),
+    m_DataPinned(other.m_DataPinned.load())
 {
   // copy m_Data ??
   for (int i = 0; i < MAX_IMAGE_DIMENSIONS; ++i)
     m_Dimensions[i] = other.m_Dimensions[i];
 }
 
+void mitk::ImageDataItem::PinData() const
+{
+  // the memory of the item belongs to its topmost parent
+  for (const ImageDataItem *item = this; item != nullptr; item = item->m_Parent.GetPointer())
+    item->m_DataPinned = true;
+}
+
 itk::LightObject::Pointer mitk::ImageDataItem::InternalClone() const
 {
   Self::Pointer newGeometry = new Self(*this);
@@ -307,6 +319,15 @@ void mitk::ImageDataItem::Modified() const
     m_VtkImageData->Modified();
 }
 
+void mitk::ImageDataItem::ReleaseVtkImageAccessors()
+{
+  delete m_VtkImageReadAccessor;
+  m_VtkImageReadAccessor = nullptr;
+
+  delete m_VtkImageWriteAccessor;
+  m_VtkImageWriteAccessor = nullptr;
+}
+
 mitk::ImageVtkReadAccessor *mitk::ImageDataItem::GetVtkImageAccessor(mitk::ImageDataItem::ImageConstPointer iP) const
 {
   if (m_VtkImageData == nullptr)
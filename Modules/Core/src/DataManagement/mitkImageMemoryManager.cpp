@@ -0,0 +1,495 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageMemoryManager.h"
+
+#include "mitkDataStorage.h"
+#include "mitkExceptionMacro.h"
+#include "mitkIOUtil.h"
+#include "mitkImage.h"
+
+#include <itkCommand.h>
+
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  /** Size of the blocks that are compressed independently, fits into the length types of zlib */
+  const std::size_t CompressionBlockSize = 64 * 1024 * 1024;
+
+  /** Writes the channels consecutively to a temporary file, which is removed with the object. */
+  class SpillFileData : public mitk::EvictedImageData
+  {
+  public:
+    explicit SpillFileData(const std::string &directory) : m_Size(0)
+    {
+      // the file is not kept open, many images may be evicted at the same time
+      std::ofstream stream;
+      m_FileName =
+        mitk::IOUtil::CreateTemporaryFile(stream, std::ios_base::binary, "MITK-EvictedImage-XXXXXX.raw", directory);
+    }
+
+    ~SpillFileData() override { std::remove(m_FileName.c_str()); }
+
+    void Store(unsigned int n, const void *data, std::size_t size) override
+    {
+      std::ofstream stream(m_FileName.c_str(), std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+      stream.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+      stream.close();
+
+      if (!stream)
+        mitkThrow() << "Could not write to spill file " << m_FileName;
+
+      m_Offsets.resize(std::max<std::size_t>(m_Offsets.size(), n + 1), 0);
+      m_Offsets[n] = static_cast<std::streamoff>(m_Size);
+      m_Size += size;
+    }
+
+    void Load(unsigned int n, void *data, std::size_t size) const override
+    {
+      if (n >= m_Offsets.size())
+        mitkThrow() << "Channel " << n << " has not been stored in spill file " << m_FileName;
+
+      std::ifstream stream(m_FileName.c_str(), std::ios_base::in | std::ios_base::binary);
+      stream.seekg(m_Offsets[n]);
+      stream.read(static_cast<char *>(data), static_cast<std::streamsize>(size));
+
+      if (!stream)
+        mitkThrow() << "Could not read from spill file " << m_FileName;
+    }
+
+    std::size_t GetMemorySize() const override { return 0; }
+
+  private:
+    std::string m_FileName;
+    std::size_t m_Size;
+    std::vector<std::streamoff> m_Offsets;
+  };
+
+  /** Compresses each channel with zlib in blocks, whose sizes fit into the zlib length types. */
+  class CompressedData : public mitk::EvictedImageData
+  {
+  public:
+    void Store(unsigned int n, const void *data, std::size_t size) override
+    {
+      m_Channels.resize(std::max<std::size_t>(m_Channels.size(), n + 1));
+      auto &blocks = m_Channels[n];
+      blocks.clear();
+
+      const auto *bytes = static_cast<const unsigned char *>(data);
+      for (std::size_t offset = 0; offset < size; offset += CompressionBlockSize)
+      {
+        const ::uLong sourceLen = static_cast<::uLong>(std::min(CompressionBlockSize, size - offset));
+        ::uLongf destLen = ::compressBound(sourceLen);
+
+        blocks.emplace_back(destLen);
+        if (::compress2(blocks.back().data(), &destLen, bytes + offset, sourceLen, Z_BEST_SPEED) != Z_OK)
+          mitkThrow() << "Could not compress the data of channel " << n;
+
+        blocks.back().resize(destLen);
+        blocks.back().shrink_to_fit();
+      }
+    }
+
+    void Load(unsigned int n, void *data, std::size_t size) const override
+    {
+      if (n >= m_Channels.size())
+        mitkThrow() << "Channel " << n << " has not been compressed";
+
+      auto *bytes = static_cast<unsigned char *>(data);
+      std::size_t offset = 0;
+
+      for (const auto &block : m_Channels[n])
+      {
+        ::uLongf destLen = static_cast<::uLongf>(std::min(CompressionBlockSize, size - offset));
+        if (::uncompress(bytes + offset, &destLen, block.data(), static_cast<::uLong>(block.size())) != Z_OK)
+          mitkThrow() << "Could not uncompress the data of channel " << n;
+
+        offset += destLen;
+      }
+
+      if (offset != size)
+        mitkThrow() << "The compressed data of channel " << n << " does not match the image size";
+    }
+
+    std::size_t GetMemorySize() const override
+    {
+      std::size_t memorySize = 0;
+      for (const auto &blocks : m_Channels)
+      {
+        for (const auto &block : blocks)
+          memorySize += block.size();
+      }
+      return memorySize;
+    }
+
+  private:
+    std::vector<std::vector<std::vector<unsigned char>>> m_Channels;
+  };
+}
+
+mitk::EvictedImageData::~EvictedImageData()
+{
+}
+
+mitk::ImageMemoryManager *mitk::ImageMemoryManager::GetInstance()
+{
+  static ImageMemoryManager::Pointer instance = ImageMemoryManager::New();
+  return instance;
+}
+
+mitk::ImageMemoryManager::ImageMemoryManager()
+  : m_MemoryBudget(0),
+    m_EvictionMode(SpillToFile),
+    m_SpillDirectory(IOUtil::GetTempPath()),
+    m_EnforcementRequested(false),
+    m_Enforcing(false),
+    m_StopEnforcement(false)
+{
+}
+
+mitk::ImageMemoryManager::~ImageMemoryManager()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_EnforcementMutex);
+    m_StopEnforcement = true;
+  }
+  m_EnforcementCondition.notify_all();
+
+  if (m_EnforcementThread.joinable())
+    m_EnforcementThread.join();
+
+  for (const auto &dataStorage : m_DataStorages)
+  {
+    dataStorage.first->AddNodeEvent.RemoveListener(
+      MessageDelegate1<ImageMemoryManager, const DataNode *>(this, &ImageMemoryManager::OnNodeAdded));
+    dataStorage.first->RemoveObserver(dataStorage.second);
+  }
+}
+
+void mitk::ImageMemoryManager::SetMemoryBudget(std::size_t bytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_MemoryBudget == bytes)
+      return;
+
+    m_MemoryBudget = bytes;
+  }
+
+  this->Modified();
+  this->RequestMemoryBudgetEnforcement();
+}
+
+std::size_t mitk::ImageMemoryManager::GetMemoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MemoryBudget;
+}
+
+void mitk::ImageMemoryManager::SetEvictionMode(EvictionMode mode)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_EvictionMode = mode;
+}
+
+mitk::ImageMemoryManager::EvictionMode mitk::ImageMemoryManager::GetEvictionMode() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_EvictionMode;
+}
+
+void mitk::ImageMemoryManager::SetSpillDirectory(const std::string &directory)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_SpillDirectory = directory;
+}
+
+std::string mitk::ImageMemoryManager::GetSpillDirectory() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_SpillDirectory;
+}
+
+void mitk::ImageMemoryManager::AddDataStorage(DataStorage *dataStorage)
+{
+  if (dataStorage == nullptr)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_DataStorages.find(dataStorage) != m_DataStorages.end())
+      return;
+
+    // the data storages are not kept alive by the manager
+    auto deleteCommand = itk::MemberCommand<ImageMemoryManager>::New();
+    deleteCommand->SetCallbackFunction(this, &ImageMemoryManager::OnDataStorageDeleted);
+    m_DataStorages[dataStorage] = dataStorage->AddObserver(itk::DeleteEvent(), deleteCommand);
+
+    dataStorage->AddNodeEvent.AddListener(
+      MessageDelegate1<ImageMemoryManager, const DataNode *>(this, &ImageMemoryManager::OnNodeAdded));
+  }
+
+  this->RequestMemoryBudgetEnforcement();
+}
+
+void mitk::ImageMemoryManager::RemoveDataStorage(DataStorage *dataStorage)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto it = m_DataStorages.find(dataStorage);
+  if (it == m_DataStorages.end())
+    return;
+
+  dataStorage->AddNodeEvent.RemoveListener(
+    MessageDelegate1<ImageMemoryManager, const DataNode *>(this, &ImageMemoryManager::OnNodeAdded));
+  dataStorage->RemoveObserver(it->second);
+
+  m_DataStorages.erase(it);
+}
+
+void mitk::ImageMemoryManager::OnNodeAdded(const DataNode *)
+{
+  // nodes are usually added by the GUI thread, which must not wait for the eviction
+  this->RequestMemoryBudgetEnforcement();
+}
+
+void mitk::ImageMemoryManager::OnDataStorageDeleted(const itk::Object *caller, const itk::EventObject &)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_DataStorages.erase(static_cast<DataStorage *>(const_cast<itk::Object *>(caller)));
+}
+
+std::size_t mitk::ImageMemoryManager::GetResidentMemorySize() const
+{
+  std::vector<DataStorage::Pointer> dataStorages;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const auto &dataStorage : m_DataStorages)
+      dataStorages.push_back(dataStorage.first);
+  }
+
+  // an image may be shared by several nodes
+  std::set<const Image *> images;
+  for (const auto &dataStorage : dataStorages)
+  {
+    auto nodes = dataStorage->GetAll();
+    for (const auto &node : *nodes)
+    {
+      if (const auto *image = dynamic_cast<const Image *>(node->GetData()))
+        images.insert(image);
+    }
+  }
+
+  std::size_t size = 0;
+  for (const auto *image : images)
+    size += image->GetAllocatedDataSize();
+
+  return size;
+}
+
+std::vector<mitk::ImageMemoryManager::EvictionCandidate> mitk::ImageMemoryManager::GetEvictionCandidates() const
+{
+  std::vector<DataStorage::Pointer> dataStorages;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const auto &dataStorage : m_DataStorages)
+      dataStorages.push_back(dataStorage.first);
+  }
+
+  // an image may be shared by several nodes
+  std::map<Image *, bool> visibilities;
+  for (const auto &dataStorage : dataStorages)
+  {
+    auto nodes = dataStorage->GetAll();
+    for (const auto &node : *nodes)
+    {
+      auto *image = dynamic_cast<Image *>(node->GetData());
+      if (image == nullptr)
+        continue;
+
+      auto &visible = visibilities[image];
+      visible = visible || node->IsVisible(nullptr);
+    }
+  }
+
+  std::vector<EvictionCandidate> candidates;
+  candidates.reserve(visibilities.size());
+  for (const auto &visibility : visibilities)
+    candidates.push_back({visibility.first, visibility.second});
+
+  return candidates;
+}
+
+void mitk::ImageMemoryManager::EnforceMemoryBudget()
+{
+  if (this->GetMemoryBudget() == 0)
+    return;
+
+  auto candidates = this->GetEvictionCandidates();
+  this->EvictCandidates(candidates);
+}
+
+void mitk::ImageMemoryManager::EvictCandidates(std::vector<EvictionCandidate> &candidates)
+{
+  std::lock_guard<std::mutex> enforceLock(m_EnforceMutex);
+
+  const std::size_t budget = this->GetMemoryBudget();
+  if (budget == 0)
+    return;
+
+  std::size_t residentSize = 0;
+  std::vector<std::pair<unsigned long long, EvictionCandidate *>> order;
+  for (auto &candidate : candidates)
+  {
+    residentSize += candidate.m_Image->GetAllocatedDataSize();
+    order.emplace_back(candidate.m_Image->GetLastDataAccessTime(), &candidate);
+  }
+
+  if (residentSize <= budget)
+    return;
+
+  // hidden images first, least recently accessed first
+  std::sort(order.begin(),
+            order.end(),
+            [](const std::pair<unsigned long long, EvictionCandidate *> &a,
+               const std::pair<unsigned long long, EvictionCandidate *> &b) {
+              if (a.second->m_Visible != b.second->m_Visible)
+                return !a.second->m_Visible;
+              return a.first < b.first;
+            });
+
+  for (const auto &entry : order)
+  {
+    if (residentSize <= budget)
+      break;
+
+    auto *image = entry.second->m_Image.GetPointer();
+    const std::size_t size = image->GetAllocatedDataSize();
+    if (size == 0)
+      continue;
+
+    if (this->EvictImage(image))
+      residentSize -= std::min(size, residentSize);
+  }
+
+  if (residentSize > budget)
+  {
+    MITK_DEBUG << "Images occupy " << residentSize << " bytes after eviction, exceeding the budget of " << budget
+               << " bytes";
+  }
+}
+
+void mitk::ImageMemoryManager::RequestMemoryBudgetEnforcement()
+{
+  if (this->GetMemoryBudget() == 0)
+    return;
+
+  auto candidates = this->GetEvictionCandidates();
+
+  {
+    std::lock_guard<std::mutex> lock(m_EnforcementMutex);
+    if (m_StopEnforcement)
+      return;
+
+    // a newer request supersedes the pending one
+    m_RequestedCandidates = std::move(candidates);
+    m_EnforcementRequested = true;
+
+    if (!m_EnforcementThread.joinable())
+      m_EnforcementThread = std::thread(&ImageMemoryManager::RunEnforcementThread, this);
+  }
+
+  m_EnforcementCondition.notify_all();
+}
+
+void mitk::ImageMemoryManager::WaitForMemoryBudgetEnforcement()
+{
+  std::unique_lock<std::mutex> lock(m_EnforcementMutex);
+  m_EnforcementCondition.wait(lock, [this] { return m_StopEnforcement || (!m_EnforcementRequested && !m_Enforcing); });
+}
+
+void mitk::ImageMemoryManager::RunEnforcementThread()
+{
+  std::unique_lock<std::mutex> lock(m_EnforcementMutex);
+
+  while (true)
+  {
+    m_EnforcementCondition.wait(lock, [this] { return m_StopEnforcement || m_EnforcementRequested; });
+
+    if (m_StopEnforcement)
+      break;
+
+    auto candidates = std::move(m_RequestedCandidates);
+    m_RequestedCandidates.clear();
+    m_EnforcementRequested = false;
+    m_Enforcing = true;
+
+    lock.unlock();
+    try
+    {
+      this->EvictCandidates(candidates);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_WARN << "Could not enforce the memory budget of the images: " << e.what();
+    }
+    // the images are released outside of the lock
+    candidates.clear();
+    lock.lock();
+
+    m_Enforcing = false;
+    m_EnforcementCondition.notify_all();
+  }
+
+  m_RequestedCandidates.clear();
+  m_EnforcementCondition.notify_all();
+}
+
+bool mitk::ImageMemoryManager::EvictImage(Image *image)
+{
+  if (image == nullptr || image->IsDataEvicted())
+    return false;
+
+  EvictionMode mode;
+  std::string spillDirectory;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    mode = m_EvictionMode;
+    spillDirectory = m_SpillDirectory;
+  }
+
+  std::unique_ptr<EvictedImageData> evictedData;
+  try
+  {
+    if (mode == SpillToFile)
+      evictedData.reset(new SpillFileData(spillDirectory));
+    else
+      evictedData.reset(new CompressedData);
+  }
+  catch (const mitk::Exception &e)
+  {
+    MITK_WARN << "Could not create storage for evicted image data: " << e.GetDescription();
+    return false;
+  }
+
+  return image->EvictData(std::move(evictedData));
+}
@@ -54,12 +54,34 @@ mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image, const Image
   OrganizeReadAccess();
 }
 
+mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image,
+                                           const RegionType &subRegion,
+                                           const mitk::ImageDataItem *iDI,
+                                           int OptionFlags)
+  : ImageAccessorBase(image, iDI, OptionFlags, &subRegion), m_Image(image)
+{
+  if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
+  {
+    try
+    {
+      OrganizeReadAccess();
+    }
+    catch (...)
+    {
+      delete m_WaitLock;
+      throw;
+    }
+  }
+  else
+  {
+    CopySubRegion(true);
+  }
+}
+
 mitk::ImageReadAccessor::~ImageReadAccessor()
 {
   if (!(m_Options & ImageAccessorBase::IgnoreLock))
   {
-    // Future work: In case of non-coherent memory, copied area needs to be deleted
-
     m_Image->m_ReadWriteLock.Lock();
 
     // delete self from list of ImageReadAccessors in Image
@@ -141,6 +163,9 @@ void mitk::ImageReadAccessor::OrganizeReadAccess()
   // insert self into readers list in Image
   m_Image->m_Readers.push_back(this);
 
+  // In case of non-coherent memory, the sub region is copied while being protected against writers
+  CopySubRegion(true);
+
   // printf("ReadAccess %d %d\n",(int) m_Image->m_Readers.size(),(int) m_Image->m_Writers.size());
   // fflush(0);
   m_Image->m_ReadWriteLock.Unlock();
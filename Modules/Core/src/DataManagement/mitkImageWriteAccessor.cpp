@@ -19,10 +19,19 @@ mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::Ima
   OrganizeWriteAccess();
 }
 
+mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image,
+                                             const RegionType &subRegion,
+                                             const mitk::ImageDataItem *iDI,
+                                             int OptionFlags)
+  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags, &subRegion), m_Image(image)
+{
+  OrganizeWriteAccess();
+}
+
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
 {
   // In case of non-coherent memory, copied area needs to be written back
-  // TODO
+  CopySubRegion(false);
 
   m_Image->m_ReadWriteLock.Lock();
 
@@ -141,6 +150,9 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
   // insert self into Writers list in Image
   m_Image->m_Writers.push_back(this);
 
+  // In case of non-coherent memory, the sub region is copied while being protected against other accessors
+  CopySubRegion(true);
+
   // printf("WriteAccess %d %d\n",(int) m_Image->m_Readers.size(),(int) m_Image->m_Writers.size());
   // fflush(0);
   m_Image->m_ReadWriteLock.Unlock();
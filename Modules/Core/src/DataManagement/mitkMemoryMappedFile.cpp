@@ -0,0 +1,140 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMemoryMappedFile.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <itksys/SystemTools.hxx>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+mitk::MemoryMappedFile::MemoryMappedFile()
+  : m_MappedPages(nullptr),
+    m_MappedLength(0),
+    m_Data(nullptr),
+    m_Size(0)
+#ifdef _WIN32
+    ,
+    m_FileHandle(INVALID_HANDLE_VALUE),
+    m_MappingHandle(nullptr)
+#endif
+{
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+  this->Unmap();
+}
+
+size_t mitk::MemoryMappedFile::GetFileSize(const std::string &path)
+{
+  return static_cast<size_t>(itksys::SystemTools::FileLength(path));
+}
+
+void mitk::MemoryMappedFile::Map(const std::string &path, size_t offset, size_t length)
+{
+  this->Unmap();
+
+  if (0 == length)
+    mitkThrow() << "Cannot map an empty range of file " << path;
+
+  const size_t fileSize = GetFileSize(path);
+  if (offset + length > fileSize)
+    mitkThrow() << "Cannot map bytes [" << offset << ", " << offset + length << ") of file " << path
+                << " with a size of " << fileSize << " bytes";
+
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const size_t alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+  if (INVALID_HANDLE_VALUE == file)
+    mitkThrow() << "Cannot open file " << path << " for memory mapping";
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  if (nullptr == mapping)
+  {
+    CloseHandle(file);
+    mitkThrow() << "Cannot create file mapping of " << path;
+  }
+
+  const unsigned long long offset64 = alignedOffset;
+  void *pages = MapViewOfFile(mapping,
+                              FILE_MAP_COPY,
+                              static_cast<DWORD>(offset64 >> 32),
+                              static_cast<DWORD>(offset64 & 0xFFFFFFFF),
+                              length + offset - alignedOffset);
+  if (nullptr == pages)
+  {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    mitkThrow() << "Cannot map view of file " << path;
+  }
+
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+#else
+  const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t alignedOffset = offset - offset % pageSize;
+
+  int file = open(path.c_str(), O_RDONLY);
+  if (-1 == file)
+    mitkThrow() << "Cannot open file " << path << " for memory mapping";
+
+  // MAP_PRIVATE gives copy-on-write semantics: pages are shared with the page cache
+  // until they are written, modifications never reach the file.
+  void *pages = mmap(nullptr, length + offset - alignedOffset, PROT_READ | PROT_WRITE, MAP_PRIVATE, file,
+                     static_cast<off_t>(alignedOffset));
+
+  // The mapping keeps its own reference on the file.
+  close(file);
+
+  if (MAP_FAILED == pages)
+    mitkThrow() << "Cannot memory map file " << path;
+#endif
+
+  m_MappedPages = pages;
+  m_MappedLength = length + offset - alignedOffset;
+  m_Data = static_cast<unsigned char *>(pages) + (offset - alignedOffset);
+  m_Size = length;
+}
+
+void mitk::MemoryMappedFile::Unmap()
+{
+  if (nullptr == m_MappedPages)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_MappedPages);
+  CloseHandle(m_MappingHandle);
+  CloseHandle(m_FileHandle);
+  m_MappingHandle = nullptr;
+  m_FileHandle = INVALID_HANDLE_VALUE;
+#else
+  munmap(m_MappedPages, m_MappedLength);
+#endif
+
+  m_MappedPages = nullptr;
+  m_MappedLength = 0;
+  m_Data = nullptr;
+  m_Size = 0;
+}
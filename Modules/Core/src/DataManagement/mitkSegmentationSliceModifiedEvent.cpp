@@ -0,0 +1,59 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSegmentationSliceModifiedEvent.h"
+
+mitk::SegmentationSliceModifiedEvent::SegmentationSliceModifiedEvent(const Image *previousSlice,
+                                                                     const Image *currentSlice,
+                                                                     unsigned int timeStep)
+  : m_PreviousSlice(previousSlice), m_CurrentSlice(currentSlice), m_TimeStep(timeStep)
+{
+}
+
+mitk::SegmentationSliceModifiedEvent::SegmentationSliceModifiedEvent(const Self &s)
+  : itk::AnyEvent(s), m_PreviousSlice(s.m_PreviousSlice), m_CurrentSlice(s.m_CurrentSlice), m_TimeStep(s.m_TimeStep)
+{
+}
+
+mitk::SegmentationSliceModifiedEvent::~SegmentationSliceModifiedEvent()
+{
+}
+
+const char *mitk::SegmentationSliceModifiedEvent::GetEventName() const
+{
+  return "SegmentationSliceModifiedEvent";
+}
+
+bool mitk::SegmentationSliceModifiedEvent::CheckEvent(const ::itk::EventObject *e) const
+{
+  return dynamic_cast<const Self *>(e) != nullptr;
+}
+
+::itk::EventObject *mitk::SegmentationSliceModifiedEvent::MakeObject() const
+{
+  return new Self(m_PreviousSlice, m_CurrentSlice, m_TimeStep);
+}
+
+const mitk::Image *mitk::SegmentationSliceModifiedEvent::GetPreviousSlice() const
+{
+  return m_PreviousSlice.GetPointer();
+}
+
+const mitk::Image *mitk::SegmentationSliceModifiedEvent::GetCurrentSlice() const
+{
+  return m_CurrentSlice.GetPointer();
+}
+
+unsigned int mitk::SegmentationSliceModifiedEvent::GetTimeStep() const
+{
+  return m_TimeStep;
+}
@@ -16,11 +16,47 @@ found in the LICENSE file.
 #include "itkSimpleFastMutexLock.h"
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
+#include "mitkNodePredicateAnd.h"
 #include "mitkNodePredicateBase.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateDataUID.h"
+#include "mitkNodePredicateOr.h"
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
+#include "mitkStringProperty.h"
 
-mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+  typedef std::set<const mitk::DataNode *> NodeSet;
+  typedef std::map<std::string, NodeSet> NodeIndex;
+
+  void EraseFromIndex(NodeIndex &index, const std::string &key, const mitk::DataNode *node)
+  {
+    auto it = index.find(key);
+    if (it == index.end())
+      return;
+
+    it->second.erase(node);
+    if (it->second.empty())
+      index.erase(it);
+  }
+
+  void EraseFromSetOfObjects(const mitk::DataStorage::SetOfObjects *set, const mitk::DataNode *node)
+  {
+    if (set == nullptr)
+      return;
+
+    auto *s = const_cast<mitk::DataStorage::SetOfObjects *>(set);
+    s->erase(std::remove(s->begin(), s->end(), node), s->end());
+  }
+}
+
+mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage(), m_IndexEnabled(true)
 {
 }
 
@@ -29,6 +65,7 @@ mitk::StandaloneDataStorage::~StandaloneDataStorage()
   for (auto it = m_SourceNodes.begin(); it != m_SourceNodes.end(); ++it)
   {
     this->RemoveListeners(it->first);
+    this->RemoveFromIndex(it->first);
   }
 }
 
@@ -81,6 +118,9 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
 
     // register for ITK changed events
     this->AddListeners(node);
+
+    if (m_IndexEnabled)
+      this->AddToIndex(node);
   }
 
   /* Notify observers */
@@ -109,9 +149,9 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
   EmitRemoveNodeEvent(node);
   {
     itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+    this->RemoveFromIndex(node);
     /* remove node from both relation adjacency lists */
-    this->RemoveFromRelation(node, m_SourceNodes);
-    this->RemoveFromRelation(node, m_DerivedNodes);
+    this->RemoveFromRelations(node);
   }
 }
 
@@ -143,6 +183,37 @@ void mitk::StandaloneDataStorage::RemoveFromRelation(const mitk::DataNode *node,
     relation.erase(adIt);
 }
 
+void mitk::StandaloneDataStorage::RemoveFromRelations(const mitk::DataNode *node)
+{
+  /* node is only contained in the derivations of its sources and in the sources of its derivations */
+  auto sourcesIt = m_SourceNodes.find(node);
+  if (sourcesIt != m_SourceNodes.end() && sourcesIt->second.IsNotNull())
+  {
+    for (const auto &source : *sourcesIt->second)
+    {
+      auto derivationsOfSourceIt = m_DerivedNodes.find(source.GetPointer());
+      if (derivationsOfSourceIt != m_DerivedNodes.end())
+        EraseFromSetOfObjects(derivationsOfSourceIt->second, node);
+    }
+  }
+
+  auto derivationsIt = m_DerivedNodes.find(node);
+  if (derivationsIt != m_DerivedNodes.end() && derivationsIt->second.IsNotNull())
+  {
+    for (const auto &derivation : *derivationsIt->second)
+    {
+      auto sourcesOfDerivationIt = m_SourceNodes.find(derivation.GetPointer());
+      if (sourcesOfDerivationIt != m_SourceNodes.end())
+        EraseFromSetOfObjects(sourcesOfDerivationIt->second, node);
+    }
+  }
+
+  if (sourcesIt != m_SourceNodes.end())
+    m_SourceNodes.erase(sourcesIt);
+  if (derivationsIt != m_DerivedNodes.end())
+    m_DerivedNodes.erase(derivationsIt);
+}
+
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetAll() const
 {
   itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
@@ -183,10 +254,13 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRe
   /* Or traverse adjacency list to collect all related nodes */
   std::vector<mitk::DataNode::ConstPointer> resultset;
   std::vector<mitk::DataNode::ConstPointer> openlist;
+  /* nodes that are in resultset or openlist */
+  std::set<const mitk::DataNode *> visited;
 
   /* Initialize openlist with node. this will add node to resultset,
      but that is necessary to detect circular relations that would lead to endless recursion */
   openlist.push_back(node);
+  visited.insert(node);
 
   while (openlist.size() > 0)
   {
@@ -205,11 +279,8 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRe
            ++parentIt) // for each parent of current node
       {
         mitk::DataNode::ConstPointer p = parentIt.Value().GetPointer();
-        if (!(std::find(resultset.cbegin(), resultset.cend(), p) !=
-              resultset.end()) // if it is not already in resultset
-            &&
-            !(std::find(openlist.cbegin(), openlist.cend(), p) != openlist.cend())) // and not already in openlist
-          openlist.push_back(p); // then add it to openlist, so that it can be processed
+        if (visited.insert(p).second) // if it is neither in resultset nor in openlist
+          openlist.push_back(p);      // then add it to openlist, so that it can be processed
       }
   }
 
@@ -251,6 +322,318 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetDe
   return this->GetRelations(node, m_DerivedNodes, condition, onlyDirectDerivations);
 }
 
+void mitk::StandaloneDataStorage::SetIndexEnabled(bool enabled)
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  if (m_IndexEnabled == enabled)
+    return;
+
+  m_IndexEnabled = enabled;
+
+  for (auto it = m_SourceNodes.cbegin(); it != m_SourceNodes.cend(); ++it)
+  {
+    if (enabled)
+      this->AddToIndex(it->first);
+    else
+      this->RemoveFromIndex(it->first);
+  }
+}
+
+bool mitk::StandaloneDataStorage::GetIndexEnabled() const
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  return m_IndexEnabled;
+}
+
+void mitk::StandaloneDataStorage::AddToIndex(const mitk::DataNode *node)
+{
+  if (node == nullptr || m_IndexEntries.find(node) != m_IndexEntries.end())
+    return;
+
+  auto modifiedCommand = itk::MemberCommand<StandaloneDataStorage>::New();
+  modifiedCommand->SetCallbackFunction(this, &StandaloneDataStorage::OnIndexedNodeModified);
+
+  IndexEntry &entry = m_IndexEntries[node];
+  entry.ModifiedObserverTag = const_cast<DataNode *>(node)->AddObserver(itk::ModifiedEvent(), modifiedCommand);
+
+  this->UpdateIndex(node);
+}
+
+void mitk::StandaloneDataStorage::RemoveFromIndex(const mitk::DataNode *node)
+{
+  auto entryIt = m_IndexEntries.find(node);
+  if (entryIt == m_IndexEntries.end())
+    return;
+
+  IndexEntry &entry = entryIt->second;
+  const_cast<DataNode *>(node)->RemoveObserver(entry.ModifiedObserverTag);
+
+  if (entry.NameProperty.IsNotNull())
+  {
+    const_cast<BaseProperty *>(entry.NameProperty.GetPointer())->RemoveObserver(entry.NamePropertyObserverTag);
+
+    auto propertyIt = m_NamePropertyNodes.find(entry.NameProperty);
+    if (propertyIt != m_NamePropertyNodes.end())
+    {
+      propertyIt->second.erase(node);
+      if (propertyIt->second.empty())
+        m_NamePropertyNodes.erase(propertyIt);
+    }
+  }
+
+  if (entry.HasName)
+    EraseFromIndex(m_NameIndex, entry.Name, node);
+  else
+    m_UnnamedNodes.erase(node);
+
+  if (!entry.DataType.empty())
+  {
+    EraseFromIndex(m_DataTypeIndex, entry.DataType, node);
+    EraseFromIndex(m_DataUIDIndex, entry.DataUID, node);
+  }
+
+  m_IndexEntries.erase(entryIt);
+}
+
+void mitk::StandaloneDataStorage::UpdateIndex(const mitk::DataNode *node)
+{
+  auto entryIt = m_IndexEntries.find(node);
+  if (entryIt == m_IndexEntries.end())
+    return;
+
+  IndexEntry &entry = entryIt->second;
+
+  // only the property of the node itself is observed, a name found in the properties of the data is not indexed
+  const BaseProperty *nameProperty = node->GetPropertyList()->GetProperty("name");
+  if (entry.NameProperty.GetPointer() != nameProperty)
+  {
+    if (entry.NameProperty.IsNotNull())
+    {
+      const_cast<BaseProperty *>(entry.NameProperty.GetPointer())->RemoveObserver(entry.NamePropertyObserverTag);
+
+      auto propertyIt = m_NamePropertyNodes.find(entry.NameProperty);
+      if (propertyIt != m_NamePropertyNodes.end())
+      {
+        propertyIt->second.erase(node);
+        if (propertyIt->second.empty())
+          m_NamePropertyNodes.erase(propertyIt);
+      }
+    }
+
+    entry.NameProperty = nameProperty;
+
+    if (nameProperty != nullptr)
+    {
+      // the value of a property may be changed without modifying the node
+      auto nameModifiedCommand = itk::MemberCommand<StandaloneDataStorage>::New();
+      nameModifiedCommand->SetCallbackFunction(this, &StandaloneDataStorage::OnNamePropertyModified);
+      entry.NamePropertyObserverTag =
+        const_cast<BaseProperty *>(nameProperty)->AddObserver(itk::ModifiedEvent(), nameModifiedCommand);
+      m_NamePropertyNodes[nameProperty].insert(node);
+    }
+  }
+
+  if (entry.HasName)
+    EraseFromIndex(m_NameIndex, entry.Name, node);
+  else
+    m_UnnamedNodes.erase(node);
+
+  const auto *nameStringProperty = dynamic_cast<const StringProperty *>(nameProperty);
+  entry.HasName = nameStringProperty != nullptr;
+  entry.Name = entry.HasName ? nameStringProperty->GetValue() : std::string();
+
+  if (entry.HasName)
+    m_NameIndex[entry.Name].insert(node);
+  else
+    m_UnnamedNodes.insert(node);
+
+  if (!entry.DataType.empty())
+  {
+    EraseFromIndex(m_DataTypeIndex, entry.DataType, node);
+    EraseFromIndex(m_DataUIDIndex, entry.DataUID, node);
+  }
+
+  // nodes without data fulfill neither data type nor data UID conditions
+  const BaseData *data = node->GetData();
+  entry.DataType = data != nullptr ? data->GetNameOfClass() : std::string();
+  entry.DataUID = data != nullptr ? data->GetUID() : std::string();
+
+  if (!entry.DataType.empty())
+  {
+    m_DataTypeIndex[entry.DataType].insert(node);
+    m_DataUIDIndex[entry.DataUID].insert(node);
+  }
+}
+
+void mitk::StandaloneDataStorage::RebuildDataUIDIndex() const
+{
+  m_DataUIDIndex.clear();
+
+  for (auto &entry : m_IndexEntries)
+  {
+    const BaseData *data = entry.first->GetData();
+    if (data == nullptr)
+      continue;
+
+    entry.second.DataUID = data->GetUID();
+    m_DataUIDIndex[entry.second.DataUID].insert(entry.first);
+  }
+}
+
+bool mitk::StandaloneDataStorage::CollectCandidates(const NodePredicateBase *condition, NodeSet &candidates) const
+{
+  if (const auto *propertyCondition = dynamic_cast<const NodePredicateProperty *>(condition))
+  {
+    if (propertyCondition->GetRenderer() != nullptr || propertyCondition->GetValidPropertyName() != "name")
+      return false;
+
+    const auto *name = dynamic_cast<const StringProperty *>(propertyCondition->GetValidProperty());
+    if (name == nullptr)
+      return false;
+
+    auto it = m_NameIndex.find(name->GetValue());
+    if (it != m_NameIndex.end())
+      candidates.insert(it->second.begin(), it->second.end());
+
+    candidates.insert(m_UnnamedNodes.begin(), m_UnnamedNodes.end());
+    return true;
+  }
+
+  if (const auto *dataTypeCondition = dynamic_cast<const NodePredicateDataType *>(condition))
+  {
+    auto it = m_DataTypeIndex.find(dataTypeCondition->GetValidDataType());
+    if (it != m_DataTypeIndex.end())
+      candidates.insert(it->second.begin(), it->second.end());
+
+    return true;
+  }
+
+  if (const auto *uidCondition = dynamic_cast<const NodePredicateDataUID *>(condition))
+  {
+    // UIDs are unique, so a bucket whose nodes still have the UID is complete
+    auto it = m_DataUIDIndex.find(uidCondition->GetUID());
+    bool upToDate = it != m_DataUIDIndex.end();
+
+    if (upToDate)
+    {
+      for (auto node : it->second)
+      {
+        const BaseData *data = node->GetData();
+        if (data == nullptr || data->GetUID() != uidCondition->GetUID())
+          upToDate = false;
+      }
+    }
+
+    if (!upToDate)
+    {
+      this->RebuildDataUIDIndex();
+      it = m_DataUIDIndex.find(uidCondition->GetUID());
+    }
+
+    if (it != m_DataUIDIndex.end())
+      candidates.insert(it->second.begin(), it->second.end());
+
+    return true;
+  }
+
+  if (const auto *andCondition = dynamic_cast<const NodePredicateAnd *>(condition))
+  {
+    // the candidates of any indexed child suffice, the intersection of all of them is the smallest
+    bool indexed = false;
+    NodeSet intersection;
+
+    for (const auto &child : andCondition->GetPredicates())
+    {
+      NodeSet childCandidates;
+      if (!this->CollectCandidates(child, childCandidates))
+        continue;
+
+      if (!indexed)
+      {
+        intersection.swap(childCandidates);
+        indexed = true;
+      }
+      else
+      {
+        NodeSet remaining;
+        std::set_intersection(intersection.begin(),
+                              intersection.end(),
+                              childCandidates.begin(),
+                              childCandidates.end(),
+                              std::inserter(remaining, remaining.end()));
+        intersection.swap(remaining);
+      }
+    }
+
+    if (indexed)
+      candidates.insert(intersection.begin(), intersection.end());
+
+    return indexed;
+  }
+
+  if (const auto *orCondition = dynamic_cast<const NodePredicateOr *>(condition))
+  {
+    // every child has to be indexed
+    const auto children = orCondition->GetPredicates();
+    if (children.empty())
+      return false;
+
+    NodeSet unification;
+    for (const auto &child : children)
+    {
+      if (!this->CollectCandidates(child, unification))
+        return false;
+    }
+
+    candidates.insert(unification.begin(), unification.end());
+    return true;
+  }
+
+  return false;
+}
+
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSubsetCandidates(
+  const NodePredicateBase *condition) const
+{
+  if (condition == nullptr)
+    return nullptr;
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  if (!m_IndexEnabled)
+    return nullptr;
+
+  NodeSet candidates;
+  if (!this->CollectCandidates(condition, candidates))
+    return nullptr;
+
+  /* the set is ordered like the adjacency list, so the candidates are in the order of GetAll() */
+  mitk::DataStorage::SetOfObjects::Pointer result = mitk::DataStorage::SetOfObjects::New();
+  for (auto node : candidates)
+    result->InsertElement(result->Size(), const_cast<mitk::DataNode *>(node));
+
+  return SetOfObjects::ConstPointer(result);
+}
+
+void mitk::StandaloneDataStorage::OnIndexedNodeModified(const itk::Object *caller, const itk::EventObject &)
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  this->UpdateIndex(dynamic_cast<const DataNode *>(caller));
+}
+
+void mitk::StandaloneDataStorage::OnNamePropertyModified(const itk::Object *caller, const itk::EventObject &)
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+
+  auto it = m_NamePropertyNodes.find(dynamic_cast<const BaseProperty *>(caller));
+  if (it == m_NamePropertyNodes.end())
+    return;
+
+  // updating may remove the node from the set
+  const NodeSet nodes = it->second;
+  for (auto node : nodes)
+    this->UpdateIndex(node);
+}
+
 void mitk::StandaloneDataStorage::PrintSelf(std::ostream &os, itk::Indent indent) const
 {
   os << indent << "StandaloneDataStorage:\n";
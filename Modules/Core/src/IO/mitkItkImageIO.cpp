@@ -20,15 +20,23 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
+#include <mitkMemoryMappedFile.h>
 #include <mitkUIDManipulator.h>
 
+#include <itkByteSwapper.h>
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
+#include <itksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
 namespace mitk
 {
@@ -38,6 +46,265 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
   const char* const PROPERTY_KEY_UID = "org_mitk_uid";
 
+  namespace
+  {
+    bool IsNativeByteOrder(bool isBigEndian)
+    {
+      return itk::ByteSwapper<short>::SystemIsBigEndian() == isBigEndian;
+    }
+
+    std::string TrimmedString(const std::string &str)
+    {
+      const auto first = str.find_first_not_of(" \t\r");
+      if (std::string::npos == first)
+        return std::string();
+      const auto last = str.find_last_not_of(" \t\r");
+      return str.substr(first, last - first + 1);
+    }
+
+    std::string LowerCaseString(std::string str)
+    {
+      std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+      return str;
+    }
+
+    /** Returns whether the NRRD kinds of all axes but the first one are domain kinds, i.e. whether the layout of
+     * the data matches the one of the image read by ITK, which makes a range (e.g. vector) axis the fastest.*/
+    bool HasLeadingRangeAxisOnly(const std::string &kinds)
+    {
+      std::istringstream stream(kinds);
+      std::string kind;
+
+      for (unsigned int axis = 0; stream >> kind; ++axis)
+      {
+        // unknown kinds are domain axes for teem as well
+        const bool isDomain = "domain" == kind || "space" == kind || "time" == kind || "???" == kind || "none" == kind;
+
+        if (axis > 0 && !isDomain)
+          return false;
+      }
+
+      return true;
+    }
+
+    /** Parses the header of an NRRD file with attached, raw encoded data.
+     * Returns false if the data cannot be mapped as it is, e.g. because a range axis is not the first axis.*/
+    bool DetermineNrrdRawDataOffset(const std::string &path, size_t &offset)
+    {
+      std::ifstream stream(path.c_str(), std::ios::binary);
+      std::string line;
+
+      if (!std::getline(stream, line) || line.compare(0, 4, "NRRD") != 0)
+        return false;
+
+      bool isRaw = false;
+      bool isBigEndian = itk::ByteSwapper<short>::SystemIsBigEndian();
+
+      while (std::getline(stream, line))
+      {
+        line = TrimmedString(line);
+
+        if (line.empty())
+        { // end of header, data is attached directly after the empty line
+          if (!isRaw || !IsNativeByteOrder(isBigEndian))
+            return false;
+          offset = static_cast<size_t>(stream.tellg());
+          return true;
+        }
+
+        if ('#' == line[0])
+          continue;
+
+        const auto separator = line.find(':');
+        if (std::string::npos == separator)
+          continue;
+
+        const auto field = LowerCaseString(TrimmedString(line.substr(0, separator)));
+        auto value = line.substr(separator + 1);
+        if (!value.empty() && '=' == value[0])
+          continue; // key/value pair, e.g. meta data
+        value = LowerCaseString(TrimmedString(value));
+
+        if ("encoding" == field)
+        {
+          isRaw = "raw" == value;
+        }
+        else if ("endian" == field)
+        {
+          isBigEndian = "big" == value;
+        }
+        else if ("kinds" == field)
+        {
+          if (!HasLeadingRangeAxisOnly(value))
+            return false;
+        }
+        else if ("data file" == field || "datafile" == field || "line skip" == field || "lineskip" == field ||
+                 "byte skip" == field || "byteskip" == field)
+        {
+          return false;
+        }
+      }
+
+      return false;
+    }
+
+    /** Parses the header of a MetaImage file. Supports uncompressed data that is either attached
+     * (ElementDataFile = LOCAL) or stored in a single separate file. Returns false if the data
+     * cannot be mapped as it is.*/
+    bool DetermineMetaImageRawDataOffset(const std::string &path, std::string &dataPath, size_t &offset)
+    {
+      std::ifstream stream(path.c_str(), std::ios::binary);
+      std::string line;
+
+      bool isBigEndian = false;
+      size_t headerSize = 0;
+
+      while (std::getline(stream, line))
+      {
+        const auto separator = line.find('=');
+        if (std::string::npos == separator)
+          return false;
+
+        const auto key = LowerCaseString(TrimmedString(line.substr(0, separator)));
+        const auto value = TrimmedString(line.substr(separator + 1));
+
+        if ("compresseddata" == key)
+        {
+          if ("true" == LowerCaseString(value))
+            return false;
+        }
+        else if ("binarydatabyteordermsb" == key || "elementbyteordermsb" == key)
+        {
+          isBigEndian = "true" == LowerCaseString(value);
+        }
+        else if ("headersize" == key)
+        {
+          const auto size = std::stol(value);
+          if (size < 0)
+            return false; // data is located at the end of the file, ITK computes the offset on its own
+          headerSize = static_cast<size_t>(size);
+        }
+        else if ("elementdatafile" == key)
+        {
+          if (!IsNativeByteOrder(isBigEndian))
+            return false;
+
+          if ("LOCAL" == value)
+          {
+            dataPath = path;
+            offset = static_cast<size_t>(stream.tellg()) + headerSize;
+            return true;
+          }
+
+          if ("LIST" == value || std::string::npos != value.find(' ') || std::string::npos != value.find('%'))
+            return false; // data is distributed over several files
+
+          dataPath = itksys::SystemTools::CollapseFullPath(value, itksys::SystemTools::GetFilenamePath(path));
+          offset = headerSize;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /** Parses the header of a single file NIfTI-1 image (n+1). Returns false if the data
+     * cannot be mapped as it is (foreign byte order, intensity scaling or vector data).*/
+    bool DetermineNiftiRawDataOffset(const std::string &path, size_t &offset)
+    {
+      std::ifstream stream(path.c_str(), std::ios::binary);
+      char header[348];
+
+      if (!stream.read(header, sizeof(header)))
+        return false;
+
+      std::int32_t sizeOfHeader;
+      std::memcpy(&sizeOfHeader, header, sizeof(sizeOfHeader));
+      if (348 != sizeOfHeader)
+        return false; // either no NIfTI-1 header or foreign byte order
+
+      if (0 != std::strncmp(header + 344, "n+1", 4))
+        return false;
+
+      std::int16_t dim[8];
+      std::memcpy(dim, header + 40, sizeof(dim));
+      if (dim[0] > 4)
+        return false;
+
+      float voxOffset, sclSlope, sclInter;
+      std::memcpy(&voxOffset, header + 108, sizeof(float));
+      std::memcpy(&sclSlope, header + 112, sizeof(float));
+      std::memcpy(&sclInter, header + 116, sizeof(float));
+
+      if ((0.0f != sclSlope && 1.0f != sclSlope) || 0.0f != sclInter || voxOffset < 348.0f)
+        return false;
+
+      offset = static_cast<size_t>(voxOffset);
+      return true;
+    }
+
+    /** Tries to map the pixel data of the file read by the passed ImageIO into memory.
+     * Returns nullptr if the data cannot be mapped as it is, e.g. because it is compressed.*/
+    MemoryMappedFile::Pointer MapImageData(const std::string &path, itk::ImageIOBase *imageIO)
+    {
+      const std::string imageIOName = imageIO->GetNameOfClass();
+      std::string dataPath = path;
+      size_t offset = 0;
+      bool mappable = false;
+
+      try
+      {
+        if ("NrrdImageIO" == imageIOName)
+        {
+          mappable = DetermineNrrdRawDataOffset(path, offset);
+        }
+        else if ("MetaImageIO" == imageIOName)
+        {
+          mappable = DetermineMetaImageRawDataOffset(path, dataPath, offset);
+        }
+        else if ("NiftiImageIO" == imageIOName)
+        {
+          mappable = DetermineNiftiRawDataOffset(path, offset);
+        }
+      }
+      catch (const std::exception &e)
+      {
+        MITK_DEBUG << "Cannot parse header of " << path << ": " << e.what();
+        mappable = false;
+      }
+
+      const size_t size = imageIO->GetImageSizeInBytes();
+
+      // Misaligned pixel data would violate the alignment requirements of the component type.
+      if (!mappable || 0 != offset % imageIO->GetComponentSize() ||
+          offset + size > MemoryMappedFile::GetFileSize(dataPath))
+      {
+        MITK_DEBUG << "Pixel data of " << path << " cannot be memory mapped. Falling back to regular reading.";
+        return nullptr;
+      }
+
+      auto mappedFile = MemoryMappedFile::New();
+
+      try
+      {
+        mappedFile->Map(dataPath, offset, size);
+      }
+      catch (const mitk::Exception &e)
+      {
+        MITK_WARN << e.GetDescription() << ". Falling back to regular reading.";
+        return nullptr;
+      }
+
+      return mappedFile;
+    }
+  }
+
+  std::string ItkImageIO::OPTION_MEMORY_MAPPED_READING()
+  {
+    static std::string s = "Memory mapped reading";
+    return s;
+  }
+
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
     : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
   {
@@ -122,6 +389,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     std::vector<std::string> readExtensions = m_ImageIO->GetSupportedReadExtensions();
 
@@ -207,6 +475,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     if (rank)
     {
@@ -326,11 +595,32 @@ namespace mitk
 
     MITK_INFO << "ioRegion: " << ioRegion << std::endl;
     m_ImageIO->SetIORegion(ioRegion);
-    void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
-    m_ImageIO->Read(buffer);
 
-    image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    MemoryMappedFile::Pointer mappedFile;
+    if (m_ImageIO->GetNumberOfDimensions() == ndim &&
+        us::any_cast<bool>(this->GetReaderOption(OPTION_MEMORY_MAPPED_READING())))
+    {
+      mappedFile = MapImageData(path, m_ImageIO);
+    }
+
+    void *buffer = nullptr;
+
+    if (mappedFile.IsNotNull())
+    {
+      MITK_INFO << "memory mapped pixel data of " << path;
+      buffer = mappedFile->GetData();
+      image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
+      image->SetImportChannel(buffer, 0, Image::ReferenceMemory);
+      image->GetChannelData(0)->SetMemoryOwner(mappedFile);
+    }
+    else
+    {
+      buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
+      m_ImageIO->Read(buffer);
+
+      image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary &dictionary = m_ImageIO->GetMetaDataDictionary();
 
@@ -713,6 +1003,13 @@ namespace mitk
   }
 
   ItkImageIO *ItkImageIO::IOClone() const { return new ItkImageIO(*this); }
+  void ItkImageIO::InitializeDefaultReaderOptions()
+  {
+    Options defaultOptions;
+    defaultOptions[OPTION_MEMORY_MAPPED_READING()] = us::Any(false);
+    this->SetDefaultReaderOptions(defaultOptions);
+  }
+
   void ItkImageIO::InitializeDefaultMetaDataKeys()
   {
     this->m_DefaultMetaDataKeys.push_back("NRRD.space");
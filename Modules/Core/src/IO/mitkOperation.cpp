@@ -24,3 +24,13 @@ mitk::OperationType mitk::Operation::GetOperationType()
 {
   return m_OperationType;
 }
+
+std::size_t mitk::Operation::GetMemoryUsage() const
+{
+  return sizeof(Operation);
+}
+
+bool mitk::Operation::IsMemoryUsagePending() const
+{
+  return false;
+}
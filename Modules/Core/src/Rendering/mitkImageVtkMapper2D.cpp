@@ -13,6 +13,7 @@ found in the LICENSE file.
 // MITK
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImageSliceSelector.h>
 #include <mitkLevelWindowProperty.h>
 #include <mitkLookupTableProperty.h>
@@ -20,6 +21,7 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkRenderingManager.h>
 #include <mitkResliceMethodProperty.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 
@@ -45,16 +47,226 @@ found in the LICENSE file.
 #include <vtkImageReslice.h>
 #include <vtkLookupTable.h>
 #include <vtkMatrix4x4.h>
+#include <vtkPiecewiseFunction.h>
 #include <vtkPlaneSource.h>
 #include <vtkPoints.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkProperty.h>
+#include <vtkRenderWindow.h>
 #include <vtkTransform.h>
 
 // ITK
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+// STL
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  /** Worker threads shared by all mappers which generate their slices asynchronously. The tasks are
+      executed in the order they have been queued; queued tasks are discarded on exit. */
+  class SliceWorkerPool
+  {
+  public:
+    static SliceWorkerPool &GetInstance()
+    {
+      static SliceWorkerPool pool;
+      return pool;
+    }
+
+    void Enqueue(std::function<void()> task)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Tasks.push_back(std::move(task));
+      }
+      m_Condition.notify_one();
+    }
+
+  private:
+    SliceWorkerPool() : m_Stop(false)
+    {
+      // half of the hardware threads are left to the application and to the rendering
+      const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+      const unsigned int numberOfThreads = std::max(1u, hardwareThreads / 2);
+
+      for (unsigned int i = 0; i < numberOfThreads; ++i)
+        m_Threads.emplace_back(&SliceWorkerPool::Run, this);
+    }
+
+    ~SliceWorkerPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+        m_Tasks.clear();
+      }
+      m_Condition.notify_all();
+
+      for (auto &thread : m_Threads)
+        thread.join();
+    }
+
+    void Run()
+    {
+      while (true)
+      {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(m_Mutex);
+          m_Condition.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+
+          if (m_Stop)
+            return;
+
+          task = std::move(m_Tasks.front());
+          m_Tasks.pop_front();
+        }
+        task();
+      }
+    }
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<std::function<void()>> m_Tasks;
+    std::vector<std::thread> m_Threads;
+    bool m_Stop;
+  };
+
+  /** Executes a configured reslicer and, if thick slices are enabled, the thick slices filter. */
+  vtkImageData *ExecuteReslicer(mitk::ExtractSliceFilter *reslicer,
+                                vtkMitkThickSlicesFilter *thickSlicesFilter,
+                                int thickSlicesMode)
+  {
+    if (thickSlicesMode > 0)
+    {
+      // Do the reslicing. Modified() is called to make sure that the reslicer is
+      // executed even though the input geometry information did not change; this
+      // is necessary when the input /em data, but not the /em geometry changes.
+      thickSlicesFilter->SetThickSliceMode(thickSlicesMode - 1);
+      thickSlicesFilter->SetInputData(reslicer->GetVtkOutput());
+
+      // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
+      reslicer->Modified();
+      reslicer->Update();
+
+      thickSlicesFilter->Modified();
+      thickSlicesFilter->Update();
+      return thickSlicesFilter->GetOutput();
+    }
+
+    reslicer->Modified();
+    // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
+    reslicer->UpdateLargestPossibleRegion();
+    return reslicer->GetVtkOutput();
+  }
+}
+
+/** A slice which is generated on a worker thread. Everything the worker uses is owned by the job, so that
+    the GUI thread may go on modifying the data node, the world geometry and its own pipeline. */
+struct mitk::ImageVtkMapper2D::AsyncSliceJob
+{
+  /** Set by the GUI thread when the slice is superseded. The worker checks it between its stages. */
+  std::atomic<bool> Canceled{false};
+  /** Set by the worker when the slice can be displayed. */
+  std::atomic<bool> Finished{false};
+
+  /** The image is kept alive while its volume is referenced by #Volume. */
+  Image::ConstPointer InputImage;
+  Image::ImageDataItemPointer VolumeData;
+  /** Single time step image referencing the memory of #VolumeData, so that the pipeline of the
+      input image is not updated by the worker. */
+  Image::Pointer Volume;
+  BaseGeometry::Pointer VolumeGeometry;
+  PlaneGeometry::Pointer WorldGeometry;
+
+  ExtractSliceFilter::Pointer Reslicer;
+  int ThickSlicesMode = 0;
+  vtkSmartPointer<vtkMitkThickSlicesFilter> ThickSlicesFilter;
+  /** The component of vector images to display, -1 for single component images. */
+  int DisplayedComponent = -1;
+  vtkSmartPointer<vtkImageExtractComponents> VectorComponentExtractor;
+  vtkSmartPointer<vtkMitkLevelWindowFilter> LevelWindowFilter;
+  /** Copies of the lookup table and the opacity function, which the level window filter does not own. */
+  vtkSmartPointer<vtkScalarsToColors> LookupTable;
+  vtkSmartPointer<vtkPiecewiseFunction> OpacityFunction;
+
+  vtkSmartPointer<vtkImageData> ReslicedImage;
+  vtkSmartPointer<vtkImageData> Texture;
+
+  RenderingManager::Pointer RenderingManager;
+  vtkRenderWindow *RenderWindow = nullptr;
+
+  void Execute();
+};
+
+void mitk::ImageVtkMapper2D::AsyncSliceJob::Execute()
+{
+  if (Canceled)
+    return;
+
+  try
+  {
+    {
+      // a writer has to wait until the volume is resliced, but not the GUI thread
+      ImageReadAccessor accessor(InputImage, VolumeData);
+      Volume->SetImportVolume(const_cast<void *>(accessor.GetData()), 0, 0, Image::ReferenceMemory);
+      ReslicedImage = ExecuteReslicer(Reslicer, ThickSlicesFilter, ThickSlicesMode);
+    }
+
+    if (Canceled)
+      return;
+
+    // calculate minimum bounding rect of IMAGE in texture
+    double textureClippingBounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    mitk::PlaneClipping::CalculateClippedPlaneBounds(VolumeGeometry, WorldGeometry, textureClippingBounds);
+
+    const ScalarType *mmPerPixel = Reslicer->GetOutputSpacing();
+    textureClippingBounds[0] = static_cast<int>(textureClippingBounds[0] / mmPerPixel[0] + 0.5);
+    textureClippingBounds[1] = static_cast<int>(textureClippingBounds[1] / mmPerPixel[0] + 0.5);
+    textureClippingBounds[2] = static_cast<int>(textureClippingBounds[2] / mmPerPixel[1] + 0.5);
+    textureClippingBounds[3] = static_cast<int>(textureClippingBounds[3] / mmPerPixel[1] + 0.5);
+    LevelWindowFilter->SetClippingBounds(textureClippingBounds);
+
+    if (DisplayedComponent >= 0)
+    {
+      VectorComponentExtractor->SetComponents(DisplayedComponent);
+      VectorComponentExtractor->SetInputData(ReslicedImage);
+      LevelWindowFilter->SetInputConnection(VectorComponentExtractor->GetOutputPort(0));
+    }
+    else
+    {
+      LevelWindowFilter->SetInputData(ReslicedImage);
+    }
+
+    LevelWindowFilter->Update();
+    Texture = LevelWindowFilter->GetOutput();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Asynchronous generation of an image slice failed: " << e.what();
+    return;
+  }
+  catch (...)
+  {
+    MITK_ERROR << "Asynchronous generation of an image slice failed with an unknown error.";
+    return;
+  }
+
+  if (Canceled)
+    return;
+
+  Finished = true;
+  RenderingManager->RequestUpdateFromWorkerThread(RenderWindow);
+}
+
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
 {
 }
@@ -134,8 +346,6 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   image->Update();
 
-  localStorage->m_PublicActors = localStorage->m_Actors.Get();
-
   // early out if there is no intersection of the current rendering geometry
   // and the geometry of the image that is to be rendered.
   if (!RenderingGeometryIntersectsImage(worldGeometry, image->GetSlicedGeometry()))
@@ -144,140 +354,38 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     return;
   }
 
-  // set main input for ExtractSliceFilter
-  localStorage->m_Reslicer->SetInput(image);
-  localStorage->m_Reslicer->SetWorldGeometry(worldGeometry);
-  localStorage->m_Reslicer->SetTimeStep(this->GetTimestep());
-
-  // set the transformation of the image to adapt reslice axis
-  localStorage->m_Reslicer->SetResliceTransformByGeometry(
-    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
-
-  // is the geometry of the slice based on the input image or the worldgeometry?
-  bool inPlaneResampleExtentByGeometry = false;
-  datanode->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
-  localStorage->m_Reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
-
-  // Initialize the interpolation mode for resampling; switch to nearest
-  // neighbor if the input image is too small.
-  if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
-  {
-    VtkResliceInterpolationProperty *resliceInterpolationProperty;
-    datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation", renderer);
-
-    int interpolationMode = VTK_RESLICE_NEAREST;
-    if (resliceInterpolationProperty != nullptr)
-    {
-      interpolationMode = resliceInterpolationProperty->GetInterpolation();
-    }
-
-    switch (interpolationMode)
-    {
-      case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-        break;
-      case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
-        break;
-      case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
-        break;
-    }
-  }
-  else
-  {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-  }
+  const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
-  // set the vtk output property to true, makes sure that no unneeded mitk image convertion
-  // is done.
-  localStorage->m_Reslicer->SetVtkOutputRequest(true);
+  bool binary = false;
+  bool binaryOutline = false;
+  datanode->GetBoolProperty("binary", binary, renderer);
+  datanode->GetBoolProperty("outline binary", binaryOutline, renderer);
 
-  // Thickslicing
-  int thickSlicesMode = 0;
-  int thickSlicesNum = 1;
-  // Thick slices parameters
-  if (image->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
+  // the outline of binary images is generated from the resliced image, which is not done asynchronously
+  bool asynchronous = false;
+  datanode->GetBoolProperty("Image Rendering.Asynchronous", asynchronous, renderer);
+  if (asynchronous && !(binary && binaryOutline))
   {
-    DataNode *dn = renderer->GetCurrentWorldPlaneGeometryNode();
-    if (dn)
-    {
-      ResliceMethodProperty *resliceMethodEnumProperty = nullptr;
-
-      if (dn->GetProperty(resliceMethodEnumProperty, "reslice.thickslices", renderer) && resliceMethodEnumProperty)
-        thickSlicesMode = resliceMethodEnumProperty->GetValueAsId();
-
-      IntProperty *intProperty = nullptr;
-      if (dn->GetProperty(intProperty, "reslice.thickslices.num", renderer) && intProperty)
-      {
-        thickSlicesNum = intProperty->GetValue();
-        if (thickSlicesNum < 1)
-          thickSlicesNum = 1;
-      }
-    }
-    else
-    {
-      MITK_WARN << "no associated widget plane data tree node found";
-    }
+    this->StartAsyncSlice(renderer, image, worldGeometry);
+    return;
   }
 
-  const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
-
-  if (thickSlicesMode > 0)
-  {
-    double dataZSpacing = 1.0;
-
-    Vector3D normInIndex, normal;
-
-    const auto *abstractGeometry =
-      dynamic_cast<const AbstractTransformGeometry *>(worldGeometry);
-    if (abstractGeometry != nullptr)
-      normal = abstractGeometry->GetPlane()->GetNormal();
-    else
-    {
-      if (planeGeometry != nullptr)
-      {
-        normal = planeGeometry->GetNormal();
-      }
-      else
-        return; // no fitting geometry set
-    }
-    normal.Normalize();
-
-    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep())->WorldToIndex(normal, normInIndex);
+  // a slice which is still generated would replace this one
+  this->CancelAsyncSlice(localStorage);
 
-    dataZSpacing = 1.0 / normInIndex.GetNorm();
-
-    localStorage->m_Reslicer->SetOutputDimensionality(3);
-    localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+  localStorage->m_PublicActors = localStorage->m_Actors.Get();
 
-    // Do the reslicing. Modified() is called to make sure that the reslicer is
-    // executed even though the input geometry information did not change; this
-    // is necessary when the input /em data, but not the /em geometry changes.
-    localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
-    localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
+  const BaseGeometry *imageGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep());
+  const int thickSlicesMode =
+    this->ConfigureReslicer(renderer, localStorage->m_Reslicer, image, this->GetTimestep(), worldGeometry, imageGeometry);
+  if (thickSlicesMode < 0)
+    return; // no fitting geometry set
 
-    // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
-    localStorage->m_Reslicer->Modified();
-    localStorage->m_Reslicer->Update();
+  // the reslicer does not reference the volume of a former asynchronous slice anymore
+  localStorage->m_ReslicerVolumeData = nullptr;
 
-    localStorage->m_TSFilter->Modified();
-    localStorage->m_TSFilter->Update();
-    localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
-  }
-  else
-  {
-    // this is needed when thick mode was enable bevore. These variable have to be reset to default values
-    localStorage->m_Reslicer->SetOutputDimensionality(2);
-    localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
-
-    localStorage->m_Reslicer->Modified();
-    // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
-    localStorage->m_Reslicer->UpdateLargestPossibleRegion();
-    localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
-  }
+  localStorage->m_ReslicedImage =
+    ExecuteReslicer(localStorage->m_Reslicer, localStorage->m_TSFilter, thickSlicesMode);
 
   // Bounds information for reslicing (only reuqired if reference geometry
   // is present)
@@ -315,13 +423,8 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   // get the number of scalar components to distinguish between different image types
   int numberOfComponents = localStorage->m_ReslicedImage->GetNumberOfScalarComponents();
-  // get the binary property
-  bool binary = false;
-  bool binaryOutline = false;
-  datanode->GetBoolProperty("binary", binary, renderer);
   if (binary) // binary image
   {
-    datanode->GetBoolProperty("outline binary", binaryOutline, renderer);
     if (binaryOutline) // contour rendering
     {
       // get pixel type of vtk image
@@ -428,6 +531,251 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   localStorage->m_LastUpdateTime.Modified();
 }
 
+int mitk::ImageVtkMapper2D::ConfigureReslicer(mitk::BaseRenderer *renderer,
+                                              ExtractSliceFilter *reslicer,
+                                              Image *input,
+                                              int timeStep,
+                                              const PlaneGeometry *worldGeometry,
+                                              const BaseGeometry *imageGeometry)
+{
+  mitk::DataNode *datanode = this->GetDataNode();
+
+  // set main input for ExtractSliceFilter
+  reslicer->SetInput(input);
+  reslicer->SetWorldGeometry(worldGeometry);
+  reslicer->SetTimeStep(timeStep);
+
+  // set the transformation of the image to adapt reslice axis
+  reslicer->SetResliceTransformByGeometry(imageGeometry);
+
+  // is the geometry of the slice based on the input image or the worldgeometry?
+  bool inPlaneResampleExtentByGeometry = false;
+  datanode->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
+  reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
+
+  // Initialize the interpolation mode for resampling; switch to nearest
+  // neighbor if the input image is too small.
+  if ((input->GetDimension() >= 3) && (input->GetDimension(2) > 1))
+  {
+    VtkResliceInterpolationProperty *resliceInterpolationProperty;
+    datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation", renderer);
+
+    int interpolationMode = VTK_RESLICE_NEAREST;
+    if (resliceInterpolationProperty != nullptr)
+    {
+      interpolationMode = resliceInterpolationProperty->GetInterpolation();
+    }
+
+    switch (interpolationMode)
+    {
+      case VTK_RESLICE_NEAREST:
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+        break;
+      case VTK_RESLICE_LINEAR:
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+        break;
+      case VTK_RESLICE_CUBIC:
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+        break;
+    }
+  }
+  else
+  {
+    reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+  }
+
+  // set the vtk output property to true, makes sure that no unneeded mitk image convertion
+  // is done.
+  reslicer->SetVtkOutputRequest(true);
+
+  // Thickslicing
+  int thickSlicesMode = 0;
+  int thickSlicesNum = 1;
+  // Thick slices parameters
+  if (input->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
+  {
+    DataNode *dn = renderer->GetCurrentWorldPlaneGeometryNode();
+    if (dn)
+    {
+      ResliceMethodProperty *resliceMethodEnumProperty = nullptr;
+
+      if (dn->GetProperty(resliceMethodEnumProperty, "reslice.thickslices", renderer) && resliceMethodEnumProperty)
+        thickSlicesMode = resliceMethodEnumProperty->GetValueAsId();
+
+      IntProperty *intProperty = nullptr;
+      if (dn->GetProperty(intProperty, "reslice.thickslices.num", renderer) && intProperty)
+      {
+        thickSlicesNum = intProperty->GetValue();
+        if (thickSlicesNum < 1)
+          thickSlicesNum = 1;
+      }
+    }
+    else
+    {
+      MITK_WARN << "no associated widget plane data tree node found";
+    }
+  }
+
+  if (thickSlicesMode > 0)
+  {
+    double dataZSpacing = 1.0;
+
+    Vector3D normInIndex, normal;
+
+    const auto *abstractGeometry =
+      dynamic_cast<const AbstractTransformGeometry *>(worldGeometry);
+    if (abstractGeometry != nullptr)
+      normal = abstractGeometry->GetPlane()->GetNormal();
+    else
+    {
+      if (worldGeometry != nullptr)
+      {
+        normal = worldGeometry->GetNormal();
+      }
+      else
+        return -1; // no fitting geometry set
+    }
+    normal.Normalize();
+
+    imageGeometry->WorldToIndex(normal, normInIndex);
+
+    dataZSpacing = 1.0 / normInIndex.GetNorm();
+
+    reslicer->SetOutputDimensionality(3);
+    reslicer->SetOutputSpacingZDirection(dataZSpacing);
+    reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+  }
+  else
+  {
+    // this is needed when thick mode was enable bevore. These variable have to be reset to default values
+    reslicer->SetOutputDimensionality(2);
+    reslicer->SetOutputSpacingZDirection(1.0);
+    reslicer->SetOutputExtentZDirection(0, 0);
+  }
+
+  return thickSlicesMode;
+}
+
+void mitk::ImageVtkMapper2D::StartAsyncSlice(mitk::BaseRenderer *renderer,
+                                             Image *image,
+                                             const PlaneGeometry *worldGeometry)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  mitk::DataNode *datanode = this->GetDataNode();
+
+  // drop the slice of the previous position if it has not been displayed yet, e.g. while scrolling
+  this->CancelAsyncSlice(localStorage);
+
+  const int timeStep = this->GetTimestep();
+
+  auto job = std::make_shared<AsyncSliceJob>();
+  job->InputImage = image;
+  job->VolumeData = image->GetVolumeData(timeStep);
+  if (job->VolumeData.IsNull())
+  {
+    this->SetToInvalidState(localStorage);
+    return;
+  }
+
+  // everything the worker reads is copied, so that the GUI thread may change it in the meantime
+  job->VolumeGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(timeStep)->Clone();
+  job->WorldGeometry = worldGeometry->Clone();
+  job->Volume = Image::New();
+  job->Volume->Initialize(image->GetPixelType(), *job->VolumeGeometry);
+
+  job->Reslicer = ExtractSliceFilter::New();
+  job->ThickSlicesMode =
+    this->ConfigureReslicer(renderer, job->Reslicer, job->Volume, 0, job->WorldGeometry, job->VolumeGeometry);
+  if (job->ThickSlicesMode < 0)
+    return; // no fitting geometry set
+
+  job->ThickSlicesFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+
+  int displayedComponent = 0;
+  if (datanode->GetIntProperty("Image.Displayed Component", displayedComponent, renderer) &&
+      image->GetPixelType().GetNumberOfComponents() > 1)
+  {
+    job->DisplayedComponent = displayedComponent;
+    job->VectorComponentExtractor = vtkSmartPointer<vtkImageExtractComponents>::New();
+  }
+
+  // configure the level window filter of the job like the one of the synchronous rendering
+  this->ApplyRenderingMode(renderer);
+  vtkMitkLevelWindowFilter *levelWindowFilter = localStorage->m_LevelWindowFilter;
+  job->LevelWindowFilter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+  job->LevelWindowFilter->SetMinOpacity(levelWindowFilter->GetMinOpacity());
+  job->LevelWindowFilter->SetMaxOpacity(levelWindowFilter->GetMaxOpacity());
+
+  // the lookup table and the transfer function belong to the properties, so they are copied as well
+  if (levelWindowFilter->GetLookupTable() != nullptr)
+  {
+    auto lookupTable = vtkSmartPointer<vtkScalarsToColors>::Take(levelWindowFilter->GetLookupTable()->NewInstance());
+    lookupTable->DeepCopy(levelWindowFilter->GetLookupTable());
+    job->LevelWindowFilter->SetLookupTable(lookupTable);
+    job->LookupTable = lookupTable;
+  }
+
+  if (levelWindowFilter->GetOpacityPiecewiseFunction() != nullptr)
+  {
+    auto opacityFunction = vtkSmartPointer<vtkPiecewiseFunction>::New();
+    opacityFunction->DeepCopy(levelWindowFilter->GetOpacityPiecewiseFunction());
+    job->LevelWindowFilter->SetOpacityPiecewiseFunction(opacityFunction);
+    job->OpacityFunction = opacityFunction;
+  }
+
+  job->RenderingManager = renderer->GetRenderingManager();
+  job->RenderWindow = renderer->GetRenderWindow();
+
+  localStorage->m_PendingSlice = job;
+  SliceWorkerPool::GetInstance().Enqueue([job]() { job->Execute(); });
+}
+
+void mitk::ImageVtkMapper2D::FinishAsyncSlice(mitk::BaseRenderer *renderer)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  std::shared_ptr<AsyncSliceJob> job = std::move(localStorage->m_PendingSlice);
+
+  // the reslicer of the job provides the geometry of the displayed slice from now on. Its input references
+  // the memory of the volume data item, which therefore has to live as long as the reslicer.
+  localStorage->m_Reslicer = job->Reslicer;
+  localStorage->m_ReslicerVolumeData = job->VolumeData;
+  localStorage->m_ReslicedImage = job->ReslicedImage;
+  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
+  localStorage->m_PublicActors = localStorage->m_Actors.Get();
+
+  double sliceBounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
+
+  this->ApplyOpacity(renderer);
+  this->ApplyColor(renderer);
+
+  // the level window has already been applied by the worker
+  localStorage->m_Texture->SetColorModeToDirectScalars();
+
+  bool textureInterpolation = false;
+  this->GetDataNode()->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+  localStorage->m_Texture->SetInterpolate(textureInterpolation);
+  localStorage->m_Texture->SetInputData(job->Texture);
+
+  this->TransformActor(renderer);
+
+  this->GeneratePlane(renderer, sliceBounds);
+  localStorage->m_Mapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+  localStorage->m_ImageActor->SetTexture(localStorage->m_Texture);
+  localStorage->m_ShadowOutlineActor->SetVisibility(false);
+
+  localStorage->m_LastUpdateTime.Modified();
+}
+
+void mitk::ImageVtkMapper2D::CancelAsyncSlice(LocalStorage *localStorage)
+{
+  if (localStorage->m_PendingSlice != nullptr)
+  {
+    localStorage->m_PendingSlice->Canceled = true;
+    localStorage->m_PendingSlice = nullptr;
+  }
+}
+
 void mitk::ImageVtkMapper2D::ApplyLevelWindow(mitk::BaseRenderer *renderer)
 {
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
@@ -619,6 +967,7 @@ void mitk::ImageVtkMapper2D::ApplyColorTransferFunction(mitk::BaseRenderer *rend
 
 void mitk::ImageVtkMapper2D::SetToInvalidState(mitk::ImageVtkMapper2D::LocalStorage* localStorage)
 {
+  this->CancelAsyncSlice(localStorage);
   localStorage->m_PublicActors = localStorage->m_EmptyActors.Get();
   // set image to nullptr, to clear the texture in 3D, because
   // the latest image is used there if the plane is out of the geometry
@@ -657,6 +1006,12 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
     return;
   }
 
+  // display an asynchronously generated slice once it is ready
+  if (localStorage->m_PendingSlice != nullptr && localStorage->m_PendingSlice->Finished)
+  {
+    this->FinishAsyncSlice(renderer);
+  }
+
   const DataNode *node = this->GetDataNode();
   data->UpdateOutputInformation();
 
@@ -1071,6 +1426,8 @@ bool mitk::ImageVtkMapper2D::RenderingGeometryIntersectsImage(const PlaneGeometr
 
 mitk::ImageVtkMapper2D::LocalStorage::~LocalStorage()
 {
+  if (m_PendingSlice != nullptr)
+    m_PendingSlice->Canceled = true;
 }
 
 mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
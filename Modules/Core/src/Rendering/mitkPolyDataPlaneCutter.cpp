@@ -0,0 +1,336 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPolyDataPlaneCutter.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <vtkCellData.h>
+#include <vtkCutter.h>
+#include <vtkIdList.h>
+#include <vtkPlane.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  /** Maximal number of cells in a leaf of the hierarchy. */
+  const std::size_t LeafSize = 16;
+
+  /** Whether an axis aligned box intersects the plane n * x = d, given as {n, d}. */
+  bool BoundsIntersectPlane(const float bounds[6], const double plane[4], double tolerance)
+  {
+    double distance = -plane[3];
+    double radius = 0.0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      distance += plane[i] * 0.5 * (bounds[2 * i] + bounds[2 * i + 1]);
+      radius += std::abs(plane[i]) * 0.5 * (bounds[2 * i + 1] - bounds[2 * i]);
+    }
+
+    return std::abs(distance) <= radius + tolerance;
+  }
+}
+
+mitk::PolyDataPlaneCutter::PolyDataPlaneCutter()
+  : m_Cutter(vtkSmartPointer<vtkCutter>::New()),
+    m_CuttingPlane(vtkSmartPointer<vtkPlane>::New()),
+    m_IndexTime(0),
+    m_Tolerance(0.0f),
+    m_ContourCacheSize(16),
+    m_NumberOfCandidateCells(0)
+{
+  m_Cutter->SetCutFunction(m_CuttingPlane);
+}
+
+mitk::PolyDataPlaneCutter::~PolyDataPlaneCutter()
+{
+}
+
+void mitk::PolyDataPlaneCutter::SetInput(vtkPolyData *input)
+{
+  if (m_Input == input)
+    return;
+
+  m_Input = input;
+  m_IndexTime = 0;
+  m_Nodes.clear();
+  m_ContourCache.clear();
+  this->Modified();
+}
+
+vtkPolyData *mitk::PolyDataPlaneCutter::GetInput() const
+{
+  return m_Input;
+}
+
+void mitk::PolyDataPlaneCutter::SetContourCacheSize(unsigned int size)
+{
+  if (m_ContourCacheSize == size)
+    return;
+
+  m_ContourCacheSize = size;
+
+  while (m_ContourCache.size() > m_ContourCacheSize)
+    m_ContourCache.pop_back();
+
+  this->Modified();
+}
+
+vtkSmartPointer<vtkPolyData> mitk::PolyDataPlaneCutter::Cut(const Point3D &origin, const Vector3D &normal)
+{
+  if (m_Input.GetPointer() == nullptr)
+    mitkThrow() << "PolyDataPlaneCutter: No input set.";
+
+  if (m_Input->GetMTime() != m_IndexTime)
+    this->BuildIndex();
+
+  Vector3D unitNormal = normal;
+  unitNormal.Normalize();
+
+  double plane[4];
+  for (int i = 0; i < 3; ++i)
+    plane[i] = unitNormal[i];
+  plane[3] = unitNormal[0] * origin[0] + unitNormal[1] * origin[1] + unitNormal[2] * origin[2];
+
+  for (auto it = m_ContourCache.begin(); it != m_ContourCache.end(); ++it)
+  {
+    if (std::equal(plane, plane + 4, it->Plane))
+    {
+      // move the hit to the front, the back of the list is evicted first
+      m_ContourCache.splice(m_ContourCache.begin(), m_ContourCache, it);
+      return m_ContourCache.front().Contour;
+    }
+  }
+
+  std::vector<vtkIdType> candidates;
+  this->CollectCandidateCells(plane, candidates);
+  m_NumberOfCandidateCells = static_cast<vtkIdType>(candidates.size());
+
+  m_CuttingPlane->SetOrigin(origin[0], origin[1], origin[2]);
+  m_CuttingPlane->SetNormal(plane[0], plane[1], plane[2]);
+  m_Cutter->SetInputData(this->ExtractCells(candidates));
+  m_Cutter->Update();
+
+  // the cutter allocates new arrays on every execution, so a shallow copy stays valid
+  auto contour = vtkSmartPointer<vtkPolyData>::New();
+  contour->ShallowCopy(m_Cutter->GetOutput());
+  m_Cutter->SetInputData(nullptr);
+
+  if (m_ContourCacheSize > 0)
+  {
+    CachedContour cachedContour;
+    std::copy(plane, plane + 4, cachedContour.Plane);
+    cachedContour.Contour = contour;
+    m_ContourCache.push_front(cachedContour);
+
+    if (m_ContourCache.size() > m_ContourCacheSize)
+      m_ContourCache.pop_back();
+  }
+
+  return contour;
+}
+
+void mitk::PolyDataPlaneCutter::BuildIndex()
+{
+  m_Nodes.clear();
+  m_ContourCache.clear();
+
+  const vtkIdType numberOfCells = m_Input->GetNumberOfCells();
+
+  m_CellIds.resize(numberOfCells);
+  m_CellBounds.resize(6 * numberOfCells);
+  std::vector<float> centers(3 * numberOfCells);
+
+  double bounds[6];
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    m_Input->GetCellBounds(cellId, bounds);
+
+    for (int i = 0; i < 3; ++i)
+    {
+      // round outwards, so that the bounds still enclose the cell
+      m_CellBounds[6 * cellId + 2 * i] =
+        std::nextafter(static_cast<float>(bounds[2 * i]), -std::numeric_limits<float>::max());
+      m_CellBounds[6 * cellId + 2 * i + 1] =
+        std::nextafter(static_cast<float>(bounds[2 * i + 1]), std::numeric_limits<float>::max());
+      centers[3 * cellId + i] = static_cast<float>(0.5 * (bounds[2 * i] + bounds[2 * i + 1]));
+    }
+
+    m_CellIds[cellId] = cellId;
+  }
+
+  // cells which only touch the plane are passed to the cutter as well
+  m_Input->GetBounds(bounds);
+  m_Tolerance = static_cast<float>(1e-6 * std::sqrt((bounds[1] - bounds[0]) * (bounds[1] - bounds[0]) +
+                                                    (bounds[3] - bounds[2]) * (bounds[3] - bounds[2]) +
+                                                    (bounds[5] - bounds[4]) * (bounds[5] - bounds[4])));
+
+  if (numberOfCells > 0)
+    this->BuildNode(0, static_cast<std::size_t>(numberOfCells), centers);
+
+  m_PointMap.assign(m_Input->GetNumberOfPoints(), -1);
+  m_IndexTime = m_Input->GetMTime();
+}
+
+int mitk::PolyDataPlaneCutter::BuildNode(std::size_t first, std::size_t count, const std::vector<float> &centers)
+{
+  const int nodeIndex = static_cast<int>(m_Nodes.size());
+  m_Nodes.push_back(Node());
+
+  Node node;
+  node.First = first;
+  node.Count = count;
+  node.Left = -1;
+  node.Right = -1;
+
+  float centerBounds[6];
+  for (int i = 0; i < 3; ++i)
+  {
+    node.Bounds[2 * i] = std::numeric_limits<float>::max();
+    node.Bounds[2 * i + 1] = -std::numeric_limits<float>::max();
+    centerBounds[2 * i] = std::numeric_limits<float>::max();
+    centerBounds[2 * i + 1] = -std::numeric_limits<float>::max();
+  }
+
+  for (std::size_t c = first; c < first + count; ++c)
+  {
+    const vtkIdType cellId = m_CellIds[c];
+
+    for (int i = 0; i < 3; ++i)
+    {
+      node.Bounds[2 * i] = std::min(node.Bounds[2 * i], m_CellBounds[6 * cellId + 2 * i]);
+      node.Bounds[2 * i + 1] = std::max(node.Bounds[2 * i + 1], m_CellBounds[6 * cellId + 2 * i + 1]);
+      centerBounds[2 * i] = std::min(centerBounds[2 * i], centers[3 * cellId + i]);
+      centerBounds[2 * i + 1] = std::max(centerBounds[2 * i + 1], centers[3 * cellId + i]);
+    }
+  }
+
+  if (count > LeafSize)
+  {
+    // split at the median of the cell centers along the axis of their largest extent
+    int axis = 0;
+    for (int i = 1; i < 3; ++i)
+    {
+      if (centerBounds[2 * i + 1] - centerBounds[2 * i] > centerBounds[2 * axis + 1] - centerBounds[2 * axis])
+        axis = i;
+    }
+
+    const std::size_t half = count / 2;
+    std::nth_element(m_CellIds.begin() + first,
+                     m_CellIds.begin() + first + half,
+                     m_CellIds.begin() + first + count,
+                     [&centers, axis](vtkIdType a, vtkIdType b) {
+                       return centers[3 * a + axis] < centers[3 * b + axis];
+                     });
+
+    node.Left = this->BuildNode(first, half, centers);
+    node.Right = this->BuildNode(first + half, count - half, centers);
+  }
+
+  m_Nodes[nodeIndex] = node;
+  return nodeIndex;
+}
+
+void mitk::PolyDataPlaneCutter::CollectCandidateCells(const double plane[4], std::vector<vtkIdType> &candidates) const
+{
+  if (m_Nodes.empty())
+    return;
+
+  std::vector<int> stack(1, 0);
+
+  while (!stack.empty())
+  {
+    const Node &node = m_Nodes[stack.back()];
+    stack.pop_back();
+
+    if (!BoundsIntersectPlane(node.Bounds, plane, m_Tolerance))
+      continue;
+
+    if (node.Left >= 0)
+    {
+      stack.push_back(node.Left);
+      stack.push_back(node.Right);
+      continue;
+    }
+
+    for (std::size_t c = node.First; c < node.First + node.Count; ++c)
+    {
+      const vtkIdType cellId = m_CellIds[c];
+
+      if (BoundsIntersectPlane(&m_CellBounds[6 * cellId], plane, m_Tolerance))
+        candidates.push_back(cellId);
+    }
+  }
+
+  // keep the order of the input cells, so that the contour is independent of the hierarchy
+  std::sort(candidates.begin(), candidates.end());
+}
+
+vtkSmartPointer<vtkPolyData> mitk::PolyDataPlaneCutter::ExtractCells(const std::vector<vtkIdType> &cellIds)
+{
+  auto cells = vtkSmartPointer<vtkPolyData>::New();
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  if (m_Input->GetPoints() != nullptr)
+    points->SetDataType(m_Input->GetPoints()->GetDataType());
+  cells->SetPoints(points);
+  cells->AllocateEstimate(static_cast<vtkIdType>(cellIds.size()), 3);
+
+  vtkPointData *inputPointData = m_Input->GetPointData();
+  vtkPointData *pointData = cells->GetPointData();
+  pointData->CopyAllocate(inputPointData, static_cast<vtkIdType>(cellIds.size()));
+
+  vtkCellData *inputCellData = m_Input->GetCellData();
+  vtkCellData *cellData = cells->GetCellData();
+  cellData->CopyAllocate(inputCellData, static_cast<vtkIdType>(cellIds.size()));
+
+  std::vector<vtkIdType> extractedPointIds;
+  auto inputCellPointIds = vtkSmartPointer<vtkIdList>::New();
+  auto cellPointIds = vtkSmartPointer<vtkIdList>::New();
+
+  for (auto cellId : cellIds)
+  {
+    m_Input->GetCellPoints(cellId, inputCellPointIds);
+    const vtkIdType numberOfCellPoints = inputCellPointIds->GetNumberOfIds();
+    cellPointIds->SetNumberOfIds(numberOfCellPoints);
+
+    for (vtkIdType i = 0; i < numberOfCellPoints; ++i)
+    {
+      const vtkIdType inputPointId = inputCellPointIds->GetId(i);
+      vtkIdType &pointId = m_PointMap[inputPointId];
+
+      if (pointId < 0)
+      {
+        pointId = points->InsertNextPoint(m_Input->GetPoint(inputPointId));
+        pointData->CopyData(inputPointData, inputPointId, pointId);
+        extractedPointIds.push_back(inputPointId);
+      }
+
+      cellPointIds->SetId(i, pointId);
+    }
+
+    const vtkIdType extractedCellId = cells->InsertNextCell(m_Input->GetCellType(cellId), cellPointIds);
+    cellData->CopyData(inputCellData, cellId, extractedCellId);
+  }
+
+  // reset only the entries that were used instead of the whole map
+  for (auto inputPointId : extractedPointIds)
+    m_PointMap[inputPointId] = -1;
+
+  return cells;
+}
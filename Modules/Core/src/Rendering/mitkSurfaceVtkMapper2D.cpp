@@ -28,10 +28,8 @@ found in the LICENSE file.
 #include <vtkActor.h>
 #include <vtkArrowSource.h>
 #include <vtkAssembly.h>
-#include <vtkCutter.h>
 #include <vtkGlyph3D.h>
 #include <vtkLookupTable.h>
-#include <vtkPlane.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkReverseSense.h>
@@ -45,10 +43,8 @@ mitk::SurfaceVtkMapper2D::LocalStorage::LocalStorage()
   m_Actor = vtkSmartPointer<vtkActor>::New();
   m_PropAssembly = vtkSmartPointer<vtkAssembly>::New();
   m_PropAssembly->AddPart(m_Actor);
-  m_CuttingPlane = vtkSmartPointer<vtkPlane>::New();
-  m_Cutter = vtkSmartPointer<vtkCutter>::New();
-  m_Cutter->SetCutFunction(m_CuttingPlane);
-  m_Mapper->SetInputConnection(m_Cutter->GetOutputPort());
+  m_Contour = vtkSmartPointer<vtkPolyData>::New();
+  m_Mapper->SetInputData(m_Contour);
 
   m_NormalGlyph = vtkSmartPointer<vtkGlyph3D>::New();
 
@@ -100,6 +96,7 @@ const mitk::Surface *mitk::SurfaceVtkMapper2D::GetInput() const
 
 // constructor PointSetVtkMapper2D
 mitk::SurfaceVtkMapper2D::SurfaceVtkMapper2D()
+  : m_TransformFilter(vtkSmartPointer<vtkTransformPolyDataFilter>::New()), m_PlaneCutter(PolyDataPlaneCutter::New())
 {
 }
 
@@ -198,32 +195,24 @@ void mitk::SurfaceVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   if (localStorage->m_Actor->GetMapper() == nullptr)
     localStorage->m_Actor->SetMapper(localStorage->m_Mapper);
 
-  double origin[3];
-  origin[0] = planeGeometry->GetOrigin()[0];
-  origin[1] = planeGeometry->GetOrigin()[1];
-  origin[2] = planeGeometry->GetOrigin()[2];
-
-  double normal[3];
-  normal[0] = planeGeometry->GetNormal()[0];
-  normal[1] = planeGeometry->GetNormal()[1];
-  normal[2] = planeGeometry->GetNormal()[2];
-
-  localStorage->m_CuttingPlane->SetOrigin(origin);
-  localStorage->m_CuttingPlane->SetNormal(normal);
   // Transform the data according to its geometry.
   // See UpdateVtkTransform documentation for details.
+  // The filter only executes again if the data or the transform have been modified, in which case
+  // the cutter rebuilds its index on the next cut.
   vtkSmartPointer<vtkLinearTransform> vtktransform = GetDataNode()->GetVtkTransform(this->GetTimestep());
-  vtkSmartPointer<vtkTransformPolyDataFilter> filter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-  filter->SetTransform(vtktransform);
-  filter->SetInputData(inputPolyData);
-  localStorage->m_Cutter->SetInputConnection(filter->GetOutputPort());
-  localStorage->m_Cutter->Update();
+  m_TransformFilter->SetTransform(vtktransform);
+  m_TransformFilter->SetInputData(inputPolyData);
+  m_TransformFilter->Update();
+
+  m_PlaneCutter->SetInput(m_TransformFilter->GetOutput());
+  localStorage->m_Contour = m_PlaneCutter->Cut(planeGeometry->GetOrigin(), planeGeometry->GetNormal());
+  localStorage->m_Mapper->SetInputData(localStorage->m_Contour);
 
   bool generateNormals = false;
   node->GetBoolProperty("draw normals 2D", generateNormals);
   if (generateNormals)
   {
-    localStorage->m_NormalGlyph->SetInputConnection(localStorage->m_Cutter->GetOutputPort());
+    localStorage->m_NormalGlyph->SetInputData(localStorage->m_Contour);
     localStorage->m_NormalGlyph->Update();
 
     localStorage->m_NormalMapper->SetInputConnection(localStorage->m_NormalGlyph->GetOutputPort());
@@ -240,7 +229,7 @@ void mitk::SurfaceVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   node->GetBoolProperty("invert normals", generateInverseNormals);
   if (generateInverseNormals)
   {
-    localStorage->m_ReverseSense->SetInputConnection(localStorage->m_Cutter->GetOutputPort());
+    localStorage->m_ReverseSense->SetInputData(localStorage->m_Contour);
     localStorage->m_ReverseSense->ReverseCellsOff();
     localStorage->m_ReverseSense->ReverseNormalsOn();
 
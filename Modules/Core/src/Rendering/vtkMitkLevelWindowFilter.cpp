@@ -558,7 +558,7 @@ void vtkMitkLevelWindowFilter::SetMinOpacity(double minOpacity)
   m_MinOpacity = minOpacity;
 }
 
-inline double vtkMitkLevelWindowFilter::GetMinOpacity() const
+double vtkMitkLevelWindowFilter::GetMinOpacity() const
 {
   return m_MinOpacity;
 }
@@ -568,7 +568,7 @@ void vtkMitkLevelWindowFilter::SetMaxOpacity(double maxOpacity)
   m_MaxOpacity = maxOpacity;
 }
 
-inline double vtkMitkLevelWindowFilter::GetMaxOpacity() const
+double vtkMitkLevelWindowFilter::GetMaxOpacity() const
 {
   return m_MaxOpacity;
 }
@@ -542,6 +542,46 @@ void TestDataStorage(mitk::DataStorage *ds, std::string filename)
       mitk::NodePredicateDataType::Pointer p(mitk::NodePredicateDataType::New("PointSet"));
       MITK_TEST_CONDITION(ds->GetNode(p) == nullptr, "Checking GetNode with invalid predicate");
     }
+
+    /* Checking named node method after renaming */
+    {
+      mitk::StringProperty *name = dynamic_cast<mitk::StringProperty *>(n2->GetProperty("name"));
+      name->SetValue("Renamed Surface Node");
+      MITK_TEST_CONDITION(ds->GetNamedNode("Renamed Surface Node") == n2 &&
+                            ds->GetNamedNode("Node 2 - Surface Node") == nullptr,
+                          "Checking named node method after changing the value of the name property");
+
+      n2->SetProperty("name", mitk::StringProperty::New("Node 2 - Surface Node"));
+      MITK_TEST_CONDITION(ds->GetNamedNode("Node 2 - Surface Node") == n2 &&
+                            ds->GetNamedNode("Renamed Surface Node") == nullptr,
+                          "Checking named node method after replacing the name property");
+    }
+
+    /* Checking combined predicates on name and data type */
+    {
+      mitk::NodePredicateAnd::Pointer p = mitk::NodePredicateAnd::New(
+        mitk::NodePredicateDataType::New("Surface"),
+        mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("Node 2 - Surface Node")));
+      MITK_TEST_CONDITION(ds->GetNode(p) == n2, "Checking GetNode with conjunction of name and data type");
+
+      mitk::NodePredicateOr::Pointer q = mitk::NodePredicateOr::New(
+        mitk::NodePredicateDataType::New("Image"),
+        mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("Node 5")));
+      const mitk::DataStorage::SetOfObjects::ConstPointer all = ds->GetSubset(q);
+      MITK_TEST_CONDITION(all->Size() == 2 && std::find(all->begin(), all->end(), n1) != all->end() &&
+                            std::find(all->begin(), all->end(), n5) != all->end(),
+                          "Checking GetSubset with disjunction of name and data type");
+    }
+
+    /* Checking data type predicate after exchanging the data */
+    {
+      n5->SetData(mitk::Surface::New());
+      mitk::NodePredicateDataType::Pointer p = mitk::NodePredicateDataType::New("Surface");
+      MITK_TEST_CONDITION(ds->GetSubset(p)->Size() == 2, "Checking data type predicate after setting data");
+
+      n5->SetData(nullptr);
+      MITK_TEST_CONDITION(ds->GetSubset(p)->Size() == 1, "Checking data type predicate after removing data");
+    }
   } // object retrieval methods
   catch (...)
   {
@@ -0,0 +1,136 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkExtractSliceFilter2.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageReadAccessor.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+/** Extracts axis-aligned slices from a volume whose voxel values are a linear function of their index,
+ *  so that nearest neighbor and linear interpolation results are known exactly. */
+class mitkExtractSliceFilter2TestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2TestSuite);
+  MITK_TEST(ExtractAlignedSlice_NearestNeighbor_ReproducesVoxels);
+  MITK_TEST(ExtractShiftedSlice_Linear_InterpolatesVoxels);
+  MITK_TEST(ChangeOutputGeometry_RegeneratesSlice);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<float, 3> ItkImageType;
+
+  static const unsigned int Size = 8;
+
+  mitk::Image::Pointer m_Image;
+  mitk::ExtractSliceFilter2::Pointer m_Filter;
+
+  static float VoxelValue(double x, double y, double z) { return static_cast<float>(x + 10 * y + 100 * z); }
+
+  static mitk::PlaneGeometry::Pointer CreateAxialPlane(unsigned int width, double x, double z)
+  {
+    mitk::Vector3D right;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+
+    mitk::Vector3D down;
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(width, Size, right, down);
+
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, x, 0.0, z);
+    plane->SetOrigin(origin);
+    plane->SetImageGeometry(true);
+
+    return plane;
+  }
+
+  void CheckSlice(const mitk::Image *slice, unsigned int width, double x, double z)
+  {
+    CPPUNIT_ASSERT(slice != nullptr);
+
+    mitk::ImageReadAccessor accessor(slice);
+    const auto *data = static_cast<const float *>(accessor.GetData());
+
+    for (unsigned int j = 0; j < Size; ++j)
+    {
+      for (unsigned int i = 0; i < width; ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(VoxelValue(x + i, j, z), data[j * width + i], mitk::eps);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    auto itkImage = ItkImageType::New();
+    ItkImageType::SizeType size;
+    size.Fill(Size);
+    itkImage->SetRegions(ItkImageType::RegionType(size));
+    itkImage->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<ItkImageType> it(itkImage, itkImage->GetLargestPossibleRegion());
+
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      auto index = it.GetIndex();
+      it.Set(VoxelValue(index[0], index[1], index[2]));
+    }
+
+    m_Image = mitk::GrabItkImageMemory(itkImage);
+    m_Filter = mitk::ExtractSliceFilter2::New();
+    m_Filter->SetInput(m_Image);
+  }
+
+  void tearDown() override
+  {
+    m_Filter = nullptr;
+    m_Image = nullptr;
+  }
+
+  void ExtractAlignedSlice_NearestNeighbor_ReproducesVoxels()
+  {
+    m_Filter->SetInterpolator(mitk::ExtractSliceFilter2::NearestNeighbor);
+    m_Filter->SetOutputGeometry(CreateAxialPlane(Size, 0.0, 3.0));
+    m_Filter->Update();
+
+    CheckSlice(m_Filter->GetOutput(), Size, 0.0, 3.0);
+  }
+
+  void ExtractShiftedSlice_Linear_InterpolatesVoxels()
+  {
+    m_Filter->SetInterpolator(mitk::ExtractSliceFilter2::Linear);
+    m_Filter->SetOutputGeometry(CreateAxialPlane(Size - 1, 0.5, 2.0));
+    m_Filter->Update();
+
+    CheckSlice(m_Filter->GetOutput(), Size - 1, 0.5, 2.0);
+  }
+
+  void ChangeOutputGeometry_RegeneratesSlice()
+  {
+    m_Filter->SetInterpolator(mitk::ExtractSliceFilter2::NearestNeighbor);
+
+    for (unsigned int z = 0; z < Size; ++z)
+    {
+      m_Filter->SetOutputGeometry(CreateAxialPlane(Size, 0.0, z));
+      m_Filter->Update();
+
+      CheckSlice(m_Filter->GetOutput(), Size, 0.0, z);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2)
@@ -0,0 +1,188 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+
+/** Looks up the data items of one image from several threads. Materialized items are found without
+ *  waiting for other threads and items that are still being materialized are never returned. */
+class mitkImageAccessorContentionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageAccessorContentionTestSuite);
+  MITK_TEST(ConcurrentSliceLookup_ReturnsSameItems);
+  MITK_TEST(ExistingDataLookup_WhileReadAccessorIsHeld_Succeeds);
+  MITK_TEST(ConcurrentVolumeMaterialization_ReturnsCompleteItems);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  unsigned int m_NumberOfThreads;
+
+  static const unsigned int NumberOfMaterializations = 20;
+
+  template <typename TFunction>
+  void RunConcurrently(TFunction function)
+  {
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 0; i < m_NumberOfThreads; ++i)
+      threads.emplace_back(function, i);
+
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  /** Creates an image whose slices are set separately, each filled with its index + 1 */
+  static mitk::Image::Pointer CreateImageFromSlices()
+  {
+    auto image = mitk::Image::New();
+    std::array<unsigned int, 3> dimensions = {{32, 32, 32}};
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions.data());
+
+    std::vector<short> slice(dimensions[0] * dimensions[1]);
+    for (unsigned int s = 0; s < dimensions[2]; ++s)
+    {
+      std::fill(slice.begin(), slice.end(), static_cast<short>(s + 1));
+      image->SetSlice(slice.data(), s);
+    }
+
+    return image;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    mitk::PixelType pixelType = mitk::MakeScalarPixelType<short>();
+
+    std::array<unsigned int, 3> dimensions = {{ 64, 64, 64 }};
+    m_Image->Initialize(pixelType, 3, dimensions.data());
+
+    // materialize the channel, so that only the lookup paths are used
+    m_Image->GetChannelData();
+
+    m_NumberOfThreads = std::min(8u, std::max(2u, std::thread::hardware_concurrency()));
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void ConcurrentSliceLookup_ReturnsSameItems()
+  {
+    const unsigned int numberOfSlices = m_Image->GetDimension(2);
+    std::vector<mitk::ImageDataItem *> items(numberOfSlices * m_NumberOfThreads, nullptr);
+
+    RunConcurrently([&](unsigned int threadId) {
+      for (unsigned int s = 0; s < numberOfSlices; ++s)
+        items[threadId * numberOfSlices + s] = m_Image->GetSliceData(s).GetPointer();
+    });
+
+    for (unsigned int s = 0; s < numberOfSlices; ++s)
+    {
+      CPPUNIT_ASSERT(items[s] != nullptr);
+      for (unsigned int i = 1; i < m_NumberOfThreads; ++i)
+        CPPUNIT_ASSERT_EQUAL(items[s], items[i * numberOfSlices + s]);
+    }
+  }
+
+  void ExistingDataLookup_WhileReadAccessorIsHeld_Succeeds()
+  {
+    mitk::ImageDataItem::Pointer channel = m_Image->GetChannelData();
+    mitk::ImageDataItem::Pointer volume = m_Image->GetVolumeData();
+    mitk::ImageDataItem::Pointer slice = m_Image->GetSliceData(5);
+
+    // another thread holds a read accessor until the lookups have finished
+    std::promise<void> accessed;
+    std::promise<void> released;
+    auto accessedFuture = accessed.get_future();
+    auto releasedFuture = released.get_future().share();
+    mitk::Image::Pointer image = m_Image;
+
+    std::thread reader([image, &accessed, releasedFuture]() {
+      mitk::ImageReadAccessor accessor(image);
+      accessed.set_value();
+      releasedFuture.wait();
+    });
+
+    accessedFuture.wait();
+
+    auto lookup = std::async(std::launch::async, [&]() {
+      return m_Image->GetChannelData() == channel && m_Image->GetVolumeData() == volume &&
+             m_Image->GetSliceData(5) == slice && m_Image->IsChannelSet() && m_Image->IsVolumeSet();
+    });
+
+    const bool finished = lookup.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+    released.set_value();
+    reader.join();
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that the lookups do not wait for the read accessor", finished);
+    CPPUNIT_ASSERT_MESSAGE("Testing that the lookups return the materialized items", lookup.get());
+  }
+
+  void ConcurrentVolumeMaterialization_ReturnsCompleteItems()
+  {
+    std::atomic<unsigned int> failures(0);
+
+    for (unsigned int i = 0; i < NumberOfMaterializations; ++i)
+    {
+      // the first thread to get the volume combines the slices while holding the image data arrays exclusively
+      auto image = CreateImageFromSlices();
+      std::vector<mitk::ImageDataItem *> items(m_NumberOfThreads, nullptr);
+
+      RunConcurrently([&](unsigned int threadId) {
+        mitk::ImageDataItem::Pointer volume = image->GetVolumeData();
+        items[threadId] = volume.GetPointer();
+
+        if (volume.IsNull() || !volume->IsComplete())
+        {
+          ++failures;
+          return;
+        }
+
+        mitk::ImageReadAccessor accessor(image, volume);
+        const auto *data = static_cast<const short *>(accessor.GetData());
+        const unsigned int sliceSize = image->GetDimension(0) * image->GetDimension(1);
+
+        for (unsigned int s = 0; s < image->GetDimension(2); ++s)
+        {
+          if (std::any_of(data + s * sliceSize, data + (s + 1) * sliceSize, [s](short value) {
+                return value != static_cast<short>(s + 1);
+              }))
+          {
+            ++failures;
+            return;
+          }
+        }
+      });
+
+      for (unsigned int threadId = 1; threadId < m_NumberOfThreads; ++threadId)
+        CPPUNIT_ASSERT_EQUAL(items[0], items[threadId]);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0u, failures.load());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageAccessorContention)
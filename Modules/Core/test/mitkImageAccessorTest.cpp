@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include "mitkImageReadAccessor.h"
 #include "mitkImageTimeSelector.h"
 #include "mitkImageWriteAccessor.h"
+#include <algorithm>
 #include <fstream>
 #include <itkMultiThreader.h>
 #include <itksys/SystemTools.hxx>
@@ -207,6 +208,42 @@ int mitkImageAccessorTest(int argc, char *argv[])
     MITK_TEST_CONDITION_REQUIRED(false, "Ignoring the lock mechanism leads to exception.");
   }
 
+  // sub region access
+  {
+    mitk::ImageAccessorBase::RegionType subRegion;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      unsigned int dimension = i < image->GetDimension() ? image->GetDimension(i) : 1;
+      subRegion.SetIndex(i, dimension / 2);
+      subRegion.SetSize(i, dimension - dimension / 2);
+    }
+
+    mitk::ImageReadAccessor wholeAccess(image);
+    mitk::ImageReadAccessor subAccess(image, subRegion, nullptr, mitk::ImageAccessorBase::ForceCoherentMemory);
+
+    const auto *whole = static_cast<const unsigned char *>(wholeAccess.GetData());
+    const auto *sub = static_cast<const unsigned char *>(subAccess.GetData());
+    const size_t pixelSize = subAccess.GetStride(0);
+
+    size_t firstOffset = 0;
+    size_t lastOffset = 0;
+    size_t subLastOffset = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      firstOffset += subRegion.GetIndex(i) * wholeAccess.GetStride(i);
+      lastOffset += (subRegion.GetIndex(i) + subRegion.GetSize(i) - 1) * wholeAccess.GetStride(i);
+      subLastOffset += (subRegion.GetSize(i) - 1) * subAccess.GetStride(i);
+    }
+
+    MITK_TEST_CONDITION(subAccess.HasSubRegion() && !wholeAccess.HasSubRegion(), "Testing HasSubRegion()");
+    MITK_TEST_CONDITION(std::equal(sub, sub + pixelSize, whole + firstOffset), "Testing first pixel of sub region");
+    MITK_TEST_CONDITION(std::equal(sub + subLastOffset, sub + subLastOffset + pixelSize, whole + lastOffset),
+                        "Testing last pixel of sub region");
+
+    subRegion.SetSize(0, image->GetDimension(0) + 1);
+    MITK_TEST_FOR_EXCEPTION(mitk::Exception, mitk::ImageReadAccessor invalid(image, subRegion));
+  }
+
   // CREATE THREADS
 
   image->GetGeometry()->Initialize();
@@ -0,0 +1,216 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImageMemoryManager.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkStandaloneDataStorage.h>
+
+/** Evicts images with voxel values that depend on their index and checks that the values are restored. */
+class mitkImageMemoryManagerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageMemoryManagerTestSuite);
+  MITK_TEST(EvictImage_SpillToFile_RestoresDataOnAccess);
+  MITK_TEST(EvictImage_CompressInMemory_RestoresDataOnAccess);
+  MITK_TEST(EvictImage_WhileAccessed_Fails);
+  MITK_TEST(EvictImage_WhileRawPointerIsHeld_Fails);
+  MITK_TEST(EnforceMemoryBudget_EvictsHiddenImagesFirst);
+  MITK_TEST(AddNode_EnforcesMemoryBudgetAsynchronously);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int Size = 16;
+
+  mitk::ImageMemoryManager::Pointer m_Manager;
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+
+  static mitk::Image::Pointer CreateImage(unsigned short offset)
+  {
+    unsigned int dimensions[] = {Size, Size, Size};
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    auto *data = static_cast<unsigned short *>(accessor.GetData());
+
+    for (unsigned int i = 0; i < Size * Size * Size; ++i)
+      data[i] = static_cast<unsigned short>(i + offset);
+
+    return image;
+  }
+
+  static void CheckImage(mitk::Image *image, unsigned short offset)
+  {
+    mitk::ImageReadAccessor accessor(image);
+    const auto *data = static_cast<const unsigned short *>(accessor.GetData());
+
+    for (unsigned int i = 0; i < Size * Size * Size; ++i)
+      CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(i + offset), data[i]);
+  }
+
+  void CheckEviction(mitk::ImageMemoryManager::EvictionMode mode)
+  {
+    auto image = CreateImage(7);
+    const std::size_t size = Size * Size * Size * sizeof(unsigned short);
+    CPPUNIT_ASSERT_EQUAL(size, image->GetAllocatedDataSize());
+
+    m_Manager->SetEvictionMode(mode);
+    CPPUNIT_ASSERT(m_Manager->EvictImage(image));
+    CPPUNIT_ASSERT(image->IsDataEvicted());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), image->GetAllocatedDataSize());
+    CPPUNIT_ASSERT_MESSAGE("Testing that an evicted image is not evicted again", !m_Manager->EvictImage(image));
+
+    CheckImage(image, 7);
+    CPPUNIT_ASSERT(!image->IsDataEvicted());
+    CPPUNIT_ASSERT_EQUAL(size, image->GetAllocatedDataSize());
+  }
+
+public:
+  void setUp() override
+  {
+    m_Manager = mitk::ImageMemoryManager::New();
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+  }
+
+  void tearDown() override
+  {
+    m_Manager = nullptr;
+    m_DataStorage = nullptr;
+  }
+
+  void EvictImage_SpillToFile_RestoresDataOnAccess() { this->CheckEviction(mitk::ImageMemoryManager::SpillToFile); }
+
+  void EvictImage_CompressInMemory_RestoresDataOnAccess()
+  {
+    this->CheckEviction(mitk::ImageMemoryManager::CompressInMemory);
+  }
+
+  void EvictImage_WhileAccessed_Fails()
+  {
+    auto image = CreateImage(0);
+
+    {
+      mitk::ImageReadAccessor accessor(image);
+      CPPUNIT_ASSERT(!m_Manager->EvictImage(image));
+    }
+
+    {
+      // the volume keeps the memory alive
+      auto volume = image->GetVolumeData(0);
+      CPPUNIT_ASSERT(!m_Manager->EvictImage(image));
+    }
+
+    CPPUNIT_ASSERT(m_Manager->EvictImage(image));
+  }
+
+  void EvictImage_WhileRawPointerIsHeld_Fails()
+  {
+    auto image = CreateImage(3);
+    const auto *data = static_cast<const unsigned short *>(image->GetData());
+    CPPUNIT_ASSERT(!m_Manager->EvictImage(image));
+
+    // the data item of the volume is released, the raw pointer into its memory is not
+    auto volumeImage = CreateImage(4);
+    const auto *volumeData = static_cast<const unsigned short *>(volumeImage->GetVolumeData(0)->GetData());
+    CPPUNIT_ASSERT(!m_Manager->EvictImage(volumeImage));
+
+    auto node = mitk::DataNode::New();
+    node->SetData(image);
+    node->SetVisibility(false);
+    m_DataStorage->Add(node);
+
+    auto volumeNode = mitk::DataNode::New();
+    volumeNode->SetData(volumeImage);
+    volumeNode->SetVisibility(false);
+    m_DataStorage->Add(volumeNode);
+
+    m_Manager->AddDataStorage(m_DataStorage);
+    m_Manager->SetMemoryBudget(1);
+    m_Manager->WaitForMemoryBudgetEnforcement();
+
+    CPPUNIT_ASSERT(!image->IsDataEvicted());
+    CPPUNIT_ASSERT(!volumeImage->IsDataEvicted());
+
+    for (unsigned int i = 0; i < Size * Size * Size; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(i + 3), data[i]);
+      CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(i + 4), volumeData[i]);
+    }
+  }
+
+  void EnforceMemoryBudget_EvictsHiddenImagesFirst()
+  {
+    auto visibleImage = CreateImage(1);
+    auto hiddenImage = CreateImage(2);
+    const std::size_t size = visibleImage->GetAllocatedDataSize();
+
+    auto visibleNode = mitk::DataNode::New();
+    visibleNode->SetData(visibleImage);
+    m_DataStorage->Add(visibleNode);
+
+    auto hiddenNode = mitk::DataNode::New();
+    hiddenNode->SetData(hiddenImage);
+    hiddenNode->SetVisibility(false);
+    m_DataStorage->Add(hiddenNode);
+
+    // the hidden image has been accessed more recently
+    CheckImage(hiddenImage, 2);
+
+    m_Manager->AddDataStorage(m_DataStorage);
+    CPPUNIT_ASSERT_EQUAL(2 * size, m_Manager->GetResidentMemorySize());
+
+    m_Manager->SetMemoryBudget(size);
+    m_Manager->WaitForMemoryBudgetEnforcement();
+    CPPUNIT_ASSERT(hiddenImage->IsDataEvicted());
+    CPPUNIT_ASSERT(!visibleImage->IsDataEvicted());
+    CPPUNIT_ASSERT_EQUAL(size, m_Manager->GetResidentMemorySize());
+
+    CheckImage(hiddenImage, 2);
+    m_Manager->EnforceMemoryBudget();
+    CPPUNIT_ASSERT_MESSAGE("Testing that the hidden image is evicted again", hiddenImage->IsDataEvicted());
+    CPPUNIT_ASSERT(!visibleImage->IsDataEvicted());
+  }
+
+  void AddNode_EnforcesMemoryBudgetAsynchronously()
+  {
+    auto visibleImage = CreateImage(1);
+    auto hiddenImage = CreateImage(2);
+    const std::size_t size = visibleImage->GetAllocatedDataSize();
+
+    m_Manager->SetMemoryBudget(size);
+    m_Manager->AddDataStorage(m_DataStorage);
+
+    auto visibleNode = mitk::DataNode::New();
+    visibleNode->SetData(visibleImage);
+    m_DataStorage->Add(visibleNode);
+    m_Manager->WaitForMemoryBudgetEnforcement();
+    CPPUNIT_ASSERT_MESSAGE("Testing that an image within the budget is not evicted", !visibleImage->IsDataEvicted());
+
+    auto hiddenNode = mitk::DataNode::New();
+    hiddenNode->SetData(hiddenImage);
+    hiddenNode->SetVisibility(false);
+    m_DataStorage->Add(hiddenNode);
+    m_Manager->WaitForMemoryBudgetEnforcement();
+
+    CPPUNIT_ASSERT(hiddenImage->IsDataEvicted());
+    CPPUNIT_ASSERT(!visibleImage->IsDataEvicted());
+    CPPUNIT_ASSERT_EQUAL(size, m_Manager->GetResidentMemorySize());
+
+    CheckImage(hiddenImage, 2);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageMemoryManager)
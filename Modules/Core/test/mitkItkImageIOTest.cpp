@@ -18,8 +18,12 @@ found in the LICENSE file.
 #include "mitkIOUtil.h"
 #include "mitkITKImageImport.h"
 #include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkItkImageIO.h>
 
 #include "itksys/SystemTools.hxx"
+#include <itkByteSwapper.h>
 #include <itkImageRegionIterator.h>
 
 #include <fstream>
@@ -43,6 +47,8 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestMemoryMappedReading);
+  MITK_TEST(TestMemoryMappedReading_NonLeadingVectorAxis_FallsBack);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -325,6 +331,115 @@ public:
     // always end with this!
   }
 
+  /**
+  * Read an uncompressed NRRD file with and without memory mapping and check that both yield the same
+  * pixel data and that modifications of a mapped image do not reach the file.
+  */
+  void TestMemoryMappedReading()
+  {
+    const unsigned int size[3] = {64, 48, 5};
+    const unsigned int numberOfPixels = size[0] * size[1] * size[2];
+
+    std::vector<short> pixels(numberOfPixels);
+    for (unsigned int i = 0; i < numberOfPixels; ++i)
+      pixels[i] = static_cast<short>(i % 1000 - 500);
+
+    std::ofstream tmpStream;
+    const std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile(tmpStream, std::ios_base::out | std::ios_base::binary, "XXXXXX.nrrd");
+    tmpStream << "NRRD0004\n"
+              << "type: short\n"
+              << "dimension: 3\n"
+              << "space: left-posterior-superior\n"
+              << "sizes: " << size[0] << " " << size[1] << " " << size[2] << "\n"
+              << "space directions: (1,0,0) (0,1,0) (0,0,2.5)\n"
+              << "kinds: domain domain domain\n"
+              << "endian: " << (itk::ByteSwapper<short>::SystemIsBigEndian() ? "big" : "little") << "\n"
+              << "encoding: raw\n"
+              << "space origin: (0,0,0)\n"
+              << "\n";
+    tmpStream.write(reinterpret_cast<const char *>(pixels.data()), pixels.size() * sizeof(short));
+    tmpStream.close();
+
+    mitk::IFileReader::Options options;
+    options[mitk::ItkImageIO::OPTION_MEMORY_MAPPED_READING()] = us::Any(true);
+
+    auto readImage = mitk::IOUtil::Load<mitk::Image>(tmpFilePath);
+    auto mappedImage = mitk::IOUtil::Load<mitk::Image>(tmpFilePath, options);
+
+    CPPUNIT_ASSERT_MESSAGE("Image was read with memory mapping", mappedImage->GetChannelData(0)->GetMemoryOwner() != nullptr);
+    CPPUNIT_ASSERT_MESSAGE("Image was read without memory mapping", readImage->GetChannelData(0)->GetMemoryOwner() == nullptr);
+    CPPUNIT_ASSERT_MESSAGE("Memory mapped image equals read image", mitk::Equal(*readImage, *mappedImage, mitk::eps, true));
+
+    {
+      mitk::ImageReadAccessor sliceAccessor(mappedImage, mappedImage->GetSliceData(3));
+      const auto *slicePixels = static_cast<const short *>(sliceAccessor.GetData());
+      CPPUNIT_ASSERT_EQUAL(pixels[3 * size[0] * size[1] + 17], slicePixels[17]);
+    }
+
+    {
+      mitk::ImageWriteAccessor writeAccessor(mappedImage);
+      static_cast<short *>(writeAccessor.GetData())[0] = 4242;
+    }
+
+    auto reloadedImage = mitk::IOUtil::Load<mitk::Image>(tmpFilePath);
+    mitk::ImageReadAccessor reloadedAccessor(reloadedImage);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Modification of mapped image does not change the file",
+                                 pixels[0],
+                                 static_cast<const short *>(reloadedAccessor.GetData())[0]);
+
+    mappedImage = nullptr;
+    std::remove(tmpFilePath.c_str());
+  }
+
+  /**
+  * Read an NRRD file whose vector axis is the last axis. ITK makes it the fastest axis, so the raw data cannot
+  * be mapped as it is and regular reading has to be used.
+  */
+  void TestMemoryMappedReading_NonLeadingVectorAxis_FallsBack()
+  {
+    const unsigned int size[3] = {16, 12, 3};
+    const unsigned int numberOfPixels = size[0] * size[1] * size[2];
+
+    std::vector<short> pixels(numberOfPixels);
+    for (unsigned int i = 0; i < numberOfPixels; ++i)
+      pixels[i] = static_cast<short>(i);
+
+    std::ofstream tmpStream;
+    const std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile(tmpStream, std::ios_base::out | std::ios_base::binary, "XXXXXX.nrrd");
+    tmpStream << "NRRD0004\n"
+              << "type: short\n"
+              << "dimension: 3\n"
+              << "sizes: " << size[0] << " " << size[1] << " " << size[2] << "\n"
+              << "kinds: domain domain 3-vector\n"
+              << "endian: " << (itk::ByteSwapper<short>::SystemIsBigEndian() ? "big" : "little") << "\n"
+              << "encoding: raw\n"
+              << "\n";
+    tmpStream.write(reinterpret_cast<const char *>(pixels.data()), pixels.size() * sizeof(short));
+    tmpStream.close();
+
+    mitk::IFileReader::Options options;
+    options[mitk::ItkImageIO::OPTION_MEMORY_MAPPED_READING()] = us::Any(true);
+
+    auto readImage = mitk::IOUtil::Load<mitk::Image>(tmpFilePath);
+    auto mappedImage = mitk::IOUtil::Load<mitk::Image>(tmpFilePath, options);
+
+    CPPUNIT_ASSERT_MESSAGE("Image was read without memory mapping", mappedImage->GetChannelData(0)->GetMemoryOwner() == nullptr);
+    CPPUNIT_ASSERT_EQUAL(3u, mappedImage->GetPixelType().GetNumberOfComponents());
+    CPPUNIT_ASSERT_MESSAGE("Image read with memory mapping option equals read image", mitk::Equal(*readImage, *mappedImage, mitk::eps, true));
+
+    {
+      // the components of a pixel are interleaved in the image
+      mitk::ImageReadAccessor accessor(mappedImage);
+      const auto *imagePixels = static_cast<const short *>(accessor.GetData());
+      const unsigned int pixelIndex = 5 * size[0] + 7;
+      for (unsigned int component = 0; component < size[2]; ++component)
+        CPPUNIT_ASSERT_EQUAL(pixels[component * size[0] * size[1] + pixelIndex], imagePixels[3 * pixelIndex + component]);
+    }
+
+    mappedImage = nullptr;
+    std::remove(tmpFilePath.c_str());
+  }
+
   /**
   * Try to write a 3D image with only one plane (a 2D images in disguise for all intents and purposes)
   */
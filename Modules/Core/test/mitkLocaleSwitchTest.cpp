@@ -0,0 +1,115 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkLocaleSwitch.h>
+
+#include <clocale>
+#include <future>
+#include <memory>
+#include <string>
+
+class mitkLocaleSwitchTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLocaleSwitchTestSuite);
+  MITK_TEST(LocaleSwitch_RestoresLocale);
+  MITK_TEST(LocaleSwitch_OverlappingSwitchesOfWorkerThreads_KeepLocaleOfCallingThread);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_OriginalLocale;
+  std::string m_OtherLocale;
+
+  static std::string GetCurrentLocale()
+  {
+    const char *currentLocale = std::setlocale(LC_ALL, nullptr);
+    return currentLocale != nullptr ? currentLocale : "";
+  }
+
+public:
+  void setUp() override
+  {
+    m_OriginalLocale = GetCurrentLocale();
+    m_OtherLocale.clear();
+
+    // any locale other than "C" that is installed on this system
+    for (const char *candidate : {"C.UTF-8", "en_US.UTF-8", "de_DE.UTF-8", "German_Germany.1252"})
+    {
+      if (std::setlocale(LC_ALL, candidate) != nullptr)
+      {
+        m_OtherLocale = GetCurrentLocale();
+        break;
+      }
+    }
+  }
+
+  void tearDown() override { std::setlocale(LC_ALL, m_OriginalLocale.c_str()); }
+
+  void LocaleSwitch_RestoresLocale()
+  {
+    if (m_OtherLocale.empty())
+    {
+      MITK_WARN << "No locale other than \"C\" is installed, skipping test.";
+      return;
+    }
+
+    {
+      mitk::LocaleSwitch localeSwitch("C");
+      CPPUNIT_ASSERT_EQUAL(std::string("C"), GetCurrentLocale());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(m_OtherLocale, GetCurrentLocale());
+  }
+
+  void LocaleSwitch_OverlappingSwitchesOfWorkerThreads_KeepLocaleOfCallingThread()
+  {
+    if (m_OtherLocale.empty())
+    {
+      MITK_WARN << "No locale other than \"C\" is installed, skipping test.";
+      return;
+    }
+
+    {
+      // like SceneIO, the calling thread switches the locale before the worker threads start
+      mitk::LocaleSwitch callingThreadSwitch("C");
+
+      std::unique_ptr<mitk::LocaleSwitch> firstSwitch;
+      auto firstThread = std::async(std::launch::async, [&]() { firstSwitch.reset(new mitk::LocaleSwitch("C")); });
+      firstThread.wait();
+
+      std::promise<void> secondSwitchCreated;
+      std::promise<void> firstSwitchDestroyed;
+      auto firstSwitchDestroyedFuture = firstSwitchDestroyed.get_future();
+
+      // the second switch is created while the first is alive and destroyed after it
+      auto secondThread = std::async(std::launch::async, [&]() {
+        mitk::LocaleSwitch secondSwitch("C");
+        secondSwitchCreated.set_value();
+        firstSwitchDestroyedFuture.wait();
+        return GetCurrentLocale();
+      });
+
+      secondSwitchCreated.get_future().wait();
+      firstSwitch.reset();
+      firstSwitchDestroyed.set_value();
+
+      CPPUNIT_ASSERT_EQUAL(std::string("C"), secondThread.get());
+      CPPUNIT_ASSERT_EQUAL(std::string("C"), GetCurrentLocale());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(m_OtherLocale, GetCurrentLocale());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLocaleSwitch)
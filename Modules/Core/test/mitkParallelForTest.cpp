@@ -0,0 +1,104 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkParallelFor.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const std::size_t Count = 1000;
+}
+
+class mitkParallelForTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelForTestSuite);
+  MITK_TEST(ParallelFor_CallsEachIndexOnce);
+  MITK_TEST(ParallelFor_SingleWorkUnit_RunsInCallingThread);
+  MITK_TEST(ParallelFor_ReportsProgressInCallingThread);
+  MITK_TEST(ParallelFor_RethrowsException);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void ParallelFor_CallsEachIndexOnce()
+  {
+    std::vector<std::atomic<int>> calls(Count);
+    for (auto &call : calls)
+      call = 0;
+
+    mitk::ParallelFor(Count, [&calls](std::size_t i) { ++calls[i]; });
+
+    for (std::size_t i = 0; i < Count; ++i)
+      CPPUNIT_ASSERT_EQUAL(1, calls[i].load());
+  }
+
+  void ParallelFor_SingleWorkUnit_RunsInCallingThread()
+  {
+    const auto callingThread = std::this_thread::get_id();
+    std::size_t numberOfCalls = 0;
+
+    mitk::ParallelFor(
+      Count,
+      [&](std::size_t) {
+        CPPUNIT_ASSERT(callingThread == std::this_thread::get_id());
+        ++numberOfCalls;
+      },
+      1);
+
+    CPPUNIT_ASSERT_EQUAL(Count, numberOfCalls);
+  }
+
+  void ParallelFor_ReportsProgressInCallingThread()
+  {
+    const auto callingThread = std::this_thread::get_id();
+    std::atomic<std::size_t> numberOfCalls(0);
+    std::size_t progress = 0;
+
+    mitk::ParallelFor(
+      Count,
+      [&numberOfCalls](std::size_t) { ++numberOfCalls; },
+      4,
+      [&](std::size_t numberOfNewCalls) {
+        CPPUNIT_ASSERT(callingThread == std::this_thread::get_id());
+        progress += numberOfNewCalls;
+        CPPUNIT_ASSERT(progress <= numberOfCalls);
+      });
+
+    CPPUNIT_ASSERT_EQUAL(Count, numberOfCalls.load());
+    CPPUNIT_ASSERT_EQUAL(Count, progress);
+  }
+
+  void ParallelFor_RethrowsException()
+  {
+    std::size_t progress = 0;
+
+    CPPUNIT_ASSERT_THROW(mitk::ParallelFor(
+                           Count,
+                           [](std::size_t i) {
+                             if (10 == i)
+                               throw std::runtime_error("Test");
+                           },
+                           0,
+                           [&progress](std::size_t numberOfNewCalls) { progress += numberOfNewCalls; }),
+                         std::runtime_error);
+
+    CPPUNIT_ASSERT_EQUAL(Count, progress);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelFor)
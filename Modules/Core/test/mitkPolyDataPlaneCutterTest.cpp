@@ -0,0 +1,153 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkPolyDataPlaneCutter.h>
+
+#include <vtkCutter.h>
+#include <vtkPlane.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+/** Compares the contours of the indexed cutter with the contours of a vtkCutter applied to the whole sphere. */
+class mitkPolyDataPlaneCutterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPolyDataPlaneCutterTestSuite);
+  MITK_TEST(Cut_AxisAlignedPlanes_EqualsVtkCutter);
+  MITK_TEST(Cut_ObliquePlane_EqualsVtkCutter);
+  MITK_TEST(Cut_PlaneOutsideOfInput_ReturnsEmptyContour);
+  MITK_TEST(Cut_SamePlane_ReturnsCachedContour);
+  MITK_TEST(Cut_ModifiedInput_RebuildsIndex);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  vtkSmartPointer<vtkSphereSource> m_SphereSource;
+  vtkSmartPointer<vtkPolyData> m_Sphere;
+  mitk::PolyDataPlaneCutter::Pointer m_Cutter;
+
+  static mitk::Point3D CreatePoint(double x, double y, double z)
+  {
+    mitk::Point3D point;
+    mitk::FillVector3D(point, x, y, z);
+    return point;
+  }
+
+  static mitk::Vector3D CreateVector(double x, double y, double z)
+  {
+    mitk::Vector3D vector;
+    mitk::FillVector3D(vector, x, y, z);
+    return vector;
+  }
+
+  void CheckCut(const mitk::Point3D &origin, const mitk::Vector3D &normal)
+  {
+    auto plane = vtkSmartPointer<vtkPlane>::New();
+    plane->SetOrigin(origin[0], origin[1], origin[2]);
+    plane->SetNormal(normal[0], normal[1], normal[2]);
+
+    auto cutter = vtkSmartPointer<vtkCutter>::New();
+    cutter->SetCutFunction(plane);
+    cutter->SetInputData(m_Sphere);
+    cutter->Update();
+
+    auto contour = m_Cutter->Cut(origin, normal);
+
+    CPPUNIT_ASSERT(cutter->GetOutput()->GetNumberOfLines() > 0);
+    CPPUNIT_ASSERT_EQUAL(cutter->GetOutput()->GetNumberOfLines(), contour->GetNumberOfLines());
+    CPPUNIT_ASSERT_EQUAL(cutter->GetOutput()->GetNumberOfPoints(), contour->GetNumberOfPoints());
+
+    double expectedBounds[6];
+    double bounds[6];
+    cutter->GetOutput()->GetBounds(expectedBounds);
+    contour->GetBounds(bounds);
+
+    for (int i = 0; i < 6; ++i)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedBounds[i], bounds[i], mitk::eps);
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that only a part of the cells is cut",
+                           m_Cutter->GetNumberOfCandidateCells() < m_Sphere->GetNumberOfCells());
+  }
+
+public:
+  void setUp() override
+  {
+    m_SphereSource = vtkSmartPointer<vtkSphereSource>::New();
+    m_SphereSource->SetCenter(1.0, 2.0, 3.0);
+    m_SphereSource->SetRadius(10.0);
+    m_SphereSource->SetThetaResolution(64);
+    m_SphereSource->SetPhiResolution(64);
+    m_SphereSource->Update();
+
+    m_Sphere = m_SphereSource->GetOutput();
+
+    m_Cutter = mitk::PolyDataPlaneCutter::New();
+    m_Cutter->SetInput(m_Sphere);
+  }
+
+  void tearDown() override
+  {
+    m_Cutter = nullptr;
+    m_Sphere = nullptr;
+    m_SphereSource = nullptr;
+  }
+
+  void Cut_AxisAlignedPlanes_EqualsVtkCutter()
+  {
+    for (double z = -5.0; z <= 11.0; z += 2.5)
+      this->CheckCut(CreatePoint(0.0, 0.0, z), CreateVector(0.0, 0.0, 1.0));
+
+    this->CheckCut(CreatePoint(3.0, 0.0, 0.0), CreateVector(1.0, 0.0, 0.0));
+    this->CheckCut(CreatePoint(0.0, -1.0, 0.0), CreateVector(0.0, 1.0, 0.0));
+  }
+
+  void Cut_ObliquePlane_EqualsVtkCutter()
+  {
+    this->CheckCut(CreatePoint(1.0, 2.0, 3.0), CreateVector(1.0, 1.0, 1.0));
+    this->CheckCut(CreatePoint(4.0, 0.0, 3.0), CreateVector(0.3, -2.0, 0.7));
+  }
+
+  void Cut_PlaneOutsideOfInput_ReturnsEmptyContour()
+  {
+    auto contour = m_Cutter->Cut(CreatePoint(0.0, 0.0, 50.0), CreateVector(0.0, 0.0, 1.0));
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), contour->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), m_Cutter->GetNumberOfCandidateCells());
+  }
+
+  void Cut_SamePlane_ReturnsCachedContour()
+  {
+    auto contour = m_Cutter->Cut(CreatePoint(0.0, 0.0, 3.0), CreateVector(0.0, 0.0, 1.0));
+    m_Cutter->Cut(CreatePoint(0.0, 0.0, 4.0), CreateVector(0.0, 0.0, 1.0));
+
+    CPPUNIT_ASSERT(contour == m_Cutter->Cut(CreatePoint(0.0, 0.0, 3.0), CreateVector(0.0, 0.0, 1.0)));
+
+    m_Cutter->SetContourCacheSize(0);
+    CPPUNIT_ASSERT(contour != m_Cutter->Cut(CreatePoint(0.0, 0.0, 3.0), CreateVector(0.0, 0.0, 1.0)));
+  }
+
+  void Cut_ModifiedInput_RebuildsIndex()
+  {
+    auto contour = m_Cutter->Cut(CreatePoint(0.0, 0.0, 15.0), CreateVector(0.0, 0.0, 1.0));
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), contour->GetNumberOfPoints());
+
+    // move the sphere upwards, the cached empty contour must not be returned anymore
+    m_SphereSource->SetCenter(1.0, 2.0, 13.0);
+    m_SphereSource->Update();
+
+    this->CheckCut(CreatePoint(0.0, 0.0, 15.0), CreateVector(0.0, 0.0, 1.0));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPolyDataPlaneCutter)
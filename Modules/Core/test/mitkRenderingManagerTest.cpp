@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include "mitkSurface.h"
 #include <vtkCubeSource.h>
 
+#include <thread>
+
 // Propertylist Test
 
 /**
@@ -157,6 +159,55 @@ public:
     myRenderingManager->ForceImmediateUpdateAll();
   }
 
+  static void TestRequestMerging(mitk::RenderingManager::Pointer renderingManager, vtkRenderWindow *renderWindow)
+  {
+    renderingManager->ResetRenderWindowStatistics();
+
+    renderingManager->RequestUpdate(renderWindow);
+    renderingManager->RequestUpdate(renderWindow);
+    renderingManager->RequestUpdate(renderWindow);
+
+    MITK_TEST_CONDITION(renderingManager->GetRenderWindowStatistics(renderWindow).NumberOfMergedRequests == 2,
+                        "Testing if repeated requests are merged into one pending request")
+
+    renderingManager->ExecutePendingRequests();
+    renderingManager->RequestUpdate(renderWindow);
+
+    MITK_TEST_CONDITION(renderingManager->GetRenderWindowStatistics(renderWindow).NumberOfMergedRequests == 2,
+                        "Testing if executing the pending requests satisfies the merged request")
+
+    renderingManager->ResetRenderWindowStatistics();
+
+    MITK_TEST_CONDITION(renderingManager->GetRenderWindowStatistics(renderWindow).NumberOfMergedRequests == 0,
+                        "Testing if the statistics are reset")
+
+    renderingManager->ExecutePendingRequests();
+  }
+
+  static void TestRequestFromWorkerThread(mitk::RenderingManager::Pointer renderingManager,
+                                          vtkRenderWindow *renderWindow)
+  {
+    const double maximumFrameRate = renderingManager->GetMaximumFrameRate();
+    renderingManager->SetMaximumFrameRate(0.0);
+    renderingManager->ResetRenderWindowStatistics();
+
+    std::thread worker([renderingManager, renderWindow]() {
+      renderingManager->RequestUpdateFromWorkerThread(renderWindow);
+      renderingManager->RequestUpdateFromWorkerThread(renderWindow);
+    });
+    worker.join();
+
+    MITK_TEST_CONDITION(renderingManager->GetRenderWindowStatistics(renderWindow).NumberOfFrames == 0,
+                        "Testing if requests of worker threads are not rendered immediately")
+
+    renderingManager->ExecutePendingRequests();
+
+    MITK_TEST_CONDITION(renderingManager->GetRenderWindowStatistics(renderWindow).NumberOfFrames == 1,
+                        "Testing if requests of worker threads are rendered once by the GUI thread")
+
+    renderingManager->SetMaximumFrameRate(maximumFrameRate);
+  }
+
 }; // mitkDataNodeTestClass
 int mitkRenderingManagerTest(int /* argc */, char * /*argv*/ [])
 {
@@ -198,6 +249,9 @@ int mitkRenderingManagerTest(int /* argc */, char * /*argv*/ [])
 
   mitkRenderingManagerTestClass::TestSurfaceLoading(myRenderingManager);
 
+  mitkRenderingManagerTestClass::TestRequestMerging(myRenderingManager, vtkRenWin);
+  mitkRenderingManagerTestClass::TestRequestFromWorkerThread(myRenderingManager, vtkRenWin);
+
   // write your own tests here and use the macros from mitkTestingMacros.h !!!
   // do not write to std::cout and do not return from this function yourself!
 
@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkInteractionConst.h"
+#include "mitkLimitedLinearUndo.h"
 #include "mitkOperation.h"
 #include "mitkUndoController.h"
 #include "mitkVerboseLimitedLinearUndo.h"
@@ -18,6 +19,7 @@ found in the LICENSE file.
 #include "mitkTestingMacros.h"
 
 #include <iostream>
+#include <vector>
 
 int g_GlobalCounter = 0;
 
@@ -31,6 +33,9 @@ namespace mitk
   public:
     TestOperation(OperationType operationType) : Operation(operationType) { g_GlobalCounter++; };
     ~TestOperation() override { g_GlobalCounter--; };
+    std::size_t GetMemoryUsage() const override { return 1000; }
+    bool IsMemoryUsagePending() const override { return m_Pending; }
+    bool m_Pending = false;
   };
 } // namespace
 
@@ -126,6 +131,70 @@ int mitkVerboseLimitedLinearUndoTest(int /* argc */, char * /*argv*/ [])
   // static singleton
   MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 4, "checking singleton UndoModel");
 
+  // the memory is not limited unless the application sets a default limit for new undo models
+  mitk::LimitedLinearUndo::Pointer limitedUndo = mitk::LimitedLinearUndo::New();
+  MITK_TEST_CONDITION_REQUIRED(limitedUndo->GetUndoMemoryLimit() == 0, "checking that the memory is not limited by default");
+
+  mitk::LimitedLinearUndo::SetDefaultUndoMemoryLimit(5000);
+  limitedUndo = mitk::LimitedLinearUndo::New();
+  mitk::LimitedLinearUndo::SetDefaultUndoMemoryLimit(0);
+  MITK_TEST_CONDITION_REQUIRED(limitedUndo->GetUndoMemoryLimit() == 5000, "checking the default limit of new undo models");
+
+  // limit the undo stack by memory: each OperationEvent holds more than 2000 bytes
+  for (int i = 0; i < 4; i++)
+  {
+    auto doOp = new mitk::TestOperation(mitk::OpTEST);
+    auto undoOp = new mitk::TestOperation(mitk::OpTEST);
+    limitedUndo->SetOperationEvent(new mitk::OperationEvent(nullptr, doOp, undoOp, "Test"));
+    mitk::OperationEvent::IncCurrObjectEventId();
+  }
+  MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 8, "checking dropping of undo items exceeding the memory limit");
+  MITK_TEST_CONDITION(limitedUndo->GetUndoMemoryUsage() <= 5000 && limitedUndo->GetUndoMemoryUsage() > 4000,
+                      "checking memory usage of the undo stack");
+
+  limitedUndo->SetUndoMemoryLimit(1);
+  MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 6, "checking that the newest undo item is kept");
+  limitedUndo->Clear();
+
+  // items of one ObjectEventId are dropped together and the newest ObjectEventId is always kept
+  limitedUndo->SetUndoMemoryLimit(1);
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 2; j++)
+    {
+      auto doOp = new mitk::TestOperation(mitk::OpTEST);
+      auto undoOp = new mitk::TestOperation(mitk::OpTEST);
+      limitedUndo->SetOperationEvent(new mitk::OperationEvent(nullptr, doOp, undoOp, "Test"));
+    }
+    mitk::OperationEvent::IncCurrObjectEventId();
+  }
+  MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 8, "checking that all items of the newest ObjectEventId are kept");
+  limitedUndo->Clear();
+
+  // items with pending memory usage are not counted until their memory usage is final
+  limitedUndo->SetUndoMemoryLimit(5000);
+  std::vector<mitk::TestOperation *> pendingOperations;
+  for (int i = 0; i < 4; i++)
+  {
+    auto doOp = new mitk::TestOperation(mitk::OpTEST);
+    auto undoOp = new mitk::TestOperation(mitk::OpTEST);
+    doOp->m_Pending = true;
+    pendingOperations.push_back(doOp);
+    limitedUndo->SetOperationEvent(new mitk::OperationEvent(nullptr, doOp, undoOp, "Test"));
+    mitk::OperationEvent::IncCurrObjectEventId();
+  }
+  MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 12, "checking that pending undo items are not dropped");
+
+  for (auto operation : pendingOperations)
+    operation->m_Pending = false;
+
+  auto doOp = new mitk::TestOperation(mitk::OpTEST);
+  auto undoOp = new mitk::TestOperation(mitk::OpTEST);
+  limitedUndo->SetOperationEvent(new mitk::OperationEvent(nullptr, doOp, undoOp, "Test"));
+  mitk::OperationEvent::IncCurrObjectEventId();
+  MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 8, "checking that finished undo items are counted again");
+  limitedUndo->Clear();
+
   // always end with this!
   MITK_TEST_END()
   // operations will be deleted after terminating the application
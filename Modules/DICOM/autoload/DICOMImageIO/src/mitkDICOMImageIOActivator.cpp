@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkAutoSelectingDICOMReaderService.h"
 #include "mitkManualSelectingDICOMReaderService.h"
 #include "mitkDICOMTagsOfInterestService.h"
+#include "mitkDICOMProgressiveImageLoader.h"
 #include "mitkSimpleVolumeDICOMSeriesReaderService.h"
 #include "mitkCoreServices.h"
 #include "mitkPropertyPersistenceInfo.h"
@@ -106,6 +107,8 @@ namespace mitk {
 
   void DICOMImageIOActivator::Unload(us::ModuleContext*)
   {
+    // images that are still loaded in the background must not outlive the readers' modules
+    DICOMProgressiveImageLoader::CancelAll();
   }
 
   void DICOMImageIOActivator::EnsureManualSelectingDICOMSeriesReader(const us::ModuleEvent event)
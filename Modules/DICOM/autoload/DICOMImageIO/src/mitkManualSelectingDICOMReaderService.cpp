@@ -15,7 +15,7 @@ found in the LICENSE file.
 mitk::ManualSelectingDICOMReaderService::ManualSelectingDICOMReaderService()
   : BaseDICOMReaderService("MITK DICOM Reader v2 (manual)"), m_Selector(DICOMFileReaderSelector::New())
 {
-  Options defaultOptions;
+  Options defaultOptions = this->GetDefaultOptions();
 
   m_Selector->LoadBuiltIn3DConfigs();
   m_Selector->LoadBuiltIn3DnTConfigs();
@@ -35,6 +35,7 @@ set(CPP_FILES
   mitkIDICOMTagsOfInterest.cpp
   mitkDICOMTagsOfInterestAddHelper.cpp
   mitkDICOMTagPath.cpp
+  mitkDICOMProgressiveImageLoader.cpp
   mitkDICOMProperty.cpp
   mitkDICOMFilesHelper.cpp
   mitkDICOMIOMetaInformationPropertyConstants.cpp
@@ -51,6 +51,11 @@ protected:
   bool GetOnlyRegardOwnSeries() const;
 
 private:
+  /** Adds the option "Load progressively" (default: false). If it is set and the reader is a
+   * DICOMITKSeriesGDCMReader, 3D blocks are loaded progressively (see DICOMITKSeriesGDCMReader::SetProgressiveLoading()).
+   * Derived classes that set their own default options have to extend GetDefaultOptions().*/
+  void InitializeDefaultOptions();
+
   /** Flags that constrols if the read() operation should only regard DICOM files of the same series
   if the specified GetLocalFileName() is a file. If it is a director, this flag has no impact (it is
   assumed false then).
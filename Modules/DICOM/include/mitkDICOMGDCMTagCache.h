@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagCache.h"
 
+#include <map>
 #include <set>
 #include <memory>
 
@@ -26,6 +27,11 @@ namespace mitk
   /**
     \ingroup DICOMModule
     \brief Tag cache implementation used by the DICOMGDCMTagScanner.
+
+    The cache owns copies of the scanned tag values, so it does not depend on
+    the gdcm::Scanner instance(s) that produced them. This allows to combine
+    the results of several scanners (e.g. of a parallel scan) and of values
+    that were restored from a persistent tag index.
   */
   class MITKDICOM_EXPORT DICOMGDCMTagCache : public DICOMTagCache
   {
@@ -41,9 +47,18 @@ namespace mitk
 
       DICOMDatasetAccessingImageFrameList GetFrameInfoList() const override;
 
+      /** Values of the tags found in one file. Tags that were scanned but not found are missing. */
+      typedef std::map<DICOMTag, std::string> TagValueMapType;
+      /** Tag values per file name. */
+      typedef std::map<std::string, TagValueMapType> FileTagValueMapType;
+
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
-      const gdcm::Scanner& GetScanner() const;
+      /**
+      \brief Initializes the cache with the tag values of all input files.
+      Input files without an entry in tagValues are treated as files without any of the scanned tags.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags, FileTagValueMapType tagValues, const StringList& inputFiles);
 
   protected:
 
@@ -52,7 +67,8 @@ namespace mitk
 
       std::set<DICOMTag> m_ScannedTags;
 
-      std::shared_ptr<gdcm::Scanner> m_Scanner;
+      /** The frame infos of m_ScanResult point into these values. */
+      FileTagValueMapType m_TagValues;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
@@ -41,6 +41,19 @@ namespace mitk
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMGDCMTagScanner before requesting the results!
 
+    The files are scanned in parallel by several gdcm::Scanner instances.
+
+    Optionally, the scanned tag values can be kept in a persistent index file
+    (see SetIndexFile()). Files whose path, modification time and size match an
+    index entry that covers all requested tags are not parsed again, which makes
+    reopening a known directory considerably faster. Newly scanned files are
+    appended to the index file. If files of a scanned directory were deleted or
+    the index file consists mainly of outdated entries, it is rewritten to a
+    temporary file that replaces it. Since the index contains tag values
+    (potentially including patient information), it is not used unless an
+    index file is set for the scanner or as default for all scanners
+    (SetDefaultIndexFile()).
+
     @remark This scanner does only support the scanning for simple value tag.
     If you need to scann for sequence items or non-top-level elements, this scanner
     will not be sufficient. See i.a. DICOMDCMTKTagScanner for these cases.
@@ -77,6 +90,19 @@ namespace mitk
       */
       void SetInputFiles(const StringList& filenames) override;
 
+      /**
+        \brief Persistent index of tag values to use for scanning. An empty string disables the index.
+        Initialized with the default index file (see SetDefaultIndexFile()).
+      */
+      void SetIndexFile(const std::string& indexFile);
+      std::string GetIndexFile() const;
+
+      /**
+        \brief Index file that is used by newly created scanners. Empty (no index) by default.
+      */
+      static void SetDefaultIndexFile(const std::string& indexFile);
+      static std::string GetDefaultIndexFile();
+
       /**
         \brief Start the scanning process.
         Calling Scan() will invalidate previous scans, forgetting
@@ -85,6 +111,12 @@ namespace mitk
       */
       void Scan() override;
 
+      /**
+        \brief Number of files that were parsed by the last Scan().
+        Files whose tag values were taken from the index are not counted.
+      */
+      std::size_t GetNumberOfScannedFiles() const;
+
       /**
         \brief Retrieve a result list for file-by-file tag access.
       */
@@ -109,7 +141,8 @@ namespace mitk
       std::set<DICOMTag> m_ScannedTags;
       StringList m_InputFilenames;
       DICOMGDCMTagCache::Pointer m_Cache;
-      std::shared_ptr<gdcm::Scanner> m_GDCMScanner;
+      std::string m_IndexFile;
+      std::size_t m_NumberOfScannedFiles;
 
     private:
       DICOMGDCMTagScanner(const DICOMGDCMTagScanner&);
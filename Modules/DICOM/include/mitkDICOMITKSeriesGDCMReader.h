@@ -227,6 +227,19 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool GetFixTiltByShearing() const;
 
+    /**
+      \brief Controls whether 3D blocks are loaded progressively (default: off).
+
+      In progressive mode, LoadImages() returns as soon as the geometry of each block is known and its central
+      frame is loaded. The remaining frames are loaded in the background from the center outward and written
+      into the output image as they arrive (see DICOMProgressiveImageLoader). Blocks that require gantry tilt
+      correction are always loaded completely. The DICOM reader services enable this mode with their reader
+      option "Load progressively".
+    */
+    void SetProgressiveLoading(bool on);
+
+    bool GetProgressiveLoading() const;
+
     /**
       \brief Controls whether groups of only two images are accepted when ensuring consecutive slices via EquiDistantBlocksSorter.
     */
@@ -345,6 +358,8 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool m_SimpleVolumeReading;
 
+    bool m_ProgressiveLoading;
+
   private:
 
     SortingBlockList m_SortingResultInProgress;
@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMProgressiveImageLoader_h
+#define mitkDICOMProgressiveImageLoader_h
+
+#include <mitkImage.h>
+
+#include <MitkDICOMExports.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief Loads the frames of an image in background threads after the image was handed out by a reader.
+
+    Used by ITKDICOMSeriesReaderHelper::LoadProgressively(). The image has to be allocated completely before
+    loading starts, so it can be used and rendered while its frames arrive. Which frames are loaded is only
+    tracked by the loader (see IsFrameLoaded()). While loading, the image is modified regularly and after the
+    last frame from the GUI thread (see CallbackFromGUIThread), so that it is rendered again.
+
+    Every loader is kept by a registry until it is finished. Loading can be cancelled for a single image
+    (GetLoader() and Cancel()) or for all images (CancelAll(), e.g. before the application shuts down).
+    Both wait for the loading threads.
+  */
+  class MITKDICOM_EXPORT DICOMProgressiveImageLoader
+  {
+    public:
+
+      /** Loads the given frame and writes it into the image. Called concurrently for different frames. */
+      typedef std::function<void(Image* image, std::size_t frame)> LoadFrameFunctionType;
+
+      /**
+        \brief Starts loading frames of image in the given order.
+
+        frameOrder contains the indices of the frames to load, the other frames of [0, numberOfFrames) are
+        regarded as loaded already. A numberOfThreads of 0 uses all cores but one.
+      */
+      static std::shared_ptr<DICOMProgressiveImageLoader> Start( Image* image,
+                                                                  std::size_t numberOfFrames,
+                                                                  const std::vector<std::size_t>& frameOrder,
+                                                                  const LoadFrameFunctionType& loadFrame,
+                                                                  unsigned int numberOfThreads = 0 );
+
+      /** \brief Returns the loader that still loads image, nullptr if image is complete. */
+      static std::shared_ptr<DICOMProgressiveImageLoader> GetLoader( const Image* image );
+
+      /** \brief Cancels the loading of all images and waits for the loading threads. */
+      static void CancelAll();
+
+      ~DICOMProgressiveImageLoader();
+
+      /** \brief Stops loading after the frames that are currently loaded and waits for the loading threads. */
+      void Cancel();
+
+      /** \brief Waits until all frames are loaded and modifies the image in the calling thread. */
+      void Wait();
+
+      bool IsFrameLoaded( std::size_t frame ) const;
+      std::size_t GetNumberOfLoadedFrames() const;
+      std::size_t GetNumberOfFrames() const;
+
+      /** \brief Returns true if all frames are loaded or loading was cancelled. */
+      bool IsFinished() const;
+
+      const Image* GetImage() const;
+
+    private:
+
+      DICOMProgressiveImageLoader( Image* image,
+                                   std::size_t numberOfFrames,
+                                   const std::vector<std::size_t>& frameOrder,
+                                   const LoadFrameFunctionType& loadFrame );
+
+      DICOMProgressiveImageLoader( const DICOMProgressiveImageLoader& ) = delete;
+      DICOMProgressiveImageLoader& operator=( const DICOMProgressiveImageLoader& ) = delete;
+
+      void Run();
+      void Join();
+
+      /** Asks the GUI thread to modify the image if the last modification is old enough or force is set. */
+      void RequestModification( bool force );
+
+      Image::Pointer m_Image;
+      std::vector<std::size_t> m_FrameOrder;
+      LoadFrameFunctionType m_LoadFrame;
+
+      std::vector<std::thread> m_Threads;
+      std::mutex m_JoinMutex;
+
+      std::atomic<std::size_t> m_NextFrame;
+      std::atomic<bool> m_Cancelled;
+
+      mutable std::mutex m_Mutex;
+      std::vector<bool> m_LoadedFrames;
+      std::size_t m_NumberOfLoadedFrames;
+      unsigned int m_NumberOfRunningThreads;
+      std::chrono::steady_clock::time_point m_LastModification;
+  };
+
+}
+
+#endif
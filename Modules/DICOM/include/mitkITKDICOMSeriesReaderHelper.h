@@ -19,12 +19,21 @@ found in the LICENSE file.
 
 #include <itkGDCMImageIO.h>
 
+#include <functional>
+
 /* Forward deceleration of an DCMTK class. Used in the txx but part of the interface.*/
 class OFDateTime;
 
 namespace mitk
 {
 
+/**
+  \brief Loads images of sorted DICOM files via ITK.
+
+  The geometry of every volume is determined by itk::ImageSeriesReader, while the
+  frames are decoded in parallel, each directly into its slot of the preallocated
+  volume. Progress is reported per decoded frame via mitk::ProgressBar.
+*/
 class ITKDICOMSeriesReaderHelper
 {
   public:
@@ -39,6 +48,19 @@ class ITKDICOMSeriesReaderHelper
     Image::Pointer Load( const StringContainer& filenames, bool correctTilt, const GantryTiltInformation& tiltInfo );
     Image::Pointer Load3DnT( const StringContainerList& filenamesLists, bool correctTilt, const GantryTiltInformation& tiltInfo );
 
+    /**
+      \brief Loads the central frame of a 3D series and returns the image right away.
+
+      The image is allocated completely, slices that are not loaded yet are zero. The remaining frames are
+      loaded by a DICOMProgressiveImageLoader from the center outward and written into the image as they
+      arrive. The loader tracks the loaded frames and can be used to cancel or wait for the loading (see
+      DICOMProgressiveImageLoader::GetLoader()).
+
+      Only series with one frame per file are supported, nullptr is returned otherwise. Gantry tilt
+      correction is not supported, since it requires the complete volume.
+    */
+    Image::Pointer LoadProgressively( const StringContainer& filenames );
+
     static bool CanHandleFile(const std::string& filename);
 
   private:
@@ -83,6 +105,22 @@ class ITKDICOMSeriesReaderHelper
     typename ImageType::Pointer
     FixUpTiltedGeometry( ImageType* input, const GantryTiltInformation& tiltInfo );
 
+    /** Loads one volume per list of filenames. Every file has to contain a single frame.
+     The geometry of each volume is determined by itk::ImageSeriesReader using io, the frames
+     of all volumes are decoded in parallel. */
+    template <typename ImageType>
+    std::vector<typename ImageType::Pointer>
+    LoadVolumes( const StringContainerList& filenamesLists, itk::GDCMImageIO* io );
+
+    /** Decodes the frame of a file into buffer, which provides space for numberOfPixels pixels. */
+    template <typename ImageType>
+    static void
+    LoadFrame( const std::string& filename, typename ImageType::PixelType* buffer, std::size_t numberOfPixels );
+
+    template <typename PixelType>
+    Image::Pointer
+    LoadDICOMByITKProgressively( const StringContainer& filenames, itk::GDCMImageIO::Pointer& io );
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK( const StringContainer& filenames,
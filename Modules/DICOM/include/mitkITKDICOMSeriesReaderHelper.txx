@@ -11,8 +11,14 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkITKDICOMSeriesReaderHelper.h"
+#include "mitkDICOMProgressiveImageLoader.h"
+#include "mitkImageWriteAccessor.h"
+#include "mitkParallelFor.h"
+#include "mitkProgressBar.h"
 
+#include <itkImageFileReader.h>
 #include <itkImageSeriesReader.h>
+#include <itkPixelTraits.h>
 #include <itkResampleImageFilter.h>
 //#include <itkAffineTransform.h>
 //#include <itkLinearInterpolateImageFunction.h>
@@ -20,6 +26,9 @@ found in the LICENSE file.
 
 #include "dcmtk/ofstd/ofdatime.h"
 
+#include <algorithm>
+#include <cstring>
+
 template <typename PixelType>
 mitk::Image::Pointer
 mitk::ITKDICOMSeriesReaderHelper
@@ -33,26 +42,14 @@ mitk::ITKDICOMSeriesReaderHelper
   mitk::Image::Pointer image = mitk::Image::New();
 
   typedef itk::Image<PixelType, 3> ImageType;
-  typedef itk::ImageSeriesReader<ImageType> ReaderType;
 
   io = itk::GDCMImageIO::New();
-  typename ReaderType::Pointer reader = ReaderType::New();
-
-  reader->SetImageIO(io);
-  reader->ReverseOrderOff(); // at this point we require an order of input images so that
-                             // the direction between the origin of the first and the last slice
-                             // is the same direction as the image normals! Otherwise we might
-                             // see images upside down. Unclear whether this is a bug in MITK,
-                             // see NormalDirectionConsistencySorter.
-
-  reader->SetFileNames(filenames);
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
+  typename ImageType::Pointer readVolume = LoadVolumes<ImageType>( StringContainerList( 1, filenames ), io ).front();
 
   // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
   if (correctTilt)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
   }
 
   image->InitializeByItk(readVolume.GetPointer());
@@ -72,6 +69,81 @@ mitk::ITKDICOMSeriesReaderHelper
   return image;
 }
 
+template <typename PixelType>
+mitk::Image::Pointer
+mitk::ITKDICOMSeriesReaderHelper
+::LoadDICOMByITKProgressively( const StringContainer& filenames, itk::GDCMImageIO::Pointer& io )
+{
+  typedef itk::Image<PixelType, 3> ImageType;
+  typedef itk::ImageSeriesReader<ImageType> ReaderType;
+
+  // the series reader is only used to determine the geometry, see LoadVolumes()
+  io = itk::GDCMImageIO::New();
+  typename ReaderType::Pointer reader = ReaderType::New();
+
+  reader->SetImageIO(io);
+  reader->ReverseOrderOff();
+  reader->SetFileNames(filenames);
+  reader->UpdateOutputInformation();
+
+  const auto size = reader->GetOutput()->GetLargestPossibleRegion().GetSize();
+  const std::size_t numberOfFrames = filenames.size();
+
+  if (size[2] != numberOfFrames)
+  {
+    MITK_DEBUG << "Frames of DICOM series do not correspond to slices, cannot load progressively.";
+    return nullptr;
+  }
+
+  mitk::Image::Pointer image = mitk::Image::New();
+  image->InitializeByItk(reader->GetOutput());
+
+  const std::size_t pixelsPerFrame = size[0] * size[1];
+
+  {
+    // the image is complete from the start, frames that are not loaded yet are zero
+    ImageWriteAccessor accessor(image);
+    std::memset(accessor.GetData(), 0, pixelsPerFrame * numberOfFrames * sizeof(PixelType));
+  }
+
+  auto loadFrame = [filenames, size, pixelsPerFrame](Image* target, std::size_t slice) {
+    std::vector<PixelType> frame(pixelsPerFrame);
+    LoadFrame<ImageType>(filenames[slice], frame.data(), pixelsPerFrame);
+
+    // only the slice is locked, so that the image can be accessed while the frame is written
+    ImageAccessorBase::RegionType region;
+    region.SetIndex(2, static_cast<itk::IndexValueType>(slice));
+    region.SetSize(0, size[0]);
+    region.SetSize(1, size[1]);
+    region.SetSize(2, 1);
+    region.SetSize(3, 1);
+
+    ImageWriteAccessor accessor(target, region);
+    std::memcpy(accessor.GetData(), frame.data(), pixelsPerFrame * sizeof(PixelType));
+  };
+
+  // the central frame is available when the image is returned
+  const std::size_t center = numberOfFrames / 2;
+  loadFrame(image, center);
+
+  // the other frames are loaded from the center outward, since the center is shown first
+  std::vector<std::size_t> frameOrder;
+  frameOrder.reserve(numberOfFrames - 1);
+
+  for (std::size_t distance = 1; frameOrder.size() + 1 < numberOfFrames; ++distance)
+  {
+    if (center + distance < numberOfFrames)
+      frameOrder.push_back(center + distance);
+
+    if (distance <= center)
+      frameOrder.push_back(center - distance);
+  }
+
+  DICOMProgressiveImageLoader::Start(image, numberOfFrames, frameOrder, loadFrame);
+
+  return image;
+}
+
 #define MITK_DEBUG_OUTPUT_FILELIST(list)\
   MITK_DEBUG << "-------------------------------------------"; \
   for (StringContainer::const_iterator _iter = (list).cbegin(); _iter!=(list).cend(); ++_iter) \
@@ -101,59 +173,38 @@ mitk::ITKDICOMSeriesReaderHelper
   mitk::Image::Pointer image = mitk::Image::New();
 
   typedef itk::Image<PixelType, 4> ImageType;
-  typedef itk::ImageSeriesReader<ImageType> ReaderType;
-
-  io = itk::GDCMImageIO::New();
-  typename ReaderType::Pointer reader = ReaderType::New();
-
-  reader->SetImageIO(io);
-  reader->ReverseOrderOff(); // at this point we require an order of input images so that
-                             // the direction between the origin of the first and the last slice
-                             // is the same direction as the image normals! Otherwise we might
-                             // see images upside down. Unclear whether this is a bug in MITK,
-                             // see NormalDirectionConsistencySorter.
-
-
-  unsigned int currentTimeStep = 0;
 
 #ifdef MBILOG_ENABLE_DEBUG
-  MITK_DEBUG << "Start loading timestep " << currentTimeStep;
-  MITK_DEBUG_OUTPUT_FILELIST( filenamesForTimeSteps.front() )
-#endif // MBILOG_ENABLE_DEBUG
-
-  reader->SetFileNames(filenamesForTimeSteps.front());
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
-
-  // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
-  if (correctTilt)
+  unsigned int debugTimeStep = 0;
+  for (auto timestepsIter = filenamesForTimeSteps.cbegin(); timestepsIter != filenamesForTimeSteps.cend(); ++debugTimeStep, ++timestepsIter)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    MITK_DEBUG << "Start loading timestep " << debugTimeStep;
+    MITK_DEBUG_OUTPUT_FILELIST( *timestepsIter )
   }
+#endif // MBILOG_ENABLE_DEBUG
 
-  image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
-  image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep++); // timestep 0
+  // the frames of all time steps are decoded in one parallel pass
+  io = itk::GDCMImageIO::New();
+  auto readVolumes = LoadVolumes<ImageType>( filenamesForTimeSteps, io );
 
-  // for other time-steps
-  for (auto timestepsIter = ++(filenamesForTimeSteps.cbegin()); // start with SECOND entry
-      timestepsIter != filenamesForTimeSteps.cend();
-      ++currentTimeStep, ++timestepsIter)
+  for (unsigned int currentTimeStep = 0; currentTimeStep < numberOfTimeSteps; ++currentTimeStep)
   {
-#ifdef MBILOG_ENABLE_DEBUG
-    MITK_DEBUG << "Start loading timestep " << currentTimeStep;
-    MITK_DEBUG_OUTPUT_FILELIST( *timestepsIter )
-#endif // MBILOG_ENABLE_DEBUG
-
-    reader->SetFileNames( *timestepsIter );
-    reader->Update();
-    readVolume = reader->GetOutput();
+    typename ImageType::Pointer readVolume = readVolumes[currentTimeStep];
 
+    // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
     if (correctTilt)
     {
-      readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+      readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
+    }
+
+    if (0 == currentTimeStep)
+    {
+      image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
     }
 
     image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep);
+
+    readVolumes[currentTimeStep] = nullptr; // release the memory of this time step early
   }
 
 #ifdef MBILOG_ENABLE_DEBUG
@@ -173,6 +224,115 @@ mitk::ITKDICOMSeriesReaderHelper
 }
 
 
+template <typename ImageType>
+std::vector<typename ImageType::Pointer>
+mitk::ITKDICOMSeriesReaderHelper
+::LoadVolumes( const StringContainerList& filenamesLists, itk::GDCMImageIO* io )
+{
+  typedef itk::ImageSeriesReader<ImageType> ReaderType;
+  typedef typename ImageType::PixelType PixelType;
+
+  struct Frame
+  {
+    const std::string* Filename;
+    PixelType* Buffer;
+    std::size_t NumberOfPixels;
+  };
+
+  std::vector<typename ImageType::Pointer> volumes;
+  std::vector<Frame> frames;
+
+  for (const auto& filenames : filenamesLists)
+  {
+    // the series reader is only used to determine the geometry, which involves the first and the last file
+    typename ReaderType::Pointer reader = ReaderType::New();
+
+    reader->SetImageIO(io);
+    reader->ReverseOrderOff(); // at this point we require an order of input images so that
+                               // the direction between the origin of the first and the last slice
+                               // is the same direction as the image normals! Otherwise we might
+                               // see images upside down. Unclear whether this is a bug in MITK,
+                               // see NormalDirectionConsistencySorter.
+
+    reader->SetFileNames(filenames);
+    reader->UpdateOutputInformation();
+
+    typename ImageType::Pointer volume = ImageType::New();
+    volume->CopyInformation(reader->GetOutput());
+    volume->SetRegions(reader->GetOutput()->GetLargestPossibleRegion());
+    volume->Allocate();
+
+    const std::size_t numberOfPixels = volume->GetLargestPossibleRegion().GetNumberOfPixels();
+
+    if (filenames.empty() || 0 != numberOfPixels % filenames.size())
+    {
+      mitkThrow() << "Error while loading DICOM series. Volume of " << numberOfPixels << " pixels cannot be composed of "
+                  << filenames.size() << " frames of equal size.";
+    }
+
+    // ImageSeriesReader stacks the files along the slowest dimension, so every file occupies a contiguous part of the buffer
+    const std::size_t pixelsPerFrame = numberOfPixels / filenames.size();
+
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+      frames.push_back({ &filenames[i], volume->GetBufferPointer() + i * pixelsPerFrame, pixelsPerFrame });
+    }
+
+    volumes.push_back(volume);
+  }
+
+  // the progress bar is only updated by the calling thread
+  ProgressBar::GetInstance()->AddStepsToDo( frames.size() );
+
+  mitk::ParallelFor( frames.size(),
+    [&frames]( std::size_t i ) {
+      LoadFrame<ImageType>( *frames[i].Filename, frames[i].Buffer, frames[i].NumberOfPixels );
+    },
+    0,
+    []( std::size_t steps ) { ProgressBar::GetInstance()->Progress( static_cast<unsigned int>( steps ) ); } );
+
+  return volumes;
+}
+
+template <typename ImageType>
+void
+mitk::ITKDICOMSeriesReaderHelper
+::LoadFrame( const std::string& filename, typename ImageType::PixelType* buffer, std::size_t numberOfPixels )
+{
+  typedef typename ImageType::PixelType PixelType;
+  typedef typename itk::NumericTraits<PixelType>::ValueType ComponentType;
+
+  itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+  io->SetFileName(filename);
+  io->ReadImageInformation();
+
+  if (io->GetImageSizeInPixels() != numberOfPixels)
+  {
+    mitkThrow() << "Error while loading DICOM series. File '" << filename << "' contains " << io->GetImageSizeInPixels()
+                << " pixels, " << numberOfPixels << " pixels were expected.";
+  }
+
+  if (io->GetComponentType() == itk::ImageIOBase::MapPixelType<ComponentType>::CType &&
+      io->GetNumberOfComponents() == itk::PixelTraits<PixelType>::Dimension)
+  {
+    // decode directly into the slot of the frame
+    io->Read(buffer);
+  }
+  else
+  {
+    // the pixel type of this file differs from the first file of the series (e.g. due to a different rescale slope),
+    // let ITK convert the pixels
+    typedef itk::ImageFileReader<ImageType> ReaderType;
+    typename ReaderType::Pointer reader = ReaderType::New();
+    reader->SetImageIO(io);
+    reader->SetFileName(filename);
+    reader->Update();
+
+    const auto* frame = reader->GetOutput();
+    std::copy(frame->GetBufferPointer(), frame->GetBufferPointer() + numberOfPixels, buffer);
+  }
+}
+
 template <typename ImageType>
 typename ImageType::Pointer
 mitk::ITKDICOMSeriesReaderHelper
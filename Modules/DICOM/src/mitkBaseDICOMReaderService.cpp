@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include <mitkCustomMimeType.h>
 #include <mitkIOMimeTypes.h>
 #include <mitkDICOMFileReaderSelector.h>
+#include <mitkDICOMITKSeriesGDCMReader.h>
 #include <mitkImage.h>
 #include <mitkDICOMFilesHelper.h>
 #include <mitkDICOMTagsOfInterestHelper.h>
@@ -33,17 +34,32 @@ found in the LICENSE file.
 #include <itksys/SystemTools.hxx>
 #include <itksys/Directory.hxx>
 
+namespace
+{
+  /** Reader option that enables DICOMITKSeriesGDCMReader::SetProgressiveLoading() */
+  const std::string ProgressiveLoadingOption = "Load progressively";
+}
+
 namespace mitk
 {
 
   BaseDICOMReaderService::BaseDICOMReaderService(const std::string& description)
     : AbstractFileReader(CustomMimeType(IOMimeTypes::DICOM_MIMETYPE()), description)
 {
+  this->InitializeDefaultOptions();
 }
 
 BaseDICOMReaderService::BaseDICOMReaderService(const mitk::CustomMimeType& customType, const std::string& description)
   : AbstractFileReader(customType, description)
 {
+  this->InitializeDefaultOptions();
+}
+
+void BaseDICOMReaderService::InitializeDefaultOptions()
+{
+  Options defaultOptions;
+  defaultOptions[ProgressiveLoadingOption] = false;
+  this->SetDefaultOptions(defaultOptions);
 }
 
 void BaseDICOMReaderService::SetOnlyRegardOwnSeries(bool regard)
@@ -135,6 +151,12 @@ std::vector<itk::SmartPointer<BaseData> > BaseDICOMReaderService::DoRead()
             m_ReadFiles.push_back( relevantFiles.at(i) );
           }
 
+          auto* gdcmReader = dynamic_cast<mitk::DICOMITKSeriesGDCMReader*>(reader.GetPointer());
+          if (nullptr != gdcmReader)
+          {
+            gdcmReader->SetProgressiveLoading(us::any_cast<bool>(this->GetOption(ProgressiveLoadingOption)));
+          }
+
           reader->SetAdditionalTagsOfInterest(mitk::GetCurrentDICOMTagsOfInterest());
           reader->SetTagLookupTableToPropertyFunctor(mitk::GetDICOMPropertyForDICOMValuesFunctor);
           reader->SetInputFiles(relevantFiles);
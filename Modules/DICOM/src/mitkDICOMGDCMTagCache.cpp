@@ -82,23 +82,45 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
+{
+  FileTagValueMapType tagValues;
+
+  for (const auto& filename : inputFiles)
+  {
+    auto& fileValues = tagValues[filename];
+
+    for (const auto& mapping : scanner->GetMapping(filename.c_str()))
+    {
+      fileValues[DICOMTag(mapping.first.GetGroup(), mapping.first.GetElement())] =
+        mapping.second != nullptr ? mapping.second : "";
+    }
+  }
+
+  this->InitCache(scannedTags, std::move(tagValues), inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, FileTagValueMapType tagValues, const StringList& inputFiles)
 {
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_TagValues = std::move(tagValues);
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
   for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
-  }
-}
+    // the mapping points into m_TagValues, whose nodes and strings are not modified anymore
+    gdcm::Scanner::TagToValue mapping;
+    const auto fileValues = m_TagValues.find(*inputIter);
 
-const gdcm::Scanner&
-mitk::DICOMGDCMTagCache::GetScanner() const
-{
-  return *(this->m_Scanner);
+    if (fileValues != m_TagValues.cend())
+    {
+      for (const auto& value : fileValues->second)
+        mapping[gdcm::Tag(value.first.GetGroup(), value.first.GetElement())] = value.second.c_str();
+    }
+
+    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0), mapping).GetPointer());
+  }
 }
@@ -14,11 +14,310 @@ found in the LICENSE file.
 #include "mitkDICOMGDCMTagCache.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
 
+#include <mitkIOUtil.h>
+#include <mitkParallelFor.h>
+
 #include <gdcmScanner.h>
 
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace
+{
+  typedef mitk::DICOMGDCMTagCache::TagValueMapType TagValueMapType;
+  typedef mitk::DICOMGDCMTagCache::FileTagValueMapType FileTagValueMapType;
+
+  /** Files are distributed to the scanning threads in chunks of this size. */
+  const std::size_t ScanChunkSize = 32;
+
+  const char* const IndexHeader = "MITK DICOM tag index 1";
+
+  /** Tag values of a file together with the file state they were scanned from. */
+  struct IndexEntry
+  {
+    IndexEntry() : ModifiedTime(0), Size(0) {}
+
+    long int ModifiedTime;
+    unsigned long Size;
+    std::set<mitk::DICOMTag> ScannedTags;
+    TagValueMapType Values;
+  };
+
+  typedef std::map<std::string, IndexEntry> IndexType;
+
+  std::mutex DefaultIndexFileMutex;
+  std::string DefaultIndexFile;
+
+  /** Content of an index file. Scanning a file again appends a new record for it, so the index file
+   *  can contain several records per file, of which the last one is valid. */
+  struct IndexFileContent
+  {
+    IndexFileContent() : NumberOfRecords(0), Valid(false), Corrupt(false) {}
+
+    IndexType Index;
+    std::size_t NumberOfRecords;
+    bool Valid;
+    bool Corrupt;
+  };
+
+  std::string ReadString(std::istream& stream, std::size_t length)
+  {
+    std::string result(length, '\0');
+
+    if (length > 0)
+      stream.read(&result[0], length);
+
+    stream.ignore(1); // line break that follows each string
+    return result;
+  }
+
+  /** Reads the index file. Missing or unreadable index files result in an empty index,
+   *  the records in front of a corrupt part of an index file are kept. */
+  IndexFileContent ReadIndex(const std::string& indexFile)
+  {
+    IndexFileContent content;
+    std::ifstream stream(indexFile.c_str(), std::ios::binary);
+
+    if (!stream.is_open())
+      return content;
+
+    std::string header;
+    std::getline(stream, header);
+
+    if (header != IndexHeader)
+    {
+      MITK_WARN << "Ignoring DICOM tag index of unknown format: " << indexFile;
+      return content;
+    }
+
+    content.Valid = true;
+
+    std::size_t pathLength = 0;
+    IndexEntry entry;
+    std::size_t numberOfScannedTags = 0;
+    std::size_t numberOfValues = 0;
+
+    while (stream >> pathLength >> entry.ModifiedTime >> entry.Size >> numberOfScannedTags >> numberOfValues)
+    {
+      stream.ignore(1);
+      auto path = ReadString(stream, pathLength);
+
+      entry.ScannedTags.clear();
+      entry.Values.clear();
+
+      for (std::size_t i = 0; i < numberOfScannedTags; ++i)
+      {
+        unsigned int group = 0;
+        unsigned int element = 0;
+        stream >> group >> element;
+        entry.ScannedTags.insert(mitk::DICOMTag(group, element));
+      }
+
+      for (std::size_t i = 0; i < numberOfValues; ++i)
+      {
+        unsigned int group = 0;
+        unsigned int element = 0;
+        std::size_t valueLength = 0;
+        stream >> group >> element >> valueLength;
+        stream.ignore(1);
+        entry.Values[mitk::DICOMTag(group, element)] = ReadString(stream, valueLength);
+      }
+
+      if (!stream)
+        break;
+
+      content.Index[path] = entry;
+      ++content.NumberOfRecords;
+    }
+
+    if (!stream.eof())
+    {
+      MITK_WARN << "Ignoring corrupt part of DICOM tag index: " << indexFile;
+      content.Corrupt = true;
+    }
+
+    return content;
+  }
+
+  void WriteRecord(std::ostream& stream, const std::string& path, const IndexEntry& entry)
+  {
+    stream << path.size() << ' ' << entry.ModifiedTime << ' ' << entry.Size << ' '
+           << entry.ScannedTags.size() << ' ' << entry.Values.size() << '\n'
+           << path << '\n';
+
+    for (const auto& tag : entry.ScannedTags)
+      stream << tag.GetGroup() << ' ' << tag.GetElement() << '\n';
+
+    for (const auto& value : entry.Values)
+    {
+      stream << value.first.GetGroup() << ' ' << value.first.GetElement() << ' ' << value.second.size() << '\n'
+             << value.second << '\n';
+    }
+  }
+
+  /** Replaces target by source in a single step, so that readers see either the old or the new file. */
+  bool ReplaceFile(const std::string& source, const std::string& target)
+  {
+#ifdef _WIN32
+    return 0 != MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    return 0 == std::rename(source.c_str(), target.c_str());
+#endif
+  }
+
+  /** Writes the complete index to a new temporary file next to the index file and replaces the index file
+   *  afterwards, so that concurrent readers never see a partially written index. */
+  void ReplaceIndex(const std::string& indexFile, const IndexType& index)
+  {
+    auto directory = itksys::SystemTools::GetFilenamePath(indexFile);
+
+    if (directory.empty())
+      directory = ".";
+
+    std::ofstream stream;
+    std::string temporaryFile;
+
+    try
+    {
+      temporaryFile = mitk::IOUtil::CreateTemporaryFile(
+        stream, std::ios_base::binary, itksys::SystemTools::GetFilenameName(indexFile) + "-XXXXXX", directory);
+    }
+    catch (const mitk::Exception&)
+    {
+      MITK_WARN << "Could not write DICOM tag index: " << indexFile;
+      return;
+    }
+
+    stream << IndexHeader << '\n';
+
+    for (const auto& entry : index)
+      WriteRecord(stream, entry.first, entry.second);
+
+    stream.close();
+
+    if (!stream || !ReplaceFile(temporaryFile, indexFile))
+    {
+      MITK_WARN << "Could not write DICOM tag index: " << indexFile;
+      std::remove(temporaryFile.c_str());
+    }
+  }
+
+  /** Appends records for the given entries to the index file. */
+  void AppendToIndex(const std::string& indexFile, const IndexType& entries)
+  {
+    std::ofstream stream(indexFile.c_str(), std::ios::binary | std::ios::app);
+
+    for (const auto& entry : entries)
+      WriteRecord(stream, entry.first, entry.second);
+
+    stream.close();
+
+    if (!stream)
+      MITK_WARN << "Could not write DICOM tag index: " << indexFile;
+  }
+
+  /** Updates the index file with the newly scanned entries of content. New records are appended as long as
+   *  the index file does not mainly consist of obsolete records. Otherwise, and if entries were removed,
+   *  the index file is rewritten without obsolete records. */
+  void WriteIndex(const std::string& indexFile, const IndexFileContent& content, const IndexType& newEntries, bool entriesRemoved)
+  {
+    if (newEntries.empty() && !entriesRemoved && !content.Corrupt)
+      return;
+
+    const auto numberOfRecords = content.NumberOfRecords + newEntries.size();
+    const auto numberOfObsoleteRecords = numberOfRecords - std::min(numberOfRecords, content.Index.size());
+
+    if (!content.Valid || content.Corrupt || entriesRemoved || numberOfObsoleteRecords > content.Index.size())
+    {
+      ReplaceIndex(indexFile, content.Index);
+    }
+    else
+    {
+      AppendToIndex(indexFile, newEntries);
+    }
+  }
+
+  /** Removes the entries of files that no longer exist in the directories of the given files from the index.
+   *  Other directories are not checked, to keep the costs independent of the size of the index. */
+  bool PruneIndex(IndexType& index, const mitk::StringList& filenames)
+  {
+    std::set<std::string> directories;
+
+    for (const auto& filename : filenames)
+      directories.insert(itksys::SystemTools::GetFilenamePath(filename));
+
+    bool entriesRemoved = false;
+
+    for (const auto& directory : directories)
+    {
+      // the index is sorted by path, so the entries of a directory are found among the paths that start with it
+      for (auto entry = index.lower_bound(directory); entry != index.end() && 0 == entry->first.compare(0, directory.size(), directory);)
+      {
+        if (itksys::SystemTools::GetFilenamePath(entry->first) == directory && !itksys::SystemTools::FileExists(entry->first, true))
+        {
+          entry = index.erase(entry);
+          entriesRemoved = true;
+        }
+        else
+        {
+          ++entry;
+        }
+      }
+    }
+
+    return entriesRemoved;
+  }
+
+  /** Scans the given files in parallel. Every chunk of files is scanned by its own gdcm::Scanner. */
+  void ScanFiles(const mitk::StringList& filenames, const std::set<mitk::DICOMTag>& tags, FileTagValueMapType& tagValues)
+  {
+    const auto numberOfChunks = (filenames.size() + ScanChunkSize - 1) / ScanChunkSize;
+    std::vector<FileTagValueMapType> chunkValues(numberOfChunks);
+
+    mitk::ParallelFor(numberOfChunks, [&](std::size_t chunk) {
+      gdcm::Scanner scanner;
+
+      for (const auto& tag : tags)
+        scanner.AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+
+      const auto begin = filenames.cbegin() + chunk * ScanChunkSize;
+      const auto end = filenames.cbegin() + std::min(filenames.size(), (chunk + 1) * ScanChunkSize);
+      const mitk::StringList chunkFilenames(begin, end);
+
+      scanner.Scan(chunkFilenames);
+
+      for (const auto& filename : chunkFilenames)
+      {
+        auto& fileValues = chunkValues[chunk][filename];
+
+        for (const auto& mapping : scanner.GetMapping(filename.c_str()))
+        {
+          fileValues[mitk::DICOMTag(mapping.first.GetGroup(), mapping.first.GetElement())] =
+            mapping.second != nullptr ? mapping.second : "";
+        }
+      }
+    });
+
+    for (auto& values : chunkValues)
+    {
+      for (auto& fileValues : values)
+        tagValues[fileValues.first] = std::move(fileValues.second);
+    }
+  }
+}
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
+  : m_IndexFile(GetDefaultIndexFile()),
+    m_NumberOfScannedFiles(0)
 {
-  m_GDCMScanner = std::make_shared<gdcm::Scanner>();
 }
 
 mitk::DICOMGDCMTagScanner::~DICOMGDCMTagScanner()
@@ -40,9 +339,7 @@ mitk::DICOMDatasetFinding mitk::DICOMGDCMTagScanner::GetTagValue( DICOMImageFram
 
 void mitk::DICOMGDCMTagScanner::AddTag( const DICOMTag& tag )
 {
-  m_ScannedTags.insert( tag );
-  m_GDCMScanner->AddTag(
-    gdcm::Tag( tag.GetGroup(), tag.GetElement() ) ); // also a set, duplicate calls to AddTag don't hurt
+  m_ScannedTags.insert( tag ); // a set, duplicate calls to AddTag don't hurt
 }
 
 void mitk::DICOMGDCMTagScanner::AddTags( const DICOMTagList& tags )
@@ -90,17 +387,111 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 }
 
 
+void mitk::DICOMGDCMTagScanner::SetIndexFile(const std::string& indexFile)
+{
+  m_IndexFile = indexFile;
+}
+
+std::string mitk::DICOMGDCMTagScanner::GetIndexFile() const
+{
+  return m_IndexFile;
+}
+
+void mitk::DICOMGDCMTagScanner::SetDefaultIndexFile(const std::string& indexFile)
+{
+  std::lock_guard<std::mutex> lock(DefaultIndexFileMutex);
+  DefaultIndexFile = indexFile;
+}
+
+std::string mitk::DICOMGDCMTagScanner::GetDefaultIndexFile()
+{
+  std::lock_guard<std::mutex> lock(DefaultIndexFileMutex);
+  return DefaultIndexFile;
+}
+
 void mitk::DICOMGDCMTagScanner::Scan()
 {
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+  FileTagValueMapType tagValues;
+  StringList filesToScan;
+
+  IndexFileContent indexContent;
+  auto& index = indexContent.Index;
+  bool indexEntriesRemoved = false;
+
+  if (!m_IndexFile.empty())
+  {
+    indexContent = ReadIndex(m_IndexFile);
+    indexEntriesRemoved = PruneIndex(index, m_InputFilenames);
+  }
+
+  for (const auto& filename : m_InputFilenames)
+  {
+    if (tagValues.find(filename) != tagValues.end())
+      continue;
+
+    if (!m_IndexFile.empty())
+    {
+      auto entry = index.find(filename);
+
+      if (entry != index.end() && entry->second.ModifiedTime == itksys::SystemTools::ModifiedTime(filename) &&
+          entry->second.Size == itksys::SystemTools::FileLength(filename) &&
+          std::includes(entry->second.ScannedTags.cbegin(), entry->second.ScannedTags.cend(), m_ScannedTags.cbegin(), m_ScannedTags.cend()))
+      {
+        tagValues[filename] = entry->second.Values;
+        continue;
+      }
+    }
+
+    tagValues[filename]; // marks the file as handled, even if it occurs several times in the input
+    filesToScan.push_back(filename);
+  }
+
+  ScanFiles(filesToScan, m_ScannedTags, tagValues);
+  m_NumberOfScannedFiles = filesToScan.size();
+
+  if (!m_IndexFile.empty())
+  {
+    IndexType newEntries;
+
+    for (const auto& filename : filesToScan)
+    {
+      auto& entry = index[filename];
+      const auto modifiedTime = itksys::SystemTools::ModifiedTime(filename);
+      const auto size = itksys::SystemTools::FileLength(filename);
+
+      // keep the values of tags that were scanned earlier if the file did not change since then
+      if (entry.ModifiedTime != modifiedTime || entry.Size != size)
+      {
+        entry = IndexEntry();
+        entry.ModifiedTime = modifiedTime;
+        entry.Size = size;
+      }
+
+      for (const auto& tag : m_ScannedTags)
+        entry.Values.erase(tag);
+
+      const auto& scannedValues = tagValues[filename];
+      entry.Values.insert(scannedValues.cbegin(), scannedValues.cend());
+      entry.ScannedTags.insert(m_ScannedTags.cbegin(), m_ScannedTags.cend());
+
+      newEntries[filename] = entry;
+    }
+
+    WriteIndex(m_IndexFile, indexContent, newEntries, indexEntriesRemoved);
+  }
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  newCache->InitCache(m_ScannedTags, std::move(tagValues), m_InputFilenames);
 
   m_Cache = newCache;
 }
 
+std::size_t mitk::DICOMGDCMTagScanner::GetNumberOfScannedFiles() const
+{
+  return m_NumberOfScannedFiles;
+}
+
 mitk::DICOMTagCache::Pointer
 mitk::DICOMGDCMTagScanner::GetScanCache() const
 {
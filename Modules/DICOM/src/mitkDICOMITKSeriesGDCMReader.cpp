@@ -28,6 +28,7 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 : DICOMFileReader()
 , m_FixTiltByShearing(m_DefaultFixTiltByShearing)
 , m_SimpleVolumeReading( simpleVolumeImport )
+, m_ProgressiveLoading( false )
 , m_DecimalPlacesForOrientation( decimalPlacesForOrientation )
 , m_ExternalCache(false)
 {
@@ -38,6 +39,7 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGDCMReader& other )
 : DICOMFileReader( other )
 , m_FixTiltByShearing( other.m_FixTiltByShearing)
+, m_ProgressiveLoading( other.m_ProgressiveLoading )
 , m_SortingResultInProgress( other.m_SortingResultInProgress )
 , m_Sorter( other.m_Sorter )
 , m_EquiDistantBlocksSorter( other.m_EquiDistantBlocksSorter->Clone() )
@@ -61,6 +63,7 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
   {
     DICOMFileReader::operator                =( other );
     this->m_FixTiltByShearing                = other.m_FixTiltByShearing;
+    this->m_ProgressiveLoading               = other.m_ProgressiveLoading;
     this->m_SortingResultInProgress          = other.m_SortingResultInProgress;
     this->m_Sorter                           = other.m_Sorter; // TODO should clone the list items
     this->m_EquiDistantBlocksSorter          = other.m_EquiDistantBlocksSorter->Clone();
@@ -119,6 +122,17 @@ bool mitk::DICOMITKSeriesGDCMReader::GetFixTiltByShearing() const
   return m_FixTiltByShearing;
 }
 
+void mitk::DICOMITKSeriesGDCMReader::SetProgressiveLoading( bool on )
+{
+  this->Modified();
+  m_ProgressiveLoading = on;
+}
+
+bool mitk::DICOMITKSeriesGDCMReader::GetProgressiveLoading() const
+{
+  return m_ProgressiveLoading;
+}
+
 void mitk::DICOMITKSeriesGDCMReader::SetAcceptTwoSlicesGroups( bool accept ) const
 {
   this->Modified();
@@ -450,7 +464,19 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
   bool success( true );
   try
   {
-    mitk::Image::Pointer mitkImage = helper.Load( filenames, m_FixTiltByShearing && hasTilt, tiltInfo );
+    const bool correctTilt = m_FixTiltByShearing && hasTilt;
+    mitk::Image::Pointer mitkImage;
+
+    if ( m_ProgressiveLoading && !correctTilt )
+    {
+      mitkImage = helper.LoadProgressively( filenames );
+    }
+
+    if ( mitkImage.IsNull() )
+    {
+      mitkImage = helper.Load( filenames, correctTilt, tiltInfo );
+    }
+
     block.SetMitkImage( mitkImage );
   }
   catch ( const std::exception& e )
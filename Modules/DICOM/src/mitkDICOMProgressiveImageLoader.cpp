@@ -0,0 +1,267 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMProgressiveImageLoader.h"
+
+#include <mitkCallbackFromGUIThread.h>
+#include <mitkExceptionMacro.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+
+namespace
+{
+  /** Modifies the image when executed, keeps it alive until then */
+  class ModifyImageCommand : public itk::Command
+  {
+    public:
+
+      typedef ModifyImageCommand Self;
+      typedef itk::Command Superclass;
+      typedef itk::SmartPointer<Self> Pointer;
+
+      itkNewMacro( Self );
+
+      void SetImage( mitk::Image* image ) { m_Image = image; }
+
+      void Execute( itk::Object*, const itk::EventObject& ) override { this->ModifyImage(); }
+      void Execute( const itk::Object*, const itk::EventObject& ) override { this->ModifyImage(); }
+
+    private:
+
+      void ModifyImage()
+      {
+        if ( m_Image.IsNotNull() )
+          m_Image->Modified();
+      }
+
+      mitk::Image::Pointer m_Image;
+  };
+
+  /** The image is modified at most this often while loading, to limit the number of re-renderings */
+  const auto ModificationInterval = std::chrono::milliseconds( 200 );
+
+  std::mutex RegistryMutex;
+  std::vector<std::shared_ptr<mitk::DICOMProgressiveImageLoader>> Registry;
+
+  /** Removes the finished loaders from the registry, requires the lock of RegistryMutex */
+  void RemoveFinishedLoaders()
+  {
+    Registry.erase( std::remove_if( Registry.begin(), Registry.end(),
+                                    []( const std::shared_ptr<mitk::DICOMProgressiveImageLoader>& loader ) { return loader->IsFinished(); } ),
+                    Registry.end() );
+  }
+}
+
+std::shared_ptr<mitk::DICOMProgressiveImageLoader> mitk::DICOMProgressiveImageLoader::Start( Image* image,
+                                                                                              std::size_t numberOfFrames,
+                                                                                              const std::vector<std::size_t>& frameOrder,
+                                                                                              const LoadFrameFunctionType& loadFrame,
+                                                                                              unsigned int numberOfThreads )
+{
+  std::shared_ptr<DICOMProgressiveImageLoader> loader(
+    new DICOMProgressiveImageLoader( image, numberOfFrames, frameOrder, loadFrame ) );
+
+  if ( frameOrder.empty() )
+    return loader;
+
+  if ( 0 == numberOfThreads )
+  {
+    // one core is left to the application
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    numberOfThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+
+  numberOfThreads = static_cast<unsigned int>( std::min<std::size_t>( numberOfThreads, frameOrder.size() ) );
+
+  {
+    std::lock_guard<std::mutex> lock( loader->m_JoinMutex );
+    loader->m_NumberOfRunningThreads = numberOfThreads;
+
+    for ( unsigned int i = 0; i < numberOfThreads; ++i )
+      loader->m_Threads.emplace_back( &DICOMProgressiveImageLoader::Run, loader.get() );
+  }
+
+  std::lock_guard<std::mutex> lock( RegistryMutex );
+  RemoveFinishedLoaders();
+  Registry.push_back( loader );
+
+  return loader;
+}
+
+std::shared_ptr<mitk::DICOMProgressiveImageLoader> mitk::DICOMProgressiveImageLoader::GetLoader( const Image* image )
+{
+  std::lock_guard<std::mutex> lock( RegistryMutex );
+  RemoveFinishedLoaders();
+
+  for ( const auto& loader : Registry )
+  {
+    if ( loader->GetImage() == image )
+      return loader;
+  }
+
+  return nullptr;
+}
+
+void mitk::DICOMProgressiveImageLoader::CancelAll()
+{
+  std::vector<std::shared_ptr<DICOMProgressiveImageLoader>> loaders;
+
+  {
+    std::lock_guard<std::mutex> lock( RegistryMutex );
+    loaders.swap( Registry );
+  }
+
+  for ( const auto& loader : loaders )
+    loader->Cancel();
+}
+
+mitk::DICOMProgressiveImageLoader::DICOMProgressiveImageLoader( Image* image,
+                                                                std::size_t numberOfFrames,
+                                                                const std::vector<std::size_t>& frameOrder,
+                                                                const LoadFrameFunctionType& loadFrame )
+: m_Image( image )
+, m_FrameOrder( frameOrder )
+, m_LoadFrame( loadFrame )
+, m_NextFrame( 0 )
+, m_Cancelled( false )
+, m_LoadedFrames( numberOfFrames, true )
+, m_NumberOfLoadedFrames( numberOfFrames )
+, m_NumberOfRunningThreads( 0 )
+, m_LastModification( std::chrono::steady_clock::now() )
+{
+  for ( const auto frame : m_FrameOrder )
+  {
+    if ( frame >= numberOfFrames || !m_LoadedFrames[frame] )
+      mitkThrow() << "Invalid order of DICOM frames to load progressively.";
+
+    m_LoadedFrames[frame] = false;
+    --m_NumberOfLoadedFrames;
+  }
+}
+
+mitk::DICOMProgressiveImageLoader::~DICOMProgressiveImageLoader()
+{
+  this->Cancel();
+}
+
+void mitk::DICOMProgressiveImageLoader::Cancel()
+{
+  m_Cancelled = true;
+  this->Join();
+}
+
+void mitk::DICOMProgressiveImageLoader::Wait()
+{
+  this->Join();
+  m_Image->Modified();
+}
+
+void mitk::DICOMProgressiveImageLoader::Join()
+{
+  std::lock_guard<std::mutex> lock( m_JoinMutex );
+
+  for ( auto& thread : m_Threads )
+  {
+    if ( thread.joinable() )
+      thread.join();
+  }
+}
+
+bool mitk::DICOMProgressiveImageLoader::IsFrameLoaded( std::size_t frame ) const
+{
+  std::lock_guard<std::mutex> lock( m_Mutex );
+  return frame < m_LoadedFrames.size() && m_LoadedFrames[frame];
+}
+
+std::size_t mitk::DICOMProgressiveImageLoader::GetNumberOfLoadedFrames() const
+{
+  std::lock_guard<std::mutex> lock( m_Mutex );
+  return m_NumberOfLoadedFrames;
+}
+
+std::size_t mitk::DICOMProgressiveImageLoader::GetNumberOfFrames() const
+{
+  return m_LoadedFrames.size();
+}
+
+bool mitk::DICOMProgressiveImageLoader::IsFinished() const
+{
+  std::lock_guard<std::mutex> lock( m_Mutex );
+  return 0 == m_NumberOfRunningThreads;
+}
+
+const mitk::Image* mitk::DICOMProgressiveImageLoader::GetImage() const
+{
+  return m_Image;
+}
+
+void mitk::DICOMProgressiveImageLoader::Run()
+{
+  const auto numberOfFrames = m_FrameOrder.size();
+
+  for ( auto i = m_NextFrame++; i < numberOfFrames && !m_Cancelled; i = m_NextFrame++ )
+  {
+    const auto frame = m_FrameOrder[i];
+    bool loaded = false;
+
+    try
+    {
+      m_LoadFrame( m_Image, frame );
+      loaded = true;
+    }
+    catch ( const std::exception& e )
+    {
+      MITK_ERROR << "Error encountered when loading DICOM frame " << frame << " progressively: " << e.what();
+    }
+    catch ( ... )
+    {
+      MITK_ERROR << "Unspecified error encountered when loading DICOM frame " << frame << " progressively.";
+    }
+
+    std::lock_guard<std::mutex> lock( m_Mutex );
+
+    if ( loaded )
+    {
+      m_LoadedFrames[frame] = true;
+      ++m_NumberOfLoadedFrames;
+    }
+
+    this->RequestModification( false );
+  }
+
+  std::lock_guard<std::mutex> lock( m_Mutex );
+
+  // the last thread makes sure that the final state is rendered
+  if ( 0 == --m_NumberOfRunningThreads && !m_Cancelled )
+    this->RequestModification( true );
+}
+
+void mitk::DICOMProgressiveImageLoader::RequestModification( bool force )
+{
+  const auto now = std::chrono::steady_clock::now();
+
+  if ( !force && now - m_LastModification < ModificationInterval )
+    return;
+
+  m_LastModification = now;
+
+  // without GUI, the image is modified by Wait()
+  if ( !CallbackFromGUIThread::HasImplementation() )
+    return;
+
+  // Modified() notifies observers (e.g. mappers), so it must not be called from a loading thread
+  auto command = ModifyImageCommand::New();
+  command->SetImage( m_Image );
+  CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread( command );
+}
@@ -29,10 +29,12 @@ found in the LICENSE file.
 
 #include "mitkDICOMGDCMTagScanner.h"
 #include "mitkArbitraryTimeGeometry.h"
+#include "mitkProgressBar.h"
 
 #include "dcmtk/dcmdata/dcvrda.h"
 
 
+
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionDateTag = mitk::DICOMTag( 0x0008, 0x0022 );
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionTimeTag = mitk::DICOMTag( 0x0008, 0x0032 );
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::TriggerTimeTag = mitk::DICOMTag( 0x0018, 0x1060 );
@@ -122,6 +124,86 @@ mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load( const StringContain
   return nullptr;
 }
 
+#define switchProgressiveCase( IOType, T ) \
+  case IOType:                             \
+    return LoadDICOMByITKProgressively<T>( filenames, io );
+
+mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::LoadProgressively( const StringContainer& filenames )
+{
+  if ( filenames.empty() )
+  {
+    MITK_DEBUG
+      << "Calling LoadDicomSeries with empty filename string container. Probably invalid application logic.";
+    return nullptr; // this is not actually an error but the result is very simple
+  }
+
+  typedef itk::GDCMImageIO DcmIoType;
+  DcmIoType::Pointer io = DcmIoType::New();
+
+  try
+  {
+    if ( io->CanReadFile( filenames.front().c_str() ) )
+    {
+      io->SetFileName( filenames.front().c_str() );
+      io->ReadImageInformation();
+
+      if ( io->GetPixelType() == itk::ImageIOBase::SCALAR )
+      {
+        switch ( io->GetComponentType() )
+        {
+          switchProgressiveCase( DcmIoType::UCHAR, unsigned char )
+          switchProgressiveCase( DcmIoType::CHAR, char )
+          switchProgressiveCase( DcmIoType::USHORT, unsigned short )
+          switchProgressiveCase( DcmIoType::SHORT, short )
+          switchProgressiveCase( DcmIoType::UINT, unsigned int )
+          switchProgressiveCase( DcmIoType::INT, int )
+          switchProgressiveCase( DcmIoType::ULONG, long unsigned int )
+          switchProgressiveCase( DcmIoType::LONG, long int )
+          switchProgressiveCase( DcmIoType::FLOAT, float )
+          switchProgressiveCase( DcmIoType::DOUBLE, double )
+          default:
+            MITK_ERROR << "Found unsupported DICOM scalar pixel type: (enum value) " << io->GetComponentType();
+        }
+      }
+      else if ( io->GetPixelType() == itk::ImageIOBase::RGB )
+      {
+        switch ( io->GetComponentType() )
+        {
+          switchProgressiveCase( DcmIoType::UCHAR, itk::RGBPixel<unsigned char> )
+          switchProgressiveCase( DcmIoType::CHAR, itk::RGBPixel<char> )
+          switchProgressiveCase( DcmIoType::USHORT, itk::RGBPixel<unsigned short> )
+          switchProgressiveCase( DcmIoType::SHORT, itk::RGBPixel<short> )
+          switchProgressiveCase( DcmIoType::UINT, itk::RGBPixel<unsigned int> )
+          switchProgressiveCase( DcmIoType::INT, itk::RGBPixel<int> )
+          switchProgressiveCase( DcmIoType::ULONG, itk::RGBPixel<long unsigned int> )
+          switchProgressiveCase( DcmIoType::LONG, itk::RGBPixel<long int> )
+          switchProgressiveCase( DcmIoType::FLOAT, itk::RGBPixel<float> )
+          switchProgressiveCase( DcmIoType::DOUBLE, itk::RGBPixel<double> )
+          default:
+            MITK_ERROR << "Found unsupported DICOM scalar pixel type: (enum value) " << io->GetComponentType();
+        }
+      }
+
+      MITK_ERROR << "Unsupported DICOM pixel type";
+      return nullptr;
+    }
+  }
+  catch ( const itk::MemoryAllocationError& e )
+  {
+    MITK_ERROR << "Out of memory. Cannot load DICOM series: " << e.what();
+  }
+  catch ( const std::exception& e )
+  {
+    MITK_ERROR << "Error encountered when loading DICOM series:" << e.what();
+  }
+  catch ( ... )
+  {
+    MITK_ERROR << "Unspecified error encountered when loading DICOM series.";
+  }
+
+  return nullptr;
+}
+
 #define switch3DnTCase( IOType, T ) \
   case IOType:                      \
     return LoadDICOMByITK3DnT<T>( filenamesLists, correctTilt, tiltInfo, io );
@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMGDCMTagScanner.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkIOUtil.h>
+
+#include <itksys/SystemTools.hxx>
+
+class mitkDICOMGDCMTagScannerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMGDCMTagScannerTestSuite);
+
+  MITK_TEST(MultiFileScanning);
+  MITK_TEST(IndexedScanning);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  std::string indexDirectory;
+
+  const mitk::DICOMTag tagImagePositionPatient = mitk::DICOMTag(0x0020, 0x0032);
+  const mitk::DICOMTag tagSOPInstanceUID = mitk::DICOMTag(0x0008, 0x0018);
+
+  mitk::DICOMDatasetAccessingImageFrameList Scan(const std::string& indexFile, std::size_t* numberOfScannedFiles = nullptr)
+  {
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetIndexFile(indexFile);
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTag(tagImagePositionPatient);
+    scanner->AddTag(tagSOPInstanceUID);
+    scanner->Scan();
+
+    if (nullptr != numberOfScannedFiles)
+      *numberOfScannedFiles = scanner->GetNumberOfScannedFiles();
+
+    return scanner->GetFrameInfoList();
+  }
+
+  void CheckEqual(const mitk::DICOMDatasetAccessingImageFrameList& expected, const mitk::DICOMDatasetAccessingImageFrameList& actual)
+  {
+    CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(expected[i]->Filename, actual[i]->Filename);
+
+      for (const auto& tag : { tagImagePositionPatient, tagSOPInstanceUID })
+      {
+        auto expectedFinding = expected[i]->GetTagValueAsString(tag);
+        auto actualFinding = actual[i]->GetTagValueAsString(tag);
+
+        CPPUNIT_ASSERT_EQUAL(expectedFinding.isValid, actualFinding.isValid);
+        CPPUNIT_ASSERT_EQUAL(expectedFinding.value, actualFinding.value);
+      }
+    }
+  }
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    indexDirectory = mitk::IOUtil::CreateTemporaryDirectory("DICOMTagIndexTest-XXXXXX");
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveADirectory(indexDirectory);
+  }
+
+  void MultiFileScanning()
+  {
+    auto frames = this->Scan("");
+    CPPUNIT_ASSERT_EQUAL(ctFiles.size(), frames.size());
+
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(ctFiles[i], frames[i]->Filename);
+      CPPUNIT_ASSERT_MESSAGE("Testing validity of SOP instance UID", frames[i]->GetTagValueAsString(tagSOPInstanceUID).isValid);
+      CPPUNIT_ASSERT_MESSAGE("Testing value of SOP instance UID", !frames[i]->GetTagValueAsString(tagSOPInstanceUID).value.empty());
+    }
+  }
+
+  void IndexedScanning()
+  {
+    const std::string indexFile = indexDirectory + "/index";
+    std::size_t numberOfScannedFiles = 0;
+    auto expectedFrames = this->Scan("", &numberOfScannedFiles);
+    CPPUNIT_ASSERT_EQUAL(ctFiles.size(), numberOfScannedFiles);
+
+    auto framesWritingIndex = this->Scan(indexFile, &numberOfScannedFiles);
+    CPPUNIT_ASSERT_MESSAGE("Testing creation of index file", itksys::SystemTools::FileExists(indexFile.c_str(), true));
+    CPPUNIT_ASSERT_EQUAL(ctFiles.size(), numberOfScannedFiles);
+    CheckEqual(expectedFrames, framesWritingIndex);
+
+    const auto indexFileSize = itksys::SystemTools::FileLength(indexFile);
+
+    auto framesReadingIndex = this->Scan(indexFile, &numberOfScannedFiles);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing that no file is parsed if all files are indexed", std::size_t(0), numberOfScannedFiles);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing that an up-to-date index is not rewritten", indexFileSize, itksys::SystemTools::FileLength(indexFile));
+    CheckEqual(expectedFrames, framesReadingIndex);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMGDCMTagScanner)
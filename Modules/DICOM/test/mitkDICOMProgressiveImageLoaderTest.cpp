@@ -0,0 +1,110 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMProgressiveImageLoader.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+class mitkDICOMProgressiveImageLoaderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMProgressiveImageLoaderTestSuite);
+
+  MITK_TEST(Wait_AllFramesLoaded);
+  MITK_TEST(Cancel_StopsLoading);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  static const unsigned int Size = 8;
+
+  mitk::Image::Pointer m_Image;
+  std::vector<std::size_t> m_FrameOrder;
+
+  /** Writes the frame index into every pixel of the slice */
+  static void LoadFrame(mitk::Image* image, std::size_t frame)
+  {
+    mitk::ImageWriteAccessor accessor(image);
+    auto* data = static_cast<unsigned char*>(accessor.GetData()) + frame * Size * Size;
+    std::memset(data, static_cast<int>(frame + 1), Size * Size);
+  }
+
+public:
+
+  void setUp() override
+  {
+    unsigned int dimensions[] = { Size, Size, Size };
+
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(m_Image);
+    std::memset(accessor.GetData(), 0, Size * Size * Size);
+
+    // frame 0 is regarded as loaded already
+    m_FrameOrder.clear();
+    for (std::size_t frame = Size - 1; frame > 0; --frame)
+      m_FrameOrder.push_back(frame);
+  }
+
+  void tearDown() override
+  {
+    mitk::DICOMProgressiveImageLoader::CancelAll();
+    m_Image = nullptr;
+  }
+
+  void Wait_AllFramesLoaded()
+  {
+    auto loader = mitk::DICOMProgressiveImageLoader::Start(m_Image, Size, m_FrameOrder, &LoadFrame, 2);
+    CPPUNIT_ASSERT(loader->IsFrameLoaded(0));
+
+    loader->Wait();
+
+    CPPUNIT_ASSERT(loader->IsFinished());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(Size), loader->GetNumberOfLoadedFrames());
+    CPPUNIT_ASSERT(nullptr == mitk::DICOMProgressiveImageLoader::GetLoader(m_Image));
+
+    mitk::ImageReadAccessor accessor(m_Image);
+    const auto* data = static_cast<const unsigned char*>(accessor.GetData());
+
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(data[0]));
+    for (std::size_t frame = 1; frame < Size; ++frame)
+    {
+      CPPUNIT_ASSERT(loader->IsFrameLoaded(frame));
+      CPPUNIT_ASSERT_EQUAL(static_cast<int>(frame + 1), static_cast<int>(data[frame * Size * Size + 5]));
+    }
+  }
+
+  void Cancel_StopsLoading()
+  {
+    auto loader = mitk::DICOMProgressiveImageLoader::Start(m_Image, Size, m_FrameOrder, [](mitk::Image* image, std::size_t frame) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      LoadFrame(image, frame);
+    }, 1);
+
+    loader->Cancel();
+
+    CPPUNIT_ASSERT(loader->IsFinished());
+    CPPUNIT_ASSERT(loader->GetNumberOfLoadedFrames() < Size);
+    CPPUNIT_ASSERT(nullptr == mitk::DICOMProgressiveImageLoader::GetLoader(m_Image));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMProgressiveImageLoader)
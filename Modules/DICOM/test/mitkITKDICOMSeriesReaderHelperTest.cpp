@@ -0,0 +1,219 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMITKSeriesGDCMReader.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkIOUtil.h>
+#include <mitkImageCast.h>
+
+#include <itkGDCMImageIO.h>
+#include <itkImageFileWriter.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
+#include <itkImageSeriesReader.h>
+#include <itkMetaDataObject.h>
+#include <itksys/Directory.hxx>
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <sstream>
+
+/**
+  \brief Verify that the frame-wise parallel decode of ITKDICOMSeriesReaderHelper yields
+  the same volume as itk::ImageSeriesReader, also for series whose files differ in pixel type.
+*/
+class mitkITKDICOMSeriesReaderHelperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkITKDICOMSeriesReaderHelperTestSuite);
+
+  MITK_TEST(Load_UniformPixelType_EqualsImageSeriesReader);
+  MITK_TEST(Load_MixedPixelTypes_EqualsImageSeriesReader);
+  MITK_TEST(Load_TinyCTAbdomen_EqualsImageSeriesReader);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  typedef itk::Image<double, 3> ReferenceImageType;
+
+  static const unsigned int Size = 32;
+
+  /** Enough frames to keep several threads busy */
+  static const unsigned int NumberOfSlices = 16;
+
+  std::string m_TempDirectory;
+
+  static unsigned int GetPixelValue(unsigned int x, unsigned int y, unsigned int z)
+  {
+    return (x * 31 + y * 17 + z * 101) % 4000;
+  }
+
+  /** Writes slice z of a synthetic CT series with the given pixel type */
+  template <typename TPixel>
+  std::string WriteSlice(unsigned int z)
+  {
+    typedef itk::Image<TPixel, 2> SliceType;
+
+    typename SliceType::SizeType size;
+    size.Fill(Size);
+
+    typename SliceType::Pointer slice = SliceType::New();
+    slice->SetRegions(size);
+    slice->Allocate();
+
+    itk::ImageRegionIterator<SliceType> iter(slice, slice->GetLargestPossibleRegion());
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      const auto& index = iter.GetIndex();
+      iter.Set(static_cast<TPixel>(GetPixelValue(index[0], index[1], z)));
+    }
+
+    itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+    io->KeepOriginalUIDOn();
+
+    itk::MetaDataDictionary& dictionary = io->GetMetaDataDictionary();
+    itk::EncapsulateMetaData<std::string>(dictionary, "0008|0016", "1.2.840.10008.5.1.4.1.1.2");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0008|0060", "CT");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|000d", "1.2.826.0.1.3680043.2.1125.1.1");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", "1.2.826.0.1.3680043.2.1125.1.1.1");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0013", std::to_string(z + 1));
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0032", "0\\0\\" + std::to_string(z));
+    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0037", "1\\0\\0\\0\\1\\0");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0028|0030", "1\\1");
+    itk::EncapsulateMetaData<std::string>(dictionary, "0018|0050", "1");
+    slice->SetMetaDataDictionary(dictionary);
+
+    const std::string filename = m_TempDirectory + "/slice" + std::to_string(z) + ".dcm";
+
+    typedef itk::ImageFileWriter<SliceType> WriterType;
+    typename WriterType::Pointer writer = WriterType::New();
+    writer->SetImageIO(io);
+    writer->SetInput(slice);
+    writer->SetFileName(filename);
+    writer->Update();
+
+    return filename;
+  }
+
+  /** Loads the files as one block and compares the image voxel by voxel with itk::ImageSeriesReader */
+  static void CheckLoadEqualsImageSeriesReader(const mitk::StringList& filenames)
+  {
+    mitk::DICOMITKSeriesGDCMReader::Pointer reader = mitk::DICOMITKSeriesGDCMReader::New();
+    reader->SetInputFiles(filenames);
+    reader->AnalyzeInputFiles();
+    CPPUNIT_ASSERT_EQUAL(1u, reader->GetNumberOfOutputs());
+    CPPUNIT_ASSERT(reader->LoadImages());
+
+    const mitk::DICOMImageBlockDescriptor& block = reader->GetOutput(0);
+    mitk::Image::Pointer image = block.GetMitkImage();
+    CPPUNIT_ASSERT(image.IsNotNull());
+
+    // read the frames in the order the reader has sorted them
+    std::vector<std::string> sortedFilenames;
+    for (const auto& frame : block.GetImageFrameList())
+    {
+      sortedFilenames.push_back(frame->Filename);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(filenames.size(), sortedFilenames.size());
+
+    typedef itk::ImageSeriesReader<ReferenceImageType> SeriesReaderType;
+    SeriesReaderType::Pointer seriesReader = SeriesReaderType::New();
+    seriesReader->SetImageIO(itk::GDCMImageIO::New());
+    seriesReader->SetFileNames(sortedFilenames);
+    seriesReader->Update();
+    ReferenceImageType::Pointer expected = seriesReader->GetOutput();
+
+    ReferenceImageType::Pointer actual;
+    mitk::CastToItkImage(image, actual);
+
+    CPPUNIT_ASSERT(expected->GetLargestPossibleRegion() == actual->GetLargestPossibleRegion());
+
+    itk::ImageRegionConstIterator<ReferenceImageType> expectedIter(expected, expected->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ReferenceImageType> actualIter(actual, actual->GetLargestPossibleRegion());
+
+    for (; !expectedIter.IsAtEnd(); ++expectedIter, ++actualIter)
+    {
+      if (expectedIter.Get() != actualIter.Get())
+      {
+        std::ostringstream message;
+        message << "Voxel " << expectedIter.GetIndex() << " is " << actualIter.Get() << ", expected "
+                << expectedIter.Get();
+        CPPUNIT_FAIL(message.str());
+      }
+    }
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_TempDirectory = mitk::IOUtil::CreateTemporaryDirectory("mitkITKDICOMSeriesReaderHelperTest_XXXXXX");
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveADirectory(m_TempDirectory);
+  }
+
+  void Load_UniformPixelType_EqualsImageSeriesReader()
+  {
+    mitk::StringList filenames;
+    for (unsigned int z = 0; z < NumberOfSlices; ++z)
+    {
+      filenames.push_back(this->WriteSlice<unsigned short>(z));
+    }
+
+    CheckLoadEqualsImageSeriesReader(filenames);
+  }
+
+  void Load_MixedPixelTypes_EqualsImageSeriesReader()
+  {
+    // every third file differs in pixel type from the others, so these frames are converted instead of being
+    // decoded directly into the volume
+    mitk::StringList filenames;
+    for (unsigned int z = 0; z < NumberOfSlices; ++z)
+    {
+      filenames.push_back(0 == z % 3 ? this->WriteSlice<short>(z) : this->WriteSlice<unsigned short>(z));
+    }
+
+    CheckLoadEqualsImageSeriesReader(filenames);
+  }
+
+  void Load_TinyCTAbdomen_EqualsImageSeriesReader()
+  {
+    const std::string directory = GetTestDataFilePath("TinyCTAbdomen");
+
+    itksys::Directory dir;
+    CPPUNIT_ASSERT(dir.Load(directory.c_str()));
+
+    mitk::StringList filenames;
+    for (unsigned long i = 0; i < dir.GetNumberOfFiles(); ++i)
+    {
+      const std::string file = dir.GetFile(i);
+      if (!file.empty() && '1' == file[0])
+      {
+        filenames.push_back(directory + "/" + file);
+      }
+    }
+
+    CPPUNIT_ASSERT(!filenames.empty());
+    std::sort(filenames.begin(), filenames.end());
+
+    CheckLoadEqualsImageSeriesReader(filenames);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkITKDICOMSeriesReaderHelper)
@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include "mitkImage.h"
 #include "mitkImageDataItem.h"
 
+#include <itkImageRegion.h>
 #include <itkObject.h>
 
 #include <vector>
@@ -28,7 +29,9 @@ namespace mitk
   /**
     \brief Holds one (compressed) mitk::Image
 
-    Uses zlib to compress the data of an mitk::Image.
+    Uses zlib to compress the data of an mitk::Image. The voxels of each time step are split into
+    3D tiles (see SetTileSize()), which are compressed independently and in parallel. Single tiles
+    or arbitrary regions of a time step can thus be restored without uncompressing the whole image.
 
     $Author$
   */
@@ -39,6 +42,9 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
+    typedef itk::Size<3> TileSizeType;
+    typedef itk::ImageRegion<3> RegionType;
+
       /**
        * \brief Creates a compressed version of the image.
        *
@@ -56,10 +62,52 @@ namespace mitk
      */
     Image::Pointer GetImage();
 
+    /**
+     * \brief Sets the maximum extent of a tile in voxels (default 64 x 64 x 16).
+     *
+     * Takes effect with the next call of SetImage(). Tiles at the image border are smaller.
+     */
+    void SetTileSize(const TileSizeType &tileSize);
+    TileSizeType GetTileSize() const { return m_TileSize; }
+
+    /**
+     * \brief Sets the maximum number of tiles that SetImage() compresses concurrently.
+     *
+     * 0 (default) uses the global default number of threads of ITK, 1 compresses in the calling thread.
+     */
+    itkSetMacro(MaximumNumberOfThreads, unsigned int);
+    itkGetConstMacro(MaximumNumberOfThreads, unsigned int);
+
+    /** \brief Returns the number of bytes occupied by the compressed voxel data. */
+    size_t GetCompressedSize() const;
+
+    /** \brief Returns the number of tiles per time step. */
+    unsigned int GetNumberOfTiles() const;
+
+    /** \brief Returns the voxel region of a time step that is covered by the given tile. */
+    RegionType GetTileRegion(unsigned int tileId) const;
+
+    /**
+     * \brief Uncompresses a single tile into a new 3D ImageDataItem of the tile region size.
+     * \throws mitk::Exception if time step or tile id are invalid or the data is corrupted
+     */
+    ImageDataItem::Pointer GetTileData(unsigned int timeStep, unsigned int tileId) const;
+
+    /**
+     * \brief Uncompresses a region of a time step into a new 3D ImageDataItem of the region size.
+     *
+     * Only the tiles intersecting the region are uncompressed.
+     * \throws mitk::Exception if the region exceeds the image or the data is corrupted
+     */
+    ImageDataItem::Pointer GetRegionData(unsigned int timeStep, const RegionType &region) const;
+
   protected:
     CompressedImageContainer(); // purposely hidden
     ~CompressedImageContainer() override;
 
+    /// uncompresses one tile of one time step into a buffer of the tile region size
+    void DecompressTile(unsigned int timeStep, unsigned int tileId, unsigned char *dest) const;
+
     PixelType *m_PixelType;
 
     unsigned int m_ImageDimension;
@@ -69,10 +117,20 @@ namespace mitk
 
     unsigned int m_NumberOfTimeSteps;
 
-    /// one for each timestep. first = pointer to compressed data; second = size of buffer in bytes
-    std::vector<std::pair<unsigned char *, unsigned long>> m_ByteBuffers;
+    TileSizeType m_TileSize;
+
+    /// extent of the compressed time steps (dimensions beyond the image dimension are 1)
+    TileSizeType m_VolumeSize;
+
+    /// number of tiles along each axis of a time step
+    TileSizeType m_NumberOfTilesPerAxis;
+
+    /// compressed tiles of all time steps, ordered by time step and tile id (x fastest)
+    std::vector<std::vector<unsigned char>> m_CompressedTiles;
 
     BaseGeometry::Pointer m_ImageGeometry;
+
+    unsigned int m_MaximumNumberOfThreads;
   };
 
 } // namespace
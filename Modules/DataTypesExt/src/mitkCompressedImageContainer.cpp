@@ -11,43 +11,125 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkExceptionMacro.h"
 #include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+#include "mitkParallelFor.h"
 
 #include "itk_zlib.h"
 
-#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
-mitk::CompressedImageContainer::CompressedImageContainer() : m_PixelType(nullptr), m_ImageGeometry(nullptr)
+namespace
 {
+  typedef mitk::CompressedImageContainer::RegionType RegionType;
+
+  /// Copies the voxels of region from a dense buffer covering sourceRegion into a dense buffer covering destRegion
+  void CopyRegion(const unsigned char *source,
+                  const RegionType &sourceRegion,
+                  unsigned char *dest,
+                  const RegionType &destRegion,
+                  const RegionType &region,
+                  size_t pixelSize)
+  {
+    const size_t rowLength = region.GetSize(0) * pixelSize;
+
+    for (auto z = region.GetIndex(2); z < region.GetUpperIndex()[2] + 1; ++z)
+    {
+      for (auto y = region.GetIndex(1); y < region.GetUpperIndex()[1] + 1; ++y)
+      {
+        const size_t sourceOffset =
+          ((z - sourceRegion.GetIndex(2)) * sourceRegion.GetSize(1) + (y - sourceRegion.GetIndex(1))) *
+            sourceRegion.GetSize(0) +
+          (region.GetIndex(0) - sourceRegion.GetIndex(0));
+        const size_t destOffset =
+          ((z - destRegion.GetIndex(2)) * destRegion.GetSize(1) + (y - destRegion.GetIndex(1))) *
+            destRegion.GetSize(0) +
+          (region.GetIndex(0) - destRegion.GetIndex(0));
+
+        std::memcpy(dest + destOffset * pixelSize, source + sourceOffset * pixelSize, rowLength);
+      }
+    }
+  }
+}
+
+mitk::CompressedImageContainer::CompressedImageContainer()
+  : m_PixelType(nullptr),
+    m_ImageDimension(0),
+    m_OneTimeStepImageSizeInBytes(0),
+    m_NumberOfTimeSteps(0),
+    m_ImageGeometry(nullptr),
+    m_MaximumNumberOfThreads(0)
+{
+  m_TileSize[0] = 64;
+  m_TileSize[1] = 64;
+  m_TileSize[2] = 16;
+  m_VolumeSize.Fill(0);
+  m_NumberOfTilesPerAxis.Fill(0);
 }
 
 mitk::CompressedImageContainer::~CompressedImageContainer()
 {
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter)
+  delete m_PixelType;
+}
+
+void mitk::CompressedImageContainer::SetTileSize(const TileSizeType &tileSize)
+{
+  for (unsigned int i = 0; i < 3; ++i)
   {
-    free(iter->first);
+    if (tileSize[i] == 0)
+      mitkThrow() << "Invalid tile size " << tileSize;
   }
 
-  delete m_PixelType;
+  m_TileSize = tileSize;
 }
 
-void mitk::CompressedImageContainer::SetImage(Image *image)
+size_t mitk::CompressedImageContainer::GetCompressedSize() const
 {
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter)
+  size_t compressedSize = 0;
+  for (const auto &compressedTile : m_CompressedTiles)
+    compressedSize += compressedTile.size();
+
+  return compressedSize;
+}
+
+unsigned int mitk::CompressedImageContainer::GetNumberOfTiles() const
+{
+  return m_NumberOfTilesPerAxis[0] * m_NumberOfTilesPerAxis[1] * m_NumberOfTilesPerAxis[2];
+}
+
+mitk::CompressedImageContainer::RegionType mitk::CompressedImageContainer::GetTileRegion(unsigned int tileId) const
+{
+  RegionType region;
+
+  for (unsigned int i = 0; i < 3; ++i)
   {
-    free(iter->first);
+    const auto tileIndex = tileId % m_NumberOfTilesPerAxis[i];
+    tileId /= m_NumberOfTilesPerAxis[i];
+
+    region.SetIndex(i, tileIndex * m_TileSize[i]);
+    region.SetSize(i, std::min(m_TileSize[i], m_VolumeSize[i] - tileIndex * m_TileSize[i]));
   }
 
-  m_ByteBuffers.clear();
+  return region;
+}
+
+void mitk::CompressedImageContainer::SetImage(Image *image)
+{
+  m_CompressedTiles.clear();
 
   // Compress diff image using zlib (will be restored on demand)
   // determine memory size occupied by voxel data
   m_ImageDimension = image->GetDimension();
   m_ImageDimensions.clear();
 
+  delete m_PixelType;
   m_PixelType = new mitk::PixelType(image->GetPixelType());
 
   m_OneTimeStepImageSizeInBytes = m_PixelType->GetSize(); // bits per element divided by 8
+  m_VolumeSize.Fill(1);
   for (unsigned int i = 0; i < m_ImageDimension; ++i)
   {
     unsigned int currentImageDimension = image->GetDimension(i);
@@ -55,9 +137,15 @@ void mitk::CompressedImageContainer::SetImage(Image *image)
     if (i < 3)
     {
       m_OneTimeStepImageSizeInBytes *= currentImageDimension; // only the 3D memory size
+      m_VolumeSize[i] = currentImageDimension;
     }
   }
 
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    m_NumberOfTilesPerAxis[i] = (m_VolumeSize[i] + m_TileSize[i] - 1) / m_TileSize[i];
+  }
+
   m_ImageGeometry = image->GetGeometry();
 
   m_NumberOfTimeSteps = 1;
@@ -66,64 +154,149 @@ void mitk::CompressedImageContainer::SetImage(Image *image)
     m_NumberOfTimeSteps = image->GetDimension(3);
   }
 
+  const unsigned int numberOfTiles = this->GetNumberOfTiles();
+  const size_t pixelSize = m_PixelType->GetSize();
+  m_CompressedTiles.resize(static_cast<size_t>(numberOfTiles) * m_NumberOfTimeSteps);
+
+  RegionType volumeRegion;
+  volumeRegion.SetSize(m_VolumeSize);
+
   for (unsigned int timestep = 0; timestep < m_NumberOfTimeSteps; ++timestep)
   {
-    // allocate a buffer as specified by zlib
-    unsigned long bufferSize =
-      m_OneTimeStepImageSizeInBytes + static_cast<unsigned long>(m_OneTimeStepImageSizeInBytes * 0.2) + 12;
-    auto *byteBuffer = (unsigned char *)malloc(bufferSize);
+    ImageReadAccessor imgAcc(image, image->GetVolumeData(timestep));
+    const auto *source = static_cast<const unsigned char *>(imgAcc.GetData());
+    std::atomic<bool> failed(false);
+
+    mitk::ParallelFor(numberOfTiles, [&](unsigned int tileId) {
+      const RegionType tileRegion = this->GetTileRegion(tileId);
+      const ::uLong sourceLen = tileRegion.GetNumberOfPixels() * pixelSize;
+
+      std::vector<unsigned char> tile(sourceLen);
+      CopyRegion(source, volumeRegion, tile.data(), tileRegion, tileRegion, pixelSize);
 
-    if (itk::Object::GetDebug())
+      // allocate a buffer as specified by zlib
+      auto &compressedTile = m_CompressedTiles[static_cast<size_t>(timestep) * numberOfTiles + tileId];
+      ::uLongf destLen = ::compressBound(sourceLen);
+      compressedTile.resize(destLen);
+
+      if (::compress2(compressedTile.data(), &destLen, tile.data(), sourceLen, Z_BEST_SPEED) != Z_OK)
+        failed = true;
+
+      // only use the neccessary amount of memory
+      compressedTile.resize(destLen);
+      compressedTile.shrink_to_fit();
+    }, m_MaximumNumberOfThreads);
+
+    if (failed)
     {
-      // compress image here into a buffer
-      MITK_INFO << "Using ZLib version: '" << zlibVersion() << "'" << std::endl
-                << "Attempting to compress " << m_OneTimeStepImageSizeInBytes << " image bytes into a buffer of size "
-                << bufferSize << std::endl;
+      m_CompressedTiles.clear();
+      mitkThrow() << "Could not compress time step " << timestep << " of the image.";
     }
+  }
 
-    ImageReadAccessor imgAcc(image, image->GetVolumeData(timestep));
-    ::Bytef *dest(byteBuffer);
-    ::uLongf destLen(bufferSize);
-    auto *source((unsigned char *)imgAcc.GetData());
-    ::uLongf sourceLen(m_OneTimeStepImageSizeInBytes);
-    int zlibRetVal = ::compress(dest, &destLen, source, sourceLen);
-    if (itk::Object::GetDebug())
+  if (itk::Object::GetDebug())
+  {
+    MITK_INFO << "Compressed " << m_OneTimeStepImageSizeInBytes * m_NumberOfTimeSteps << " image bytes in "
+              << m_CompressedTiles.size() << " tiles into " << this->GetCompressedSize()
+              << " bytes using ZLib version '" << zlibVersion() << "'";
+  }
+}
+
+void mitk::CompressedImageContainer::DecompressTile(unsigned int timeStep,
+                                                    unsigned int tileId,
+                                                    unsigned char *dest) const
+{
+  const auto &compressedTile = m_CompressedTiles[static_cast<size_t>(timeStep) * this->GetNumberOfTiles() + tileId];
+  const ::uLongf expectedLen = this->GetTileRegion(tileId).GetNumberOfPixels() * m_PixelType->GetSize();
+
+  ::uLongf destLen(expectedLen);
+  int zlibRetVal = ::uncompress(dest, &destLen, compressedTile.data(), compressedTile.size());
+
+  if (zlibRetVal != Z_OK || destLen != expectedLen)
+  {
+    mitkThrow() << "Could not uncompress tile " << tileId << " of time step " << timeStep << " (zlib error "
+                << zlibRetVal << ").";
+  }
+}
+
+mitk::ImageDataItem::Pointer mitk::CompressedImageContainer::GetTileData(unsigned int timeStep,
+                                                                         unsigned int tileId) const
+{
+  if (timeStep >= m_NumberOfTimeSteps || tileId >= this->GetNumberOfTiles() || m_CompressedTiles.empty())
+    mitkThrow() << "Invalid tile " << tileId << " of time step " << timeStep << " requested.";
+
+  const RegionType tileRegion = this->GetTileRegion(tileId);
+  unsigned int dimensions[3];
+  for (unsigned int i = 0; i < 3; ++i)
+    dimensions[i] = tileRegion.GetSize(i);
+
+  auto *data = new unsigned char[tileRegion.GetNumberOfPixels() * m_PixelType->GetSize()];
+  ImageDataItem::Pointer item = new ImageDataItem(*m_PixelType, timeStep, 3, dimensions, data, true);
+  this->DecompressTile(timeStep, tileId, data);
+  item->SetComplete(true);
+
+  return item;
+}
+
+mitk::ImageDataItem::Pointer mitk::CompressedImageContainer::GetRegionData(unsigned int timeStep,
+                                                                           const RegionType &region) const
+{
+  RegionType volumeRegion;
+  volumeRegion.SetSize(m_VolumeSize);
+
+  if (timeStep >= m_NumberOfTimeSteps || m_CompressedTiles.empty() || region.GetNumberOfPixels() == 0 ||
+      !volumeRegion.IsInside(region))
+  {
+    mitkThrow() << "Invalid region " << region << " of time step " << timeStep << " requested.";
+  }
+
+  unsigned int dimensions[3];
+  for (unsigned int i = 0; i < 3; ++i)
+    dimensions[i] = region.GetSize(i);
+
+  const size_t pixelSize = m_PixelType->GetSize();
+  auto *data = new unsigned char[region.GetNumberOfPixels() * pixelSize];
+  ImageDataItem::Pointer item = new ImageDataItem(*m_PixelType, timeStep, 3, dimensions, data, true);
+
+  // collect the tiles intersecting the region
+  std::vector<unsigned int> tileIds;
+  for (unsigned int tileId = 0; tileId < this->GetNumberOfTiles(); ++tileId)
+  {
+    RegionType intersection = this->GetTileRegion(tileId);
+    if (intersection.Crop(region))
+      tileIds.push_back(tileId);
+  }
+
+  std::atomic<bool> failed(false);
+  mitk::ParallelFor(tileIds.size(), [&](unsigned int i) {
+    const RegionType tileRegion = this->GetTileRegion(tileIds[i]);
+    std::vector<unsigned char> tile(tileRegion.GetNumberOfPixels() * pixelSize);
+
+    try
     {
-      if (zlibRetVal == Z_OK)
-      {
-        MITK_INFO << "Success, using " << destLen << " bytes of the buffer (ratio "
-                  << ((double)destLen / (double)sourceLen) << ")" << std::endl;
-      }
-      else
-      {
-        switch (zlibRetVal)
-        {
-          case Z_MEM_ERROR:
-            MITK_ERROR << "not enough memory" << std::endl;
-            break;
-          case Z_BUF_ERROR:
-            MITK_ERROR << "output buffer too small" << std::endl;
-            break;
-          default:
-            MITK_ERROR << "other, unspecified error" << std::endl;
-            break;
-        }
-      }
+      this->DecompressTile(timeStep, tileIds[i], tile.data());
+    }
+    catch (const mitk::Exception &)
+    {
+      failed = true;
+      return;
     }
 
-    // only use the neccessary amount of memory, realloc the buffer!
-    byteBuffer = (unsigned char *)realloc(byteBuffer, destLen);
-    bufferSize = destLen;
-    // MITK_INFO << "Using " << bufferSize << " bytes to store compressed image (" << destLen << " needed)" <<
-    // std::endl;
+    RegionType intersection = tileRegion;
+    intersection.Crop(region);
+    CopyRegion(tile.data(), tileRegion, data, region, intersection, pixelSize);
+  });
 
-    m_ByteBuffers.push_back(std::pair<unsigned char *, unsigned long>(byteBuffer, bufferSize));
-  }
+  if (failed)
+    mitkThrow() << "Could not uncompress region " << region << " of time step " << timeStep << ".";
+
+  item->SetComplete(true);
+  return item;
 }
 
 mitk::Image::Pointer mitk::CompressedImageContainer::GetImage()
 {
-  if (m_ByteBuffers.empty())
+  if (m_CompressedTiles.empty())
     return nullptr;
 
   // uncompress image data, create an Image
@@ -135,40 +308,38 @@ mitk::Image::Pointer mitk::CompressedImageContainer::GetImage()
   image->Initialize(*m_PixelType, m_ImageDimension, dims); // this IS needed, right ?? But it does allocate memory ->
                                                            // does create one big lump of memory (also in windows)
 
-  unsigned int timeStep(0);
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter, ++timeStep)
+  const unsigned int numberOfTiles = this->GetNumberOfTiles();
+  const size_t pixelSize = m_PixelType->GetSize();
+
+  RegionType volumeRegion;
+  volumeRegion.SetSize(m_VolumeSize);
+
+  for (unsigned int timeStep = 0; timeStep < m_NumberOfTimeSteps; ++timeStep)
   {
-    ImageReadAccessor imgAcc(image, image->GetVolumeData(timeStep));
-    auto *dest((unsigned char *)imgAcc.GetData());
-    ::uLongf destLen(m_OneTimeStepImageSizeInBytes);
-    ::Bytef *source(iter->first);
-    ::uLongf sourceLen(iter->second);
-    int zlibRetVal = ::uncompress(dest, &destLen, source, sourceLen);
-    if (itk::Object::GetDebug())
-    {
-      if (zlibRetVal == Z_OK)
+    ImageWriteAccessor imgAcc(image, image->GetVolumeData(timeStep));
+    auto *dest = static_cast<unsigned char *>(imgAcc.GetData());
+    std::atomic<bool> failed(false);
+
+    mitk::ParallelFor(numberOfTiles, [&](unsigned int tileId) {
+      const RegionType tileRegion = this->GetTileRegion(tileId);
+      std::vector<unsigned char> tile(tileRegion.GetNumberOfPixels() * pixelSize);
+
+      try
       {
-        MITK_INFO << "Success, destLen now " << destLen << " bytes" << std::endl;
+        this->DecompressTile(timeStep, tileId, tile.data());
       }
-      else
+      catch (const mitk::Exception &e)
       {
-        switch (zlibRetVal)
-        {
-          case Z_DATA_ERROR:
-            MITK_ERROR << "compressed data corrupted" << std::endl;
-            break;
-          case Z_MEM_ERROR:
-            MITK_ERROR << "not enough memory" << std::endl;
-            break;
-          case Z_BUF_ERROR:
-            MITK_ERROR << "output buffer too small" << std::endl;
-            break;
-          default:
-            MITK_ERROR << "other, unspecified error" << std::endl;
-            break;
-        }
+        MITK_ERROR << e.GetDescription();
+        failed = true;
+        return;
       }
-    }
+
+      CopyRegion(tile.data(), tileRegion, dest, volumeRegion, tileRegion, pixelSize);
+    });
+
+    if (failed)
+      mitkThrow() << "Could not uncompress time step " << timeStep << " of the image.";
   }
 
   image->SetGeometry(m_ImageGeometry);
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include "mitkImageDataItem.h"
 #include "mitkImageReadAccessor.h"
 
+#include <cstring>
+
 class mitkCompressedImageContainerTestClass
 {
 public:
@@ -106,6 +108,58 @@ public:
         break; // break "for timeStep"
       }
     }
+
+    // check partial uncompression of the last time step
+    mitk::CompressedImageContainer::TileSizeType tileSize;
+    tileSize.Fill(7); // odd size to get border tiles
+    container->SetTileSize(tileSize);
+    container->SetImage(image);
+
+    mitk::CompressedImageContainer::RegionType region;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      unsigned int size = dim < image->GetDimension() ? image->GetDimension(dim) : 1;
+      region.SetIndex(dim, size / 3);
+      region.SetSize(dim, size - size / 3);
+    }
+
+    const unsigned int timeStep = numberOfTimeSteps - 1;
+    mitk::ImageDataItem::Pointer regionData = container->GetRegionData(timeStep, region);
+    mitk::ImageReadAccessor origImgAcc(image, image->GetVolumeData(timeStep));
+    mitk::ImageReadAccessor regionAcc(image, regionData);
+
+    auto *originalData((unsigned char *)origImgAcc.GetData());
+    auto *uncompressedData((unsigned char *)regionAcc.GetData());
+    const unsigned long pixelSize = m_PixelType.GetBpe() >> 3;
+    const unsigned long rowLength = region.GetSize(0) * pixelSize;
+
+    unsigned long differentRows(0);
+    for (auto z = region.GetIndex(2); z < region.GetUpperIndex()[2] + 1; ++z)
+    {
+      for (auto y = region.GetIndex(1); y < region.GetUpperIndex()[1] + 1; ++y, uncompressedData += rowLength)
+      {
+        unsigned long offset =
+          ((z * image->GetDimension(1) + y) * image->GetDimension(0) + region.GetIndex(0)) * pixelSize;
+        if (std::memcmp(originalData + offset, uncompressedData, rowLength) != 0)
+        {
+          ++differentRows;
+        }
+      }
+    }
+
+    if (differentRows > 0)
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Region data not identical after partial uncompression. " << differentRows
+                << " rows different." << std::endl;
+    }
+
+    if (container->GetTileData(timeStep, container->GetNumberOfTiles() - 1)->GetSize() !=
+        container->GetTileRegion(container->GetNumberOfTiles() - 1).GetNumberOfPixels() * pixelSize)
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Tile data has wrong size." << std::endl;
+    }
   }
 };
 
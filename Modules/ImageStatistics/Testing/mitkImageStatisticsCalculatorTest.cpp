@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkPlanarFigureMaskGenerator.h>
 #include <mitkImageMaskGenerator.h>
 #include <mitkImageStatisticsConstants.h>
+#include <mitkImagePixelWriteAccessor.h>
 
 /**
  * \brief Test class for mitkImageStatisticsCalculator
@@ -54,6 +55,8 @@ class mitkImageStatisticsCalculatorTestSuite : public mitk::TestFixture
   MITK_TEST(TestUS4DCroppedPlanarFigureTimeStep1);
   MITK_TEST(TestUS4DCroppedAllTimesteps);
   MITK_TEST(TestUS4DCropped3DMask);
+  MITK_TEST(TestCroppedMultilabelMask);
+  MITK_TEST(TestIncrementalUpdate);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -84,6 +87,9 @@ public:
   void TestUS4DCroppedPlanarFigureTimeStep1();
   void TestUS4DCroppedAllTimesteps();
   void TestUS4DCropped3DMask();
+
+  void TestCroppedMultilabelMask();
+  void TestIncrementalUpdate();
 private:
 	mitk::Image::ConstPointer m_TestImage;
 
@@ -1038,6 +1044,188 @@ mitk::PlanarPolygon::Pointer mitkImageStatisticsCalculatorTestSuite::GeneratePla
 	return figure;
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestCroppedMultilabelMask()
+{
+	MITK_INFO << std::endl << "Test cropped multilabel mask:-----------------------------------------------------------------------------------";
+
+	// image of 6x6x2 voxels with the gray value x + 10 * y
+	const unsigned int imageDimensions[] = { 6, 6, 2 };
+	mitk::Image::Pointer image = mitk::Image::New();
+	image->Initialize(mitk::MakeScalarPixelType<short>(), 3, imageDimensions);
+	{
+		mitk::ImagePixelWriteAccessor<short, 3> imageAccessor(image);
+		itk::Index<3> index;
+		for (index[2] = 0; index[2] < 2; ++index[2])
+			for (index[1] = 0; index[1] < 6; ++index[1])
+				for (index[0] = 0; index[0] < 6; ++index[0])
+					imageAccessor.SetPixelByIndex(index, static_cast<short>(index[0] + 10 * index[1]));
+	}
+
+	// mask of 4x4x2 voxels starting at image index (1, 1, 0): label 1 in its left half, label 2 in its right half
+	const unsigned int maskDimensions[] = { 4, 4, 2 };
+	mitk::Image::Pointer mask = mitk::Image::New();
+	mask->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, maskDimensions);
+	{
+		mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+		itk::Index<3> index;
+		for (index[2] = 0; index[2] < 2; ++index[2])
+			for (index[1] = 0; index[1] < 4; ++index[1])
+				for (index[0] = 0; index[0] < 4; ++index[0])
+					maskAccessor.SetPixelByIndex(index, index[0] < 2 ? 1 : 2);
+	}
+	mitk::Point3D maskOrigin;
+	maskOrigin[0] = 1;
+	maskOrigin[1] = 1;
+	maskOrigin[2] = 0;
+	mask->SetOrigin(maskOrigin);
+
+	mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+	imgMaskGen->SetImageMask(mask);
+	imgMaskGen->SetInputImage(image.GetPointer());
+	imgMaskGen->SetTimeStep(0);
+
+	mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+	imgStatCalc->SetInputImage(image);
+	imgStatCalc->SetMask(imgMaskGen.GetPointer());
+
+	// both labels are computed at once, one per column of expected values
+	const unsigned short labels[] = { 1, 2 };
+	const mitk::ImageStatisticsContainer::RealType expected_mean[] = { 26.5, 28.5 };
+	const mitk::ImageStatisticsContainer::RealType expected_min[] = { 11, 13 };
+	const mitk::ImageStatisticsContainer::RealType expected_max[] = { 42, 44 };
+	const int expected_minIndexX[] = { 1, 3 };
+	const int expected_maxIndexX[] = { 2, 4 };
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		mitk::ImageStatisticsContainer::Pointer statisticsContainer;
+		CPPUNIT_ASSERT_NO_THROW(statisticsContainer = imgStatCalc->GetStatistics(labels[i]));
+		auto stats = statisticsContainer->GetStatisticsForTimeStep(0);
+
+		auto numberOfVoxels = stats.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS());
+		auto mean = stats.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEAN());
+		auto min = stats.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MINIMUM());
+		auto max = stats.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MAXIMUM());
+		auto minIndex = stats.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MINIMUMPOSITION());
+		auto maxIndex = stats.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MAXIMUMPOSITION());
+
+		CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::VoxelCountType(16), numberOfVoxels);
+		CPPUNIT_ASSERT_MESSAGE("Calculated mean is not equal to the desired value.", std::abs(mean - expected_mean[i]) < mitk::eps);
+		CPPUNIT_ASSERT_MESSAGE("Calculated minimum is not equal to the desired value.", std::abs(min - expected_min[i]) < mitk::eps);
+		CPPUNIT_ASSERT_MESSAGE("Calculated maximum is not equal to the desired value.", std::abs(max - expected_max[i]) < mitk::eps);
+		CPPUNIT_ASSERT_EQUAL(expected_minIndexX[i], static_cast<int>(minIndex[0]));
+		CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(minIndex[1]));
+		CPPUNIT_ASSERT_EQUAL(expected_maxIndexX[i], static_cast<int>(maxIndex[0]));
+		CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(maxIndex[1]));
+	}
+}
+
+void mitkImageStatisticsCalculatorTestSuite::TestIncrementalUpdate()
+{
+	MITK_INFO << std::endl << "Test incremental update:-----------------------------------------------------------------------------------";
+
+	// image of 6x6x2 voxels with the gray value x + 10 * y, mask with label 1 for x < 3 and label 2 otherwise
+	const unsigned int dimensions[] = { 6, 6, 2 };
+	mitk::Image::Pointer image = mitk::Image::New();
+	image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+	mitk::Image::Pointer mask = mitk::Image::New();
+	mask->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+	{
+		mitk::ImagePixelWriteAccessor<short, 3> imageAccessor(image);
+		mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+		itk::Index<3> index;
+		for (index[2] = 0; index[2] < 2; ++index[2])
+			for (index[1] = 0; index[1] < 6; ++index[1])
+				for (index[0] = 0; index[0] < 6; ++index[0])
+				{
+					imageAccessor.SetPixelByIndex(index, static_cast<short>(index[0] + 10 * index[1]));
+					maskAccessor.SetPixelByIndex(index, index[0] < 3 ? 1 : 2);
+				}
+	}
+
+	// the first slice is changed such that the column x = 3 moves from label 2 to label 1
+	mitk::Image::Pointer previousSlice = mitk::Image::New();
+	previousSlice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+	mitk::Image::Pointer currentSlice = mitk::Image::New();
+	currentSlice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+	{
+		mitk::ImagePixelWriteAccessor<unsigned short, 2> previousAccessor(previousSlice);
+		mitk::ImagePixelWriteAccessor<unsigned short, 2> currentAccessor(currentSlice);
+		itk::Index<2> index;
+		for (index[1] = 0; index[1] < 6; ++index[1])
+			for (index[0] = 0; index[0] < 6; ++index[0])
+			{
+				previousAccessor.SetPixelByIndex(index, index[0] < 3 ? 1 : 2);
+				currentAccessor.SetPixelByIndex(index, index[0] < 4 ? 1 : 2);
+			}
+	}
+
+	mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+	imgMaskGen->SetImageMask(mask);
+	imgMaskGen->SetInputImage(image.GetPointer());
+
+	mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+	imgStatCalc->SetInputImage(image);
+	imgStatCalc->SetMask(imgMaskGen.GetPointer());
+
+	const unsigned short labels[] = { 1, 2 };
+	mitk::ImageStatisticsContainer::Pointer updatedContainers[2];
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		CPPUNIT_ASSERT_NO_THROW(updatedContainers[i] = imgStatCalc->GetStatistics(labels[i]));
+	}
+
+	CPPUNIT_ASSERT_MESSAGE("Incremental update failed", imgStatCalc->UpdateStatistics(previousSlice, currentSlice, 0));
+
+	{
+		mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+		itk::Index<3> index;
+		index[0] = 3;
+		index[2] = 0;
+		for (index[1] = 0; index[1] < 6; ++index[1])
+			maskAccessor.SetPixelByIndex(index, 1);
+	}
+
+	// the exactly updated statistics have to match a computation from scratch on the changed mask
+	mitk::ImageMaskGenerator::Pointer referenceMaskGen = mitk::ImageMaskGenerator::New();
+	referenceMaskGen->SetImageMask(mask);
+	referenceMaskGen->SetInputImage(image.GetPointer());
+
+	const std::string exactStatistics[] = { mitk::ImageStatisticsConstants::MEAN(),
+		mitk::ImageStatisticsConstants::STANDARDDEVIATION(),
+		mitk::ImageStatisticsConstants::SKEWNESS(),
+		mitk::ImageStatisticsConstants::KURTOSIS(),
+		mitk::ImageStatisticsConstants::MPP(),
+		mitk::ImageStatisticsConstants::VOLUME() };
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		auto updated = updatedContainers[i]->GetStatisticsForTimeStep(0);
+		auto reference = ComputeStatistics(image.GetPointer(), referenceMaskGen.GetPointer(), nullptr, labels[i])->GetStatisticsForTimeStep(0);
+
+		CPPUNIT_ASSERT_EQUAL(reference.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()),
+			updated.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+		for (const auto &statistic : exactStatistics)
+		{
+			auto updatedValue = updated.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(statistic);
+			auto referenceValue = reference.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(statistic);
+			CPPUNIT_ASSERT_MESSAGE("Incrementally updated " + statistic + " differs from the full computation.",
+				std::abs(updatedValue - referenceValue) < 1e-6);
+		}
+	}
+
+	// label 1 got a new maximum, which is exact
+	auto updatedMax = updatedContainers[0]->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MAXIMUM());
+	CPPUNIT_ASSERT_MESSAGE("Incrementally updated maximum is not equal to the desired value.", std::abs(updatedMax - 53) < mitk::eps);
+
+	// label 2 lost its minimum, so the next request recomputes it
+	mitk::ImageStatisticsContainer::Pointer recomputed;
+	CPPUNIT_ASSERT_NO_THROW(recomputed = imgStatCalc->GetStatistics(2));
+	auto recomputedMin = recomputed->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MINIMUM());
+	CPPUNIT_ASSERT_MESSAGE("Recomputed minimum is not equal to the desired value.", std::abs(recomputedMin - 3) < mitk::eps);
+}
+
 const mitk::ImageStatisticsContainer::Pointer
 mitkImageStatisticsCalculatorTestSuite::ComputeStatistics(mitk::Image::ConstPointer image,
 	mitk::MaskGenerator::Pointer maskGen,
@@ -26,6 +26,7 @@ set(H_FILES
   mitkPointSetStatisticsCalculator.h
   mitkExtendedStatisticsImageFilter.h
   mitkExtendedLabelStatisticsImageFilter.h
+  mitkMultiLabelStatisticsImageFilter.h
   mitkHotspotMaskGenerator.h
   mitkMaskGenerator.h
   mitkPlanarFigureMaskGenerator.h
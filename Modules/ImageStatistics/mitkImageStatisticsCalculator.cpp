@@ -11,19 +11,69 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageStatisticsCalculator.h"
-#include <mitkExtendedLabelStatisticsImageFilter.h>
-#include <mitkExtendedStatisticsImageFilter.h>
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkImageMaskGenerator.h>
 #include <mitkImageStatisticsConstants.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkImageToItk.h>
 #include <mitkMaskUtilities.h>
-#include <mitkMinMaxImageFilterWithIndex.h>
-#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkMultiLabelStatisticsImageFilter.h>
 #include <mitkitkMaskImageFilter.h>
 
+#include <itkImageRegionConstIterator.h>
+#include <itkMath.h>
+
+#include <set>
+
+namespace
+{
+  // adds all statistics of a label except the positions of minimum and maximum
+  template <typename TLabelStatistics>
+  void AddLabelStatistics(const TLabelStatistics &labelStatistics,
+                          double voxelVolume,
+                          mitk::ImageStatisticsContainer::ImageStatisticsObject &statObj)
+  {
+    auto volume = static_cast<double>(labelStatistics.m_Count) * voxelVolume;
+    auto variance = labelStatistics.m_Sigma * labelStatistics.m_Sigma;
+    auto rms = std::sqrt(std::pow(labelStatistics.m_Mean, 2.) + labelStatistics.m_Variance); // variance = sigma^2
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(),
+                         static_cast<mitk::ImageStatisticsContainer::VoxelCountType>(labelStatistics.m_Count));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), labelStatistics.m_Mean);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
+                         static_cast<mitk::ImageStatisticsContainer::RealType>(labelStatistics.m_Minimum));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
+                         static_cast<mitk::ImageStatisticsContainer::RealType>(labelStatistics.m_Maximum));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), labelStatistics.m_Sigma);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), labelStatistics.m_Skewness);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), labelStatistics.m_Kurtosis);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), labelStatistics.m_MPP);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), labelStatistics.m_Entropy);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), labelStatistics.m_Median);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), labelStatistics.m_Uniformity);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), labelStatistics.m_UPP);
+    statObj.m_Histogram = labelStatistics.m_Histogram.GetPointer();
+  }
+
+  // reads the labels of a mask slice in row-major order
+  template <typename TPixel, unsigned int VImageDimension>
+  void ReadMaskSlice(itk::Image<TPixel, VImageDimension> *slice,
+                     std::vector<mitk::ImageStatisticsCalculator::MaskPixelType> *labels)
+  {
+    itk::ImageRegionConstIterator<itk::Image<TPixel, VImageDimension>> it(slice, slice->GetLargestPossibleRegion());
+    labels->reserve(slice->GetLargestPossibleRegion().GetNumberOfPixels());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      labels->push_back(static_cast<mitk::ImageStatisticsCalculator::MaskPixelType>(it.Get()));
+    }
+  }
+}
+
 namespace mitk
 {
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
@@ -102,8 +152,11 @@ namespace mitk
       mitkThrow() << "Image not initialized!";
     }
 
-    if (IsUpdateRequired(label))
+    if (m_RecomputeRequired || IsUpdateRequired(label))
     {
+      m_LabelAccumulators.clear();
+      m_RecomputeRequired = false;
+
       auto timeGeometry = m_Image->GetTimeGeometry();
       // always compute statistics on all timesteps
       for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
@@ -172,8 +225,8 @@ namespace mitk
     typename itk::Image<TPixel, VImageDimension> *image, const TimeGeometry *timeGeometry, TimeStepType timeStep)
   {
     typedef typename itk::Image<TPixel, VImageDimension> ImageType;
-    typedef typename itk::ExtendedStatisticsImageFilter<ImageType> ImageStatisticsFilterType;
-    typedef typename itk::MinMaxImageFilterWithIndex<ImageType> MinMaxFilterType;
+    typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
+    typedef typename itk::MultiLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
 
     // reset statistics container if exists
     ImageStatisticsContainer::Pointer statisticContainerForImage;
@@ -192,55 +245,22 @@ namespace mitk
 
     auto statObj = ImageStatisticsContainer::ImageStatisticsObject();
 
+    // min/max, moments and histogram are computed by one filter in two multithreaded sweeps
     typename ImageStatisticsFilterType::Pointer statisticsFilter = ImageStatisticsFilterType::New();
     statisticsFilter->SetInput(image);
+    statisticsFilter->SetDefaultLabel(labelNoMask);
     statisticsFilter->SetCoordinateTolerance(0.001);
     statisticsFilter->SetDirectionTolerance(0.001);
 
-    // TODO: this is single threaded. Implement our own image filter that does this multi threaded
-    //        typename itk::MinimumMaximumImageCalculator<ImageType>::Pointer imgMinMaxFilter =
-    //        itk::MinimumMaximumImageCalculator<ImageType>::New(); imgMinMaxFilter->SetImage(image);
-    //        imgMinMaxFilter->Compute();
-    vnl_vector<int> minIndex, maxIndex;
-
-    typename MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
-    minMaxFilter->SetInput(image);
-    minMaxFilter->UpdateLargestPossibleRegion();
-    typename ImageType::PixelType minval = minMaxFilter->GetMin();
-    typename ImageType::PixelType maxval = minMaxFilter->GetMax();
-
-    typename ImageType::IndexType tmpMinIndex = minMaxFilter->GetMinIndex();
-    typename ImageType::IndexType tmpMaxIndex = minMaxFilter->GetMaxIndex();
-
-    //        typename ImageType::IndexType tmpMinIndex = imgMinMaxFilter->GetIndexOfMinimum();
-    //        typename ImageType::IndexType tmpMaxIndex = imgMinMaxFilter->GetIndexOfMaximum();
-
-    minIndex.set_size(tmpMaxIndex.GetIndexDimension());
-    maxIndex.set_size(tmpMaxIndex.GetIndexDimension());
-
-    for (unsigned int i = 0; i < tmpMaxIndex.GetIndexDimension(); i++)
-    {
-      minIndex[i] = tmpMinIndex[i];
-      maxIndex[i] = tmpMaxIndex[i];
-    }
-
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
-
-    // convert m_binSize in m_nBins if necessary
-    unsigned int nBinsForHistogram;
     if (m_UseBinSizeOverNBins)
     {
-      nBinsForHistogram = std::max(static_cast<double>(std::ceil(maxval - minval)) / m_binSizeForHistogramStatistics,
-                                   10.); // do not allow less than 10 bins
+      statisticsFilter->SetHistogramBinSize(m_binSizeForHistogramStatistics);
     }
     else
     {
-      nBinsForHistogram = m_nBinsForHistogramStatistics;
+      statisticsFilter->SetHistogramBins(m_nBinsForHistogramStatistics);
     }
 
-    statisticsFilter->SetHistogramParameters(nBinsForHistogram, minval, maxval);
-
     try
     {
       statisticsFilter->Update();
@@ -250,33 +270,22 @@ namespace mitk
       mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
     }
 
-    auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+    const auto &labelStatistics = statisticsFilter->GetStatistics(labelNoMask);
 
-    auto numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
-    auto volume = static_cast<double>(numberOfPixels) * voxelVolume;
-    auto variance = statisticsFilter->GetSigma() * statisticsFilter->GetSigma();
-    auto rms =
-      std::sqrt(std::pow(statisticsFilter->GetMean(), 2.) + statisticsFilter->GetVariance()); // variance = sigma^2
+    vnl_vector<int> minIndex, maxIndex;
+    minIndex.set_size(VImageDimension);
+    maxIndex.set_size(VImageDimension);
 
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(),
-                         static_cast<ImageStatisticsContainer::VoxelCountType>(numberOfPixels));
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), statisticsFilter->GetMean());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
-                         static_cast<ImageStatisticsContainer::RealType>(statisticsFilter->GetMinimum()));
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
-                         static_cast<ImageStatisticsContainer::RealType>(statisticsFilter->GetMaximum()));
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), statisticsFilter->GetSigma());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), statisticsFilter->GetSkewness());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), statisticsFilter->GetKurtosis());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), statisticsFilter->GetMPP());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), statisticsFilter->GetEntropy());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), statisticsFilter->GetMedian());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), statisticsFilter->GetUniformity());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), statisticsFilter->GetUPP());
-    statObj.m_Histogram = statisticsFilter->GetHistogram().GetPointer();
+    for (unsigned int i = 0; i < VImageDimension; i++)
+    {
+      minIndex[i] = labelStatistics.m_MinimumIndex[i];
+      maxIndex[i] = labelStatistics.m_MaximumIndex[i];
+    }
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
+    AddLabelStatistics(labelStatistics, GetVoxelVolume<TPixel, VImageDimension>(image), statObj);
     statisticContainerForImage->SetStatisticsForTimeStep(timeStep, statObj);
   }
 
@@ -299,11 +308,7 @@ namespace mitk
   {
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
-    typedef typename MaskType::PixelType LabelPixelType;
-    typedef itk::ExtendedLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
-    typedef MaskUtilities<TPixel, VImageDimension> MaskUtilType;
-    typedef typename itk::MinMaxLabelImageFilterWithIndex<ImageType, MaskType> MinMaxLabelFilterType;
-    typedef typename ImageType::PixelType InputImgPixelType;
+    typedef itk::MultiLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
 
     // workaround: if m_SecondaryMaskGenerator ist not null but m_MaskGenerator is! (this is the case if we request a
     // 'ignore zuero valued pixels' mask in the gui but do not define a primary mask)
@@ -364,66 +369,41 @@ namespace mitk
       maskImage = maskFilter->GetOutput();
     }
 
-    typename MaskUtilType::Pointer maskUtil = MaskUtilType::New();
-    maskUtil->SetImage(image);
-    maskUtil->SetMask(maskImage.GetPointer());
-
-    // if mask is smaller than image, extract the image region where the mask is
-    typename ImageType::Pointer adaptedImage = ImageType::New();
-
-    adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
-
-    // find min, max, minindex and maxindex
-    typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
-    minMaxFilter->SetInput(adaptedImage);
-    minMaxFilter->SetLabelInput(maskImage);
-    minMaxFilter->UpdateLargestPossibleRegion();
-
-    // set histogram parameters for each label individually (min/max may be different for each label)
-    typedef typename std::map<LabelPixelType, InputImgPixelType> MapType;
-    typedef typename std::pair<LabelPixelType, InputImgPixelType> PairType;
-
-    std::vector<LabelPixelType> relevantLabels = minMaxFilter->GetRelevantLabels();
-    MapType minVals;
-    MapType maxVals;
-    std::map<LabelPixelType, unsigned int> nBins;
-
-    for (LabelPixelType label : relevantLabels)
-    {
-      minVals.insert(PairType(label, minMaxFilter->GetMin(label)));
-      maxVals.insert(PairType(label, minMaxFilter->GetMax(label)));
-
-      unsigned int nBinsForHistogram;
-      if (m_UseBinSizeOverNBins)
-      {
-        nBinsForHistogram =
-          std::max(static_cast<double>(std::ceil(minMaxFilter->GetMax(label) - minMaxFilter->GetMin(label))) /
-                     m_binSizeForHistogramStatistics,
-                   10.); // do not allow less than 10 bins
-      }
-      else
-      {
-        nBinsForHistogram = m_nBinsForHistogramStatistics;
-      }
-
-      nBins.insert(typename std::pair<LabelPixelType, unsigned int>(label, nBinsForHistogram));
-    }
-
+    // min/max, moments and histograms of all labels are computed by one filter in two multithreaded sweeps. The
+    // filter only visits the voxels covered by the mask, so a smaller mask needs no cropped copy of the image.
     typename ImageStatisticsFilterType::Pointer imageStatisticsFilter = ImageStatisticsFilterType::New();
     imageStatisticsFilter->SetDirectionTolerance(0.001);
     imageStatisticsFilter->SetCoordinateTolerance(0.001);
-    imageStatisticsFilter->SetInput(adaptedImage);
+    imageStatisticsFilter->SetInput(image);
     imageStatisticsFilter->SetLabelInput(maskImage);
-    imageStatisticsFilter->SetHistogramParametersForLabels(nBins, minVals, maxVals);
-    imageStatisticsFilter->Update();
 
-    std::list<int> labels = imageStatisticsFilter->GetRelevantLabels();
-    auto it = labels.begin();
+    if (m_UseBinSizeOverNBins)
+    {
+      imageStatisticsFilter->SetHistogramBinSize(m_binSizeForHistogramStatistics);
+    }
+    else
+    {
+      imageStatisticsFilter->SetHistogramBins(m_nBinsForHistogramStatistics);
+    }
+
+    try
+    {
+      imageStatisticsFilter->Update();
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
+    }
+
+    auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
 
-    while (it != labels.end())
+    for (const auto &labelStatisticsPair : imageStatisticsFilter->GetLabelStatistics())
     {
+      const LabelIndex label = labelStatisticsPair.first;
+      const auto &labelStatistics = labelStatisticsPair.second;
+
       ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
-      auto labelIt = m_StatisticContainers.find(*it);
+      auto labelIt = m_StatisticContainers.find(label);
       // reset if statisticContainer already exist
       if (labelIt != m_StatisticContainers.end())
       {
@@ -434,68 +414,36 @@ namespace mitk
       {
         statisticContainerForLabelImage = ImageStatisticsContainer::New();
         statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
-        // link label (*it) to statisticContainer
-        m_StatisticContainers.emplace(*it, statisticContainerForLabelImage);
+        // link label to statisticContainer
+        m_StatisticContainers.emplace(label, statisticContainerForLabelImage);
       }
 
       ImageStatisticsContainer::ImageStatisticsObject statObj;
 
-      // find min, max, minindex and maxindex
-      // make sure to only look in the masked region, use a masker for this
-
-      vnl_vector<int> minIndex, maxIndex;
-      mitk::Point3D worldCoordinateMin;
-      mitk::Point3D worldCoordinateMax;
-      mitk::Point3D indexCoordinateMin;
-      mitk::Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
-      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
-      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
-
-      minIndex.set_size(3);
-      maxIndex.set_size(3);
-
-      // for (unsigned int i=0; i < tmpMaxIndex.GetIndexDimension(); i++)
-      for (unsigned int i = 0; i < 3; i++)
-      {
-        minIndex[i] = indexCoordinateMin[i];
-        maxIndex[i] = indexCoordinateMax[i];
-      }
+      vnl_vector<int> minIndex = GetInputImagePosition(labelStatistics.m_MinimumIndex);
+      vnl_vector<int> maxIndex = GetInputImagePosition(labelStatistics.m_MaximumIndex);
 
       statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
 
-      assert(std::abs(minMaxFilter->GetMax(*it) - imageStatisticsFilter->GetMaximum(*it)) < mitk::eps);
-      assert(std::abs(minMaxFilter->GetMin(*it) - imageStatisticsFilter->GetMinimum(*it)) < mitk::eps);
-
-      auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
-      auto numberOfVoxels =
-        static_cast<unsigned long>(imageStatisticsFilter->GetSum(*it) / (double)imageStatisticsFilter->GetMean(*it));
-      auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
-      auto rms = std::sqrt(std::pow(imageStatisticsFilter->GetMean(*it), 2.) +
-                           imageStatisticsFilter->GetVariance(*it)); // variance = sigma^2
-      auto variance = imageStatisticsFilter->GetSigma(*it) * imageStatisticsFilter->GetSigma(*it);
-
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), imageStatisticsFilter->GetMean(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), imageStatisticsFilter->GetMinimum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), imageStatisticsFilter->GetMaximum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), imageStatisticsFilter->GetSigma(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), imageStatisticsFilter->GetSkewness(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), imageStatisticsFilter->GetKurtosis(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), imageStatisticsFilter->GetMPP(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), imageStatisticsFilter->GetEntropy(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), imageStatisticsFilter->GetMedian(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), imageStatisticsFilter->GetUniformity(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), imageStatisticsFilter->GetUPP(*it));
-      statObj.m_Histogram = imageStatisticsFilter->GetHistogram(*it).GetPointer();
-
+      AddLabelStatistics(labelStatistics, voxelVolume, statObj);
       statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
-      ++it;
+
+      // keep the sums to allow incremental updates by UpdateStatistics()
+      auto &accumulator = m_LabelAccumulators[timeStep][label];
+      accumulator.m_Count = labelStatistics.m_Count;
+      accumulator.m_PositivePixelCount = labelStatistics.m_PositivePixelCount;
+      accumulator.m_Sum = labelStatistics.m_Sum;
+      accumulator.m_SumOfSquares = labelStatistics.m_SumOfSquares;
+      accumulator.m_SumOfCubes = labelStatistics.m_SumOfCubes;
+      accumulator.m_SumOfQuadruples = labelStatistics.m_SumOfQuadruples;
+      accumulator.m_SumOfPositivePixels = labelStatistics.m_SumOfPositivePixels;
+      accumulator.m_Minimum = labelStatistics.m_Minimum;
+      accumulator.m_Maximum = labelStatistics.m_Maximum;
+      accumulator.m_MinimumPosition = minIndex;
+      accumulator.m_MaximumPosition = maxIndex;
+      accumulator.m_VoxelVolume = voxelVolume;
+      accumulator.m_Histogram = labelStatistics.m_Histogram;
     }
 
     // swap maskGenerators back
@@ -506,6 +454,263 @@ namespace mitk
     }
   }
 
+  template <unsigned int VImageDimension>
+  vnl_vector<int> ImageStatisticsCalculator::GetInputImagePosition(const itk::Index<VImageDimension> &index) const
+  {
+    // the positions refer to the image the statistics are computed on, convert them to the index space of the
+    // input image
+    mitk::Point3D worldCoordinate;
+    mitk::Point3D indexCoordinate;
+    m_InternalImageForStatistics->GetGeometry()->IndexToWorld(index, worldCoordinate);
+    m_Image->GetGeometry()->WorldToIndex(worldCoordinate, indexCoordinate);
+
+    vnl_vector<int> position;
+    position.set_size(3);
+    for (unsigned int i = 0; i < 3; i++)
+    {
+      position[i] = indexCoordinate[i];
+    }
+    return position;
+  }
+
+  bool ImageStatisticsCalculator::UpdateStatistics(const mitk::Image *previousMaskSlice,
+                                                   const mitk::Image *currentMaskSlice,
+                                                   TimeStepType timeStep)
+  {
+    if (previousMaskSlice == nullptr || currentMaskSlice == nullptr)
+    {
+      mitkThrow() << "Mask slices are required to update the statistics.";
+    }
+
+    if (previousMaskSlice->GetDimension(0) != currentMaskSlice->GetDimension(0) ||
+        previousMaskSlice->GetDimension(1) != currentMaskSlice->GetDimension(1))
+    {
+      mitkThrow() << "The previous and the current mask slice differ in size.";
+    }
+
+    // only the statistics of a primary image mask that are up to date otherwise can be updated
+    auto accumulatorsIt = m_LabelAccumulators.find(timeStep);
+    if (m_Image.IsNull() || m_InternalImageForStatistics.IsNull() || m_SecondaryMaskGenerator.IsNotNull() ||
+        dynamic_cast<ImageMaskGenerator *>(m_MaskGenerator.GetPointer()) == nullptr ||
+        accumulatorsIt == m_LabelAccumulators.end() || IsUpdateRequired(accumulatorsIt->second.begin()->first))
+    {
+      m_RecomputeRequired = true;
+      return false;
+    }
+
+    std::vector<MaskPixelType> previousLabels;
+    std::vector<MaskPixelType> currentLabels;
+    AccessByItk_1(previousMaskSlice, ReadMaskSlice, &previousLabels);
+    AccessByItk_1(currentMaskSlice, ReadMaskSlice, &currentLabels);
+
+    ImageTimeSelector::Pointer imgTimeSel = ImageTimeSelector::New();
+    imgTimeSel->SetInput(m_InternalImageForStatistics);
+    imgTimeSel->SetTimeNr(timeStep);
+    imgTimeSel->UpdateLargestPossibleRegion();
+    mitk::Image::Pointer imageTimeSlice = imgTimeSel->GetOutput();
+
+    bool success = false;
+    AccessByItk_n(imageTimeSlice,
+                  InternalUpdateStatistics,
+                  (&previousLabels, &currentLabels, currentMaskSlice, timeStep, &success));
+
+    if (!success)
+    {
+      m_RecomputeRequired = true;
+    }
+    return success;
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalUpdateStatistics(typename itk::Image<TPixel, VImageDimension> *image,
+                                                           const std::vector<MaskPixelType> *previousLabels,
+                                                           const std::vector<MaskPixelType> *currentLabels,
+                                                           const mitk::Image *maskSlice,
+                                                           TimeStepType timeStep,
+                                                           bool *success)
+  {
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+    *success = false;
+
+    // the slice index (u, v) corresponds to the image index origin + u * uStep + v * vStep. Slices that are not
+    // aligned with the voxel grid of the image cannot be mapped voxel by voxel.
+    const BaseGeometry *sliceGeometry = maskSlice->GetGeometry();
+    const BaseGeometry *imageGeometry = m_InternalImageForStatistics->GetGeometry(timeStep);
+    int origin[3], uStep[3], vStep[3];
+    {
+      mitk::Point3D sliceIndex, worldCoordinate, imageIndex[3];
+      sliceIndex.Fill(0);
+      for (unsigned int p = 0; p < 3; ++p)
+      {
+        if (p > 0)
+        {
+          sliceIndex.Fill(0);
+          sliceIndex[p - 1] = 1;
+        }
+        sliceGeometry->IndexToWorld(sliceIndex, worldCoordinate);
+        imageGeometry->WorldToIndex(worldCoordinate, imageIndex[p]);
+      }
+
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        const double continuousSteps[3] = {imageIndex[0][i], imageIndex[1][i] - imageIndex[0][i],
+                                           imageIndex[2][i] - imageIndex[0][i]};
+        int *steps[3] = {&origin[i], &uStep[i], &vStep[i]};
+        for (unsigned int p = 0; p < 3; ++p)
+        {
+          *steps[p] = itk::Math::Round<int>(continuousSteps[p]);
+          if (std::abs(continuousSteps[p] - *steps[p]) > 0.01 || (i >= VImageDimension && *steps[p] != 0))
+          {
+            return;
+          }
+        }
+      }
+    }
+
+    // the mapping is affine, so the slice lies within the image if its corners do
+    const auto region = image->GetLargestPossibleRegion();
+    const int width = maskSlice->GetDimension(0);
+    const int height = maskSlice->GetDimension(1);
+    typename ImageType::IndexType index;
+    for (int corner = 0; corner < 4; ++corner)
+    {
+      const int u = (corner & 1) ? width - 1 : 0;
+      const int v = (corner & 2) ? height - 1 : 0;
+      for (unsigned int i = 0; i < VImageDimension; ++i)
+      {
+        index[i] = origin[i] + u * uStep[i] + v * vStep[i];
+      }
+      if (!region.IsInside(index))
+      {
+        return;
+      }
+    }
+
+    auto &accumulators = m_LabelAccumulators[timeStep];
+    std::set<LabelIndex> changedLabels;
+    HistogramType::IndexType histogramIndex(1);
+    HistogramType::MeasurementVectorType histogramMeasurement(1);
+
+    for (int v = 0; v < height; ++v)
+    {
+      for (int u = 0; u < width; ++u)
+      {
+        const std::size_t sliceOffset = static_cast<std::size_t>(v) * width + u;
+        const LabelIndex previousLabel = (*previousLabels)[sliceOffset];
+        const LabelIndex currentLabel = (*currentLabels)[sliceOffset];
+        if (previousLabel == currentLabel)
+        {
+          continue;
+        }
+
+        for (unsigned int i = 0; i < VImageDimension; ++i)
+        {
+          index[i] = origin[i] + u * uStep[i] + v * vStep[i];
+        }
+        const double value = static_cast<double>(image->GetPixel(index));
+        histogramMeasurement[0] = value;
+
+        // remove the voxel from its previous label
+        auto previousIt = accumulators.find(previousLabel);
+        if (previousIt != accumulators.end())
+        {
+          LabelAccumulator &accumulator = previousIt->second;
+          accumulator.m_Count -= 1;
+          accumulator.m_Sum -= value;
+          accumulator.m_SumOfSquares -= value * value;
+          accumulator.m_SumOfCubes -= value * value * value;
+          accumulator.m_SumOfQuadruples -= value * value * value * value;
+          if (value > 0)
+          {
+            accumulator.m_PositivePixelCount -= 1;
+            accumulator.m_SumOfPositivePixels -= value;
+          }
+
+          // other voxels may share the extreme value, only a full sweep can tell
+          if (value <= accumulator.m_Minimum || value >= accumulator.m_Maximum)
+          {
+            m_RecomputeRequired = true;
+          }
+          else if (accumulator.m_Histogram->GetIndex(histogramMeasurement, histogramIndex))
+          {
+            const auto frequency = accumulator.m_Histogram->GetFrequency(histogramIndex);
+            if (frequency > 0)
+            {
+              accumulator.m_Histogram->SetFrequencyOfIndex(histogramIndex, frequency - 1);
+            }
+          }
+          changedLabels.insert(previousLabel);
+        }
+        else
+        {
+          m_RecomputeRequired = true;
+        }
+
+        // add the voxel to its current label
+        auto currentIt = accumulators.find(currentLabel);
+        if (currentIt != accumulators.end())
+        {
+          LabelAccumulator &accumulator = currentIt->second;
+          accumulator.m_Count += 1;
+          accumulator.m_Sum += value;
+          accumulator.m_SumOfSquares += value * value;
+          accumulator.m_SumOfCubes += value * value * value;
+          accumulator.m_SumOfQuadruples += value * value * value * value;
+          if (value > 0)
+          {
+            accumulator.m_PositivePixelCount += 1;
+            accumulator.m_SumOfPositivePixels += value;
+          }
+
+          // a new extreme is exact, but changes the histogram range of a full computation
+          if (value < accumulator.m_Minimum)
+          {
+            accumulator.m_Minimum = value;
+            accumulator.m_MinimumPosition = GetInputImagePosition(index);
+            m_RecomputeRequired = true;
+          }
+          else if (value > accumulator.m_Maximum)
+          {
+            accumulator.m_Maximum = value;
+            accumulator.m_MaximumPosition = GetInputImagePosition(index);
+            m_RecomputeRequired = true;
+          }
+          else if (accumulator.m_Histogram->GetIndex(histogramMeasurement, histogramIndex))
+          {
+            accumulator.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+          }
+          changedLabels.insert(currentLabel);
+        }
+        else
+        {
+          // the label is new, its statistics container does not exist yet
+          m_RecomputeRequired = true;
+        }
+      }
+    }
+
+    for (const auto label : changedLabels)
+    {
+      auto &accumulator = accumulators[label];
+      if (accumulator.m_Count == 0)
+      {
+        // the label vanished, the full computation drops it
+        m_RecomputeRequired = true;
+        continue;
+      }
+
+      itk::ComputeDerivedLabelStatistics(accumulator);
+
+      ImageStatisticsContainer::ImageStatisticsObject statObj;
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), accumulator.m_MinimumPosition);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), accumulator.m_MaximumPosition);
+      AddLabelStatistics(accumulator, accumulator.m_VoxelVolume, statObj);
+      m_StatisticContainers[label]->SetStatisticsForTimeStep(timeStep, statObj);
+    }
+
+    *success = true;
+  }
+
   bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
   {
     unsigned long thisClassTimeStamp = this->GetMTime();
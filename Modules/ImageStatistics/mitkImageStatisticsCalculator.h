@@ -76,6 +76,25 @@ namespace mitk
          */
         ImageStatisticsContainer* GetStatistics(LabelIndex label=1);
 
+        /**Documentation
+        @brief Updates the statistics computed by the last GetStatistics() call after the mask has been changed within
+        one slice, e.g. by a segmentation tool (see mitk::SegmentationSliceModifiedEvent).
+        @param previousMaskSlice the values of the changed mask slice before the change.
+        @param currentMaskSlice the values of the changed mask slice after the change. Both slices need the same size
+        and a geometry that locates them within the mask.
+        @param timeStep the time step of the mask that has been changed.
+        Every changed voxel is removed from its previous label and added to its current one, which keeps the voxel
+        count, volume, mean, moments and MPP of all labels exact without visiting the unchanged voxels.
+        The statistics containers are updated immediately. If a change cannot be applied exactly (an extreme value of a
+        label is removed, a value lies outside of the histogram range of its new label, a label appears or vanishes),
+        the container shows approximate values for minimum, maximum and the histogram based statistics (median, entropy,
+        uniformity, UPP) and the next GetStatistics() call recomputes all labels from scratch.
+        Incremental updates require a primary image mask and no secondary mask.
+        @return false if the change could not be applied, in that case the next GetStatistics() call recomputes all
+        statistics.
+        */
+        bool UpdateStatistics(const mitk::Image* previousMaskSlice, const mitk::Image* currentMaskSlice, TimeStepType timeStep);
+
     protected:
         ImageStatisticsCalculator(){
             m_nBinsForHistogramStatistics = 100;
@@ -93,6 +112,13 @@ namespace mitk
                 typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry,
                 unsigned int timeStep);
 
+        template < typename TPixel, unsigned int VImageDimension > void InternalUpdateStatistics(
+                typename itk::Image< TPixel, VImageDimension >* image, const std::vector<MaskPixelType>* previousLabels,
+                const std::vector<MaskPixelType>* currentLabels, const mitk::Image* maskSlice, TimeStepType timeStep, bool* success);
+
+        template < unsigned int VImageDimension >
+        vnl_vector<int> GetInputImagePosition(const itk::Index<VImageDimension>& index) const;
+
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(typename itk::Image<TPixel, VImageDimension>* image) const;
 
@@ -113,6 +139,41 @@ namespace mitk
         bool m_UseBinSizeOverNBins;
 
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
+
+        /** Accumulated sums of a label, kept to update its statistics incrementally. The members match those of
+            itk::MultiLabelStatisticsImageFilter::LabelStatistics. */
+        struct LabelAccumulator
+        {
+          ImageStatisticsContainer::VoxelCountType m_Count = 0;
+          ImageStatisticsContainer::VoxelCountType m_PositivePixelCount = 0;
+          double m_Sum = 0;
+          double m_SumOfSquares = 0;
+          double m_SumOfCubes = 0;
+          double m_SumOfQuadruples = 0;
+          double m_SumOfPositivePixels = 0;
+          double m_Minimum = 0;
+          double m_Maximum = 0;
+          vnl_vector<int> m_MinimumPosition;
+          vnl_vector<int> m_MaximumPosition;
+          double m_VoxelVolume = 1;
+
+          double m_Mean = 0;
+          double m_Sigma = 0;
+          double m_Variance = 0;
+          double m_Skewness = 0;
+          double m_Kurtosis = 0;
+          double m_MPP = 0;
+          double m_Median = 0;
+          double m_Entropy = 0;
+          double m_Uniformity = 0;
+          double m_UPP = 0;
+          HistogramType::Pointer m_Histogram;
+        };
+
+        /** Accumulators of the labels per time step, filled by the masked computation */
+        std::map<TimeStepType, std::map<LabelIndex, LabelAccumulator>> m_LabelAccumulators;
+        /** Set if UpdateStatistics() could not apply a change exactly, forces a full computation */
+        bool m_RecomputeRequired = false;
     };
 
 }
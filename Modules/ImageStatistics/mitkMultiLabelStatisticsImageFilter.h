@@ -0,0 +1,213 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __mitkMultiLabelStatisticsImageFilter
+#define __mitkMultiLabelStatisticsImageFilter
+
+#include <itkImageToImageFilter.h>
+#include <itkHistogram.h>
+
+#include <map>
+#include <vector>
+
+namespace itk
+{
+  /** Derives mean, variance, skewness, kurtosis, MPP and the histogram based statistics of a label from its
+   *  accumulated sums and its histogram. TLabelStatistics provides the members of
+   *  MultiLabelStatisticsImageFilter::LabelStatistics, which allows to re-derive incrementally updated sums. */
+  template <class TLabelStatistics>
+  void ComputeDerivedLabelStatistics(TLabelStatistics &ls);
+
+  /**
+  * \class MultiLabelStatisticsImageFilter
+  * \brief Computes the statistics of all labels of a label image in two multithreaded sweeps over the voxels.
+  *
+  * The first sweep accumulates count, minimum, maximum (including their indices) and the first four moments
+  * for every label, the second sweep fills the histograms, whose ranges are the per label minima and maxima
+  * of the first sweep. Every thread accumulates into its own per label structures, which are merged after
+  * each sweep. Median, entropy, uniformity and UPP are derived from the histograms.
+  *
+  * The label image may cover only a part of the input image (e.g. a cropped segmentation); only the voxels
+  * covered by the label image are processed and no cropped copy of the input is created. If no label image
+  * is set, all voxels of the input are attributed to the default label.
+  *
+  * The indices of the minimum and maximum refer to the index space of the input image.
+  */
+  template <class TInputImage, class TLabelImage>
+  class MultiLabelStatisticsImageFilter : public ImageToImageFilter<TInputImage, TInputImage>
+  {
+  public:
+    typedef MultiLabelStatisticsImageFilter Self;
+    typedef ImageToImageFilter<TInputImage, TInputImage> Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    itkNewMacro(Self);
+    itkTypeMacro(MultiLabelStatisticsImageFilter, ImageToImageFilter);
+
+    typedef typename TInputImage::RegionType RegionType;
+    typedef typename TInputImage::IndexType IndexType;
+    typedef typename TInputImage::OffsetType OffsetType;
+    typedef typename TInputImage::PixelType PixelType;
+    typedef typename NumericTraits<PixelType>::RealType RealType;
+    typedef typename TLabelImage::PixelType LabelPixelType;
+    typedef itk::Statistics::Histogram<double> HistogramType;
+
+    /** \brief Statistics stored per label */
+    class LabelStatistics
+    {
+    public:
+      LabelStatistics()
+        : m_Count(0),
+          m_PositivePixelCount(0),
+          m_Sum(0),
+          m_SumOfSquares(0),
+          m_SumOfCubes(0),
+          m_SumOfQuadruples(0),
+          m_SumOfPositivePixels(0),
+          m_Minimum(NumericTraits<RealType>::max()),
+          m_Maximum(NumericTraits<RealType>::NonpositiveMin()),
+          m_Mean(0),
+          m_Sigma(0),
+          m_Variance(0),
+          m_Skewness(0),
+          m_Kurtosis(0),
+          m_MPP(0),
+          m_Median(0),
+          m_Entropy(0),
+          m_Uniformity(0),
+          m_UPP(0)
+      {
+        m_MinimumIndex.Fill(0);
+        m_MaximumIndex.Fill(0);
+      }
+
+      SizeValueType m_Count;
+      SizeValueType m_PositivePixelCount;
+      RealType m_Sum;
+      RealType m_SumOfSquares;
+      RealType m_SumOfCubes;
+      RealType m_SumOfQuadruples;
+      RealType m_SumOfPositivePixels;
+      RealType m_Minimum;
+      RealType m_Maximum;
+      IndexType m_MinimumIndex;
+      IndexType m_MaximumIndex;
+
+      RealType m_Mean;
+      RealType m_Sigma;
+      RealType m_Variance;
+      RealType m_Skewness;
+      RealType m_Kurtosis;
+      RealType m_MPP;
+      RealType m_Median;
+      RealType m_Entropy;
+      RealType m_Uniformity;
+      RealType m_UPP;
+      HistogramType::Pointer m_Histogram;
+    };
+
+    typedef std::map<LabelPixelType, LabelStatistics> LabelStatisticsMapType;
+
+    /** Set the label image. Optional, see class description. */
+    void SetLabelInput(const TLabelImage *input)
+    {
+      // Process object is not const-correct so the const casting is required.
+      this->SetNthInput(1, const_cast<TLabelImage *>(input));
+    }
+
+    /** Get the label image */
+    const TLabelImage *GetLabelInput() const
+    {
+      return itkDynamicCastInDebugMode<TLabelImage *>(const_cast<DataObject *>(this->ProcessObject::GetInput(1)));
+    }
+
+    /** Label that all voxels are attributed to if no label image is set. Default is 1. */
+    itkSetMacro(DefaultLabel, LabelPixelType);
+    itkGetConstMacro(DefaultLabel, LabelPixelType);
+
+    /** Use a fixed number of histogram bins for every label. */
+    void SetHistogramBins(unsigned int numberOfBins);
+
+    /** Derive the number of histogram bins of every label from its value range and the given bin size.
+     *  At least 10 bins are used. */
+    void SetHistogramBinSize(double binSize);
+
+    /** Returns the statistics of all labels found by the last update. */
+    const LabelStatisticsMapType &GetLabelStatistics() const { return m_LabelStatistics; }
+
+    /** Does the specified label exist? Can only be called after a call to Update(). */
+    bool HasLabel(LabelPixelType label) const { return m_LabelStatistics.find(label) != m_LabelStatistics.end(); }
+
+    /** Returns the statistics of a label. Throws an itk::ExceptionObject if the label does not exist. */
+    const LabelStatistics &GetStatistics(LabelPixelType label) const;
+
+    std::vector<LabelPixelType> GetRelevantLabels() const;
+
+  protected:
+    MultiLabelStatisticsImageFilter();
+    ~MultiLabelStatisticsImageFilter() override {}
+
+    /** The label image may be smaller than the input image, so the inputs are not required to occupy the same
+     *  physical space. The alignment of both grids is verified before the first sweep instead. */
+    void VerifyInputInformation() override {}
+
+    void GenerateInputRequestedRegion() override;
+
+    void AllocateOutputs() override;
+
+    /** Runs the two sweeps, each as a multithreaded execution of the superclass. */
+    void GenerateData() override;
+
+    void BeforeThreadedGenerateData() override;
+
+    void ThreadedGenerateData(const RegionType &outputRegionForThread, ThreadIdType threadId) override;
+
+    void AfterThreadedGenerateData() override;
+
+  private:
+    enum class SweepType
+    {
+      Moments,
+      Histogram
+    };
+
+    typedef std::vector<HistogramType::AbsoluteFrequencyType> FrequencyContainerType;
+    typedef std::map<LabelPixelType, FrequencyContainerType> FrequencyMapType;
+
+    void InitializeProcessingRegion();
+    void InitializeHistograms();
+    void ComputeDerivedStatistics();
+
+    SweepType m_Sweep;
+    LabelPixelType m_DefaultLabel;
+
+    unsigned int m_NumberOfBins;
+    double m_BinSize;
+    bool m_UseBinSize;
+
+    /** Region of the input image that is covered by the label image. */
+    RegionType m_ProcessingRegion;
+    /** Offset from an input image index to the corresponding label image index. */
+    OffsetType m_LabelOffset;
+
+    std::vector<LabelStatisticsMapType> m_LabelStatisticsPerThread;
+    std::vector<FrequencyMapType> m_FrequenciesPerThread;
+    LabelStatisticsMapType m_LabelStatistics;
+  };
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "mitkMultiLabelStatisticsImageFilter.hxx"
+#endif
+
+#endif
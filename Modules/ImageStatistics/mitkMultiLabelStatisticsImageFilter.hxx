@@ -0,0 +1,457 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __mitkMultiLabelStatisticsImageFilter_hxx
+#define __mitkMultiLabelStatisticsImageFilter_hxx
+
+#include "mitkMultiLabelStatisticsImageFilter.h"
+
+#include <itkContinuousIndex.h>
+#include <itkImageScanlineConstIterator.h>
+#include <itkMath.h>
+#include <mitkHistogramStatisticsCalculator.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+  template <class TInputImage, class TLabelImage>
+  MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::MultiLabelStatisticsImageFilter()
+    : m_Sweep(SweepType::Moments),
+      m_DefaultLabel(1),
+      m_NumberOfBins(100),
+      m_BinSize(10),
+      m_UseBinSize(false)
+  {
+    this->SetNumberOfRequiredInputs(1);
+    m_LabelOffset.Fill(0);
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::SetHistogramBins(unsigned int numberOfBins)
+  {
+    if (numberOfBins != m_NumberOfBins || m_UseBinSize)
+    {
+      m_NumberOfBins = numberOfBins;
+      m_UseBinSize = false;
+      this->Modified();
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::SetHistogramBinSize(double binSize)
+  {
+    if (binSize != m_BinSize || !m_UseBinSize)
+    {
+      m_BinSize = binSize;
+      m_UseBinSize = true;
+      this->Modified();
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  const typename MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelStatistics &
+    MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetStatistics(LabelPixelType label) const
+  {
+    auto it = m_LabelStatistics.find(label);
+    if (it == m_LabelStatistics.end())
+    {
+      itkExceptionMacro(<< "No statistics available for label " << static_cast<double>(label));
+    }
+    return it->second;
+  }
+
+  template <class TInputImage, class TLabelImage>
+  std::vector<typename MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelPixelType>
+    MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetRelevantLabels() const
+  {
+    std::vector<LabelPixelType> labels;
+    labels.reserve(m_LabelStatistics.size());
+    for (const auto &labelStatistics : m_LabelStatistics)
+    {
+      labels.push_back(labelStatistics.first);
+    }
+    return labels;
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+
+    // both inputs are needed completely, independent of the output region
+    auto *input = const_cast<TInputImage *>(this->GetInput());
+    if (input != nullptr)
+    {
+      input->SetRequestedRegionToLargestPossibleRegion();
+    }
+
+    auto *labelInput = const_cast<TLabelImage *>(this->GetLabelInput());
+    if (labelInput != nullptr)
+    {
+      labelInput->SetRequestedRegionToLargestPossibleRegion();
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::AllocateOutputs()
+  {
+    // Pass the input through as the output
+    typename TInputImage::Pointer image = const_cast<TInputImage *>(this->GetInput());
+    this->GraftOutput(image);
+
+    // the threads split the region covered by the label image
+    this->GetOutput()->SetRequestedRegion(m_ProcessingRegion);
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::InitializeProcessingRegion()
+  {
+    const TInputImage *input = this->GetInput();
+    const TLabelImage *labelInput = this->GetLabelInput();
+
+    m_LabelOffset.Fill(0);
+
+    if (labelInput == nullptr)
+    {
+      m_ProcessingRegion = input->GetLargestPossibleRegion();
+      return;
+    }
+
+    const double coordinateTolerance = this->GetCoordinateTolerance() * std::abs(input->GetSpacing()[0]);
+
+    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    {
+      if (std::abs(input->GetSpacing()[i] - labelInput->GetSpacing()[i]) > coordinateTolerance)
+      {
+        itkExceptionMacro(<< "Spacing of label image and input image is not equal. Label image: "
+                          << labelInput->GetSpacing() << " input image: " << input->GetSpacing());
+      }
+
+      for (unsigned int j = 0; j < TInputImage::ImageDimension; ++j)
+      {
+        if (std::abs(input->GetDirection()[i][j] - labelInput->GetDirection()[i][j]) > this->GetDirectionTolerance())
+        {
+          itkExceptionMacro(<< "Label image needs to have the same direction as the input image");
+        }
+      }
+    }
+
+    // the origin of the label image has to be located on a voxel center of the input image
+    ContinuousIndex<double, TInputImage::ImageDimension> labelOrigin;
+    input->TransformPhysicalPointToContinuousIndex(labelInput->GetOrigin(), labelOrigin);
+
+    IndexType processingIndex;
+    const auto &labelRegion = labelInput->GetLargestPossibleRegion();
+
+    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    {
+      const auto labelOriginIndex = Math::Round<IndexValueType>(labelOrigin[i]);
+      if (std::abs(labelOrigin[i] - labelOriginIndex) > this->GetCoordinateTolerance())
+      {
+        itkExceptionMacro(<< "Voxels of label image and input image are not aligned");
+      }
+
+      processingIndex[i] = labelOriginIndex + labelRegion.GetIndex()[i];
+      m_LabelOffset[i] = -labelOriginIndex;
+    }
+
+    m_ProcessingRegion.SetIndex(processingIndex);
+    m_ProcessingRegion.SetSize(labelRegion.GetSize());
+
+    if (!input->GetLargestPossibleRegion().IsInside(m_ProcessingRegion))
+    {
+      itkExceptionMacro(<< "Label image region needs to be inside of the input image region. Input image region: "
+                        << input->GetLargestPossibleRegion() << " label image region: " << m_ProcessingRegion);
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::GenerateData()
+  {
+    this->InitializeProcessingRegion();
+    m_LabelStatistics.clear();
+
+    m_Sweep = SweepType::Moments;
+    Superclass::GenerateData();
+
+    if (!m_LabelStatistics.empty())
+    {
+      m_Sweep = SweepType::Histogram;
+      Superclass::GenerateData();
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::BeforeThreadedGenerateData()
+  {
+    const ThreadIdType numberOfThreads = this->GetNumberOfThreads();
+
+    if (m_Sweep == SweepType::Moments)
+    {
+      m_LabelStatisticsPerThread.assign(numberOfThreads, LabelStatisticsMapType());
+    }
+    else
+    {
+      m_FrequenciesPerThread.assign(numberOfThreads, FrequencyMapType());
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedGenerateData(
+    const RegionType &outputRegionForThread, ThreadIdType threadId)
+  {
+    if (outputRegionForThread.GetSize(0) == 0)
+    {
+      return;
+    }
+
+    const TLabelImage *labelInput = this->GetLabelInput();
+
+    ImageScanlineConstIterator<TInputImage> it(this->GetInput(), outputRegionForThread);
+    ImageScanlineConstIterator<TLabelImage> labelIt;
+
+    if (labelInput != nullptr)
+    {
+      typename TLabelImage::RegionType labelRegion(outputRegionForThread.GetIndex() + m_LabelOffset,
+                                                   outputRegionForThread.GetSize());
+      labelIt = ImageScanlineConstIterator<TLabelImage>(labelInput, labelRegion);
+    }
+
+    // Voxels of the same label are usually contiguous, so the per label entry is only looked up if the label
+    // changes between two voxels.
+    LabelPixelType currentLabel = m_DefaultLabel;
+
+    if (m_Sweep == SweepType::Moments)
+    {
+      LabelStatisticsMapType &threadStatistics = m_LabelStatisticsPerThread[threadId];
+      LabelStatistics *labelStatistics = nullptr;
+
+      while (!it.IsAtEnd())
+      {
+        while (!it.IsAtEndOfLine())
+        {
+          const LabelPixelType label = labelInput != nullptr ? labelIt.Get() : m_DefaultLabel;
+          if (labelStatistics == nullptr || label != currentLabel)
+          {
+            labelStatistics = &threadStatistics[label];
+            currentLabel = label;
+          }
+
+          const auto value = static_cast<RealType>(it.Get());
+          const RealType squaredValue = value * value;
+
+          if (value < labelStatistics->m_Minimum)
+          {
+            labelStatistics->m_Minimum = value;
+            labelStatistics->m_MinimumIndex = it.GetIndex();
+          }
+          if (value > labelStatistics->m_Maximum)
+          {
+            labelStatistics->m_Maximum = value;
+            labelStatistics->m_MaximumIndex = it.GetIndex();
+          }
+
+          ++labelStatistics->m_Count;
+          labelStatistics->m_Sum += value;
+          labelStatistics->m_SumOfSquares += squaredValue;
+          labelStatistics->m_SumOfCubes += squaredValue * value;
+          labelStatistics->m_SumOfQuadruples += squaredValue * squaredValue;
+
+          if (value > 0)
+          {
+            ++labelStatistics->m_PositivePixelCount;
+            labelStatistics->m_SumOfPositivePixels += value;
+          }
+
+          ++it;
+          if (labelInput != nullptr)
+            ++labelIt;
+        }
+
+        it.NextLine();
+        if (labelInput != nullptr)
+          labelIt.NextLine();
+      }
+    }
+    else
+    {
+      FrequencyMapType &threadFrequencies = m_FrequenciesPerThread[threadId];
+      const HistogramType *histogram = nullptr;
+      FrequencyContainerType *frequencies = nullptr;
+
+      typename HistogramType::IndexType histogramIndex(1);
+      typename HistogramType::MeasurementVectorType histogramMeasurement(1);
+
+      while (!it.IsAtEnd())
+      {
+        while (!it.IsAtEndOfLine())
+        {
+          const LabelPixelType label = labelInput != nullptr ? labelIt.Get() : m_DefaultLabel;
+          if (histogram == nullptr || label != currentLabel)
+          {
+            // every label has been seen in the first sweep, so it is known here
+            histogram = m_LabelStatistics.find(label)->second.m_Histogram.GetPointer();
+            frequencies = &threadFrequencies[label];
+            frequencies->resize(histogram->GetSize(0), 0);
+            currentLabel = label;
+          }
+
+          histogramMeasurement[0] = static_cast<RealType>(it.Get());
+          if (histogram->GetIndex(histogramMeasurement, histogramIndex))
+          {
+            ++(*frequencies)[histogramIndex[0]];
+          }
+
+          ++it;
+          if (labelInput != nullptr)
+            ++labelIt;
+        }
+
+        it.NextLine();
+        if (labelInput != nullptr)
+          labelIt.NextLine();
+      }
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterThreadedGenerateData()
+  {
+    if (m_Sweep == SweepType::Moments)
+    {
+      // merge in thread order, so that the first occurrence of an extremum wins
+      for (const auto &threadStatistics : m_LabelStatisticsPerThread)
+      {
+        for (const auto &threadLabelStatistics : threadStatistics)
+        {
+          const LabelStatistics &source = threadLabelStatistics.second;
+          LabelStatistics &target = m_LabelStatistics[threadLabelStatistics.first];
+
+          target.m_Count += source.m_Count;
+          target.m_PositivePixelCount += source.m_PositivePixelCount;
+          target.m_Sum += source.m_Sum;
+          target.m_SumOfSquares += source.m_SumOfSquares;
+          target.m_SumOfCubes += source.m_SumOfCubes;
+          target.m_SumOfQuadruples += source.m_SumOfQuadruples;
+          target.m_SumOfPositivePixels += source.m_SumOfPositivePixels;
+
+          if (source.m_Minimum < target.m_Minimum)
+          {
+            target.m_Minimum = source.m_Minimum;
+            target.m_MinimumIndex = source.m_MinimumIndex;
+          }
+          if (source.m_Maximum > target.m_Maximum)
+          {
+            target.m_Maximum = source.m_Maximum;
+            target.m_MaximumIndex = source.m_MaximumIndex;
+          }
+        }
+      }
+
+      m_LabelStatisticsPerThread.clear();
+      this->InitializeHistograms();
+    }
+    else
+    {
+      for (const auto &threadFrequencies : m_FrequenciesPerThread)
+      {
+        for (const auto &labelFrequencies : threadFrequencies)
+        {
+          HistogramType *histogram = m_LabelStatistics[labelFrequencies.first].m_Histogram;
+          const FrequencyContainerType &frequencies = labelFrequencies.second;
+
+          for (std::size_t bin = 0; bin < frequencies.size(); ++bin)
+          {
+            if (frequencies[bin] != 0)
+              histogram->IncreaseFrequency(bin, frequencies[bin]);
+          }
+        }
+      }
+
+      m_FrequenciesPerThread.clear();
+      this->ComputeDerivedStatistics();
+    }
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::InitializeHistograms()
+  {
+    for (auto &labelStatistics : m_LabelStatistics)
+    {
+      LabelStatistics &statistics = labelStatistics.second;
+
+      unsigned int numberOfBins = m_NumberOfBins;
+      if (m_UseBinSize)
+      {
+        numberOfBins = std::max(static_cast<double>(std::ceil(statistics.m_Maximum - statistics.m_Minimum)) / m_BinSize,
+                                10.); // do not allow less than 10 bins
+      }
+
+      typename HistogramType::SizeType size(1);
+      typename HistogramType::MeasurementVectorType lowerBound(1);
+      typename HistogramType::MeasurementVectorType upperBound(1);
+      size[0] = numberOfBins;
+      lowerBound[0] = statistics.m_Minimum;
+      upperBound[0] = statistics.m_Maximum;
+
+      statistics.m_Histogram = HistogramType::New();
+      statistics.m_Histogram->SetMeasurementVectorSize(1);
+      statistics.m_Histogram->Initialize(size, lowerBound, upperBound);
+    }
+  }
+
+  template <class TLabelStatistics>
+  void ComputeDerivedLabelStatistics(TLabelStatistics &ls)
+  {
+    const auto count = static_cast<double>(ls.m_Count);
+
+    ls.m_Mean = ls.m_Sum / count;
+    ls.m_MPP = ls.m_SumOfPositivePixels / static_cast<double>(ls.m_PositivePixelCount);
+
+    // unbiased estimate of variance
+    ls.m_Variance = (ls.m_SumOfSquares - ls.m_Sum * ls.m_Sum / count) / count;
+    ls.m_Sigma = std::sqrt(ls.m_Variance);
+
+    const double secondMoment = ls.m_SumOfSquares / count;
+    const double thirdMoment = ls.m_SumOfCubes / count;
+    const double fourthMoment = ls.m_SumOfQuadruples / count;
+
+    // see http://www.boost.org/doc/libs/1_51_0/doc/html/boost/accumulators/impl/skewness_impl.html
+    ls.m_Skewness = (thirdMoment - 3. * secondMoment * ls.m_Mean + 2. * std::pow(ls.m_Mean, 3.)) /
+                    std::pow(secondMoment - std::pow(ls.m_Mean, 2.), 1.5);
+    // see http://www.boost.org/doc/libs/1_51_0/doc/html/boost/accumulators/impl/kurtosis_impl.html, dropped -3
+    ls.m_Kurtosis = (fourthMoment - 4. * thirdMoment * ls.m_Mean + 6. * secondMoment * std::pow(ls.m_Mean, 2.) -
+                     3. * std::pow(ls.m_Mean, 4.)) /
+                    std::pow(secondMoment - std::pow(ls.m_Mean, 2.), 2.);
+
+    mitk::HistogramStatisticsCalculator histStatCalc;
+    histStatCalc.SetHistogram(ls.m_Histogram);
+    histStatCalc.CalculateStatistics();
+    ls.m_Median = histStatCalc.GetMedian();
+    ls.m_Entropy = histStatCalc.GetEntropy();
+    ls.m_Uniformity = histStatCalc.GetUniformity();
+    ls.m_UPP = histStatCalc.GetUPP();
+  }
+
+  template <class TInputImage, class TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::ComputeDerivedStatistics()
+  {
+    for (auto &labelStatistics : m_LabelStatistics)
+    {
+      ComputeDerivedLabelStatistics(labelStatistics.second);
+    }
+  }
+
+} // end namespace itk
+
+#endif
@@ -53,6 +53,11 @@ mitk::ImageStatisticsContainer* QmitkImageStatisticsCalculationRunnable::GetStat
   return this->m_StatisticsContainer.GetPointer();
 }
 
+mitk::ImageStatisticsCalculator* QmitkImageStatisticsCalculationRunnable::GetStatisticsCalculator() const
+{
+  return this->m_StatisticsCalculator.GetPointer();
+}
+
 const mitk::Image* QmitkImageStatisticsCalculationRunnable::GetStatisticsImage() const
 {
   return this->m_StatisticsImage.GetPointer();
@@ -163,6 +168,7 @@ bool QmitkImageStatisticsCalculationRunnable::RunComputation()
   if (statisticCalculationSuccessful)
   {
     m_StatisticsContainer = calculator->GetStatistics();
+    m_StatisticsCalculator = calculator;
 
     auto imageRule = mitk::StatisticsToImageRelationRule::New();
     imageRule->Connect(m_StatisticsContainer, m_StatisticsImage);
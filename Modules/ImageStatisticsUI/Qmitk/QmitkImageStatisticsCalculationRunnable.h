@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkImage.h"
 #include "mitkPlanarFigure.h"
 #include "mitkImageStatisticsContainer.h"
+#include "mitkImageStatisticsCalculator.h"
 
 #include "QmitkDataGenerationJobBase.h"
 
@@ -52,6 +53,10 @@ public:
   /*!
   /brief returns the calculated image statistics. */
   mitk::ImageStatisticsContainer* GetStatisticsData() const;
+  /*!
+  /brief returns the calculator that computed the statistics, e.g. to update them incrementally after the mask has
+  been changed (see mitk::ImageStatisticsCalculator::UpdateStatistics). nullptr if the calculation failed. */
+  mitk::ImageStatisticsCalculator* GetStatisticsCalculator() const;
 
   const mitk::Image* GetStatisticsImage() const;
   const mitk::Image* GetMaskImage() const;
@@ -80,6 +85,7 @@ private:
   mitk::Image::ConstPointer m_BinaryMask;                              ///< member variable holds the binary mask image for segmentation image statistics calculation.
   mitk::PlanarFigure::ConstPointer m_PlanarFigureMask;                 ///< member variable holds the planar figure for segmentation image statistics calculation.
   mitk::ImageStatisticsContainer::Pointer m_StatisticsContainer;
+  mitk::ImageStatisticsCalculator::Pointer m_StatisticsCalculator;
   bool m_IgnoreZeros;                                             ///< member variable holds flag to indicate if zero valued voxel should be suppressed
   unsigned int m_HistogramNBins;                                      ///< member variable holds the bin size for histogram resolution.
 };
@@ -21,9 +21,21 @@ found in the LICENSE file.
 #include "mitkNodePredicateDataProperty.h"
 #include "mitkProperties.h"
 #include "mitkImageStatisticsContainerManager.h"
+#include "mitkSegmentationSliceModifiedEvent.h"
+
+#include <itkCommand.h>
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
+QmitkImageStatisticsDataGenerator::~QmitkImageStatisticsDataGenerator()
+{
+  for (auto& update : m_IncrementalUpdates)
+  {
+    update.m_Calculator = nullptr;
+  }
+  this->RemoveObsoleteMaskObservers();
+}
+
 void QmitkImageStatisticsDataGenerator::SetIgnoreZeroValueVoxel(bool _arg)
 {
   if (m_IgnoreZeroValueVoxel != _arg)
@@ -241,12 +253,125 @@ mitk::DataNode::Pointer QmitkImageStatisticsDataGenerator::PrepareResultForStora
     }
     resultNode->SetName(this->GenerateStatisticsNodeName(statsJob->GetStatisticsImage(), roi));
 
+    this->ObserveMaskSliceModifications(statsJob);
+
     return resultNode;
   }
 
   return nullptr;
 }
 
+void QmitkImageStatisticsDataGenerator::ObserveMaskSliceModifications(const QmitkImageStatisticsCalculationRunnable* job) const
+{
+  // incremental updates are not supported with a secondary mask (ignored zero voxels)
+  auto mask = const_cast<mitk::Image*>(job->GetMaskImage());
+  if (mask == nullptr || job->GetIgnoreZeroValueVoxel() || job->GetStatisticsCalculator() == nullptr)
+  {
+    return;
+  }
+
+  // the new result replaces the previous one of the same image and mask
+  for (auto& update : m_IncrementalUpdates)
+  {
+    if (update.m_Mask.Lock() == mask && update.m_StatisticsImage == job->GetStatisticsImage())
+    {
+      update.m_Calculator = nullptr;
+    }
+  }
+  this->RemoveObsoleteMaskObservers();
+
+  auto command = itk::MemberCommand<QmitkImageStatisticsDataGenerator>::New();
+  command->SetCallbackFunction(const_cast<QmitkImageStatisticsDataGenerator*>(this), &QmitkImageStatisticsDataGenerator::OnMaskSliceModified);
+
+  IncrementalUpdate update;
+  update.m_Mask = mask;
+  update.m_ObserverTag = mask->AddObserver(mitk::SegmentationSliceModifiedEvent(), command);
+  update.m_StatisticsImage = job->GetStatisticsImage();
+  update.m_Statistics = job->GetStatisticsData();
+  update.m_Calculator = job->GetStatisticsCalculator();
+  m_IncrementalUpdates.push_back(update);
+}
+
+void QmitkImageStatisticsDataGenerator::OnMaskSliceModified(const itk::Object* caller, const itk::EventObject& event)
+{
+  auto sliceEvent = dynamic_cast<const mitk::SegmentationSliceModifiedEvent*>(&event);
+  if (sliceEvent == nullptr)
+  {
+    return;
+  }
+
+  auto storage = m_Storage.Lock();
+  auto updatedNodes = mitk::DataStorage::SetOfObjects::New();
+
+  // observers are only removed later, removing them while the event is invoked is not safe
+  for (auto& update : m_IncrementalUpdates)
+  {
+    if (update.m_Calculator.IsNull() || update.m_Mask.Lock().GetPointer() != caller)
+    {
+      continue;
+    }
+
+    // results that have been removed from the storage are not updated anymore
+    mitk::DataNode::Pointer node;
+    if (storage.IsNotNull())
+    {
+      auto statistics = update.m_Statistics;
+      node = storage->GetNode(mitk::NodePredicateFunction::New([&statistics](const mitk::DataNode* candidate) { return candidate->GetData() == statistics.GetPointer(); }));
+    }
+
+    bool updated = false;
+
+    if (node.IsNotNull() && sliceEvent->GetPreviousSlice() != nullptr)
+    {
+      try
+      {
+        updated = update.m_Calculator->UpdateStatistics(sliceEvent->GetPreviousSlice(), sliceEvent->GetCurrentSlice(), sliceEvent->GetTimeStep());
+      }
+      catch (const std::exception& e)
+      {
+        MITK_WARN << "Statistics could not be updated incrementally: " << e.what();
+      }
+    }
+
+    if (updated)
+    {
+      // the result is newer than the changed mask again, so it is not recomputed
+      update.m_Statistics->Modified();
+      updatedNodes->push_back(node);
+    }
+    else
+    {
+      // the outdated result is recomputed completely by the regular generation
+      update.m_Calculator = nullptr;
+    }
+  }
+
+  if (!updatedNodes->empty())
+  {
+    emit NewDataAvailable(updatedNodes.GetPointer());
+  }
+}
+
+void QmitkImageStatisticsDataGenerator::RemoveObsoleteMaskObservers() const
+{
+  for (auto pos = m_IncrementalUpdates.begin(); pos != m_IncrementalUpdates.end();)
+  {
+    auto mask = pos->m_Mask.Lock();
+    if (mask.IsNull() || pos->m_Calculator.IsNull())
+    {
+      if (mask.IsNotNull())
+      {
+        mask->RemoveObserver(pos->m_ObserverTag);
+      }
+      pos = m_IncrementalUpdates.erase(pos);
+    }
+    else
+    {
+      ++pos;
+    }
+  }
+}
+
 std::string QmitkImageStatisticsDataGenerator::GenerateStatisticsNodeName(const mitk::Image* image, const mitk::BaseData* roi) const
 {
   std::stringstream statisticsNodeName;
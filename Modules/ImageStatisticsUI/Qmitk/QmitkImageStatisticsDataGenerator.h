@@ -15,13 +15,21 @@ found in the LICENSE file.
 
 #include "QmitkImageAndRoiDataGeneratorBase.h"
 
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkWeakPointer.h>
+
 #include <MitkImageStatisticsUIExports.h>
 
+class QmitkImageStatisticsCalculationRunnable;
+
 /**
 Generates ImageStatisticContainers by using QmitkImageStatisticsCalculationRunnables for each pair if image and ROIs and ensures their
 validity.
 It also encodes the HistogramNBins and IgnoreZeroValueVoxel as properties to the results as these settings are important criteria for
 discreminating statistics results.
+Statistics of image masks are updated incrementally if the mask invokes a mitk::SegmentationSliceModifiedEvent (e.g. if it
+is changed by a segmentation tool), see mitk::ImageStatisticsCalculator::UpdateStatistics(). They are only recomputed
+completely if the change cannot be applied incrementally.
 For more details of how the generation is done see QmitkDataGenerationBase.
 */
 class MITKIMAGESTATISTICSUI_EXPORT QmitkImageStatisticsDataGenerator : public QmitkImageAndRoiDataGeneratorBase
@@ -29,6 +37,7 @@ class MITKIMAGESTATISTICSUI_EXPORT QmitkImageStatisticsDataGenerator : public Qm
 public:
   QmitkImageStatisticsDataGenerator(mitk::DataStorage::Pointer storage, QObject* parent = nullptr) : QmitkImageAndRoiDataGeneratorBase(storage, parent) {};
   QmitkImageStatisticsDataGenerator(QObject* parent = nullptr) : QmitkImageAndRoiDataGeneratorBase(parent) {};
+  ~QmitkImageStatisticsDataGenerator() override;
 
   bool IsValidResultAvailable(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
 
@@ -59,11 +68,32 @@ protected:
   void RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
   mitk::DataNode::Pointer PrepareResultForStorage(const std::string& label, mitk::BaseData* result, const QmitkDataGenerationJobBase* job) const;
 
+  /** Keeps the calculator of a result whose mask is an image to update the result when a slice of the mask is changed.*/
+  void ObserveMaskSliceModifications(const QmitkImageStatisticsCalculationRunnable* job) const;
+  /** Updates the statistics of the calling mask with the changed slice, drops results that cannot be updated, so that they
+  are recomputed completely.*/
+  void OnMaskSliceModified(const itk::Object* caller, const itk::EventObject& event);
+  /** Removes the observers of masks whose results cannot be updated anymore.*/
+  void RemoveObsoleteMaskObservers() const;
+
   QmitkImageStatisticsDataGenerator(const QmitkImageStatisticsDataGenerator&) = delete;
   QmitkImageStatisticsDataGenerator& operator = (const QmitkImageStatisticsDataGenerator&) = delete;
 
   bool m_IgnoreZeroValueVoxel = false;
   unsigned int m_HistogramNBins = 100;
+
+  struct IncrementalUpdate
+  {
+    mitk::WeakPointer<mitk::Image> m_Mask;
+    unsigned long m_ObserverTag = 0;
+    /** Only used to identify the result of an image and mask.*/
+    const mitk::Image* m_StatisticsImage = nullptr;
+    mitk::ImageStatisticsContainer::Pointer m_Statistics;
+    /** nullptr if the statistics cannot be updated anymore.*/
+    mitk::ImageStatisticsCalculator::Pointer m_Calculator;
+  };
+  /** Results that are updated incrementally, only accessed by the GUI thread.*/
+  mutable std::vector<IncrementalUpdate> m_IncrementalUpdates;
 };
 
 #endif
@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include "mitkStatisticsToMaskRelationRule.h"
 #include "mitkImageStatisticsContainerManager.h"
 #include "mitkProperties.h"
+#include "mitkImagePixelWriteAccessor.h"
+#include "mitkSegmentationSliceModifiedEvent.h"
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
@@ -78,6 +80,7 @@ class QmitkImageStatisticsDataGeneratorTestSuite : public mitk::TestFixture
   MITK_TEST(InputChangedTest);
   MITK_TEST(SettingsChangedTest);
   MITK_TEST(DataStorageModificationTest);
+  MITK_TEST(MaskSliceModifiedTest);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::DataStorage::Pointer m_DataStorage;
@@ -514,6 +517,90 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Error: Auto update was triggerd, but only irrelevant node was added.", 3 == generator.m_NewDataAvailable.size());
   }
 
+
+  void MaskSliceModifiedTest()
+  {
+    // image of 6x6x2 voxels with the gray value x + 10 * y, mask with label 1 for x < 3
+    const unsigned int dimensions[] = { 6, 6, 2 };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+    auto mask = mitk::Image::New();
+    mask->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> imageAccessor(image);
+      mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+      itk::Index<3> index;
+      for (index[2] = 0; index[2] < 2; ++index[2])
+        for (index[1] = 0; index[1] < 6; ++index[1])
+          for (index[0] = 0; index[0] < 6; ++index[0])
+          {
+            imageAccessor.SetPixelByIndex(index, static_cast<short>(index[0] + 10 * index[1]));
+            maskAccessor.SetPixelByIndex(index, index[0] < 3 ? 1 : 0);
+          }
+    }
+
+    auto imageNode = mitk::DataNode::New();
+    imageNode->SetName("Image");
+    imageNode->SetData(image);
+    m_DataStorage->Add(imageNode);
+
+    auto maskNode = mitk::DataNode::New();
+    maskNode->SetName("Segmentation");
+    maskNode->SetData(mask);
+    m_DataStorage->Add(maskNode);
+
+    TestQmitkImageStatisticsDataGenerator generator(m_DataStorage);
+
+    generator.SetImageNodes({ imageNode });
+    generator.SetROINodes({ maskNode });
+    generator.Generate();
+    m_TestApp->exec();
+
+    CPPUNIT_ASSERT_EQUAL(1, generator.m_DataGenerationStartedEmited);
+    CPPUNIT_ASSERT(1 == generator.m_NewDataAvailable.size());
+    auto resultNode = generator.m_NewDataAvailable[0]->front();
+    auto statistics = dynamic_cast<const mitk::ImageStatisticsContainer*>(resultNode->GetData());
+    CPPUNIT_ASSERT(statistics != nullptr);
+
+    // a segmentation tool changes the first slice such that the column x = 3 is added to label 1
+    auto previousSlice = mitk::Image::New();
+    previousSlice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+    auto currentSlice = mitk::Image::New();
+    currentSlice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+    {
+      mitk::ImagePixelWriteAccessor<unsigned short, 2> previousAccessor(previousSlice);
+      mitk::ImagePixelWriteAccessor<unsigned short, 2> currentAccessor(currentSlice);
+      mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+      itk::Index<2> index;
+      for (index[1] = 0; index[1] < 6; ++index[1])
+        for (index[0] = 0; index[0] < 6; ++index[0])
+        {
+          previousAccessor.SetPixelByIndex(index, index[0] < 3 ? 1 : 0);
+          currentAccessor.SetPixelByIndex(index, index[0] < 4 ? 1 : 0);
+        }
+
+      itk::Index<3> maskIndex;
+      maskIndex[0] = 3;
+      maskIndex[2] = 0;
+      for (maskIndex[1] = 0; maskIndex[1] < 6; ++maskIndex[1])
+        maskAccessor.SetPixelByIndex(maskIndex, 1);
+    }
+    mask->Modified();
+    mask->InvokeEvent(mitk::SegmentationSliceModifiedEvent(previousSlice, currentSlice, 0));
+
+    CPPUNIT_ASSERT_MESSAGE("Error: Statistics were not updated incrementally.", 2 == generator.m_NewDataAvailable.size());
+    CPPUNIT_ASSERT(resultNode == generator.m_NewDataAvailable[1]->front());
+
+    // 24 voxels of the first slice with a sum of 636 and 18 voxels of the second slice with a sum of 468
+    const auto& stats = statistics->GetStatisticsForTimeStep(0);
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::VoxelCountType(42),
+      stats.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1104.0 / 42.0,
+      stats.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEAN()), mitk::eps);
+
+    CPPUNIT_ASSERT_MESSAGE("Error: Updated statistics are regarded as outdated.", generator.Generate());
+    CPPUNIT_ASSERT_EQUAL(1, generator.m_DataGenerationStartedEmited);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(QmitkImageStatisticsDataGenerator)
@@ -6,3 +6,7 @@ set(MODULE_TESTS
     mitkLabelSetImageSurfaceStampFilterTest.cpp
 )
 
+set(MODULE_RENDERING_TESTS
+    mitkLabelSetImageVtkMapper2DTest.cpp
+)
+
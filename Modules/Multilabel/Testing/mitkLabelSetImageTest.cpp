@@ -11,16 +11,36 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <thread>
+
+namespace
+{
+  struct LayerEventCounter
+  {
+    void OnBeforeChangeLayer() { ++m_Before; }
+    void OnAfterChangeLayer() { ++m_After; }
+
+    int m_Before = 0;
+    int m_After = 0;
+  };
+}
+
 class mitkLabelSetImageTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkLabelSetImageTestSuite);
   MITK_TEST(TestInitialize);
   MITK_TEST(TestAddLayer);
+  MITK_TEST(TestAddLayerKeepsLayerImage);
   MITK_TEST(TestGetActiveLabelSet);
   MITK_TEST(TestGetActiveLabel);
   MITK_TEST(TestInitializeByLabeledImage);
@@ -31,6 +51,7 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestExistsLabel);
   MITK_TEST(TestExistsLabelSet);
   MITK_TEST(TestSetActiveLayer);
+  MITK_TEST(TestSetActiveLayerWaitsForAccessors);
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestMergeLabel);
@@ -115,6 +136,45 @@ public:
                            m_LabelSetImage->GetActiveLabel(layerID)->GetValue() == 200);
   }
 
+  void TestAddLayerKeepsLayerImage()
+  {
+    const std::size_t size = 96 * 128 * 52;
+
+    mitk::Image::Pointer layerImage = mitk::Image::New();
+    layerImage->Initialize(m_LabelSetImage);
+    {
+      mitk::ImageWriteAccessor accessor(layerImage);
+      std::fill_n(static_cast<mitk::Label::PixelType *>(accessor.GetData()), size, 7);
+    }
+
+    const unsigned int layerID = m_LabelSetImage->AddLayer(layerImage);
+
+    // the data of the layers is swapped with the data of the label set image when switching layers
+    m_LabelSetImage->SetActiveLayer(0);
+    m_LabelSetImage->SetActiveLayer(layerID);
+    m_LabelSetImage->SetActiveLayer(0);
+
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLayerImage(layerID) != layerImage.GetPointer());
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLayerImage(0) != layerImage.GetPointer());
+
+    {
+      mitk::ImageReadAccessor accessor(layerImage);
+      const auto *data = static_cast<const mitk::Label::PixelType *>(accessor.GetData());
+      CPPUNIT_ASSERT_MESSAGE("The passed image was changed by adding it as layer",
+                             std::all_of(data, data + size, [](mitk::Label::PixelType value) { return value == 7; }));
+    }
+
+    // writing to the passed image does not change the layer
+    {
+      mitk::ImageWriteAccessor accessor(layerImage);
+      std::fill_n(static_cast<mitk::Label::PixelType *>(accessor.GetData()), size, 3);
+    }
+
+    mitk::ImageReadAccessor layerAccessor(m_LabelSetImage->GetLayerImage(layerID));
+    const auto *layerData = static_cast<const mitk::Label::PixelType *>(layerAccessor.GetData());
+    CPPUNIT_ASSERT(std::all_of(layerData, layerData + size, [](mitk::Label::PixelType value) { return value == 7; }));
+  }
+
   void TestGetActiveLabelSet()
   {
     mitk::LabelSet::Pointer newlayer = mitk::LabelSet::New();
@@ -323,6 +383,44 @@ public:
                            mitk::Equal(*newlayer, *m_LabelSetImage->GetActiveLabelSet(), 0.00001, true));
   }
 
+  void TestSetActiveLayerWaitsForAccessors()
+  {
+    const unsigned int layerID = m_LabelSetImage->AddLayer();
+    m_LabelSetImage->SetActiveLayer(0);
+
+    LayerEventCounter counter;
+    m_LabelSetImage->BeforeChangeLayerEvent +=
+      mitk::MessageDelegate<LayerEventCounter>(&counter, &LayerEventCounter::OnBeforeChangeLayer);
+    m_LabelSetImage->AfterChangeLayerEvent +=
+      mitk::MessageDelegate<LayerEventCounter>(&counter, &LayerEventCounter::OnAfterChangeLayer);
+
+    // another thread reads the active layer while the layer is switched
+    std::promise<void> accessed;
+    auto accessedFuture = accessed.get_future();
+    mitk::LabelSetImage::Pointer labelSetImage = m_LabelSetImage;
+
+    std::thread reader([labelSetImage, &accessed]() {
+      mitk::ImageReadAccessor accessor(labelSetImage);
+      accessed.set_value();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    });
+
+    accessedFuture.wait();
+    CPPUNIT_ASSERT_NO_THROW(m_LabelSetImage->SetActiveLayer(layerID));
+    reader.join();
+
+    CPPUNIT_ASSERT_EQUAL(layerID, m_LabelSetImage->GetActiveLayer());
+    CPPUNIT_ASSERT_EQUAL(1, counter.m_Before);
+    CPPUNIT_ASSERT_EQUAL(1, counter.m_After);
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLayerImage(layerID) == m_LabelSetImage.GetPointer());
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLayerImage(0) != m_LabelSetImage.GetPointer());
+
+    m_LabelSetImage->BeforeChangeLayerEvent -=
+      mitk::MessageDelegate<LayerEventCounter>(&counter, &LayerEventCounter::OnBeforeChangeLayer);
+    m_LabelSetImage->AfterChangeLayerEvent -=
+      mitk::MessageDelegate<LayerEventCounter>(&counter, &LayerEventCounter::OnAfterChangeLayer);
+  }
+
   void TestRemoveLayer()
   {
     // Cache active layer
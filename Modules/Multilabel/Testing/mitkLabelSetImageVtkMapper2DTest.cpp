@@ -0,0 +1,189 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkRenderingTestHelper.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+
+#include <vtkImageData.h>
+#include <vtkRenderWindow.h>
+#include <vtkSmartPointer.h>
+#include <vtkWindowToImageFilter.h>
+
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+  const unsigned int Size = 30;
+  const int WindowSize = 300;
+
+  /** Rendered colors may deviate slightly from the label colors */
+  const double Tolerance = 30.0;
+}
+
+/**
+  \brief Verify that the layers of a LabelSetImage are composited in layer order, with the upper layers blended
+  over the lower ones.
+
+  The lower layer labels the left two thirds of the image, the upper layer the right two thirds. The middle third
+  is labeled in both layers.
+*/
+class mitkLabelSetImageVtkMapper2DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageVtkMapper2DTestSuite);
+  MITK_TEST(Render_OpaqueLayers_UpperLayerCoversOverlap);
+  MITK_TEST(Render_SwappedLayers_OtherLayerCoversOverlap);
+  MITK_TEST(Render_TranslucentUpperLayer_BlendsOverlap);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::LabelSetImage::PixelType PixelType;
+
+  mitk::RenderingTestHelper m_RenderingTestHelper;
+  mitk::Color m_Red;
+  mitk::Color m_Blue;
+
+  static mitk::Label::Pointer CreateLabel(const mitk::Color &color, float opacity)
+  {
+    mitk::Label::Pointer label = mitk::Label::New();
+    label->SetValue(1);
+    label->SetColor(color);
+    label->SetOpacity(opacity);
+    return label;
+  }
+
+  /** Sets the label of all pixels with begin <= x < end to 1 */
+  static void FillColumns(mitk::Image *image, itk::IndexValueType begin, itk::IndexValueType end)
+  {
+    mitk::ImagePixelWriteAccessor<PixelType, 3> accessor(image);
+    itk::Index<3> index;
+
+    for (index[2] = 0; index[2] < static_cast<itk::IndexValueType>(Size); ++index[2])
+      for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(Size); ++index[1])
+        for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(Size); ++index[0])
+          accessor.SetPixelByIndex(index, index[0] >= begin && index[0] < end ? 1 : 0);
+  }
+
+  void RenderLayers(const mitk::Color &lowerColor, const mitk::Color &upperColor, float upperOpacity)
+  {
+    unsigned int dimensions[] = {Size, Size, Size};
+
+    auto reference = mitk::Image::New();
+    reference->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, dimensions);
+
+    auto segmentation = mitk::LabelSetImage::New();
+    segmentation->Initialize(reference);
+
+    // layer 0 is the active layer, its data is the data of the segmentation itself
+    FillColumns(segmentation, 0, 2 * Size / 3);
+    segmentation->GetLabelSet(0)->AddLabel(CreateLabel(lowerColor, 1.0f));
+
+    auto upperLayer = mitk::Image::New();
+    upperLayer->Initialize(reference);
+    FillColumns(upperLayer, Size / 3, Size);
+
+    auto upperLabelSet = mitk::LabelSet::New();
+    upperLabelSet->AddLabel(segmentation->GetExteriorLabel());
+    upperLabelSet->AddLabel(CreateLabel(upperColor, upperOpacity));
+    segmentation->AddLayer(upperLayer, upperLabelSet);
+
+    // both layers are composited independent of which one is active
+    segmentation->SetActiveLayer(0);
+
+    auto node = mitk::DataNode::New();
+    node->SetData(segmentation);
+    node->SetBoolProperty("labelset.contour.active", false);
+    m_RenderingTestHelper.AddNodeToStorage(node);
+
+    m_RenderingTestHelper.SetViewDirection(mitk::SliceNavigationController::Axial);
+    m_RenderingTestHelper.Render();
+  }
+
+  /** Checks the color of the render window in the center of the given third of the image */
+  void CheckColor(unsigned int third, double red, double green, double blue)
+  {
+    auto windowToImage = vtkSmartPointer<vtkWindowToImageFilter>::New();
+    windowToImage->SetInput(m_RenderingTestHelper.GetVtkRenderWindow());
+    windowToImage->ReadFrontBufferOff();
+    windowToImage->Update();
+
+    vtkImageData *screenshot = windowToImage->GetOutput();
+    const int x = (2 * third + 1) * WindowSize / 6;
+    const int y = WindowSize / 2;
+    const double expected[] = {red, green, blue};
+
+    for (int c = 0; c < 3; ++c)
+    {
+      const double actual = screenshot->GetScalarComponentAsDouble(x, y, 0, c);
+
+      if (std::abs(expected[c] - actual) > Tolerance)
+      {
+        std::ostringstream message;
+        message << "Component " << c << " in third " << third << " is " << actual << ", expected " << expected[c];
+        CPPUNIT_FAIL(message.str());
+      }
+    }
+  }
+
+public:
+  /**
+   * The RenderingTestHelper does not have an empty default constructor, the helper is initialized with a
+   * resolution here.
+   */
+  mitkLabelSetImageVtkMapper2DTestSuite() : m_RenderingTestHelper(WindowSize, WindowSize) {}
+
+  void setUp() override
+  {
+    m_RenderingTestHelper = mitk::RenderingTestHelper(WindowSize, WindowSize);
+
+    m_Red.Set(1.0f, 0.0f, 0.0f);
+    m_Blue.Set(0.0f, 0.0f, 1.0f);
+  }
+
+  void tearDown() override {}
+
+  void Render_OpaqueLayers_UpperLayerCoversOverlap()
+  {
+    this->RenderLayers(m_Red, m_Blue, 1.0f);
+
+    this->CheckColor(0, 255, 0, 0);
+    this->CheckColor(1, 0, 0, 255);
+    this->CheckColor(2, 0, 0, 255);
+  }
+
+  void Render_SwappedLayers_OtherLayerCoversOverlap()
+  {
+    this->RenderLayers(m_Blue, m_Red, 1.0f);
+
+    this->CheckColor(0, 0, 0, 255);
+    this->CheckColor(1, 255, 0, 0);
+    this->CheckColor(2, 255, 0, 0);
+  }
+
+  void Render_TranslucentUpperLayer_BlendsOverlap()
+  {
+    this->RenderLayers(m_Red, m_Blue, 0.5f);
+
+    // the lower layer shows through the upper one, which is blended with the black background elsewhere
+    this->CheckColor(0, 255, 0, 0);
+    this->CheckColor(1, 128, 0, 128);
+    this->CheckColor(2, 0, 0, 128);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageVtkMapper2D)
@@ -162,10 +162,8 @@ namespace mitk
 
       try
       {
-        // Hack: Remove the const attribute to switch between the layer images. Normally you could get the different
-        // layer images by input->GetLayerImage(layer)
-        mitk::LabelSetImage *mitkLayerImage = const_cast<mitk::LabelSetImage *>(input);
-        mitkLayerImage->SetActiveLayer(layer);
+        // the layer is read in place, the active layer of the input is not switched
+        const mitk::Image *mitkLayerImage = input->GetLayerImage(layer);
 
         // Cast mitk layer image to itk
         ImageToItk<itkInputImageType>::Pointer imageToItkFilter = ImageToItk<itkInputImageType>::New();
@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkImageReadAccessor.h"
 #include "mitkImagePixelReadAccessor.h"
 #include "mitkImagePixelWriteAccessor.h"
 #include "mitkInteractionConst.h"
@@ -93,8 +94,8 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     lsClone->AddObserver(itk::ModifiedEvent(), command);
     m_LabelSetContainer.push_back(lsClone);
 
-    // clone layer Image data
-    mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
+    // clone layer Image data (for the active layer this is the spare buffer, see SetActiveLayer)
+    mitk::Image::Pointer liClone = other.m_LayerContainer[i]->Clone();
     m_LayerContainer.push_back(liClone);
   }
 
@@ -162,11 +163,17 @@ mitk::LabelSetImage::~LabelSetImage()
 
 mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer)
 {
+  if (layer == GetActiveLayer() && !m_activeLayerInvalid)
+    return this;
+
   return m_LayerContainer[layer];
 }
 
 const mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer) const
 {
+  if (layer == GetActiveLayer() && !m_activeLayerInvalid)
+    return this;
+
   return m_LayerContainer[layer];
 }
 
@@ -227,12 +234,28 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
     AccessFixedDimensionByItk(newImage, SetToZero, 4);
   }
 
-  unsigned int newLabelSetId = this->AddLayer(newImage, lset);
+  unsigned int newLabelSetId = this->AddLayerImage(newImage, lset);
 
   return newLabelSetId;
 }
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset)
+{
+  // the data of the layer images is swapped with the data of this image (see SetActiveLayer()), so the layer gets
+  // an image of its own and the image of the caller, which may be in use elsewhere, is never changed
+  mitk::Image::Pointer newImage = mitk::Image::New();
+  newImage->Initialize(layerImage);
+
+  for (unsigned int timeStep = 0; timeStep < layerImage->GetTimeSteps(); ++timeStep)
+  {
+    mitk::ImageReadAccessor accessor(layerImage, layerImage->GetVolumeData(timeStep));
+    newImage->SetVolume(accessor.GetData(), timeStep);
+  }
+
+  return this->AddLayerImage(newImage, lset);
+}
+
+unsigned int mitk::LabelSetImage::AddLayerImage(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset)
 {
   unsigned int newLabelSetId = m_LayerContainer.size();
 
@@ -297,54 +320,33 @@ void mitk::LabelSetImage::AddLabelSetToLayer(const unsigned int layerIdx, const
 
 void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
-  try
+  if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
   {
-    if (4 == this->GetDimension())
+    // checked before any event is sent, the swap itself does not fail anymore
+    if (!this->CanSwapImageData(m_LayerContainer[layer]))
     {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
-      {
-        BeforeChangeLayerEvent.Send();
-
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (GetActiveLayer()));
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
-
-        AfterChangeLayerEvent.Send();
-      }
+      mitkThrow() << "Cannot activate layer " << layer << ", its image data does not match the segmentation.";
+    }
+
+    BeforeChangeLayerEvent.Send();
+
+    // The layer data is exchanged with the data of this image instead of being copied. Afterwards the container
+    // holds the data of the previously active layer at its index and a spare buffer at the index of the new
+    // active layer, which is reused on the next switch. Waits for image accessors of both images.
+    this->SwapImageData(m_LayerContainer[layer]);
+
+    if (m_activeLayerInvalid)
+    {
+      // We should not write the invalid layer back to the vector
+      m_activeLayerInvalid = false;
     }
     else
     {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
-      {
-        BeforeChangeLayerEvent.Send();
-
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessByItk_1(this, ImageToLayerContainerProcessing, GetActiveLayer());
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
-
-        AfterChangeLayerEvent.Send();
-      }
+      std::swap(m_LayerContainer[GetActiveLayer()], m_LayerContainer[layer]);
     }
-  }
-  catch (itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
+    m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
+
+    AfterChangeLayerEvent.Send();
   }
   this->Modified();
 }
@@ -818,57 +820,6 @@ void mitk::LabelSetImage::ConcatenateProcessing(ImageType *itkTarget, mitk::Labe
   }
 }
 
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::LabelSetImage::LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *target,
-                                                          unsigned int layer)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typename ImageType::Pointer itkSource;
-  // mitk::CastToItkImage(m_LayerContainer[layer], itkSource);
-  itkSource = ImageToItkImage<TPixel, VImageDimension>(m_LayerContainer[layer]);
-  typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
-
-  SourceIteratorType sourceIter(itkSource, itkSource->GetLargestPossibleRegion());
-  sourceIter.GoToBegin();
-
-  TargetIteratorType targetIter(target, target->GetLargestPossibleRegion());
-  targetIter.GoToBegin();
-
-  while (!sourceIter.IsAtEnd())
-  {
-    targetIter.Set(sourceIter.Get());
-    ++sourceIter;
-    ++targetIter;
-  }
-}
-
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::LabelSetImage::ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source,
-                                                          unsigned int layer) const
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typename ImageType::Pointer itkTarget;
-  // mitk::CastToItkImage(m_LayerContainer[layer], itkTarget);
-  itkTarget = ImageToItkImage<TPixel, VImageDimension>(m_LayerContainer[layer]);
-
-  typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
-
-  SourceIteratorType sourceIter(source, source->GetLargestPossibleRegion());
-  sourceIter.GoToBegin();
-
-  TargetIteratorType targetIter(itkTarget, itkTarget->GetLargestPossibleRegion());
-  targetIter.GoToBegin();
-
-  while (!sourceIter.IsAtEnd())
-  {
-    targetIter.Set(sourceIter.Get());
-    ++sourceIter;
-    ++targetIter;
-  }
-}
-
 template <typename ImageType>
 void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int /*layer*/)
 {
@@ -199,7 +199,11 @@ namespace mitk
     void MaskStamp(mitk::Image *mask, bool forceOverwrite);
 
     /**
-      * \brief  */
+      * \brief Makes the given layer the active one by exchanging its data with the data of this image.
+      *
+      * Waits until all image accessors of the segmentation are released, so the calling thread must not
+      * hold one. BeforeChangeLayerEvent and AfterChangeLayerEvent are only sent if the layer is switched.
+      * \throws mitk::Exception if the image data of the layer does not match the segmentation */
     void SetActiveLayer(unsigned int layer);
 
     /**
@@ -215,7 +219,7 @@ namespace mitk
 
     /**
     * \brief Add a layer based on a provided mitk::Image
-    * \param layerImage is added to the vector of label images
+    * \param layerImage the content of the new layer. It is copied, layerImage itself is neither kept nor changed.
     * \param lset a label set that will be added to the new layer if provided
     *\return the layer ID of the new layer
     */
@@ -242,7 +246,11 @@ namespace mitk
     void RemoveLayer();
 
     /**
-      * \brief  */
+      * \brief Returns the image data of the given layer.
+      *
+      * For the active layer, the LabelSetImage itself is returned, since the active layer's data is kept
+      * in the LabelSetImage and not in the layer container. The returned image thus shows the data of
+      * another layer after SetActiveLayer(); callers must not keep it across layer switches. */
     mitk::Image *GetLayerImage(unsigned int layer);
 
     const mitk::Image *GetLayerImage(unsigned int layer) const;
@@ -270,15 +278,12 @@ namespace mitk
     LabelSetImage(const LabelSetImage &other);
     ~LabelSetImage() override;
 
+    /** \brief Adds a layer that takes over \a layerImage, which must not be used elsewhere */
+    unsigned int AddLayerImage(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset);
+
     template <typename ImageType1, typename ImageType2>
     void ChangeLayerProcessing(ImageType1 *source, ImageType2 *target);
 
-    template <typename TPixel, unsigned int VImageDimension>
-    void LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer);
-
-    template <typename TPixel, unsigned int VImageDimension>
-    void ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
-
     template <typename ImageType>
     void CalculateCenterOfMassProcessing(ImageType *input, PixelType index, unsigned int layer);
 
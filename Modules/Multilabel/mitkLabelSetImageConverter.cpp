@@ -34,12 +34,10 @@ static void ConvertLabelSetImageToImage(const itk::Image<TPixel, VDimension> *,
   if (numberOfLayers > 1)
   {
     auto vectorImageComposer = ComposeFilterType::New();
-    auto activeLayer = labelSetImage->GetActiveLayer();
 
     for (decltype(numberOfLayers) layer = 0; layer < numberOfLayers; ++layer)
     {
-      auto layerImage = mitk::ImageToItkImage<TPixel, VDimension>(
-        layer != activeLayer ? labelSetImage->GetLayerImage(layer) : labelSetImage);
+      auto layerImage = mitk::ImageToItkImage<TPixel, VDimension>(labelSetImage->GetLayerImage(layer));
 
       vectorImageComposer->SetInput(layer, layerImage);
     }
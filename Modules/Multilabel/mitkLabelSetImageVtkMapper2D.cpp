@@ -15,6 +15,7 @@ found in the LICENSE file.
 // MITK
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImageSliceSelector.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLevelWindowProperty.h>
@@ -29,7 +30,6 @@ found in the LICENSE file.
 #include <mitkVtkResliceInterpolationProperty.h>
 
 // MITK Rendering
-#include "vtkMitkLevelWindowFilter.h"
 #include "vtkMitkThickSlicesFilter.h"
 #include "vtkNeverTranslucentTexture.h"
 
@@ -52,6 +52,13 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
 mitk::LabelSetImageVtkMapper2D::LabelSetImageVtkMapper2D()
 {
 }
@@ -95,35 +102,9 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
   if (numberOfLayers != localStorage->m_NumberOfLayers)
   {
     localStorage->m_NumberOfLayers = numberOfLayers;
-    localStorage->m_ReslicedImageVector.clear();
-    localStorage->m_ReslicerVector.clear();
-    localStorage->m_LayerTextureVector.clear();
-    localStorage->m_LevelWindowFilterVector.clear();
-    localStorage->m_LayerMapperVector.clear();
-    localStorage->m_LayerActorVector.clear();
-
-    localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
-
-    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
-    {
-      localStorage->m_ReslicedImageVector.push_back(vtkSmartPointer<vtkImageData>::New());
-      localStorage->m_ReslicerVector.push_back(mitk::ExtractSliceFilter::New());
-      localStorage->m_LayerTextureVector.push_back(vtkSmartPointer<vtkNeverTranslucentTexture>::New());
-      localStorage->m_LevelWindowFilterVector.push_back(vtkSmartPointer<vtkMitkLevelWindowFilter>::New());
-      localStorage->m_LayerMapperVector.push_back(vtkSmartPointer<vtkPolyDataMapper>::New());
-      localStorage->m_LayerActorVector.push_back(vtkSmartPointer<vtkActor>::New());
-
-      // do not repeat the texture (the image)
-      localStorage->m_LayerTextureVector[lidx]->RepeatOff();
-
-      // set corresponding mappers for the actors
-      localStorage->m_LayerActorVector[lidx]->SetMapper(localStorage->m_LayerMapperVector[lidx]);
-
-      localStorage->m_Actors->AddPart(localStorage->m_LayerActorVector[lidx]);
-    }
-
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineShadowActor);
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineActor);
+    localStorage->m_LayerColorTables.assign(numberOfLayers, std::vector<unsigned char>());
+    localStorage->m_LayerColorTableSources.assign(numberOfLayers, nullptr);
+    localStorage->m_LayerColorTableTimes.assign(numberOfLayers, 0);
   }
 
   // early out if there is no intersection of the current rendering geometry
@@ -133,118 +114,81 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     // set image to nullptr, to clear the texture in 3D, because
     // the latest image is used there if the plane is out of the geometry
     // see bug-13275
-    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
-    {
-      localStorage->m_ReslicedImageVector[lidx] = nullptr;
-      localStorage->m_LayerMapperVector[lidx]->SetInputData(localStorage->m_EmptyPolyData);
-      localStorage->m_OutlineActor->SetVisibility(false);
-      localStorage->m_OutlineShadowActor->SetVisibility(false);
-    }
+    localStorage->m_ReslicedImage = nullptr;
+    localStorage->m_ImageMapper->SetInputData(localStorage->m_EmptyPolyData);
+    localStorage->m_OutlineActor->SetVisibility(false);
+    localStorage->m_OutlineShadowActor->SetVisibility(false);
     return;
   }
 
-  for (int lidx = 0; lidx < numberOfLayers; ++lidx)
-  {
-    mitk::Image *layerImage = nullptr;
-
-    // set main input for ExtractSliceFilter
-    if (lidx == activeLayer)
-      layerImage = image;
-    else
-      layerImage = image->GetLayerImage(lidx);
-
-    localStorage->m_ReslicerVector[lidx]->SetInput(layerImage);
-    localStorage->m_ReslicerVector[lidx]->SetWorldGeometry(worldGeometry);
-    localStorage->m_ReslicerVector[lidx]->SetTimeStep(this->GetTimestep());
-
-    // set the transformation of the image to adapt reslice axis
-    localStorage->m_ReslicerVector[lidx]->SetResliceTransformByGeometry(
-      layerImage->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
-
-    // is the geometry of the slice based on the image image or the worldgeometry?
-    bool inPlaneResampleExtentByGeometry = false;
-    node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
-    localStorage->m_ReslicerVector[lidx]->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
-    localStorage->m_ReslicerVector[lidx]->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-    localStorage->m_ReslicerVector[lidx]->SetVtkOutputRequest(true);
-
-    // this is needed when thick mode was enabled before. These variables have to be reset to default values
-    localStorage->m_ReslicerVector[lidx]->SetOutputDimensionality(2);
-    localStorage->m_ReslicerVector[lidx]->SetOutputSpacingZDirection(1.0);
-    localStorage->m_ReslicerVector[lidx]->SetOutputExtentZDirection(0, 0);
-
-    // Bounds information for reslicing (only required if reference geometry is present)
-    // this used for generating a vtkPLaneSource with the right size
-    double sliceBounds[6];
-    sliceBounds[0] = 0.0;
-    sliceBounds[1] = 0.0;
-    sliceBounds[2] = 0.0;
-    sliceBounds[3] = 0.0;
-    sliceBounds[4] = 0.0;
-    sliceBounds[5] = 0.0;
-
-    localStorage->m_ReslicerVector[lidx]->GetClippedPlaneBounds(sliceBounds);
-
-    // setup the textured plane
-    this->GeneratePlane(renderer, sliceBounds);
-
-    // get the spacing of the slice
-    localStorage->m_mmPerPixel = localStorage->m_ReslicerVector[lidx]->GetOutputSpacing();
-    localStorage->m_ReslicerVector[lidx]->Modified();
-    // start the pipeline with updating the largest possible, needed if the geometry of the image has changed
-    localStorage->m_ReslicerVector[lidx]->UpdateLargestPossibleRegion();
-    localStorage->m_ReslicedImageVector[lidx] = localStorage->m_ReslicerVector[lidx]->GetVtkOutput();
-
-    const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
-
-    double textureClippingBounds[6];
-    for (auto &textureClippingBound : textureClippingBounds)
-    {
-      textureClippingBound = 0.0;
-    }
-
-    // Calculate the actual bounds of the transformed plane clipped by the
-    // dataset bounding box; this is required for drawing the texture at the
-    // correct position during 3D mapping.
-    mitk::PlaneClipping::CalculateClippedPlaneBounds(layerImage->GetGeometry(), planeGeometry, textureClippingBounds);
-
-    textureClippingBounds[0] = static_cast<int>(textureClippingBounds[0] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[1] = static_cast<int>(textureClippingBounds[1] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[2] = static_cast<int>(textureClippingBounds[2] / localStorage->m_mmPerPixel[1] + 0.5);
-    textureClippingBounds[3] = static_cast<int>(textureClippingBounds[3] / localStorage->m_mmPerPixel[1] + 0.5);
-
-    // clipping bounds for cutting the imageLayer
-    localStorage->m_LevelWindowFilterVector[lidx]->SetClippingBounds(textureClippingBounds);
-
-    localStorage->m_LevelWindowFilterVector[lidx]->SetLookupTable(
-      image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable());
-
-    // do not use a VTK lookup table (we do that ourselves in m_LevelWindowFilter)
-    localStorage->m_LayerTextureVector[lidx]->SetColorModeToDirectScalars();
-
-    // connect the imageLayer with the levelwindow filter
-    localStorage->m_LevelWindowFilterVector[lidx]->SetInputData(localStorage->m_ReslicedImageVector[lidx]);
-    // connect the texture with the output of the levelwindow filter
-
-    // check for texture interpolation property
-    bool textureInterpolation = false;
-    node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
-
-    // set the interpolation modus according to the property
-    localStorage->m_LayerTextureVector[lidx]->SetInterpolate(textureInterpolation);
-
-    localStorage->m_LayerTextureVector[lidx]->SetInputConnection(
-      localStorage->m_LevelWindowFilterVector[lidx]->GetOutputPort());
-
-    this->TransformActor(renderer);
-
-    // set the plane as input for the mapper
-    localStorage->m_LayerMapperVector[lidx]->SetInputConnection(localStorage->m_Plane->GetOutputPort());
-
-    // set the texture for the actor
-    localStorage->m_LayerActorVector[lidx]->SetTexture(localStorage->m_LayerTextureVector[lidx]);
-    localStorage->m_LayerActorVector[lidx]->GetProperty()->SetOpacity(opacity);
-  }
+  // the active layer is resliced by the ExtractSliceFilter, all other layers are sampled
+  // on its grid in CompositeLayers()
+  localStorage->m_Reslicer->SetInput(image);
+  localStorage->m_Reslicer->SetWorldGeometry(worldGeometry);
+  localStorage->m_Reslicer->SetTimeStep(this->GetTimestep());
+
+  // set the transformation of the image to adapt reslice axis
+  const BaseGeometry *imageGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep());
+  localStorage->m_Reslicer->SetResliceTransformByGeometry(imageGeometry);
+
+  // is the geometry of the slice based on the image image or the worldgeometry?
+  bool inPlaneResampleExtentByGeometry = false;
+  node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
+  localStorage->m_Reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
+  localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+  localStorage->m_Reslicer->SetVtkOutputRequest(true);
+
+  // this is needed when thick mode was enabled before. These variables have to be reset to default values
+  localStorage->m_Reslicer->SetOutputDimensionality(2);
+  localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
+  localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+
+  // Bounds information for reslicing (only required if reference geometry is present)
+  // this used for generating a vtkPLaneSource with the right size
+  double sliceBounds[6];
+  sliceBounds[0] = 0.0;
+  sliceBounds[1] = 0.0;
+  sliceBounds[2] = 0.0;
+  sliceBounds[3] = 0.0;
+  sliceBounds[4] = 0.0;
+  sliceBounds[5] = 0.0;
+
+  localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
+
+  // setup the textured plane
+  this->GeneratePlane(renderer, sliceBounds);
+
+  // get the spacing of the slice
+  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
+  localStorage->m_Reslicer->Modified();
+  // start the pipeline with updating the largest possible, needed if the geometry of the image has changed
+  localStorage->m_Reslicer->UpdateLargestPossibleRegion();
+  localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+
+  // sample all layers in one pass. Voxels outside of the image are transparent, which also clips
+  // the texture to the image bounds during 3D mapping.
+  this->UpdateSampleGrid(renderer, imageGeometry);
+  this->CompositeLayers(renderer, image);
+
+  // the composited image already holds the colors
+  localStorage->m_Texture->SetColorModeToDirectScalars();
+  localStorage->m_Texture->SetInputData(localStorage->m_CompositedImage);
+
+  // check for texture interpolation property
+  bool textureInterpolation = false;
+  node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+
+  // set the interpolation modus according to the property
+  localStorage->m_Texture->SetInterpolate(textureInterpolation);
+
+  this->TransformActor(renderer);
+
+  // set the plane as input for the mapper
+  localStorage->m_ImageMapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+
+  // set the texture for the actor
+  localStorage->m_ImageActor->SetTexture(localStorage->m_Texture);
+  localStorage->m_ImageActor->GetProperty()->SetOpacity(opacity);
 
   mitk::Label* activeLabel = image->GetActiveLabel(activeLayer);
   if (nullptr != activeLabel)
@@ -255,7 +199,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     {
       //generate contours/outlines
       localStorage->m_OutlinePolyData =
-        this->CreateOutlinePolyData(renderer, localStorage->m_ReslicedImageVector[activeLayer], activeLabel->GetValue());
+        this->CreateOutlinePolyData(renderer, localStorage->m_ReslicedImage, activeLabel->GetValue());
       localStorage->m_OutlineActor->SetVisibility(true);
       localStorage->m_OutlineShadowActor->SetVisibility(true);
       const mitk::Color& color = activeLabel->GetColor();
@@ -278,6 +222,156 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
   localStorage->m_OutlineShadowActor->SetVisibility(false);
 }
 
+void mitk::LabelSetImageVtkMapper2D::UpdateSampleGrid(mitk::BaseRenderer *renderer,
+                                                      const BaseGeometry *imageGeometry)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  vtkImageData *reslicedImage = localStorage->m_ReslicedImage;
+  vtkMatrix4x4 *resliceAxes = localStorage->m_Reslicer->GetResliceAxes();
+
+  int extent[6];
+  double spacing[3];
+  double origin[3];
+  reslicedImage->GetExtent(extent);
+  reslicedImage->GetSpacing(spacing);
+  reslicedImage->GetOrigin(origin);
+
+  std::vector<double> key(extent, extent + 6);
+  key.insert(key.end(), spacing, spacing + 3);
+  key.insert(key.end(), origin, origin + 3);
+  key.insert(key.end(), &resliceAxes->Element[0][0], &resliceAxes->Element[0][0] + 16);
+  key.push_back(static_cast<double>(imageGeometry->GetMTime()));
+  key.push_back(static_cast<double>(reinterpret_cast<std::uintptr_t>(imageGeometry)));
+
+  if (key == localStorage->m_SampleGridKey)
+    return;
+
+  // maps a pixel of the resliced image to the continuous index of the image volume
+  auto pixelToIndex = [&](int x, int y) {
+    double pixel[4] = {origin[0] + x * spacing[0], origin[1] + y * spacing[1], origin[2] + extent[4] * spacing[2], 1.0};
+    double world[4];
+    resliceAxes->MultiplyPoint(pixel, world);
+
+    Point3D worldPoint;
+    FillVector3D(worldPoint, world[0], world[1], world[2]);
+    Point3D index;
+    imageGeometry->WorldToIndex(worldPoint, index);
+    return index;
+  };
+
+  // the slice is planar, so the continuous index is an affine function of the pixel
+  const Point3D firstIndex = pixelToIndex(extent[0], extent[2]);
+  const Vector3D xStep = pixelToIndex(extent[0] + 1, extent[2]) - firstIndex;
+  const Vector3D yStep = pixelToIndex(extent[0], extent[2] + 1) - firstIndex;
+
+  const auto *dimensions = localStorage->m_Reslicer->GetInput()->GetDimensions();
+  const vtkIdType dimX = dimensions[0];
+  const vtkIdType dimY = dimensions[1];
+  const vtkIdType dimZ = localStorage->m_Reslicer->GetInput()->GetDimension() > 2 ? dimensions[2] : 1;
+
+  const int width = std::max(0, extent[1] - extent[0] + 1);
+  const int height = std::max(0, extent[3] - extent[2] + 1);
+  localStorage->m_SampleOffsets.resize(static_cast<std::size_t>(width) * height);
+  vtkIdType *offset = localStorage->m_SampleOffsets.data();
+
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x, ++offset)
+    {
+      // round like the nearest neighbor interpolation of vtkImageReslice
+      const auto i = static_cast<vtkIdType>(std::floor(firstIndex[0] + x * xStep[0] + y * yStep[0] + 0.5));
+      const auto j = static_cast<vtkIdType>(std::floor(firstIndex[1] + x * xStep[1] + y * yStep[1] + 0.5));
+      const auto k = static_cast<vtkIdType>(std::floor(firstIndex[2] + x * xStep[2] + y * yStep[2] + 0.5));
+
+      *offset = (i >= 0 && i < dimX && j >= 0 && j < dimY && k >= 0 && k < dimZ) ? i + dimX * (j + dimY * k) : -1;
+    }
+  }
+
+  localStorage->m_SampleGridKey.swap(key);
+}
+
+void mitk::LabelSetImageVtkMapper2D::CompositeLayers(mitk::BaseRenderer *renderer, mitk::LabelSetImage *image)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  const std::vector<vtkIdType> &offsets = localStorage->m_SampleOffsets;
+  const std::size_t numberOfPixels = offsets.size();
+
+  // The colors are accumulated premultiplied by their alpha in separate channels, so that the
+  // blending loops below are free of dependencies and can be vectorized by the compiler.
+  std::vector<float> red(numberOfPixels, 0.0f);
+  std::vector<float> green(numberOfPixels, 0.0f);
+  std::vector<float> blue(numberOfPixels, 0.0f);
+  std::vector<float> alpha(numberOfPixels, 0.0f);
+  std::vector<unsigned char> layerColors(4 * numberOfPixels);
+
+  const float normalization = 1.0f / 255.0f;
+  const unsigned char transparent[4] = {0, 0, 0, 0};
+
+  for (int lidx = 0; lidx < localStorage->m_NumberOfLayers; ++lidx)
+  {
+    mitk::Image *layerImage = image->GetLayerImage(lidx);
+
+    if (nullptr == layerImage || !layerImage->IsVolumeSet(this->GetTimestep()))
+      continue;
+
+    this->ApplyLookuptable(renderer, lidx);
+    const unsigned char *colorTable = localStorage->m_LayerColorTables[lidx].data();
+
+    {
+      mitk::ImageReadAccessor accessor(layerImage, layerImage->GetVolumeData(this->GetTimestep()));
+      const auto *labels = static_cast<const mitk::Label::PixelType *>(accessor.GetData());
+
+      // gather the colors of the sampled labels, pixels outside of the image are transparent
+      for (std::size_t p = 0; p < numberOfPixels; ++p)
+      {
+        const unsigned char *color = offsets[p] < 0 ? transparent : colorTable + 4 * labels[offsets[p]];
+        std::memcpy(&layerColors[4 * p], color, 4);
+      }
+    }
+
+    // blend the layer over the layers below
+    const unsigned char *color = layerColors.data();
+    float *r = red.data();
+    float *g = green.data();
+    float *b = blue.data();
+    float *a = alpha.data();
+
+    for (std::size_t p = 0; p < numberOfPixels; ++p)
+    {
+      const float layerAlpha = color[4 * p + 3] * normalization;
+      const float weight = layerAlpha * normalization;
+      const float remainder = 1.0f - layerAlpha;
+
+      r[p] = color[4 * p] * weight + r[p] * remainder;
+      g[p] = color[4 * p + 1] * weight + g[p] * remainder;
+      b[p] = color[4 * p + 2] * weight + b[p] * remainder;
+      a[p] = layerAlpha + a[p] * remainder;
+    }
+  }
+
+  vtkImageData *reslicedImage = localStorage->m_ReslicedImage;
+  vtkImageData *compositedImage = localStorage->m_CompositedImage;
+  compositedImage->SetExtent(reslicedImage->GetExtent());
+  compositedImage->SetSpacing(reslicedImage->GetSpacing());
+  compositedImage->SetOrigin(reslicedImage->GetOrigin());
+  compositedImage->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+
+  // convert back to non-premultiplied colors, as expected by the texture
+  auto *output = static_cast<unsigned char *>(compositedImage->GetScalarPointer());
+
+  for (std::size_t p = 0; p < numberOfPixels; ++p)
+  {
+    const float scale = alpha[p] > 0.0f ? 255.0f / alpha[p] : 0.0f;
+
+    output[4 * p] = static_cast<unsigned char>(red[p] * scale + 0.5f);
+    output[4 * p + 1] = static_cast<unsigned char>(green[p] * scale + 0.5f);
+    output[4 * p + 2] = static_cast<unsigned char>(blue[p] * scale + 0.5f);
+    output[4 * p + 3] = static_cast<unsigned char>(alpha[p] * 255.0f + 0.5f);
+  }
+
+  compositedImage->Modified();
+}
+
 bool mitk::LabelSetImageVtkMapper2D::RenderingGeometryIntersectsImage(const PlaneGeometry *renderingGeometry,
                                                                       SlicedGeometry3D *imageGeometry)
 {
@@ -474,12 +568,12 @@ void mitk::LabelSetImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer, co
   localStorage->m_OutlineShadowActor->GetProperty()->SetColor(0, 0, 0);
 }
 
-void mitk::LabelSetImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer, int layer)
+void mitk::LabelSetImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer)
 {
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
   float opacity = 1.0f;
   this->GetDataNode()->GetOpacity(opacity, renderer, "opacity");
-  localStorage->m_LayerActorVector[layer]->GetProperty()->SetOpacity(opacity);
+  localStorage->m_ImageActor->GetProperty()->SetOpacity(opacity);
   localStorage->m_OutlineActor->GetProperty()->SetOpacity(opacity);
   localStorage->m_OutlineShadowActor->GetProperty()->SetOpacity(opacity);
 }
@@ -488,8 +582,36 @@ void mitk::LabelSetImageVtkMapper2D::ApplyLookuptable(mitk::BaseRenderer *render
 {
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   auto *input = dynamic_cast<mitk::LabelSetImage *>(this->GetDataNode()->GetData());
-  localStorage->m_LevelWindowFilterVector[layer]->SetLookupTable(
-    input->GetLabelSet(layer)->GetLookupTable()->GetVtkLookupTable());
+  vtkLookupTable *lookupTable = input->GetLabelSet(layer)->GetLookupTable()->GetVtkLookupTable();
+  lookupTable->Build();
+
+  std::vector<unsigned char> &colorTable = localStorage->m_LayerColorTables[layer];
+  if (lookupTable == localStorage->m_LayerColorTableSources[layer] &&
+      lookupTable->GetMTime() <= localStorage->m_LayerColorTableTimes[layer])
+    return;
+
+  // map every label value to a color the same way vtkMitkLevelWindowFilter maps scalars
+  double tableRange[2];
+  lookupTable->GetTableRange(tableRange);
+
+  const unsigned char *realLookupTable = lookupTable->GetPointer(0);
+  const std::size_t maxIndex = lookupTable->GetNumberOfColors() - 1;
+
+  const float scale = (tableRange[1] - tableRange[0] > 0 ? (maxIndex + 1) / (tableRange[1] - tableRange[0]) : 0.0);
+  // ensuring that starting point is zero, and rounding by the later conversion to int
+  const float bias = -tableRange[0] * scale + 0.5f;
+
+  const std::size_t numberOfLabelValues = std::numeric_limits<mitk::Label::PixelType>::max() + std::size_t(1);
+  colorTable.resize(4 * numberOfLabelValues);
+
+  for (std::size_t value = 0; value < numberOfLabelValues; ++value)
+  {
+    const auto idx = std::min(static_cast<std::size_t>(std::max(0, static_cast<int>(value * scale + bias))), maxIndex);
+    std::memcpy(&colorTable[4 * value], &realLookupTable[4 * idx], 4);
+  }
+
+  localStorage->m_LayerColorTableSources[layer] = lookupTable;
+  localStorage->m_LayerColorTableTimes[layer] = lookupTable->GetMTime();
 }
 
 void mitk::LabelSetImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
@@ -579,17 +701,14 @@ void mitk::LabelSetImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or saggital
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_ReslicerVector[0]->GetResliceAxes(); // same for all layers
+  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_Reslicer->GetResliceAxes();
   trans->SetMatrix(matrix);
 
-  for (int lidx = 0; lidx < localStorage->m_NumberOfLayers; ++lidx)
-  {
-    // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
-    localStorage->m_LayerActorVector[lidx]->SetUserTransform(trans);
-    // transform the origin to center based coordinates, because MITK is center based.
-    localStorage->m_LayerActorVector[lidx]->SetPosition(
-      -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
-  }
+  // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
+  localStorage->m_ImageActor->SetUserTransform(trans);
+  // transform the origin to center based coordinates, because MITK is center based.
+  localStorage->m_ImageActor->SetPosition(
+    -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
   // same for outline actor
   localStorage->m_OutlineActor->SetUserTransform(trans);
   localStorage->m_OutlineActor->SetPosition(
@@ -633,6 +752,11 @@ mitk::LabelSetImageVtkMapper2D::LocalStorage::LocalStorage()
   // Do as much actions as possible in here to avoid double executions.
   m_Plane = vtkSmartPointer<vtkPlaneSource>::New();
   m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
+  m_ImageActor = vtkSmartPointer<vtkActor>::New();
+  m_ImageMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+  m_Texture = vtkSmartPointer<vtkNeverTranslucentTexture>::New();
+  m_CompositedImage = vtkSmartPointer<vtkImageData>::New();
+  m_Reslicer = mitk::ExtractSliceFilter::New();
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
   m_OutlineActor = vtkSmartPointer<vtkActor>::New();
@@ -647,4 +771,12 @@ mitk::LabelSetImageVtkMapper2D::LocalStorage::LocalStorage()
 
   m_OutlineActor->SetVisibility(false);
   m_OutlineShadowActor->SetVisibility(false);
+
+  // do not repeat the texture (the image)
+  m_Texture->RepeatOff();
+  m_ImageActor->SetMapper(m_ImageMapper);
+
+  m_Actors->AddPart(m_ImageActor);
+  m_Actors->AddPart(m_OutlineShadowActor);
+  m_Actors->AddPart(m_OutlineActor);
 }
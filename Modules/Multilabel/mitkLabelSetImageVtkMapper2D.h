@@ -35,13 +35,18 @@ class vtkImageReslice;
 class vtkPoints;
 class vtkMitkThickSlicesFilter;
 class vtkPolyData;
-class vtkMitkLevelWindowFilter;
 class vtkNeverTranslucentTexture;
 
 namespace mitk
 {
 
   /** \brief Mapper to resample and display 2D slices of a 3D labelset image.
+   *
+   * All layers are rendered by a single textured plane. The active layer is resliced by an ExtractSliceFilter,
+   * which also defines the sampling grid of the slice. The voxel offsets of this grid are computed once per
+   * plane (see UpdateSampleGrid()) and used to sample all layers, whose label colors are composited into one
+   * RGBA texture on the CPU (see CompositeLayers()). Thus the reslicing setup and the texture upload do not
+   * grow with the number of layers.
    *
    * Properties that can be set for labelset images and influence this mapper are:
    *
@@ -87,15 +92,32 @@ namespace mitk
     public:
       vtkSmartPointer<vtkPropAssembly> m_Actors;
 
-      std::vector<vtkSmartPointer<vtkActor>> m_LayerActorVector;
-      std::vector<vtkSmartPointer<vtkPolyDataMapper>> m_LayerMapperVector;
-      std::vector<vtkSmartPointer<vtkImageData>> m_ReslicedImageVector;
-      std::vector<vtkSmartPointer<vtkNeverTranslucentTexture>> m_LayerTextureVector;
+      /** \brief The actor of the textured plane showing all layers */
+      vtkSmartPointer<vtkActor> m_ImageActor;
+      vtkSmartPointer<vtkPolyDataMapper> m_ImageMapper;
+      vtkSmartPointer<vtkNeverTranslucentTexture> m_Texture;
+
+      /** \brief The resliced active layer, used for the outline of the active label */
+      vtkSmartPointer<vtkImageData> m_ReslicedImage;
+      /** \brief The RGBA composition of all layers */
+      vtkSmartPointer<vtkImageData> m_CompositedImage;
 
       vtkSmartPointer<vtkPolyData> m_EmptyPolyData;
       vtkSmartPointer<vtkPlaneSource> m_Plane;
 
-      std::vector<mitk::ExtractSliceFilter::Pointer> m_ReslicerVector;
+      /** \brief Reslices the active layer and defines the sampling grid of all layers */
+      mitk::ExtractSliceFilter::Pointer m_Reslicer;
+
+      /** \brief Voxel offset of every pixel of the resliced image into the layer volumes, -1 if outside. */
+      std::vector<vtkIdType> m_SampleOffsets;
+      /** \brief Reslice axes, extent, spacing and image geometry the sample offsets were computed for. */
+      std::vector<double> m_SampleGridKey;
+
+      /** \brief RGBA color of every label value, per layer. */
+      std::vector<std::vector<unsigned char>> m_LayerColorTables;
+      /** \brief The lookup table each color table was built from, and its modification time at that point. */
+      std::vector<vtkLookupTable *> m_LayerColorTableSources;
+      std::vector<vtkMTimeType> m_LayerColorTableTimes;
 
       vtkSmartPointer<vtkPolyData> m_OutlinePolyData;
       /** \brief An actor for the outline */
@@ -116,10 +138,6 @@ namespace mitk
 
       int m_NumberOfLayers;
 
-      /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
-      // vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
-      std::vector<vtkSmartPointer<vtkMitkLevelWindowFilter>> m_LevelWindowFilterVector;
-
       /** \brief Default constructor of the local storage. */
       LocalStorage();
       /** \brief Default deconstructor of the local storage. */
@@ -190,14 +208,25 @@ namespace mitk
       */
     void GenerateDataForRenderer(mitk::BaseRenderer *renderer) override;
 
+    /** \brief Computes the voxel offsets of the pixels of the resliced active layer.
+      *
+      * The offsets are only recomputed if the reslice axes, the extent or spacing of the slice, or the
+      * geometry of the image have changed since the last call.
+      */
+    void UpdateSampleGrid(mitk::BaseRenderer *renderer, const BaseGeometry *imageGeometry);
+
+    /** \brief Samples all layers at the sample offsets and blends their label colors, from the first
+      * to the last layer, into the RGBA image LocalStorage::m_CompositedImage.
+      */
+    void CompositeLayers(mitk::BaseRenderer *renderer, mitk::LabelSetImage *image);
+
     /** \brief This method uses the vtkCamera clipping range and the layer property
       * to calcualte the depth of the object (e.g. image or contour). The depth is used
       * to keep the correct order for the final VTK rendering.*/
     float CalculateLayerDepth(mitk::BaseRenderer *renderer);
 
-    /** \brief This method applies (or modifies) the lookuptable for all types of images.
-     * \warning To use the lookup table, the property 'Lookup Table' must be set and a 'Image Rendering.Mode'
-     * which uses the lookup table must be set.
+    /** \brief Updates the color table of a layer from the lookup table of its label set, if the lookup
+     * table has been modified.
   */
     void ApplyLookuptable(mitk::BaseRenderer *renderer, int layer);
 
@@ -220,8 +249,8 @@ namespace mitk
     /** \brief Set the color of the image/polydata */
     void ApplyColor(mitk::BaseRenderer *renderer, const mitk::Color &color);
 
-    /** \brief Set the opacity of the actor. */
-    void ApplyOpacity(mitk::BaseRenderer *renderer, int layer);
+    /** \brief Set the opacity of the actors. */
+    void ApplyOpacity(mitk::BaseRenderer *renderer);
 
     /**
       * \brief Calculates whether the given rendering geometry intersects the
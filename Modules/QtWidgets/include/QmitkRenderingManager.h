@@ -55,6 +55,8 @@ protected:
 
   void GenerateRenderingRequestEvent() override;
 
+  void GenerateDelayedRenderingRequestEvent(unsigned int milliseconds) override;
+
   void StartOrResetTimer() override;
 
   int pendingTimerCallbacks;
@@ -63,6 +65,8 @@ protected slots:
 
   void TimerCallback();
 
+  void DelayedRenderingRequestCallback();
+
 private:
   friend class QmitkRenderingManagerFactory;
 };
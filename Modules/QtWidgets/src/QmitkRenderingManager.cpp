@@ -41,6 +41,16 @@ void QmitkRenderingManager::GenerateRenderingRequestEvent()
   QApplication::postEvent(this, new QmitkRenderingRequestEvent);
 }
 
+void QmitkRenderingManager::GenerateDelayedRenderingRequestEvent(unsigned int milliseconds)
+{
+  QTimer::singleShot(milliseconds, this, SLOT(DelayedRenderingRequestCallback()));
+}
+
+void QmitkRenderingManager::DelayedRenderingRequestCallback()
+{
+  this->GenerateRenderingRequestEvent();
+}
+
 void QmitkRenderingManager::StartOrResetTimer()
 {
   QTimer::singleShot(200, this, SLOT(TimerCallback()));
@@ -29,6 +29,7 @@ namespace tinyxml2
 namespace mitk
 {
   class BaseData;
+  class BaseDataSerializer;
   class PropertyList;
 
   class MITKSCENESERIALIZATION_EXPORT SceneIO : public itk::Object
@@ -115,6 +116,15 @@ namespace mitk
      */
     const PropertyList *GetFailedProperties();
 
+    /**
+     * \brief Set the number of threads that serialize or read the base data of the nodes concurrently.
+     *
+     * 0 (default) uses one thread per core, 1 processes all nodes in the calling thread. The entries of the scene
+     * file are extracted with the same number of threads.
+     */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
   protected:
     SceneIO();
     ~SceneIO() override;
@@ -122,6 +132,18 @@ namespace mitk
     std::string CreateEmptyTempDirectory();
 
     tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error);
+
+    /**
+     * \brief Creates the \<data\> element of a BaseData and the serializer that writes its file.
+     *
+     * The serializer is null if none is registered for the type of the data. The "file" attribute is left to the
+     * caller, so that the serializers of several nodes can write their files concurrently.
+     */
+    tinyxml2::XMLElement *CreateBaseDataElement(tinyxml2::XMLDocument &doc,
+                                                BaseData *data,
+                                                const std::string &filenamehint,
+                                                itk::SmartPointer<BaseDataSerializer> &serializer);
+
     tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint);
 
     void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
@@ -132,6 +154,7 @@ namespace mitk
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+    unsigned int m_NumberOfThreads;
   };
 }
 
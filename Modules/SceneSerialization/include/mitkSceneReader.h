@@ -31,5 +31,18 @@ namespace mitk
     itkCloneMacro(Self);
 
     virtual bool LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /**
+     * \brief Number of threads that read the base data files of the scene concurrently.
+     *
+     * 0 (default) uses one thread per core, 1 reads all files in the calling thread.
+     */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+  protected:
+    SceneReader();
+
+    unsigned int m_NumberOfThreads;
   };
 }
@@ -11,10 +11,15 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <Poco/Delegate.h>
+#include <Poco/FileStream.h>
 #include <Poco/Path.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/String.h>
 #include <Poco/TemporaryFile.h>
 #include <Poco/Zip/Compress.h>
 #include <Poco/Zip/Decompress.h>
+#include <Poco/Zip/ZipArchive.h>
+#include <Poco/Zip/ZipStream.h>
 
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
@@ -22,6 +27,7 @@ found in the LICENSE file.
 #include "mitkSceneReader.h"
 
 #include "mitkBaseRenderer.h"
+#include "mitkParallelFor.h"
 #include "mitkProgressBar.h"
 #include "mitkRenderingManager.h"
 #include "mitkStandaloneDataStorage.h"
@@ -32,13 +38,213 @@ found in the LICENSE file.
 
 #include <fstream>
 #include <mitkIOUtil.h>
+#include <set>
 #include <sstream>
 
 #include "itksys/SystemTools.hxx"
 
 #include <tinyxml2.h>
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+namespace
+{
+  typedef std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> UnzipErrorInfo;
+  typedef std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> UnzipOkInfo;
+
+  /** A BaseData whose file is written after the elements of all nodes have been added to the document */
+  struct PendingBaseData
+  {
+    mitk::DataNode *Node;
+    tinyxml2::XMLElement *Element;
+    mitk::BaseDataSerializer::Pointer Serializer;
+    std::string Filename;
+    bool Error;
+  };
+
+  /** Writes the file of the serializer, may be called concurrently for different serializers */
+  bool SerializeBaseData(mitk::BaseDataSerializer *serializer, std::string &filename)
+  {
+    if (serializer == nullptr)
+      return false;
+
+    try
+    {
+      filename = serializer->Serialize();
+      return true;
+    }
+    catch (std::exception &e)
+    {
+      MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
+    }
+    catch (...)
+    {
+      MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed with an unknown exception.";
+    }
+
+    return false;
+  }
+
+  /**
+   * Whether the writer of the file already compressed its content (e.g. images written as gzip encoded NRRD,
+   * VTK XML files or compressed MetaImages), so that deflating it again would only cost time.
+   */
+  bool IsCompressedByWriter(const Poco::Path &path)
+  {
+    static const std::set<std::string> compressedExtensions = {
+      "bz2", "gz", "jpeg", "jpg", "png", "vti", "vtm", "vtp", "vtu", "zip", "zraw"};
+
+    const std::string extension = Poco::toLower(path.getExtension());
+    if (compressedExtensions.count(extension) != 0)
+      return true;
+
+    if (extension != "nrrd" && extension != "mha" && extension != "mhd")
+      return false;
+
+    // the headers are plain text, terminated by an empty line (NRRD) or the ElementDataFile field (MetaImage)
+    std::ifstream file(Poco::Path::transcode(path.toString()).c_str(), std::ios::binary);
+    std::string line;
+    for (int i = 0; i < 256 && std::getline(file, line); ++i)
+    {
+      line = Poco::toLower(Poco::trim(line));
+
+      if (line.empty())
+        break;
+
+      if (line.compare(0, 9, "encoding:") == 0)
+      {
+        const std::string encoding = Poco::trim(line.substr(9));
+        return encoding == "gz" || encoding == "gzip" || encoding == "bz2" || encoding == "bzip2";
+      }
+
+      if (line.compare(0, 14, "compresseddata") == 0)
+        return line.find("true") != std::string::npos;
+
+      if (line.compare(0, 15, "elementdatafile") == 0)
+        break;
+    }
+
+    return false;
+  }
+
+  /**
+   * Adds the files of the directory to the archive and deletes them afterwards, so that the temporary files and the
+   * archive do not have to fit on disk at the same time. Files that are already compressed are stored.
+   */
+  void AddDirectoryToArchive(Poco::Zip::Compress &zipper, const Poco::Path &directory, const Poco::Path &entryDirectory)
+  {
+    std::vector<std::string> names;
+    Poco::File(directory).list(names);
+
+    for (const auto &name : names)
+    {
+      Poco::Path path(directory, name);
+      Poco::File file(path);
+
+      if (file.isDirectory())
+      {
+        path.makeDirectory();
+        Poco::Path subdirectory(entryDirectory);
+        subdirectory.pushDirectory(name);
+
+        zipper.addDirectory(subdirectory, file.getLastModified());
+        AddDirectoryToArchive(zipper, path, subdirectory);
+      }
+      else
+      {
+        if (IsCompressedByWriter(path))
+        {
+          zipper.addFile(path, Poco::Path(entryDirectory, name), Poco::Zip::ZipCommon::CM_STORE);
+        }
+        else
+        {
+          zipper.addFile(path, Poco::Path(entryDirectory, name), Poco::Zip::ZipCommon::CM_DEFLATE);
+        }
+
+        file.remove();
+      }
+    }
+  }
+
+  /**
+   * Extracts the entries of the archive to the directory. The local headers are parsed first, then the entries are
+   * inflated concurrently, each with its own stream into the archive.
+   */
+  void ExtractArchive(const std::string &filename,
+                      const Poco::Path &directory,
+                      unsigned int numberOfThreads,
+                      std::vector<UnzipErrorInfo> &errors,
+                      std::vector<UnzipOkInfo> &extracted)
+  {
+    std::vector<Poco::Zip::ZipLocalFileHeader> entries;
+    std::vector<Poco::Path> targets;
+
+    {
+      std::ifstream file(filename.c_str(), std::ios::binary);
+      Poco::Zip::ZipArchive archive(file);
+
+      for (auto iter = archive.headerBegin(); iter != archive.headerEnd(); ++iter)
+      {
+        const Poco::Zip::ZipLocalFileHeader &header = iter->second;
+
+        if (!Poco::Zip::ZipCommon::isValidPath(header.getFileName()))
+        {
+          errors.emplace_back(header, "Illegal entry name " + header.getFileName());
+          continue;
+        }
+
+        // directories are created before the threads start
+        Poco::Path target(directory, Poco::Path(header.getFileName()));
+        if (header.isDirectory())
+        {
+          Poco::File(target.makeDirectory()).createDirectories();
+          continue;
+        }
+
+        Poco::File(target.parent()).createDirectories();
+        entries.push_back(header);
+        targets.push_back(target.makeFile());
+      }
+    }
+
+    std::vector<std::string> entryErrors(entries.size());
+
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(static_cast<unsigned int>(entries.size()));
+    mitk::ParallelFor(
+      entries.size(),
+      [&](std::size_t i) {
+        try
+        {
+          std::ifstream file(filename.c_str(), std::ios::binary);
+          Poco::Zip::ZipInputStream input(file, entries[i], true);
+          Poco::FileOutputStream output(targets[i].toString());
+          Poco::StreamCopier::copyStream(input, output);
+          output.close();
+
+          if (!input.crcValid())
+            entryErrors[i] = "CRC mismatch in " + entries[i].getFileName();
+        }
+        catch (std::exception &e)
+        {
+          entryErrors[i] = "Could not extract " + entries[i].getFileName() + ": " + e.what();
+        }
+      },
+      numberOfThreads,
+      [](std::size_t steps) { mitk::ProgressBar::GetInstance()->Progress(static_cast<unsigned int>(steps)); });
+
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+      if (entryErrors[i].empty())
+      {
+        extracted.emplace_back(entries[i], targets[i]);
+      }
+      else
+      {
+        errors.emplace_back(entries[i], entryErrors[i]);
+      }
+    }
+  }
+}
+
+mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0), m_NumberOfThreads(0)
 {
 }
 
@@ -85,6 +291,9 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
                                                     DataStorage *pStorage,
                                                     bool clearStorageFirst)
 {
+  // The locale is global to the process. It is switched here, before the files are read by several threads, and
+  // restored after all of them have finished. The switches of the readers in the worker threads find the "C" locale
+  // installed already and leave it untouched, so none of them restores another locale while others still parse.
   mitk::LocaleSwitch localeSwitch("C");
 
   // prepare data storage
@@ -119,16 +328,37 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
 
   // unzip all filenames contents to temp dir
   m_UnzipErrors = 0;
-  Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
-  unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
-  unzipper.decompressAllFiles();
-  unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
+  try
+  {
+    std::vector<UnzipErrorInfo> errors;
+    std::vector<UnzipOkInfo> extracted;
+    ExtractArchive(filename, Poco::Path(m_WorkingDirectory).makeDirectory(), m_NumberOfThreads, errors, extracted);
+
+    for (auto &error : errors)
+      this->OnUnzipError(this, error);
+
+    for (auto &ok : extracted)
+      this->OnUnzipOk(this, ok);
+  }
+  catch (std::exception &e)
+  {
+    // archives whose headers cannot be parsed up front are still extracted sequentially from the stream
+    MITK_WARN << "Could not read the entries of '" << filename << "' (" << e.what() << "), extracting sequentially.";
+
+    file.clear();
+    file.seekg(0);
+
+    Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
+    unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
+      this, &SceneIO::OnUnzipError);
+    unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
+      this, &SceneIO::OnUnzipOk);
+    unzipper.decompressAllFiles();
+    unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
+      this, &SceneIO::OnUnzipError);
+    unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
+      this, &SceneIO::OnUnzipOk);
+  }
 
   if (m_UnzipErrors)
   {
@@ -161,6 +391,7 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   DataStorage *pStorage,
   bool clearStorageFirst)
 {
+  // held until the worker threads have finished, see LoadScene()
   mitk::LocaleSwitch localeSwitch("C");
 
   // prepare data storage
@@ -205,6 +436,7 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   }
 
   SceneReader::Pointer reader = SceneReader::New();
+  reader->SetNumberOfThreads(m_NumberOfThreads);
   if (!reader->LoadScene(document, workingDir, storage))
   {
     MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
@@ -236,6 +468,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
     return false;
   }
 
+  // held until the worker threads have finished, see LoadScene()
   mitk::LocaleSwitch localeSwitch("C");
 
   try
@@ -285,6 +518,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
       SourcesMapType sourceUIDs; // for dependencies: IDs of a node's parent nodes
 
       UIDGenerator nodeUIDGen("OBJECT_");
+      std::vector<PendingBaseData> pendingBaseData;
 
       for (auto iter = sceneNodes->begin(); iter != sceneNodes->end(); ++iter)
       {
@@ -354,13 +588,11 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           // store basedata
           if (BaseData *data = node->GetData())
           {
-            // std::string filenameHint( node->GetName() );
-            bool error(false);
-            auto *dataElement = SaveBaseData(document, data, filenameHint, error); // returns a reference to a file
-            if (error)
-            {
-              m_FailedNodes->push_back(node);
-            }
+            // the file is written after all nodes have been visited
+            PendingBaseData pending = {node, nullptr, nullptr, "", true};
+            auto *dataElement = CreateBaseDataElement(document, data, filenameHint, pending.Serializer);
+            pending.Element = dataElement;
+            pendingBaseData.push_back(pending);
 
             // store basedata properties
             PropertyList *propertyList = data->GetPropertyList();
@@ -403,8 +635,33 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           MITK_WARN << "Ignoring nullptr node during scene serialization.";
         }
 
-        ProgressBar::GetInstance()->Progress();
+        // the progress of nodes with data is reported while their files are written
+        if (node == nullptr || node->GetData() == nullptr)
+        {
+          ProgressBar::GetInstance()->Progress();
+        }
       } // end for all nodes
+
+      // the serializers write their files concurrently, the document is only modified by this thread
+      mitk::ParallelFor(
+        pendingBaseData.size(),
+        [&pendingBaseData](std::size_t i) {
+          pendingBaseData[i].Error = !SerializeBaseData(pendingBaseData[i].Serializer, pendingBaseData[i].Filename);
+        },
+        m_NumberOfThreads,
+        [](std::size_t steps) { mitk::ProgressBar::GetInstance()->Progress(static_cast<unsigned int>(steps)); });
+
+      for (const auto &pending : pendingBaseData)
+      {
+        if (pending.Error)
+        {
+          m_FailedNodes->push_back(pending.Node);
+        }
+        else
+        {
+          pending.Element->SetAttribute("file", pending.Filename.c_str());
+        }
+      }
     }   // end if sceneNodes
 
     std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
@@ -436,8 +693,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         else
         {
           Poco::Zip::Compress zipper(file, true);
-          Poco::Path tmpdir(m_WorkingDirectory);
-          zipper.addRecursive(tmpdir);
+          AddDirectoryToArchive(zipper, Poco::Path(m_WorkingDirectory).makeDirectory(), Poco::Path());
           zipper.close();
         }
         try
@@ -467,9 +723,27 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 }
 
 tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error)
+{
+  BaseDataSerializer::Pointer serializer;
+  auto *element = CreateBaseDataElement(doc, data, filenamehint, serializer);
+
+  std::string writtenfilename;
+  error = !SerializeBaseData(serializer, writtenfilename);
+  if (!error)
+  {
+    element->SetAttribute("file", writtenfilename.c_str());
+  }
+
+  return element;
+}
+
+tinyxml2::XMLElement *mitk::SceneIO::CreateBaseDataElement(tinyxml2::XMLDocument &doc,
+                                                           BaseData *data,
+                                                           const std::string &filenamehint,
+                                                           BaseDataSerializer::Pointer &serializer)
 {
   assert(data);
-  error = true;
+  serializer = nullptr;
 
   // find correct serializer
   // the serializer must
@@ -494,22 +768,13 @@ tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, Ba
        iter != thingsThatCanSerializeThis.end();
        ++iter)
   {
-    if (auto *serializer = dynamic_cast<BaseDataSerializer *>(iter->GetPointer()))
+    if (auto *baseDataSerializer = dynamic_cast<BaseDataSerializer *>(iter->GetPointer()))
     {
+      serializer = baseDataSerializer;
       serializer->SetData(data);
       serializer->SetFilenameHint(filenamehint);
       std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
       serializer->SetWorkingDirectory(defaultLocale_WorkingDirectory);
-      try
-      {
-        std::string writtenfilename = serializer->Serialize();
-        element->SetAttribute("file", writtenfilename.c_str());
-        error = false;
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
-      }
       break;
     }
   }
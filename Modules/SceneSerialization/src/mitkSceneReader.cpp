@@ -13,6 +13,10 @@ found in the LICENSE file.
 #include "mitkSceneReader.h"
 #include <tinyxml2.h>
 
+mitk::SceneReader::SceneReader() : m_NumberOfThreads(0)
+{
+}
+
 bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage)
 {
   // find version node --> note version in some variable
@@ -46,6 +50,7 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   {
     if (auto *reader = dynamic_cast<SceneReader *>(iter->GetPointer()))
     {
+      reader->SetNumberOfThreads(m_NumberOfThreads);
       if (!reader->LoadScene(document, workingDirectory, storage))
       {
         MITK_ERROR << "There were errors while loading scene file "
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include "Poco/Path.h"
 #include "mitkBaseRenderer.h"
 #include "mitkIOUtil.h"
+#include "mitkParallelFor.h"
 #include "mitkProgressBar.h"
 #include "mitkPropertyListDeserializer.h"
 #include "mitkSerializerMacros.h"
@@ -68,20 +69,36 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
   // create a node for the tag "data" and test if node was created
   typedef std::vector<mitk::DataNode::Pointer> DataNodeVector;
   DataNodeVector DataNodes;
-  unsigned int listSize = 0;
+  std::vector<const tinyxml2::XMLElement *> dataElements;
   for (auto *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
-    ++listSize;
+    dataElements.push_back(element->FirstChildElement("data"));
   }
 
+  const auto listSize = static_cast<unsigned int>(dataElements.size());
   ProgressBar::GetInstance()->AddStepsToDo(listSize * 2);
 
-  for (auto *element = document.FirstChildElement("node"); element != nullptr;
-       element = element->NextSiblingElement("node"))
+  // reading the files dominates the loading time, so they are read concurrently; the nodes are created afterwards
+  // in this thread, since DataNode::SetData() initializes default properties that are not meant to be thread-safe
+  std::vector<BaseData::Pointer> baseData(dataElements.size());
+  std::vector<char> readErrors(dataElements.size(), false);
+  mitk::ParallelFor(
+    dataElements.size(),
+    [&](std::size_t i) {
+      bool readError(false);
+      baseData[i] = LoadBaseDataFromDataTag(dataElements[i], workingDirectory, readError);
+      readErrors[i] = readError;
+    },
+    m_NumberOfThreads,
+    [](std::size_t steps) { mitk::ProgressBar::GetInstance()->Progress(static_cast<unsigned int>(steps)); });
+
+  for (std::size_t i = 0; i < dataElements.size(); ++i)
   {
-    DataNodes.push_back(LoadBaseDataFromDataTag(element->FirstChildElement("data"), workingDirectory, error));
-    ProgressBar::GetInstance()->Progress();
+    if (readErrors[i])
+      error = true;
+
+    DataNodes.push_back(CreateNodeFromDataTag(dataElements[i], baseData[i]));
   }
 
   // iterate all nodes
@@ -239,11 +256,11 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
   return !error;
 }
 
-mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
+mitk::BaseData::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
                                                                      const std::string &workingDirectory,
-                                                                     bool &error)
+                                                                     bool &error) const
 {
-  DataNode::Pointer node;
+  BaseData::Pointer data;
 
   if (dataElement)
   {
@@ -257,36 +274,48 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
         {
           MITK_WARN << "Discarding multiple base data results from " << filename << " except the first one.";
         }
-        node = DataNode::New();
-        node->SetData(baseData.front());
+        data = baseData.front();
       }
       catch (std::exception &e)
       {
         MITK_ERROR << "Error during attempt to read '" << filename << "'. Exception says: " << e.what();
         error = true;
       }
+      catch (...)
+      {
+        MITK_ERROR << "Error during attempt to read '" << filename << "'. Unknown exception.";
+        error = true;
+      }
 
-      if (node.IsNull())
+      if (data.IsNull() && !error)
       {
         MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
         error = true;
       }
     }
+  }
 
-    const char* dataUID = dataElement->Attribute("UID");
-    if (!error && dataUID != nullptr)
+  return data;
+}
+
+mitk::DataNode::Pointer mitk::SceneReaderV1::CreateNodeFromDataTag(const tinyxml2::XMLElement *dataElement,
+                                                                   BaseData *data)
+{
+  // in case there was no <data> element we create an empty node (for appending a propertylist later)
+  DataNode::Pointer node = DataNode::New();
+
+  if (data != nullptr)
+  {
+    node->SetData(data);
+
+    const char *dataUID = dataElement->Attribute("UID");
+    if (dataUID != nullptr)
     {
-      UIDManipulator manip(node->GetData());
+      UIDManipulator manip(data);
       manip.SetUID(dataUID);
     }
   }
 
-  // in case there was no <data> element we create a new empty node (for appending a propertylist later)
-  if (node.IsNull())
-  {
-    node = DataNode::New();
-  }
-
   return node;
 }
 
@@ -32,11 +32,20 @@ namespace mitk
 
   protected:
     /**
-      \brief tries to create one DataNode from a given XML \<node\> element
+      \brief tries to read the BaseData of a given XML \<data\> element
+
+      Only reads the file, so that the data of several nodes can be read concurrently.
     */
-    DataNode::Pointer LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
+    BaseData::Pointer LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
                                               const std::string &workingDirectory,
-                                              bool &error);
+                                              bool &error) const;
+
+    /**
+      \brief creates one DataNode for the BaseData read from a given XML \<data\> element
+
+      The node is empty if there was no \<data\> element or its file could not be read.
+    */
+    DataNode::Pointer CreateNodeFromDataTag(const tinyxml2::XMLElement *dataElement, BaseData *data);
 
     /**
       \brief reads all the properties from the XML document and recreates them in node
@@ -78,6 +78,7 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_SequentialAndParallelScenesAreInterchangeable);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
@@ -125,6 +126,45 @@ public:
     }
   }
 
+
+  void Test_SequentialAndParallelScenesAreInterchangeable()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+
+    const unsigned int threadCombinations[][2] = {{1, 4}, {4, 1}};
+
+    for (const auto& scenario : m_TestCaseProvider.GetAllScenarios())
+    {
+      if (!scenario.serializable)
+        continue;
+
+      for (const auto& threads : threadCombinations)
+      {
+        MITK_TEST_OUTPUT(<< "Scenario '" << scenario.key << "' written with " << threads[0] << " and read with "
+                         << threads[1] << " threads");
+
+        std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+        mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+        writer->SetNumberOfThreads(threads[0]);
+        mitk::DataStorage::Pointer originalStorage = scenario.BuildDataStorage();
+        CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+        mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+        reader->SetNumberOfThreads(threads[1]);
+        mitk::DataStorage::Pointer restoredStorage;
+        CPPUNIT_ASSERT_NO_THROW(restoredStorage = reader->LoadScene(archiveFilename));
+        CPPUNIT_ASSERT_MESSAGE(std::string("Comparing restored test scenario '") + scenario.key + "'",
+                               mitk::DataStorageCompare(originalStorage,
+                                                        restoredStorage,
+                                                        mitk::DataStorageCompare::CMP_Hierarchy |
+                                                          mitk::DataStorageCompare::CMP_Data |
+                                                          mitk::DataStorageCompare::CMP_Properties,
+                                                        scenario.comparisonPrecision)
+                                 .CompareVerbose());
+      }
+    }
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
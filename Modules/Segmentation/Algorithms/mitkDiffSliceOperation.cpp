@@ -12,14 +12,216 @@ found in the LICENSE file.
 
 #include "mitkDiffSliceOperation.h"
 
+#include <mitkExceptionMacro.h>
 #include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 
 #include <itkCommand.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  /** Compresses the slices of all DiffSliceOperations one after another in a single background thread.
+      This bounds the threads and the uncompressed slices held at a time, however many operations are created. */
+  class CompressionQueue
+  {
+  public:
+    static CompressionQueue &GetInstance()
+    {
+      static CompressionQueue instance;
+      return instance;
+    }
+
+    /** Runs the task in the queue thread or, after Shutdown(), in the calling thread */
+    std::shared_future<void> Enqueue(std::function<void()> function)
+    {
+      std::packaged_task<void()> task(std::move(function));
+      auto future = task.get_future().share();
+
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (!m_Stop)
+        {
+          if (!m_Thread.joinable())
+            m_Thread = std::thread(&CompressionQueue::Run, this);
+
+          m_Tasks.push_back(std::move(task));
+        }
+      }
+
+      if (task.valid())
+        task(); // exceptions are stored in the future
+      else
+        m_Condition.notify_one();
+
+      return future;
+    }
+
+    /** Executes the remaining tasks and stops the queue thread */
+    void Shutdown()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+      }
+
+      m_Condition.notify_one();
+
+      if (m_Thread.joinable())
+        m_Thread.join();
+    }
+
+  private:
+    CompressionQueue() : m_Stop(false) {}
+
+    // the queue is shut down by the unloading Segmentation module, before other static objects are destroyed
+    ~CompressionQueue() { this->Shutdown(); }
+
+    void Run()
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+
+      while (true)
+      {
+        m_Condition.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+
+        // remaining tasks are still executed, operations wait for their compression
+        if (m_Tasks.empty())
+          return;
+
+        auto task = std::move(m_Tasks.front());
+        m_Tasks.pop_front();
+
+        lock.unlock();
+        task(); // exceptions are stored in the future
+        lock.lock();
+      }
+    }
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<std::packaged_task<void()>> m_Tasks;
+    std::thread m_Thread;
+    bool m_Stop;
+  };
+
+  void AppendLength(std::vector<unsigned char> &delta, std::size_t length)
+  {
+    // 7 bits per byte, the highest bit marks that more bytes follow
+    while (length >= 0x80)
+    {
+      delta.push_back(static_cast<unsigned char>(length | 0x80));
+      length >>= 7;
+    }
+    delta.push_back(static_cast<unsigned char>(length));
+  }
+
+  std::size_t ReadLength(const std::vector<unsigned char> &delta, std::size_t &position)
+  {
+    std::size_t length = 0;
+    for (unsigned int shift = 0; position < delta.size(); shift += 7)
+    {
+      const unsigned char byte = delta[position++];
+      length |= static_cast<std::size_t>(byte & 0x7f) << shift;
+
+      if ((byte & 0x80) == 0)
+        return length;
+    }
+
+    mitkThrow() << "The slice delta is truncated";
+  }
+
+  /** Encodes the XOR of slice and reference as alternating runs: the length of a run of equal bytes, the length
+      of the following run of differing bytes and their XOR values. Segmentation edits change few compact regions
+      of a slice, so the delta is much smaller than the slice. */
+  std::vector<unsigned char> EncodeDelta(const unsigned char *slice, const unsigned char *reference, std::size_t size)
+  {
+    std::vector<unsigned char> delta;
+    std::size_t i = 0;
+
+    while (i < size)
+    {
+      const std::size_t equalBegin = i;
+      while (i < size && slice[i] == reference[i])
+        ++i;
+
+      const std::size_t differentBegin = i;
+      while (i < size && slice[i] != reference[i])
+        ++i;
+
+      AppendLength(delta, differentBegin - equalBegin);
+      AppendLength(delta, i - differentBegin);
+
+      for (std::size_t j = differentBegin; j < i; ++j)
+        delta.push_back(slice[j] ^ reference[j]);
+    }
+
+    delta.shrink_to_fit();
+    return delta;
+  }
+
+  void ApplyDelta(const std::vector<unsigned char> &delta, unsigned char *data, std::size_t size)
+  {
+    std::size_t position = 0;
+    std::size_t offset = 0;
+
+    while (position < delta.size())
+    {
+      offset += ReadLength(delta, position);
+      const std::size_t length = ReadLength(delta, position);
+
+      if (offset + length > size || position + length > delta.size())
+        mitkThrow() << "The slice delta does not match the size of the slice";
+
+      for (std::size_t j = 0; j < length; ++j)
+        data[offset + j] ^= delta[position + j];
+
+      offset += length;
+      position += length;
+    }
+  }
+
+  bool HaveSameLayout(const mitk::Image *slice, const mitk::Image *reference)
+  {
+    if (slice->GetPixelType() != reference->GetPixelType() || slice->GetDimension() != reference->GetDimension())
+      return false;
+
+    for (unsigned int i = 0; i < slice->GetDimension(); ++i)
+    {
+      if (slice->GetDimension(i) != reference->GetDimension(i))
+        return false;
+    }
+
+    return true;
+  }
+}
+
+/** \brief The slice of a DiffSliceOperation encoded as delta to the slice of its reference operation.*/
+struct mitk::DiffSliceOperation::SliceDelta
+{
+  /** \brief False if the slices differ in pixel type or dimensions, so the slice has been compressed instead.*/
+  bool m_IsEncoded = false;
+  std::vector<unsigned char> m_Data;
+};
+
+void mitk::DiffSliceOperation::ShutdownCompression()
+{
+  CompressionQueue::GetInstance().Shutdown();
+}
+
 mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
 {
   m_TimeStep = 0;
   m_zlibSliceContainer = nullptr;
+  m_UncompressedSliceSize = 0;
   m_Image = nullptr;
   m_WorldGeometry = nullptr;
   m_SliceGeometry = nullptr;
@@ -32,6 +234,16 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
                                              SlicedGeometry3D *sliceGeometry,
                                              unsigned int timestep,
                                              BaseGeometry *currentWorldGeometry)
+  : DiffSliceOperation(imageVolume, slice, sliceGeometry, timestep, currentWorldGeometry, nullptr)
+{
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
+                                             Image *slice,
+                                             SlicedGeometry3D *sliceGeometry,
+                                             unsigned int timestep,
+                                             BaseGeometry *currentWorldGeometry,
+                                             const DiffSliceOperation *referenceOperation)
   : Operation(1)
 
 {
@@ -48,8 +260,57 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
 
   m_TimeStep = timestep;
 
+  m_UncompressedSliceSize = slice->GetPixelType().GetSize();
+  for (unsigned int i = 0; i < slice->GetDimension(); ++i)
+    m_UncompressedSliceSize *= slice->GetDimension(i);
+
+  // compress the slice in the background, the caller does not need to wait for it. The slices are small,
+  // so each one is compressed by the queue thread alone instead of occupying the thread pool of ITK.
   m_zlibSliceContainer = CompressedImageContainer::New();
-  m_zlibSliceContainer->SetImage(slice);
+  m_zlibSliceContainer->SetMaximumNumberOfThreads(1);
+
+  CompressedImageContainer::Pointer container = m_zlibSliceContainer;
+  Image::Pointer slicePointer = slice;
+
+  // a delta to a slice that is itself stored as delta would need to decode a chain of slices
+  if (referenceOperation != nullptr && referenceOperation->m_SliceDelta == nullptr &&
+      referenceOperation->m_zlibSliceContainer.IsNotNull())
+  {
+    m_SliceDelta = std::make_shared<SliceDelta>();
+    m_ReferenceContainer = referenceOperation->m_zlibSliceContainer;
+    m_ReferenceCompression = referenceOperation->m_Compression;
+
+    auto sliceDelta = m_SliceDelta;
+    auto referenceContainer = m_ReferenceContainer;
+    auto referenceCompression = m_ReferenceCompression;
+    const std::size_t size = m_UncompressedSliceSize;
+
+    // the reference slice has been queued before, so it is compressed already when this task runs
+    m_Compression = CompressionQueue::GetInstance().Enqueue([=]() {
+      if (referenceCompression.valid())
+        referenceCompression.get();
+
+      Image::Pointer reference = referenceContainer->GetImage();
+      if (reference.IsNull() || !HaveSameLayout(slicePointer, reference))
+      {
+        container->SetImage(slicePointer);
+        return;
+      }
+
+      ImageReadAccessor sliceAccessor(slicePointer);
+      ImageReadAccessor referenceAccessor(reference);
+      sliceDelta->m_Data = EncodeDelta(static_cast<const unsigned char *>(sliceAccessor.GetData()),
+                                       static_cast<const unsigned char *>(referenceAccessor.GetData()),
+                                       size);
+      sliceDelta->m_IsEncoded = true;
+    });
+  }
+  else
+  {
+    m_Compression = CompressionQueue::GetInstance().Enqueue([container, slicePointer]() {
+      container->SetImage(slicePointer);
+    });
+  }
 
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
@@ -71,6 +332,9 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
 
 mitk::DiffSliceOperation::~DiffSliceOperation()
 {
+  if (m_Compression.valid())
+    m_Compression.wait();
+
   m_WorldGeometry = nullptr;
   m_zlibSliceContainer = nullptr;
 
@@ -84,10 +348,47 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 
 mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
 {
+  // rethrows exceptions of the compression
+  if (m_Compression.valid())
+    m_Compression.get();
+
+  if (m_SliceDelta != nullptr && m_SliceDelta->m_IsEncoded)
+  {
+    Image::Pointer image = m_ReferenceContainer->GetImage();
+    {
+      ImageWriteAccessor accessor(image);
+      ApplyDelta(m_SliceDelta->m_Data, static_cast<unsigned char *>(accessor.GetData()), m_UncompressedSliceSize);
+    }
+    return image;
+  }
+
   Image::Pointer image = m_zlibSliceContainer->GetImage();
   return image;
 }
 
+std::size_t mitk::DiffSliceOperation::GetMemoryUsage() const
+{
+  std::size_t memoryUsage = sizeof(DiffSliceOperation);
+
+  if (m_zlibSliceContainer.IsNotNull())
+  {
+    // the reference slice is counted by the reference operation
+    if (this->IsMemoryUsagePending())
+      memoryUsage += m_UncompressedSliceSize;
+    else if (m_SliceDelta != nullptr && m_SliceDelta->m_IsEncoded)
+      memoryUsage += m_SliceDelta->m_Data.size();
+    else
+      memoryUsage += m_zlibSliceContainer->GetCompressedSize();
+  }
+
+  return memoryUsage;
+}
+
+bool mitk::DiffSliceOperation::IsMemoryUsagePending() const
+{
+  return m_Compression.valid() && m_Compression.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
 bool mitk::DiffSliceOperation::IsValid()
 {
   return m_ImageIsValid && m_zlibSliceContainer.IsNotNull() && (m_WorldGeometry.IsNotNull()); // TODO improve
@@ -19,6 +19,9 @@ found in the LICENSE file.
 
 #include <vtkSmartPointer.h>
 
+#include <future>
+#include <memory>
+
 namespace mitk
 {
   class Image;
@@ -34,6 +37,13 @@ namespace mitk
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
+
+    The slice is compressed in the background by a single thread that is shared by all operations.
+    It must not be modified after it was passed to the constructor.
+
+    The undo and do operations of an edit hold nearly the same slice. Given the other operation as reference,
+    the slice is stored as XOR/RLE encoded delta to the slice of the reference, which is usually a small
+    fraction of the compressed slice.
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
   {
@@ -57,6 +67,21 @@ namespace mitk
                        unsigned int timestep,
                        BaseGeometry *currentWorldGeometry);
 
+    /** \brief Stores the slice as delta to the slice of \a referenceOperation.
+      The reference has to be created before this operation. Its slice is kept as long as this operation exists.
+      The slice is compressed on its own if \a referenceOperation is nullptr or stores a delta itself, or if the
+      slices differ in pixel type or dimensions.*/
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       mitk::Image *slice,
+                       SlicedGeometry3D *sliceGeometry,
+                       unsigned int timestep,
+                       BaseGeometry *currentWorldGeometry,
+                       const DiffSliceOperation *referenceOperation);
+
+    /** \brief Compresses the pending slices and stops the background thread.
+      Called when the Segmentation module is unloaded. Slices of later operations are compressed immediately.*/
+    static void ShutdownCompression();
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -66,9 +91,17 @@ namespace mitk
     mitk::Image *GetImage() { return this->m_Image; }
     /** \brief Set thee slice to be applied.*/
     void SetImage(vtkImageData *slice) { this->m_Slice = slice; }
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation.
+      Waits for the background compression of the slice, if it has not finished yet.*/
     Image::Pointer GetSlice();
 
+    /** \brief Returns the compressed size of the slice or its delta or, while it is being compressed, its
+      uncompressed size.*/
+    std::size_t GetMemoryUsage() const override;
+
+    /** \brief Returns true while the slice is being compressed.*/
+    bool IsMemoryUsagePending() const override;
+
     /** \brief Get timeStep.*/
     void SetTimeStep(unsigned int timestep) { this->m_TimeStep = timestep; }
     /** \brief Set timeStep*/
@@ -89,6 +122,20 @@ namespace mitk
 
     CompressedImageContainer::Pointer m_zlibSliceContainer;
 
+    /** \brief Finishes as soon as the slice is compressed into m_zlibSliceContainer.*/
+    std::shared_future<void> m_Compression;
+
+    std::size_t m_UncompressedSliceSize;
+
+    struct SliceDelta;
+
+    /** \brief The delta to the slice in m_ReferenceContainer, nullptr if the slice is compressed on its own.*/
+    std::shared_ptr<SliceDelta> m_SliceDelta;
+
+    CompressedImageContainer::Pointer m_ReferenceContainer;
+
+    std::shared_future<void> m_ReferenceCompression;
+
     mitk::Image *m_Image;
 
     vtkSmartPointer<vtkImageData> m_Slice;
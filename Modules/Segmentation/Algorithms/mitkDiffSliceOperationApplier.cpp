@@ -15,12 +15,32 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperation.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
+#include "mitkSegmentationInterpolationController.h"
+#include "mitkSegmentationSliceModifiedEvent.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkVtkImageOverwrite.h>
 
 // VTK
 #include <vtkSmartPointer.h>
 
+namespace
+{
+  mitk::Image::Pointer ExtractAffectedSlice(mitk::DiffSliceOperation *imageOperation)
+  {
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New();
+    extractor->SetInput(imageOperation->GetImage());
+    extractor->SetTimeStep(imageOperation->GetTimeStep());
+    extractor->SetWorldGeometry(dynamic_cast<mitk::PlaneGeometry *>(imageOperation->GetWorldGeometry()));
+    extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
+    extractor->Modified();
+    extractor->Update();
+
+    mitk::Image::Pointer slice = extractor->GetOutput();
+    slice->DisconnectPipeline();
+    return slice;
+  }
+}
+
 mitk::DiffSliceOperationApplier::DiffSliceOperationApplier()
 {
 }
@@ -40,6 +60,11 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
   // chak if the operation is valid
   if (imageOperation->IsValid())
   {
+    // observers of slice modifications need the content that is overwritten
+    mitk::Image::Pointer previousSlice;
+    if (imageOperation->GetImage()->HasObserver(SegmentationSliceModifiedEvent()))
+      previousSlice = ExtractAffectedSlice(imageOperation);
+
     // the actual overwrite filter (vtk)
     vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
@@ -62,22 +87,26 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     extractor->Modified();
     extractor->Update();
 
+    // the 2D interpolation updates its slice counts from the slice event below instead of scanning the image again
+    auto *interpolator = SegmentationInterpolationController::InterpolatorForImage(imageOperation->GetImage());
+    if (interpolator)
+      interpolator->BlockModified(previousSlice.IsNotNull());
+
     // make sure the modification is rendered
     RenderingManager::GetInstance()->RequestUpdateAll();
     imageOperation->GetImage()->Modified();
 
-    mitk::ExtractSliceFilter::Pointer extractor2 = mitk::ExtractSliceFilter::New();
-    extractor2->SetInput(imageOperation->GetImage());
-    extractor2->SetTimeStep(imageOperation->GetTimeStep());
-    extractor2->SetWorldGeometry(dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()));
-    extractor2->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
-    extractor2->Modified();
-    extractor2->Update();
+    if (interpolator)
+      interpolator->BlockModified(false);
+
+    mitk::Image::Pointer slice2 = ExtractAffectedSlice(imageOperation);
+
+    if (previousSlice.IsNotNull())
+      imageOperation->GetImage()->InvokeEvent(
+        SegmentationSliceModifiedEvent(previousSlice, slice2, imageOperation->GetTimeStep()));
 
     // TODO Move this code to SurfaceInterpolationController!
-    mitk::Image::Pointer slice2 = extractor2->GetOutput();
     mitk::PlaneGeometry::Pointer plane = dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry());
-    slice2->DisconnectPipeline();
     mitk::SegTool2D::UpdateSurfaceInterpolation(slice2, imageOperation->GetImage(), plane, true);
   }
 }
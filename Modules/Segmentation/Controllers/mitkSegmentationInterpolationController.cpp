@@ -15,15 +15,42 @@ found in the LICENSE file.
 #include "mitkImageCast.h"
 #include "mitkImageReadAccessor.h"
 #include "mitkImageTimeSelector.h"
+#include "mitkSegmentationSliceModifiedEvent.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkParallelFor.h>
 //#include <mitkPlaneGeometry.h>
 
 #include "mitkShapeBasedInterpolationAlgorithm.h"
 
 #include <itkCommand.h>
 #include <itkImage.h>
-#include <itkImageSliceConstIteratorWithIndex.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  /// Adds a change to a pixel count, which must never become negative
+  void AddToCount(unsigned int &count, int delta)
+  {
+    assert(static_cast<int>(count) + delta >= 0); // otherwise some counting is going wrong
+    count = static_cast<unsigned int>(static_cast<int>(count) + delta);
+  }
+
+  /// Sets the pixels of the label to 1 and all others to 0, as expected by the interpolation algorithm
+  template <typename TPixel, unsigned int VImageDimension>
+  void BinarizeLabel(itk::Image<TPixel, VImageDimension> *slice, mitk::Label::PixelType label)
+  {
+    TPixel *pixel = slice->GetBufferPointer();
+    const auto numberOfPixels = slice->GetLargestPossibleRegion().GetNumberOfPixels();
+
+    for (itk::SizeValueType i = 0; i < numberOfPixels; ++i, ++pixel)
+      *pixel = static_cast<TPixel>(static_cast<mitk::Label::PixelType>(*pixel) == label ? 1 : 0);
+  }
+}
 
 mitk::SegmentationInterpolationController::InterpolatorMapType
   mitk::SegmentationInterpolationController::s_InterpolatorForImage; // static member initialization
@@ -43,7 +70,7 @@ mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationContro
 }
 
 mitk::SegmentationInterpolationController::SegmentationInterpolationController()
-  : m_BlockModified(false), m_2DInterpolationActivated(false)
+  : m_BlockModified(false), m_2DInterpolationActivated(false), m_ModifiedObserverTag(0), m_SliceModifiedObserverTag(0)
 {
 }
 
@@ -74,14 +101,64 @@ mitk::SegmentationInterpolationController::~SegmentationInterpolationController(
       break;
     }
   }
+
+  this->DetachFromSegmentation();
+}
+
+void mitk::SegmentationInterpolationController::DetachFromSegmentation()
+{
+  if (m_Segmentation.IsNull())
+    return;
+
+  m_Segmentation->RemoveObserver(m_ModifiedObserverTag);
+  m_Segmentation->RemoveObserver(m_SliceModifiedObserverTag);
+
+  auto iter = s_InterpolatorForImage.find(m_Segmentation);
+  if (iter != s_InterpolatorForImage.end() && iter->second == this)
+    s_InterpolatorForImage.erase(iter);
 }
 
 void mitk::SegmentationInterpolationController::OnImageModified(const itk::EventObject &)
 {
-  if (!m_BlockModified && m_Segmentation.IsNotNull() && m_2DInterpolationActivated)
+  if (m_BlockModified || m_Segmentation.IsNull())
+    return;
+
+  // the changed region is unknown, so all slabs are scanned again with the next query
+  this->InitializeOccupancy();
+
+  if (m_2DInterpolationActivated)
+    this->Modified();
+}
+
+void mitk::SegmentationInterpolationController::OnSliceModified(const itk::EventObject &event)
+{
+  const auto *sliceEvent = dynamic_cast<const SegmentationSliceModifiedEvent *>(&event);
+  if (sliceEvent == nullptr || m_Segmentation.IsNull())
+    return;
+
+  const Image *previousSlice = sliceEvent->GetPreviousSlice();
+  const Image *currentSlice = sliceEvent->GetCurrentSlice();
+  const unsigned int timeStep = sliceEvent->GetTimeStep();
+  if (currentSlice == nullptr || timeStep >= m_Occupancy.size())
+    return;
+
+  SliceToVolumeMapping mapping;
+  if (previousSlice != nullptr && currentSlice->GetDimension() == 2 &&
+      previousSlice->GetPixelType() == currentSlice->GetPixelType() &&
+      previousSlice->GetDimension(0) == currentSlice->GetDimension(0) &&
+      previousSlice->GetDimension(1) == currentSlice->GetDimension(1) &&
+      this->ComputeSliceToVolumeMapping(currentSlice, timeStep, mapping))
+  {
+    AccessFixedDimensionByItk_3(currentSlice, ScanSliceChange, 2, previousSlice, mapping, timeStep);
+  }
+  else
   {
-    SetSegmentationVolume(m_Segmentation);
+    // the change cannot be located voxel by voxel, so the slabs touched by the slice are scanned again
+    this->MarkSlabsOutdated(currentSlice->GetGeometry(), timeStep);
   }
+
+  if (m_2DInterpolationActivated)
+    this->Modified();
 }
 
 void mitk::SegmentationInterpolationController::BlockModified(bool block)
@@ -93,6 +170,7 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 {
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
+  m_Occupancy.clear();
 
   // delete this from the list of interpolators
   auto iter = s_InterpolatorForImage.find(segmentation);
@@ -102,7 +180,11 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
   }
 
   if (!segmentation)
+  {
+    this->DetachFromSegmentation();
+    m_Segmentation = nullptr;
     return;
+  }
   if (segmentation->GetDimension() > 4 || segmentation->GetDimension() < 3)
   {
     itkExceptionMacro("SegmentationInterpolationController needs a 3D-segmentation or 3D+t, not 2D.");
@@ -110,43 +192,28 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
   if (m_Segmentation != segmentation)
   {
+    this->DetachFromSegmentation();
+
     // observe Modified() event of image
     itk::ReceptorMemberCommand<SegmentationInterpolationController>::Pointer command =
       itk::ReceptorMemberCommand<SegmentationInterpolationController>::New();
     command->SetCallbackFunction(this, &SegmentationInterpolationController::OnImageModified);
-    segmentation->AddObserver(itk::ModifiedEvent(), command);
+    m_ModifiedObserverTag = segmentation->AddObserver(itk::ModifiedEvent(), command);
+
+    // observe changes of single slices
+    itk::ReceptorMemberCommand<SegmentationInterpolationController>::Pointer sliceCommand =
+      itk::ReceptorMemberCommand<SegmentationInterpolationController>::New();
+    sliceCommand->SetCallbackFunction(this, &SegmentationInterpolationController::OnSliceModified);
+    m_SliceModifiedObserverTag = segmentation->AddObserver(SegmentationSliceModifiedEvent(), sliceCommand);
   }
 
   m_Segmentation = segmentation;
 
-  m_SegmentationCountInSlice.resize(m_Segmentation->GetTimeSteps());
-  for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
-  {
-    m_SegmentationCountInSlice[timeStep].resize(3);
-    for (unsigned int dim = 0; dim < 3; ++dim)
-    {
-      m_SegmentationCountInSlice[timeStep][dim].clear();
-      m_SegmentationCountInSlice[timeStep][dim].resize(m_Segmentation->GetDimension(dim));
-      m_SegmentationCountInSlice[timeStep][dim].assign(m_Segmentation->GetDimension(dim), 0);
-    }
-  }
+  // the time steps are scanned when they are queried
+  this->InitializeOccupancy();
 
   s_InterpolatorForImage.insert(std::make_pair(m_Segmentation, this));
 
-  // for all timesteps
-  // scan whole image
-  for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
-  {
-    ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-    timeSelector->SetInput(m_Segmentation);
-    timeSelector->SetTimeNr(timeStep);
-    timeSelector->UpdateLargestPossibleRegion();
-    Image::Pointer segmentation3D = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
-  }
-
-  // PrintStatus();
-
   SetReferenceVolume(m_ReferenceImage);
 
   Modified();
@@ -181,12 +248,231 @@ void mitk::SegmentationInterpolationController::SetReferenceVolume(const Image *
     }
 }
 
+void mitk::SegmentationInterpolationController::InitializeOccupancy()
+{
+  const unsigned int numberOfTimeSteps = m_Segmentation->GetTimeSteps();
+  const unsigned int numberOfSlabs = (m_Segmentation->GetDimension(2) + SlabThickness - 1) / SlabThickness;
+
+  m_SegmentationCountInSlice.assign(numberOfTimeSteps, std::vector<DirtyVectorType>(3));
+  m_Occupancy.assign(numberOfTimeSteps, TimeStepOccupancy());
+
+  for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      m_SegmentationCountInSlice[timeStep][dim].assign(m_Segmentation->GetDimension(dim), 0);
+
+    m_Occupancy[timeStep].slabs.resize(numberOfSlabs);
+  }
+}
+
+void mitk::SegmentationInterpolationController::UpdateOccupancy(unsigned int timeStep)
+{
+  if (m_Segmentation.IsNull() || timeStep >= m_Occupancy.size())
+    return;
+
+  const auto &slabs = m_Occupancy[timeStep].slabs;
+  if (std::none_of(slabs.begin(), slabs.end(), [](const SlabOccupancy &slab) { return slab.outdated; }))
+    return;
+
+  ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
+  timeSelector->SetInput(m_Segmentation);
+  timeSelector->SetTimeNr(timeStep);
+  timeSelector->UpdateLargestPossibleRegion();
+  Image::Pointer segmentation3D = timeSelector->GetOutput();
+  AccessFixedDimensionByItk_1(segmentation3D, ScanOutdatedSlabs, 3, timeStep);
+}
+
+void mitk::SegmentationInterpolationController::MarkSlabsOutdated(const BaseGeometry *geometry, unsigned int timeStep)
+{
+  const BaseGeometry *volumeGeometry = m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+  if (geometry == nullptr || volumeGeometry == nullptr)
+    return;
+
+  double minSlice = std::numeric_limits<double>::max();
+  double maxSlice = std::numeric_limits<double>::lowest();
+  for (unsigned int corner = 0; corner < 8; ++corner)
+  {
+    Point3D index;
+    volumeGeometry->WorldToIndex(geometry->GetCornerPoint(corner), index);
+    minSlice = std::min(minSlice, index[2]);
+    maxSlice = std::max(maxSlice, index[2]);
+  }
+
+  // one slice of margin covers the reslicing to the nearest voxel
+  const int firstSlice = std::max(0, static_cast<int>(std::floor(minSlice)));
+  const int lastSlice =
+    std::min(static_cast<int>(m_Segmentation->GetDimension(2)) - 1, static_cast<int>(std::ceil(maxSlice)));
+  const int slabThickness = SlabThickness;
+
+  for (int slab = firstSlice / slabThickness; firstSlice <= lastSlice && slab <= lastSlice / slabThickness; ++slab)
+    m_Occupancy[timeStep].slabs[slab].outdated = true;
+}
+
+bool mitk::SegmentationInterpolationController::ComputeSliceToVolumeMapping(const Image *slice,
+                                                                            unsigned int timeStep,
+                                                                            SliceToVolumeMapping &mapping) const
+{
+  const BaseGeometry *sliceGeometry = slice->GetGeometry();
+  const BaseGeometry *volumeGeometry = m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+  if (sliceGeometry == nullptr || volumeGeometry == nullptr)
+    return false;
+
+  // volume indices of the slice pixels (0, 0), (1, 0) and (0, 1)
+  Point3D volumeIndex[3];
+  for (unsigned int p = 0; p < 3; ++p)
+  {
+    Point3D sliceIndex, world;
+    sliceIndex.Fill(0);
+    if (p > 0)
+      sliceIndex[p - 1] = 1;
+    sliceGeometry->IndexToWorld(sliceIndex, world);
+    volumeGeometry->WorldToIndex(world, volumeIndex[p]);
+  }
+
+  int uLength = 0, vLength = 0, dot = 0;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    const double continuous[3] = {
+      volumeIndex[0][i], volumeIndex[1][i] - volumeIndex[0][i], volumeIndex[2][i] - volumeIndex[0][i]};
+    int *discrete[3] = {&mapping.origin[i], &mapping.uStep[i], &mapping.vStep[i]};
+    for (unsigned int p = 0; p < 3; ++p)
+    {
+      *discrete[p] = static_cast<int>(std::round(continuous[p]));
+      if (std::abs(continuous[p] - *discrete[p]) > 0.01)
+        return false;
+    }
+
+    uLength += std::abs(mapping.uStep[i]);
+    vLength += std::abs(mapping.vStep[i]);
+    dot += mapping.uStep[i] * mapping.vStep[i];
+  }
+
+  // both slice axes have to advance by one voxel along two different volume axes
+  if (uLength != 1 || vLength != 1 || dot != 0)
+    return false;
+
+  // the mapping is affine, so the slice lies within the volume if its corners do
+  const int width = slice->GetDimension(0);
+  const int height = slice->GetDimension(1);
+  for (int corner = 0; corner < 4; ++corner)
+  {
+    const int u = (corner & 1) ? width - 1 : 0;
+    const int v = (corner & 2) ? height - 1 : 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const int index = mapping.origin[i] + u * mapping.uStep[i] + v * mapping.vStep[i];
+      if (index < 0 || index >= static_cast<int>(m_Segmentation->GetDimension(i)))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<mitk::SegmentationInterpolationController::DirtyVectorType>
+  &mitk::SegmentationInterpolationController::GetLabelSliceCounts(LabelSliceCountsType &labelCounts,
+                                                                  LabelValueType label,
+                                                                  unsigned int numberOfAxialSlices) const
+{
+  auto iter = labelCounts.find(label);
+  if (iter == labelCounts.end())
+  {
+    std::vector<DirtyVectorType> counts = {DirtyVectorType(m_Segmentation->GetDimension(0), 0),
+                                           DirtyVectorType(m_Segmentation->GetDimension(1), 0),
+                                           DirtyVectorType(numberOfAxialSlices, 0)};
+    iter = labelCounts.emplace(label, std::move(counts)).first;
+  }
+
+  return iter->second;
+}
+
+void mitk::SegmentationInterpolationController::ReplaceSlabCounts(unsigned int timeStep,
+                                                                  unsigned int slab,
+                                                                  LabelSliceCountsType &labelCounts)
+{
+  TimeStepOccupancy &occupancy = m_Occupancy[timeStep];
+  SlabOccupancy &slabOccupancy = occupancy.slabs[slab];
+  std::vector<DirtyVectorType> &aggregatedCounts = m_SegmentationCountInSlice[timeStep];
+  const unsigned int firstSlice = slab * SlabThickness;
+  const unsigned int numberOfSlices = aggregatedCounts[2].size();
+
+  auto addToSums = [&](const LabelSliceCountsType &slabCounts, int sign) {
+    for (const auto &labelSlabCounts : slabCounts)
+    {
+      auto &sums = this->GetLabelSliceCounts(occupancy.labelCounts, labelSlabCounts.first, numberOfSlices);
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        // the axial counts of the slab start at its first slice
+        const unsigned int offset = dim == 2 ? firstSlice : 0;
+        const DirtyVectorType &counts = labelSlabCounts.second[dim];
+        for (unsigned int index = 0; index < counts.size() && offset + index < sums[dim].size(); ++index)
+        {
+          if (counts[index] == 0)
+            continue;
+
+          AddToCount(sums[dim][offset + index], sign * static_cast<int>(counts[index]));
+          AddToCount(aggregatedCounts[dim][offset + index], sign * static_cast<int>(counts[index]));
+        }
+      }
+    }
+  };
+
+  addToSums(slabOccupancy.labelCounts, -1);
+  slabOccupancy.labelCounts.swap(labelCounts);
+  addToSums(slabOccupancy.labelCounts, 1);
+  slabOccupancy.outdated = false;
+}
+
+void mitk::SegmentationInterpolationController::AddToVoxelCount(
+  unsigned int timeStep, LabelValueType label, unsigned int x, unsigned int y, unsigned int z, int delta)
+{
+  if (label == 0 || delta == 0)
+    return;
+
+  TimeStepOccupancy &occupancy = m_Occupancy[timeStep];
+  SlabOccupancy &slabOccupancy = occupancy.slabs[z / SlabThickness];
+  if (slabOccupancy.outdated)
+    return; // the next scan of the slab includes the change
+
+  std::vector<DirtyVectorType> &aggregatedCounts = m_SegmentationCountInSlice[timeStep];
+  auto &slabCounts = this->GetLabelSliceCounts(slabOccupancy.labelCounts, label, SlabThickness);
+  auto &sums = this->GetLabelSliceCounts(occupancy.labelCounts, label, aggregatedCounts[2].size());
+
+  const unsigned int index[3] = {x, y, z};
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    AddToCount(slabCounts[dim][dim == 2 ? z % SlabThickness : index[dim]], delta);
+    AddToCount(sums[dim][index[dim]], delta);
+    AddToCount(aggregatedCounts[dim][index[dim]], delta);
+  }
+}
+
+unsigned int mitk::SegmentationInterpolationController::GetNumberOfPixelsInSlice(unsigned int sliceDimension,
+                                                                                  unsigned int sliceIndex,
+                                                                                  unsigned int timeStep,
+                                                                                  LabelValueType label)
+{
+  if (timeStep >= m_Occupancy.size() || sliceDimension > 2)
+    return 0;
+
+  this->UpdateOccupancy(timeStep);
+
+  const LabelSliceCountsType &labelCounts = m_Occupancy[timeStep].labelCounts;
+  auto iter = labelCounts.find(label);
+  if (iter == labelCounts.end() || sliceIndex >= iter->second[sliceDimension].size())
+    return 0;
+
+  return iter->second[sliceDimension][sliceIndex];
+}
+
 void mitk::SegmentationInterpolationController::SetChangedVolume(const Image *sliceDiff, unsigned int timeStep)
 {
   if (!sliceDiff)
     return;
   if (sliceDiff->GetDimension() != 3)
     return;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
 
   AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
 
@@ -259,114 +545,140 @@ void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Imag
   unsigned int dim0(options.dim0);
   unsigned int dim1(options.dim1);
 
-  int numberOfPixels(0); // number of pixels in this slice that are not 0
-
   unsigned int dim0max = m_SegmentationCountInSlice[timeStep][dim0].size();
   unsigned int dim1max = m_SegmentationCountInSlice[timeStep][dim1].size();
 
-  // scan the slice from two directions
-  // and set the flags for the two dimensions of the slice
+  unsigned int index[3];
+  index[sliceDimension] = sliceIndex;
+
+  // the difference image holds the changes of a binary segmentation, which are counted for label 1
   for (unsigned int v = 0; v < dim1max; ++v)
   {
     for (unsigned int u = 0; u < dim0max; ++u)
     {
       DATATYPE value = *(pixelData + u + v * dim0max);
+      if (value == 0)
+        continue;
 
-      assert((signed)m_SegmentationCountInSlice[timeStep][dim0][u] + (signed)value >=
-             0); // just for debugging. This must always be true, otherwise some counting is going wrong
-      assert((signed)m_SegmentationCountInSlice[timeStep][dim1][v] + (signed)value >= 0);
-
-      m_SegmentationCountInSlice[timeStep][dim0][u] =
-        static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][dim0][u] + value);
-      m_SegmentationCountInSlice[timeStep][dim1][v] =
-        static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][dim1][v] + value);
-      numberOfPixels += static_cast<int>(value);
+      index[dim0] = u;
+      index[dim1] = v;
+      this->AddToVoxelCount(timeStep, 1, index[0], index[1], index[2], static_cast<int>(value));
     }
   }
-
-  // flag for the dimension of the slice itself
-  assert((signed)m_SegmentationCountInSlice[timeStep][sliceDimension][sliceIndex] + numberOfPixels >= 0);
-  m_SegmentationCountInSlice[timeStep][sliceDimension][sliceIndex] += numberOfPixels;
-
-  // MITK_INFO << "scan t=" << timeStep << " from (0,0) to (" << dim0max << "," << dim1max << ") (" << pixelData << "-"
-  // << pixelData+dim0max*dim1max-1 <<  ") in slice " << sliceIndex << " found " << numberOfPixels << " pixels" <<
-  // std::endl;
 }
 
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::SegmentationInterpolationController::ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *diffImage,
                                                                   unsigned int timeStep)
 {
-  typedef itk::ImageSliceConstIteratorWithIndex<itk::Image<TPixel, VImageDimension>> IteratorType;
+  typedef itk::ImageRegionConstIteratorWithIndex<itk::Image<TPixel, VImageDimension>> IteratorType;
 
   IteratorType iter(diffImage, diffImage->GetLargestPossibleRegion());
-  iter.SetFirstDirection(0);
-  iter.SetSecondDirection(1);
 
-  int numberOfPixels(0); // number of pixels in this slice that are not 0
+  for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+  {
+    TPixel value = iter.Get();
+    if (value == 0)
+      continue;
+
+    const typename IteratorType::IndexType &index = iter.GetIndex();
+    if (static_cast<unsigned int>(index[0]) >= m_SegmentationCountInSlice[timeStep][0].size() ||
+        static_cast<unsigned int>(index[1]) >= m_SegmentationCountInSlice[timeStep][1].size() ||
+        static_cast<unsigned int>(index[2]) >= m_SegmentationCountInSlice[timeStep][2].size())
+      continue;
 
-  typename IteratorType::IndexType index;
-  unsigned int x = 0;
-  unsigned int y = 0;
-  unsigned int z = 0;
+    this->AddToVoxelCount(timeStep, 1, index[0], index[1], index[2], static_cast<int>(value));
+  }
+}
 
-  iter.GoToBegin();
-  while (!iter.IsAtEnd())
+template <typename DATATYPE>
+void mitk::SegmentationInterpolationController::ScanOutdatedSlabs(const itk::Image<DATATYPE, 3> *image,
+                                                                  unsigned int timeStep)
+{
+  std::vector<unsigned int> outdatedSlabs;
+  for (unsigned int slab = 0; slab < m_Occupancy[timeStep].slabs.size(); ++slab)
   {
-    while (!iter.IsAtEndOfSlice())
-    {
-      while (!iter.IsAtEndOfLine())
-      {
-        index = iter.GetIndex();
+    if (m_Occupancy[timeStep].slabs[slab].outdated)
+      outdatedSlabs.push_back(slab);
+  }
 
-        x = index[0];
-        y = index[1];
-        z = index[2];
+  const unsigned int numberOfSlices = image->GetLargestPossibleRegion().GetSize(2);
+  std::vector<LabelSliceCountsType> scannedCounts(outdatedSlabs.size());
 
-        TPixel value = iter.Get();
+  // each slab is counted separately, so the threads do not share any counts
+  mitk::ParallelFor(outdatedSlabs.size(), [&](std::size_t i) {
+    const unsigned int firstSlice = outdatedSlabs[i] * SlabThickness;
+    const unsigned int lastSlice = std::min(firstSlice + SlabThickness, numberOfSlices);
+    this->ScanSlab(image, firstSlice, lastSlice, scannedCounts[i]);
+  });
 
-        assert((signed)m_SegmentationCountInSlice[timeStep][0][x] + (signed)value >=
-               0); // just for debugging. This must always be true, otherwise some counting is going wrong
-        assert((signed)m_SegmentationCountInSlice[timeStep][1][y] + (signed)value >= 0);
+  for (std::size_t i = 0; i < outdatedSlabs.size(); ++i)
+    this->ReplaceSlabCounts(timeStep, outdatedSlabs[i], scannedCounts[i]);
+}
 
-        m_SegmentationCountInSlice[timeStep][0][x] =
-          static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][0][x] + value);
-        m_SegmentationCountInSlice[timeStep][1][y] =
-          static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][1][y] + value);
+template <typename DATATYPE>
+void mitk::SegmentationInterpolationController::ScanSlab(const itk::Image<DATATYPE, 3> *image,
+                                                         unsigned int firstSlice,
+                                                         unsigned int lastSlice,
+                                                         LabelSliceCountsType &labelCounts) const
+{
+  const auto size = image->GetLargestPossibleRegion().GetSize();
+  const DATATYPE *pixel = image->GetBufferPointer() + firstSlice * size[0] * size[1];
 
-        numberOfPixels += static_cast<int>(value);
+  // neighboring pixels mostly share their label, so the counts of the last label are kept at hand
+  std::vector<DirtyVectorType> *counts = nullptr;
+  LabelValueType countedLabel = 0;
 
-        ++iter;
+  for (unsigned int z = firstSlice; z < lastSlice; ++z)
+  {
+    for (unsigned int y = 0; y < size[1]; ++y)
+    {
+      for (unsigned int x = 0; x < size[0]; ++x, ++pixel)
+      {
+        const auto label = static_cast<LabelValueType>(*pixel);
+        if (label == 0)
+          continue;
+
+        if (counts == nullptr || label != countedLabel)
+        {
+          counts = &this->GetLabelSliceCounts(labelCounts, label, SlabThickness);
+          countedLabel = label;
+        }
+
+        ++(*counts)[0][x];
+        ++(*counts)[1][y];
+        ++(*counts)[2][z - firstSlice];
       }
-      iter.NextLine();
     }
-    assert((signed)m_SegmentationCountInSlice[timeStep][2][z] + numberOfPixels >= 0);
-    m_SegmentationCountInSlice[timeStep][2][z] += numberOfPixels;
-    numberOfPixels = 0;
-
-    iter.NextSlice();
   }
 }
 
 template <typename DATATYPE>
-void mitk::SegmentationInterpolationController::ScanWholeVolume(const itk::Image<DATATYPE, 3> *,
-                                                                const Image *volume,
+void mitk::SegmentationInterpolationController::ScanSliceChange(const itk::Image<DATATYPE, 2> *currentSlice,
+                                                                const Image *previousSlice,
+                                                                const SliceToVolumeMapping &mapping,
                                                                 unsigned int timeStep)
 {
-  if (!volume)
-    return;
-  if (timeStep >= m_SegmentationCountInSlice.size())
-    return;
+  ImageReadAccessor previousAccess(previousSlice);
+  const auto *previous = static_cast<const DATATYPE *>(previousAccess.GetData());
+  const DATATYPE *current = currentSlice->GetBufferPointer();
 
-  ImageReadAccessor readAccess(volume, volume->GetVolumeData(timeStep));
+  const auto size = currentSlice->GetLargestPossibleRegion().GetSize();
+  unsigned int index[3];
 
-  for (unsigned int slice = 0; slice < volume->GetDimension(2); ++slice)
+  for (unsigned int v = 0; v < size[1]; ++v)
   {
-    const auto *rawVolume =
-      static_cast<const DATATYPE *>(readAccess.GetData()); // we again promise not to change anything, we'll just count
-    const DATATYPE *rawSlice = rawVolume + (volume->GetDimension(0) * volume->GetDimension(1) * slice);
+    for (unsigned int u = 0; u < size[0]; ++u, ++previous, ++current)
+    {
+      if (*previous == *current)
+        continue;
+
+      for (unsigned int i = 0; i < 3; ++i)
+        index[i] = mapping.origin[i] + u * mapping.uStep[i] + v * mapping.vStep[i];
 
-    ScanChangedSlice<DATATYPE>(nullptr, SetChangedSliceOptions(2, slice, 0, 1, timeStep, rawSlice));
+      this->AddToVoxelCount(timeStep, static_cast<LabelValueType>(*previous), index[0], index[1], index[2], -1);
+      this->AddToVoxelCount(timeStep, static_cast<LabelValueType>(*current), index[0], index[1], index[2], 1);
+    }
   }
 }
 
@@ -374,6 +686,8 @@ void mitk::SegmentationInterpolationController::PrintStatus()
 {
   unsigned int timeStep(0); // if needed, put a loop over time steps around everyting, but beware, output will be long
 
+  this->UpdateOccupancy(timeStep);
+
   MITK_INFO << "Interpolator status (timestep 0): dimensions " << m_SegmentationCountInSlice[timeStep][0].size() << " "
             << m_SegmentationCountInSlice[timeStep][1].size() << " " << m_SegmentationCountInSlice[timeStep][2].size()
             << std::endl;
@@ -437,22 +751,61 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
   if (m_Segmentation.IsNull())
     return nullptr;
 
-  if (!currentPlane)
-  {
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return nullptr;
+  if (sliceDimension > 2)
     return nullptr;
-  }
 
-  if (timeStep >= m_SegmentationCountInSlice.size())
+  this->UpdateOccupancy(timeStep);
+
+  return this->InterpolateSlice(
+    m_SegmentationCountInSlice[timeStep][sliceDimension], sliceDimension, sliceIndex, currentPlane, timeStep, nullptr);
+}
+
+mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsigned int sliceDimension,
+                                                                            unsigned int sliceIndex,
+                                                                            const mitk::PlaneGeometry *currentPlane,
+                                                                            unsigned int timeStep,
+                                                                            LabelValueType label)
+{
+  if (m_Segmentation.IsNull())
+    return nullptr;
+
+  if (timeStep >= m_Occupancy.size())
     return nullptr;
   if (sliceDimension > 2)
     return nullptr;
-  unsigned int upperLimit = m_SegmentationCountInSlice[timeStep][sliceDimension].size();
+
+  this->UpdateOccupancy(timeStep);
+
+  const LabelSliceCountsType &labelCounts = m_Occupancy[timeStep].labelCounts;
+  auto iter = labelCounts.find(label);
+  if (label == 0 || iter == labelCounts.end())
+    return nullptr;
+
+  return this->InterpolateSlice(iter->second[sliceDimension], sliceDimension, sliceIndex, currentPlane, timeStep, &label);
+}
+
+mitk::Image::Pointer mitk::SegmentationInterpolationController::InterpolateSlice(
+  const DirtyVectorType &sliceCounts,
+  unsigned int sliceDimension,
+  unsigned int sliceIndex,
+  const mitk::PlaneGeometry *currentPlane,
+  unsigned int timeStep,
+  const LabelValueType *label)
+{
+  if (!currentPlane)
+  {
+    return nullptr;
+  }
+
+  unsigned int upperLimit = sliceCounts.size();
   if (sliceIndex >= upperLimit - 1)
     return nullptr; // can't interpolate first and last slice
   if (sliceIndex < 1)
     return nullptr;
 
-  if (m_SegmentationCountInSlice[timeStep][sliceDimension][sliceIndex] > 0)
+  if (sliceCounts[sliceIndex] > 0)
     return nullptr; // slice contains a segmentation, won't interpolate anything then
 
   unsigned int lowerBound(0);
@@ -461,7 +814,7 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
 
   for (lowerBound = sliceIndex - 1; /*lowerBound >= 0*/; --lowerBound)
   {
-    if (m_SegmentationCountInSlice[timeStep][sliceDimension][lowerBound] > 0)
+    if (sliceCounts[lowerBound] > 0)
     {
       bounds = true;
       break;
@@ -477,7 +830,7 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
   bounds = false;
   for (upperBound = sliceIndex + 1; upperBound < upperLimit; ++upperBound)
   {
-    if (m_SegmentationCountInSlice[timeStep][sliceDimension][upperBound] > 0)
+    if (sliceCounts[upperBound] > 0)
     {
       bounds = true;
       break;
@@ -556,6 +909,13 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
 
     if (lowerMITKSlice.IsNull() || upperMITKSlice.IsNull())
       return nullptr;
+
+    if (label != nullptr)
+    {
+      // the interpolation algorithm expects binary slices
+      AccessFixedDimensionByItk_1(lowerMITKSlice, BinarizeLabel, 2, *label);
+      AccessFixedDimensionByItk_1(upperMITKSlice, BinarizeLabel, 2, *label);
+    }
   }
   catch (const std::exception &e)
   {
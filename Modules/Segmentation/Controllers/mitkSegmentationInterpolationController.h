@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkCommon.h"
 #include "mitkImage.h"
+#include "mitkLabel.h"
 #include <MitkSegmentationExports.h>
 
 #include <itkImage.h>
@@ -36,26 +37,28 @@ namespace mitk
     \ingroup ToolManagerEtAl
 
     This class keeps track of the contents of a 3D segmentation image.
-    \attention mitk::SegmentationInterpolationController assumes that the image contains pixel values of 0 and 1.
-
-    After you set the segmentation image using SetSegmentationVolume(), the whole image is scanned for pixels other than
-    0.
-    SegmentationInterpolationController registers as an observer to the segmentation image, and repeats the scan
-    whenvever the
-    image is modified.
-
-    You can prevent this (time consuming) scan if you do the changes slice-wise and send difference images to
-    SegmentationInterpolationController.
-    For this purpose SetChangedSlice() should be used. mitk::OverwriteImageFilter already does this every time it
-    changes a
-    slice of an image. There is a static method InterpolatorForImage(), which can be used to find out if there already
-    is an interpolator
-    instance for a specified image. OverwriteImageFilter uses this to get to know its interpolator.
+    \attention The legacy difference updates SetChangedSlice() and SetChangedVolume() assume that the image contains
+    pixel values of 0 and 1, their differences are accounted to label 1.
+
+    After you set the segmentation image using SetSegmentationVolume(), the image is scanned for pixels other than 0.
+    The scan is split into slabs of consecutive axial slices, which are scanned in parallel. It is deferred until a
+    time step is actually queried, e.g. by Interpolate(), so only the time steps in use are scanned.
+
+    SegmentationInterpolationController registers as an observer to the segmentation image. A Modified() of the image
+    marks all slabs as outdated, so they are scanned again with the next query. Writers that know the changed region
+    should block this reaction using BlockModified() and report the change instead:
+    - SegTool2D and DiffSliceOperationApplier invoke a SegmentationSliceModifiedEvent with the slice content before and
+      after the change. Slices aligned with the voxel grid update the counts from the changed pixels only, for other
+      slices only the slabs touched by the slice are scanned again.
+    - SetChangedSlice() and SetChangedVolume() take difference images. mitk::OverwriteImageFilter already does this
+      every time it changes a slice of an image. There is a static method InterpolatorForImage(), which can be used to
+      find out if there already is an interpolator instance for a specified image.
 
     SegmentationInterpolationController needs to maintain some information about the image slices (in every dimension).
-    This information is stored internally in m_SegmentationCountInSlice, which is basically three std::vectors (one for
-    each dimension).
-    Each item describes one image dimension, each vector item holds the count of pixels in "its" slice.
+    For every label, it counts the pixels of the label in each slice of each dimension, so slices of multi-label
+    segmentations can be interpolated per label (see Interpolate()) without scanning the image again. The counts of all
+    labels other than 0 are summed up in m_SegmentationCountInSlice, which is basically three std::vectors (one for
+    each dimension) per time step.
 
     $Author$
   */
@@ -66,6 +69,8 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
+    typedef Label::PixelType LabelValueType;
+
       /**
         \brief Find interpolator for a given image.
         \return nullptr if there is no interpolator yet.
@@ -89,6 +94,7 @@ namespace mitk
       \brief Initialize with a whole volume.
 
       Will scan the volume for segmentation pixels (values other than 0) and fill some internal data structures.
+      The scan of a time step is deferred until it is queried.
       You don't have to call this method every time something changes, but only
       when several slices at once change.
 
@@ -139,8 +145,36 @@ namespace mitk
                                const mitk::PlaneGeometry *currentPlane,
                                unsigned int timeStep);
 
+    /**
+      \brief Generates an interpolated image of a single label for the given slice.
+
+      Only the pixels with the given label value are considered, both when looking for the neighboring slices and when
+      interpolating their shapes. The result contains 1 for the estimated pixels of the label and 0 elsewhere.
+    */
+    Image::Pointer Interpolate(unsigned int sliceDimension,
+                               unsigned int sliceIndex,
+                               const mitk::PlaneGeometry *currentPlane,
+                               unsigned int timeStep,
+                               LabelValueType label);
+
+    /**
+      \brief Number of pixels with the given label in a slice.
+
+      Scans the outdated slabs of the time step first, if any. Label 0 is not counted.
+    */
+    unsigned int GetNumberOfPixelsInSlice(unsigned int sliceDimension,
+                                          unsigned int sliceIndex,
+                                          unsigned int timeStep,
+                                          LabelValueType label);
+
     void OnImageModified(const itk::EventObject &);
 
+    /**
+      \brief Updates the counts from the content of a slice before and after a change, see
+      SegmentationSliceModifiedEvent.
+    */
+    void OnSliceModified(const itk::EventObject &);
+
     /**
      * Activate/Deactivate the 2D interpolation.
     */
@@ -178,6 +212,35 @@ namespace mitk
     typedef std::vector<std::vector<DirtyVectorType>> TimeResolvedDirtyVectorType;
     typedef std::map<const Image *, SegmentationInterpolationController *> InterpolatorMapType;
 
+    /// number of consecutive axial slices that are scanned together
+    static const unsigned int SlabThickness = 8;
+
+    /// pixel counts of each label in the slices of the three dimensions, [label][dim][index]
+    typedef std::map<LabelValueType, std::vector<DirtyVectorType>> LabelSliceCountsType;
+
+    /// Pixel counts of the axial slices [slab * SlabThickness, (slab + 1) * SlabThickness).
+    /// The axial counts are relative to the first slice of the slab.
+    struct SlabOccupancy
+    {
+      bool outdated = true;
+      LabelSliceCountsType labelCounts;
+    };
+
+    /// Pixel counts of one time step, the sums of the counts of all slabs
+    struct TimeStepOccupancy
+    {
+      LabelSliceCountsType labelCounts;
+      std::vector<SlabOccupancy> slabs;
+    };
+
+    /// Maps the pixel (u, v) of a slice to the voxel origin + u * uStep + v * vStep of the segmentation
+    struct SliceToVolumeMapping
+    {
+      int origin[3];
+      int uStep[3];
+      int vStep[3];
+    };
+
     SegmentationInterpolationController(); // purposely hidden
     ~SegmentationInterpolationController() override;
 
@@ -188,8 +251,55 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *, unsigned int timeStep);
 
+    /// scans the outdated slabs of a time step in parallel
     template <typename DATATYPE>
-    void ScanWholeVolume(const itk::Image<DATATYPE, 3> *, const Image *volume, unsigned int timeStep);
+    void ScanOutdatedSlabs(const itk::Image<DATATYPE, 3> *, unsigned int timeStep);
+
+    /// counts the pixels of the axial slices [firstSlice, lastSlice)
+    template <typename DATATYPE>
+    void ScanSlab(const itk::Image<DATATYPE, 3> *,
+                  unsigned int firstSlice,
+                  unsigned int lastSlice,
+                  LabelSliceCountsType &labelCounts) const;
+
+    /// counts the changed pixels of a slice aligned with the voxel grid
+    template <typename DATATYPE>
+    void ScanSliceChange(const itk::Image<DATATYPE, 2> *currentSlice,
+                         const Image *previousSlice,
+                         const SliceToVolumeMapping &mapping,
+                         unsigned int timeStep);
+
+    /// allocates the counts of all time steps and marks all slabs as outdated
+    void InitializeOccupancy();
+
+    /// scans the outdated slabs of a time step, if any
+    void UpdateOccupancy(unsigned int timeStep);
+
+    /// marks the slabs touched by the geometry as outdated
+    void MarkSlabsOutdated(const BaseGeometry *geometry, unsigned int timeStep);
+
+    /// replaces the counts of a slab by newly scanned ones and updates the sums
+    void ReplaceSlabCounts(unsigned int timeStep, unsigned int slab, LabelSliceCountsType &labelCounts);
+
+    /// adds delta to the counts of a voxel, unless its slab is outdated anyway
+    void AddToVoxelCount(
+      unsigned int timeStep, LabelValueType label, unsigned int x, unsigned int y, unsigned int z, int delta);
+
+    bool ComputeSliceToVolumeMapping(const Image *slice, unsigned int timeStep, SliceToVolumeMapping &mapping) const;
+
+    std::vector<DirtyVectorType> &GetLabelSliceCounts(LabelSliceCountsType &labelCounts,
+                                                      LabelValueType label,
+                                                      unsigned int numberOfAxialSlices) const;
+
+    Image::Pointer InterpolateSlice(const DirtyVectorType &sliceCounts,
+                                    unsigned int sliceDimension,
+                                    unsigned int sliceIndex,
+                                    const mitk::PlaneGeometry *currentPlane,
+                                    unsigned int timeStep,
+                                    const LabelValueType *label);
+
+    /// stops observing the current segmentation and removes this from the list of interpolators
+    void DetachFromSegmentation();
 
     void PrintStatus();
 
@@ -204,12 +314,18 @@ namespace mitk
     */
     TimeResolvedDirtyVectorType m_SegmentationCountInSlice;
 
+    /// per label and per slab counts of each time step, m_Occupancy[timeStep]
+    std::vector<TimeStepOccupancy> m_Occupancy;
+
     static InterpolatorMapType s_InterpolatorForImage;
 
     Image::ConstPointer m_Segmentation;
     Image::ConstPointer m_ReferenceImage;
     bool m_BlockModified;
     bool m_2DInterpolationActivated;
+
+    unsigned long m_ModifiedObserverTag;
+    unsigned long m_SliceModifiedObserverTag;
   };
 
 } // namespace
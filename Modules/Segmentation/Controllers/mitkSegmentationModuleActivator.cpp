@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include <usModuleActivator.h>
 #include <usModuleContext.h>
 
+#include "mitkDiffSliceOperation.h"
 #include "mitkToolManagerProvider.h"
 
 namespace mitk
@@ -32,7 +33,12 @@ namespace mitk
       context->RegisterService<mitk::ToolManagerProvider>(m_ToolManagerProvider);
     }
 
-    void Unload(us::ModuleContext *) override {}
+    void Unload(us::ModuleContext *) override
+    {
+      // the compression thread must not outlive the module
+      mitk::DiffSliceOperation::ShutdownCompression();
+    }
+
   private:
     mitk::ToolManagerProvider::Pointer m_ToolManagerProvider;
   };
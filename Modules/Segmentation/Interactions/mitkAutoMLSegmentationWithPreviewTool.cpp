@@ -60,6 +60,7 @@ void mitk::AutoMLSegmentationWithPreviewTool::Activated()
   Superclass::Activated();
 
   m_SelectedLabels = {};
+  m_MLPreview = nullptr;
 
   m_MLPreviewNode = mitk::DataNode::New();
   m_MLPreviewNode->SetProperty("name", StringProperty::New(std::string(this->GetName()) + "ML preview"));
@@ -76,10 +77,47 @@ void mitk::AutoMLSegmentationWithPreviewTool::Deactivated()
   m_MLPreviewNode = nullptr;
 
   Superclass::Deactivated();
+
+  // reset after the superclass has stopped the preview computation
+  m_MLPreview = nullptr;
+}
+
+void mitk::AutoMLSegmentationWithPreviewTool::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+
+  m_PreviewSelectedLabels = m_SelectedLabels;
+  m_PreviewToolMTime = this->GetMTime();
+  m_PreviewTimePoint = mitk::RenderingManager::GetInstance()->GetTimeNavigationController()->GetSelectedTimePoint();
 }
 
 void mitk::AutoMLSegmentationWithPreviewTool::UpdateCleanUp()
 {
+  if (m_MLPreviewNode.IsNotNull() && m_MLPreview.IsNotNull() && m_MLPreviewNode->GetData() != m_MLPreview)
+  {
+    this->m_MLPreviewNode->SetData(m_MLPreview);
+    this->m_MLPreviewNode->SetProperty("binary", mitk::BoolProperty::New(false));
+    mitk::RenderingModeProperty::Pointer renderingMode = mitk::RenderingModeProperty::New();
+    renderingMode->SetValue(mitk::RenderingModeProperty::LOOKUPTABLE_LEVELWINDOW_COLOR);
+    this->m_MLPreviewNode->SetProperty("Image Rendering.Mode", renderingMode);
+    mitk::LookupTable::Pointer lut = mitk::LookupTable::New();
+    mitk::LookupTableProperty::Pointer prop = mitk::LookupTableProperty::New(lut);
+    vtkSmartPointer<vtkLookupTable> lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+    lookupTable->SetHueRange(1.0, 0.0);
+    lookupTable->SetSaturationRange(1.0, 1.0);
+    lookupTable->SetValueRange(1.0, 1.0);
+    lookupTable->SetTableRange(-1.0, 1.0);
+    lookupTable->Build();
+    lut->SetVtkLookupTable(lookupTable);
+    prop->SetLookupTable(lut);
+    this->m_MLPreviewNode->SetProperty("LookupTable", prop);
+    mitk::LevelWindowProperty::Pointer levWinProp = mitk::LevelWindowProperty::New();
+    mitk::LevelWindow levelwindow;
+    levelwindow.SetRangeMinMax(0, m_MLPreview->GetScalarValueMax());
+    levWinProp->SetLevelWindow(levelwindow);
+    this->m_MLPreviewNode->SetProperty("levelwindow", levWinProp);
+  }
+
   if (m_MLPreviewNode.IsNotNull())
     m_MLPreviewNode->SetVisibility(m_SelectedLabels.empty());
 
@@ -92,18 +130,23 @@ void mitk::AutoMLSegmentationWithPreviewTool::UpdateCleanUp()
   }
 }
 
-void mitk::AutoMLSegmentationWithPreviewTool::DoUpdatePreview(const Image* inputAtTimeStep, Image* previewImage, TimeStepType timeStep)
+bool mitk::AutoMLSegmentationWithPreviewTool::CanUpdatePreviewAsynchronously() const
 {
-  const auto timePoint = mitk::RenderingManager::GetInstance()->GetTimeNavigationController()->GetSelectedTimePoint();
+  return true;
+}
 
-  if (nullptr == m_MLPreviewNode->GetData()
-      || this->GetMTime() > m_MLPreviewNode->GetData()->GetMTime()
+void mitk::AutoMLSegmentationWithPreviewTool::DoUpdatePreview(const Image* inputAtTimeStep, Image* previewImage, TimeStepType timeStep)
+{
+  // Only members copied in UpdatePrepare() are used, because this function may be called in a worker thread.
+  // The new ML preview is passed to m_MLPreviewNode in UpdateCleanUp().
+  if (m_MLPreview.IsNull()
+      || m_PreviewToolMTime > m_MLPreview->GetMTime()
       || this->m_LastMLTimeStep != timeStep //this covers the case where dynamic
                                             //segmentations have to compute a preview
                                             //for all time steps on confirmation
-      || this->GetLastTimePointOfUpdate() != timePoint //this ensures that static seg
-                                                       //previews work with dynamic images
-                                                       //with avoiding unnecessary other computations
+      || this->GetLastTimePointOfUpdate() != m_PreviewTimePoint //this ensures that static seg
+                                                                //previews work with dynamic images
+                                                                //with avoiding unnecessary other computations
      )
   {
     if (nullptr == inputAtTimeStep)
@@ -118,37 +161,13 @@ void mitk::AutoMLSegmentationWithPreviewTool::DoUpdatePreview(const Image* input
 
     if (newMLPreview.IsNotNull())
     {
-      this->m_MLPreviewNode->SetData(newMLPreview);
-      this->m_MLPreviewNode->SetProperty("binary", mitk::BoolProperty::New(false));
-      mitk::RenderingModeProperty::Pointer renderingMode = mitk::RenderingModeProperty::New();
-      renderingMode->SetValue(mitk::RenderingModeProperty::LOOKUPTABLE_LEVELWINDOW_COLOR);
-      this->m_MLPreviewNode->SetProperty("Image Rendering.Mode", renderingMode);
-      mitk::LookupTable::Pointer lut = mitk::LookupTable::New();
-      mitk::LookupTableProperty::Pointer prop = mitk::LookupTableProperty::New(lut);
-      vtkSmartPointer<vtkLookupTable> lookupTable = vtkSmartPointer<vtkLookupTable>::New();
-      lookupTable->SetHueRange(1.0, 0.0);
-      lookupTable->SetSaturationRange(1.0, 1.0);
-      lookupTable->SetValueRange(1.0, 1.0);
-      lookupTable->SetTableRange(-1.0, 1.0);
-      lookupTable->Build();
-      lut->SetVtkLookupTable(lookupTable);
-      prop->SetLookupTable(lut);
-      this->m_MLPreviewNode->SetProperty("LookupTable", prop);
-      mitk::LevelWindowProperty::Pointer levWinProp = mitk::LevelWindowProperty::New();
-      mitk::LevelWindow levelwindow;
-      levelwindow.SetRangeMinMax(0, newMLPreview->GetScalarValueMax());
-      levWinProp->SetLevelWindow(levelwindow);
-      this->m_MLPreviewNode->SetProperty("levelwindow", levWinProp);
+      m_MLPreview = newMLPreview;
     }
   }
 
-  if (!m_SelectedLabels.empty())
+  if (!m_PreviewSelectedLabels.empty() && m_MLPreview.IsNotNull())
   {
-    const auto mlPreviewImage = this->GetMLPreview();
-    if (nullptr != mlPreviewImage)
-    {
-      AccessByItk_n(mlPreviewImage, CalculateMergedSimplePreview, (previewImage, timeStep));
-    }
+    AccessByItk_n(m_MLPreview.GetPointer(), CalculateMergedSimplePreview, (previewImage, timeStep));
   }
 }
 
@@ -166,8 +185,8 @@ void mitk::AutoMLSegmentationWithPreviewTool::CalculateMergedSimplePreview(const
   typename OutputImageType::Pointer itkBinaryResultImage;
 
   filter->SetInput(itkImage);
-  filter->SetLowerThreshold(m_SelectedLabels[0]);
-  filter->SetUpperThreshold(m_SelectedLabels[0]);
+  filter->SetLowerThreshold(m_PreviewSelectedLabels[0]);
+  filter->SetUpperThreshold(m_PreviewSelectedLabels[0]);
   filter->SetInsideValue(1);
   filter->SetOutsideValue(0);
   filter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
@@ -176,9 +195,9 @@ void mitk::AutoMLSegmentationWithPreviewTool::CalculateMergedSimplePreview(const
   itkBinaryResultImage->DisconnectPipeline();
 
   // if more than one region id is used compute the union of all given binary regions
-  for (const auto labelID : m_SelectedLabels)
+  for (const auto labelID : m_PreviewSelectedLabels)
   {
-    if (labelID != m_SelectedLabels[0])
+    if (labelID != m_PreviewSelectedLabels[0])
     {
       filter->SetLowerThreshold(labelID);
       filter->SetUpperThreshold(labelID);
@@ -50,16 +50,21 @@ namespace mitk
     AutoMLSegmentationWithPreviewTool();
     ~AutoMLSegmentationWithPreviewTool() = default;
 
+    void UpdatePrepare() override;
     void UpdateCleanUp() override;
     void DoUpdatePreview(const Image* inputAtTimeStep, Image* previewImage, TimeStepType timeStep) override;
 
+    bool CanUpdatePreviewAsynchronously() const override;
+
     /** Function to generate the new multi lable preview for a given time step input image.
      * The function must be implemented by derived tools.
      * This function is called by DoUpdatePreview if needed.
      * Reasons are:
      * - ML preview does not exist
      * - Modify time of tools is newer then of ML preview
-     * - ML preview was not generated for the current selected timestep of input image or for the current selected timepoint.*/
+     * - ML preview was not generated for the current selected timestep of input image or for the current selected timepoint.
+     * The function may be called in a worker thread (see CanUpdatePreviewAsynchronously()) and should
+     * therefore use the parameters copied in UpdatePrepare().*/
     virtual LabelSetImage::Pointer ComputeMLPreview(const Image* inputAtTimeStep, TimeStepType timeStep) = 0;
 
   private:
@@ -74,8 +79,15 @@ namespace mitk
 
     SelectedLabelVectorType m_SelectedLabels = {};
 
+    /** State of the tool copied in UpdatePrepare() for DoUpdatePreview() */
+    SelectedLabelVectorType m_PreviewSelectedLabels = {};
+    itk::ModifiedTimeType m_PreviewToolMTime = 0;
+    TimePointType m_PreviewTimePoint = 0.;
+
     // holds the multilabel result as a preview image
     mitk::DataNode::Pointer m_MLPreviewNode;
+    /** Multilabel result computed by DoUpdatePreview(), passed to m_MLPreviewNode in UpdateCleanUp()*/
+    LabelSetImage::Pointer m_MLPreview;
     TimeStepType m_LastMLTimeStep = 0;
   };
 }
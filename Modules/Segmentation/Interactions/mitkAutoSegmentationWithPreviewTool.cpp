@@ -18,19 +18,49 @@ found in the LICENSE file.
 #include "mitkLevelWindowProperty.h"
 #include "mitkProperties.h"
 
+#include "mitkBaseRenderer.h"
 #include "mitkDataStorage.h"
 #include "mitkRenderingManager.h"
 #include <mitkSliceNavigationController.h>
 
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkImageReadAccessor.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageTimeSelector.h"
+#include "mitkImageWriteAccessor.h"
 #include "mitkLabelSetImage.h"
 #include "mitkMaskAndCutRoiImageFilter.h"
 #include "mitkPadImageFilter.h"
 #include "mitkNodePredicateGeometry.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  const int PreviewProgressSteps = 200;
+
+  /** Region of the slice with the given index along dimension of a volume */
+  mitk::ImageAccessorBase::RegionType GetSliceRegion(const mitk::Image *image, unsigned int dimension, unsigned int index)
+  {
+    mitk::ImageAccessorBase::RegionType::IndexType regionIndex;
+    regionIndex.Fill(0);
+    regionIndex[dimension] = index;
+
+    mitk::ImageAccessorBase::RegionType::SizeType regionSize;
+    regionSize.Fill(1);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (i != dimension)
+        regionSize[i] = image->GetDimension(i);
+    }
+
+    return mitk::ImageAccessorBase::RegionType(regionIndex, regionSize);
+  }
+}
+
 mitk::AutoSegmentationWithPreviewTool::AutoSegmentationWithPreviewTool(bool lazyDynamicPreviews): m_LazyDynamicPreviews(lazyDynamicPreviews)
 {
   m_ProgressCommand = mitk::ToolCommand::New();
@@ -38,6 +68,9 @@ mitk::AutoSegmentationWithPreviewTool::AutoSegmentationWithPreviewTool(bool lazy
 
 mitk::AutoSegmentationWithPreviewTool::~AutoSegmentationWithPreviewTool()
 {
+  // The worker is already stopped by Deactivated() or SetAsynchronousPreview(false), because the
+  // derived tool, whose DoUpdatePreview() it calls, is already destroyed here.
+  this->StopPreviewThread();
 }
 
 bool mitk::AutoSegmentationWithPreviewTool::CanHandle(const BaseData* referenceData, const BaseData* workingData) const
@@ -101,6 +134,10 @@ void mitk::AutoSegmentationWithPreviewTool::Activated()
 
 void mitk::AutoSegmentationWithPreviewTool::Deactivated()
 {
+  // DoUpdatePreview() must not be running anymore when the tool is deactivated or destroyed
+  this->CancelPreview();
+  this->StopPreviewThread();
+
   m_ToolManager->RoiDataChanged -=
     mitk::MessageDelegate<mitk::AutoSegmentationWithPreviewTool>(this, &mitk::AutoSegmentationWithPreviewTool::OnRoiDataChanged);
 
@@ -139,6 +176,8 @@ void mitk::AutoSegmentationWithPreviewTool::ConfirmSegmentation()
     this->UpdatePreview(true);
   }
 
+  this->WaitForPreview();
+
   CreateResultSegmentationFromPreview();
 
   RenderingManager::GetInstance()->RequestUpdateAll();
@@ -401,11 +440,64 @@ void mitk::AutoSegmentationWithPreviewTool::OnTimePointChanged()
   }
 }
 
+void mitk::AutoSegmentationWithPreviewTool::SetAsynchronousPreview(bool asynchronousPreview)
+{
+  if (!asynchronousPreview)
+  {
+    // Afterwards the worker does not send AsynchronousPreviewUpdated anymore, so listeners may be removed
+    this->WaitForPreview();
+    this->StopPreviewThread();
+  }
+
+  m_AsynchronousPreview = asynchronousPreview;
+}
+
+bool mitk::AutoSegmentationWithPreviewTool::GetAsynchronousPreview() const
+{
+  return m_AsynchronousPreview;
+}
+
 void mitk::AutoSegmentationWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
+{
+  if (!m_AsynchronousPreview || !this->CanUpdatePreviewAsynchronously())
+  {
+    this->UpdatePreviewSynchronously(ignoreLazyPreviewSetting);
+    return;
+  }
+
+  if (m_PreviewUpdateActive)
+  {
+    // Requests during the computation are merged into one job that is started as soon as the
+    // running job, which is cancelled here, has stopped.
+    m_PreviewUpdateRequested = true;
+    m_RequestedIgnoreLazyPreviewSetting =
+      m_RequestedIgnoreLazyPreviewSetting || m_IgnoreLazyPreviewSetting || ignoreLazyPreviewSetting;
+
+    std::lock_guard<std::mutex> lock(m_PreviewMutex);
+    ++m_PreviewGeneration;
+    return;
+  }
+
+  if (nullptr == this->GetSegmentationInput() || nullptr == this->GetPreviewSegmentation())
+  {
+    this->UpdatePreviewSynchronously(ignoreLazyPreviewSetting);
+    return;
+  }
+
+  m_PreviewUpdateActive = true;
+  m_PreviewError.clear();
+
+  this->CurrentlyBusy.Send(true);
+  m_ProgressCommand->AddStepsToDo(PreviewProgressSteps);
+
+  this->StartPreviewJob(ignoreLazyPreviewSetting);
+}
+
+void mitk::AutoSegmentationWithPreviewTool::UpdatePreviewSynchronously(bool ignoreLazyPreviewSetting)
 {
   const auto inputImage = this->GetSegmentationInput();
   auto previewImage = this->GetPreviewSegmentation();
-  int progress_steps = 200;
+  int progress_steps = PreviewProgressSteps;
 
   this->CurrentlyBusy.Send(true);
 
@@ -460,6 +552,410 @@ void mitk::AutoSegmentationWithPreviewTool::UpdatePreview(bool ignoreLazyPreview
   CurrentlyBusy.Send(false);
 }
 
+void mitk::AutoSegmentationWithPreviewTool::StartPreviewJob(bool ignoreLazyPreviewSetting)
+{
+  this->UpdatePrepare();
+
+  m_TimePointOfPreviewUpdate =
+    mitk::RenderingManager::GetInstance()->GetTimeNavigationController()->GetSelectedTimePoint();
+  m_IgnoreLazyPreviewSetting = ignoreLazyPreviewSetting;
+
+  const auto inputImage = this->GetSegmentationInput();
+  const auto previewImage = this->GetPreviewSegmentation();
+
+  if (nullptr == inputImage || nullptr == previewImage)
+  {
+    this->FinishPreviewUpdate();
+    return;
+  }
+
+  // The job works on a snapshot, the computed time steps are transferred into the preview by ApplyAsynchronousPreview()
+  std::unique_ptr<PreviewJob> job(new PreviewJob);
+  job->input = inputImage;
+  job->staging = Image::New();
+  job->staging->Initialize(previewImage);
+  job->allTimeSteps = previewImage->GetTimeSteps() > 1 && (ignoreLazyPreviewSetting || !m_LazyDynamicPreviews);
+  job->timePoint = m_TimePointOfPreviewUpdate;
+  job->timeStep = previewImage->GetTimeGeometry()->TimePointToTimeStep(m_TimePointOfPreviewUpdate);
+
+  if (this->IsPreviewPixelWise())
+    job->slices = this->GetVisibleSlices(inputImage, previewImage, m_TimePointOfPreviewUpdate);
+
+  {
+    std::lock_guard<std::mutex> lock(m_PreviewMutex);
+    job->generation = ++m_PreviewGeneration;
+    m_PendingPreviewJob = std::move(job);
+
+    if (!m_PreviewThread.joinable())
+      m_PreviewThread = std::thread(&AutoSegmentationWithPreviewTool::RunPreviewThread, this);
+  }
+  m_PreviewJobChanged.notify_all();
+}
+
+std::vector<std::pair<unsigned int, unsigned int>> mitk::AutoSegmentationWithPreviewTool::GetVisibleSlices(
+  const Image *inputImage, const Image *previewImage, TimePointType timePoint) const
+{
+  std::vector<std::pair<unsigned int, unsigned int>> slices;
+
+  // Slices can only be transferred if the input is not cropped by a ROI
+  if (inputImage->GetDimension() < 3 || !inputImage->GetTimeGeometry()->IsValidTimePoint(timePoint))
+    return slices;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (inputImage->GetDimension(i) != previewImage->GetDimension(i))
+      return slices;
+  }
+
+  const auto geometry = inputImage->GetTimeGeometry()->GetGeometryForTimePoint(timePoint);
+
+  for (const auto &renderer : BaseRenderer::baseRendererMap)
+  {
+    if (renderer.second->GetMapperID() != BaseRenderer::Standard2D)
+      continue;
+
+    const PlaneGeometry *planeGeometry = renderer.second->GetCurrentWorldPlaneGeometry();
+    if (nullptr == planeGeometry)
+      continue;
+
+    Vector3D normal = planeGeometry->GetNormal();
+    normal.Normalize();
+
+    for (unsigned int dimension = 0; dimension < 3; ++dimension)
+    {
+      Vector3D axis = geometry->GetAxisVector(dimension);
+      axis.Normalize();
+
+      // Only slices that are aligned with the voxel grid are computed in advance
+      if (std::abs(std::abs(normal * axis) - 1.0) > sqrteps)
+        continue;
+
+      itk::Index<3> index;
+      geometry->WorldToIndex(planeGeometry->GetCenter(), index);
+
+      if (index[dimension] >= 0 && index[dimension] < static_cast<itk::IndexValueType>(inputImage->GetDimension(dimension)))
+      {
+        const std::pair<unsigned int, unsigned int> slice(dimension, static_cast<unsigned int>(index[dimension]));
+        if (std::find(slices.begin(), slices.end(), slice) == slices.end())
+          slices.push_back(slice);
+      }
+
+      break;
+    }
+  }
+
+  return slices;
+}
+
+void mitk::AutoSegmentationWithPreviewTool::RunPreviewThread()
+{
+  std::unique_lock<std::mutex> lock(m_PreviewMutex);
+
+  while (true)
+  {
+    m_PreviewJobChanged.wait(lock, [this]() { return m_StopPreviewThread || m_PendingPreviewJob; });
+
+    if (m_StopPreviewThread)
+      return;
+
+    std::unique_ptr<PreviewJob> job = std::move(m_PendingPreviewJob);
+    m_PreviewJobRunning = true;
+    lock.unlock();
+
+    PreviewResult errorResult;
+    errorResult.generation = job->generation;
+
+    try
+    {
+      this->ExecutePreviewJob(*job);
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      errorResult.error = e.GetDescription();
+    }
+    catch (const std::exception &e)
+    {
+      errorResult.error = e.what();
+    }
+    catch (...)
+    {
+      errorResult.error = "Unknown error while computing the preview.";
+    }
+
+    if (!errorResult.error.empty())
+      this->PublishPreviewResult(errorResult);
+
+    job.reset();
+
+    // Sent before the job is marked as finished, so that waiting for the worker (e.g. before a listener
+    // is removed) includes the notification
+    this->AsynchronousPreviewUpdated.Send();
+
+    lock.lock();
+    m_PreviewJobRunning = false;
+    m_PreviewJobChanged.notify_all();
+  }
+}
+
+void mitk::AutoSegmentationWithPreviewTool::ExecutePreviewJob(const PreviewJob &job)
+{
+  if (!job.slices.empty())
+  {
+    // The visible slices are computed first for an instant feedback
+    const auto inputImage = this->GetImageByTimePoint(job.input, job.timePoint);
+
+    for (const auto &slice : job.slices)
+    {
+      if (this->IsSuperseded(job))
+        return;
+
+      PreviewResult result;
+      result.generation = job.generation;
+      result.image = this->ComputePreviewSlice(inputImage, job.staging->GetPixelType(), slice.first, slice.second);
+      result.timeSteps.push_back(job.timeStep);
+      result.sliceDimension = static_cast<int>(slice.first);
+      result.sliceIndex = slice.second;
+
+      if (this->PublishPreviewResult(result))
+        this->AsynchronousPreviewUpdated.Send();
+    }
+  }
+
+  PreviewResult result;
+  result.generation = job.generation;
+  result.image = job.staging;
+
+  if (job.allTimeSteps)
+  {
+    for (unsigned int timeStep = 0; timeStep < job.input->GetTimeSteps(); ++timeStep)
+    {
+      if (this->IsSuperseded(job))
+        return;
+
+      auto feedBackImage3D = this->GetImageByTimeStep(job.input, timeStep);
+
+      this->DoUpdatePreview(feedBackImage3D, job.staging, timeStep);
+      result.timeSteps.push_back(timeStep);
+    }
+  }
+  else
+  {
+    if (this->IsSuperseded(job))
+      return;
+
+    auto feedBackImage3D = this->GetImageByTimePoint(job.input, job.timePoint);
+
+    this->DoUpdatePreview(feedBackImage3D, job.staging, job.timeStep);
+    result.timeSteps.push_back(job.timeStep);
+  }
+
+  this->PublishPreviewResult(result);
+}
+
+mitk::Image::Pointer mitk::AutoSegmentationWithPreviewTool::ComputePreviewSlice(const Image *inputImage,
+                                                                                 const PixelType &previewPixelType,
+                                                                                 unsigned int dimension,
+                                                                                 unsigned int index)
+{
+  const auto region = GetSliceRegion(inputImage, dimension, index);
+
+  unsigned int dimensions[3];
+  for (unsigned int i = 0; i < 3; ++i)
+    dimensions[i] = static_cast<unsigned int>(region.GetSize(i));
+
+  auto inputSlice = Image::New();
+  inputSlice->Initialize(inputImage->GetPixelType(), 3, dimensions);
+
+  {
+    ImageReadAccessor accessor(inputImage, region, nullptr, ImageAccessorBase::ForceCoherentMemory);
+    inputSlice->SetVolume(accessor.GetData());
+  }
+
+  auto slice = Image::New();
+  slice->Initialize(previewPixelType, 3, dimensions);
+
+  this->DoUpdatePreview(inputSlice, slice, 0);
+
+  return slice;
+}
+
+bool mitk::AutoSegmentationWithPreviewTool::IsSuperseded(const PreviewJob &job) const
+{
+  std::lock_guard<std::mutex> lock(m_PreviewMutex);
+  return job.generation != m_PreviewGeneration;
+}
+
+bool mitk::AutoSegmentationWithPreviewTool::PublishPreviewResult(const PreviewResult &result)
+{
+  std::lock_guard<std::mutex> lock(m_PreviewMutex);
+  if (result.generation != m_PreviewGeneration)
+    return false;
+
+  m_PreviewResults.push_back(result);
+  return true;
+}
+
+void mitk::AutoSegmentationWithPreviewTool::ApplyAsynchronousPreview()
+{
+  if (!m_PreviewUpdateActive)
+    return;
+
+  std::vector<PreviewResult> results;
+  bool jobDone = false;
+  unsigned long generation = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_PreviewMutex);
+    results.swap(m_PreviewResults);
+    jobDone = !m_PendingPreviewJob && !m_PreviewJobRunning;
+    generation = m_PreviewGeneration;
+  }
+
+  auto previewImage = this->GetPreviewSegmentation();
+  bool previewChanged = false;
+
+  for (const auto &result : results)
+  {
+    if (result.generation != generation)
+      continue;
+
+    if (!result.error.empty())
+    {
+      m_PreviewError = result.error;
+      continue;
+    }
+
+    if (nullptr == previewImage)
+      continue;
+
+    try
+    {
+      if (result.sliceDimension >= 0)
+      {
+        if (!result.image->IsVolumeSet(0))
+          continue;
+
+        const auto timeStep = result.timeSteps.front();
+        const auto region = GetSliceRegion(previewImage, result.sliceDimension, result.sliceIndex);
+
+        ImageReadAccessor sliceAccessor(result.image.GetPointer());
+        ImageWriteAccessor previewAccessor(
+          previewImage, region, previewImage->GetVolumeData(timeStep), ImageAccessorBase::ForceCoherentMemory);
+
+        std::memcpy(previewAccessor.GetData(),
+                    sliceAccessor.GetData(),
+                    region.GetNumberOfPixels() * previewImage->GetPixelType().GetSize());
+        previewImage->Modified();
+      }
+      else
+      {
+        for (const auto timeStep : result.timeSteps)
+        {
+          if (!result.image->IsVolumeSet(timeStep))
+            continue;
+
+          ImageReadAccessor accessor(result.image.GetPointer(), result.image->GetVolumeData(timeStep));
+          previewImage->SetVolume(accessor.GetData(), timeStep);
+        }
+      }
+
+      previewChanged = true;
+    }
+    catch (const mitk::Exception &e)
+    {
+      m_PreviewError = e.GetDescription();
+    }
+  }
+
+  if (previewChanged)
+    RenderingManager::GetInstance()->RequestUpdateAll();
+
+  if (!jobDone)
+    return;
+
+  if (m_PreviewUpdateRequested)
+  {
+    const bool ignoreLazyPreviewSetting = m_RequestedIgnoreLazyPreviewSetting;
+    m_PreviewUpdateRequested = false;
+    m_RequestedIgnoreLazyPreviewSetting = false;
+
+    this->StartPreviewJob(ignoreLazyPreviewSetting);
+    return;
+  }
+
+  this->FinishPreviewUpdate();
+}
+
+void mitk::AutoSegmentationWithPreviewTool::FinishPreviewUpdate()
+{
+  this->UpdateCleanUp();
+  m_LastTimePointOfUpdate = m_TimePointOfPreviewUpdate;
+  m_PreviewUpdateActive = false;
+
+  m_ProgressCommand->SetProgress(PreviewProgressSteps);
+  CurrentlyBusy.Send(false);
+
+  if (!m_PreviewError.empty())
+  {
+    MITK_ERROR << "Exception caught: " << m_PreviewError;
+    ErrorMessage.Send(m_PreviewError);
+  }
+}
+
+void mitk::AutoSegmentationWithPreviewTool::WaitForPreview()
+{
+  while (m_PreviewUpdateActive)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_PreviewMutex);
+      m_PreviewJobChanged.wait(lock, [this]() { return !m_PendingPreviewJob && !m_PreviewJobRunning; });
+    }
+
+    this->ApplyAsynchronousPreview();
+  }
+}
+
+void mitk::AutoSegmentationWithPreviewTool::CancelPreview()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_PreviewMutex);
+    ++m_PreviewGeneration;
+    m_PendingPreviewJob.reset();
+
+    // A running DoUpdatePreview() cannot be interrupted, the job stops afterwards
+    m_PreviewJobChanged.wait(lock, [this]() { return !m_PreviewJobRunning; });
+    m_PreviewResults.clear();
+  }
+
+  if (m_PreviewUpdateActive)
+  {
+    m_PreviewUpdateActive = false;
+    m_PreviewUpdateRequested = false;
+    m_RequestedIgnoreLazyPreviewSetting = false;
+
+    m_ProgressCommand->SetProgress(PreviewProgressSteps);
+    CurrentlyBusy.Send(false);
+  }
+}
+
+void mitk::AutoSegmentationWithPreviewTool::StopPreviewThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_PreviewMutex);
+    ++m_PreviewGeneration;
+    m_PendingPreviewJob.reset();
+    m_StopPreviewThread = true;
+  }
+  m_PreviewJobChanged.notify_all();
+
+  if (m_PreviewThread.joinable())
+    m_PreviewThread.join();
+
+  // StartPreviewJob() starts a new worker if needed
+  std::lock_guard<std::mutex> lock(m_PreviewMutex);
+  m_StopPreviewThread = false;
+}
+
 void mitk::AutoSegmentationWithPreviewTool::UpdatePrepare()
 {
   // default implementation does nothing
@@ -472,6 +968,16 @@ void mitk::AutoSegmentationWithPreviewTool::UpdateCleanUp()
   //reimplement in derived classes for special behavior
 }
 
+bool mitk::AutoSegmentationWithPreviewTool::CanUpdatePreviewAsynchronously() const
+{
+  return false;
+}
+
+bool mitk::AutoSegmentationWithPreviewTool::IsPreviewPixelWise() const
+{
+  return false;
+}
+
 mitk::TimePointType mitk::AutoSegmentationWithPreviewTool::GetLastTimePointOfUpdate() const
 {
   return m_LastTimePointOfUpdate;
@@ -19,6 +19,13 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include <MitkSegmentationExports.h>
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -31,6 +38,15 @@ namespace mitk
   This class also takes care to properly transfer a confirmed preview into the segementation
   result.
 
+  If the asynchronous preview is enabled and the tool supports it (see CanUpdatePreviewAsynchronously()),
+  UpdatePreview() returns immediately and DoUpdatePreview() is called in a worker thread on a snapshot
+  of the input. Requests that arrive while the preview is computed cancel the running computation at the
+  next time step and are merged into a single new computation. Tools that compute the preview pixel
+  by pixel (see IsPreviewPixelWise()) first compute the slices that are currently shown by the 2D render
+  windows and then the complete volume. The worker sends AsynchronousPreviewUpdated whenever new results
+  are available; ApplyAsynchronousPreview() has to be called in reaction from the GUI thread to transfer
+  them into the preview. QmitkToolGUI enables the asynchronous preview and takes care of that.
+
   \ingroup ToolManagerEtAl
   \sa mitk::Tool
   \sa QmitkInteractiveSegmentation
@@ -69,6 +85,23 @@ namespace mitk
      * reimplement UpdatePrepare() or UpdateCleanUp().*/
     void UpdatePreview(bool ignoreLazyPreviewSetting = false);
 
+    /** Indicates if UpdatePreview() computes the preview in a worker thread (if supported by the tool).
+     * Disabled by default, because ApplyAsynchronousPreview() has to be called from the GUI thread.
+     * Disabling completes a running computation and stops the worker thread, so AsynchronousPreviewUpdated
+     * is not sent anymore afterwards.*/
+    void SetAsynchronousPreview(bool asynchronousPreview);
+    bool GetAsynchronousPreview() const;
+
+    /** Sent from the worker thread if results of an asynchronous preview computation are available.*/
+    Message<> AsynchronousPreviewUpdated;
+
+    /** Transfers the available results of the asynchronous preview computation into the preview and
+     * finishes the update of the preview if the computation is done. Has to be called from the GUI thread.*/
+    void ApplyAsynchronousPreview();
+
+    /** Blocks until a running asynchronous preview computation (including merged requests) is done and applied.*/
+    void WaitForPreview();
+
   protected:
     mitk::ToolCommand::Pointer m_ProgressCommand;
 
@@ -79,9 +112,21 @@ namespace mitk
      */
     virtual void InitiateToolByInput();
 
+    /** Called on the GUI thread before the preview is computed. Derived classes should copy the parameters
+     * that are used by DoUpdatePreview() here, because they may be changed while an asynchronous
+     * computation is running.*/
     virtual void UpdatePrepare();
     virtual void UpdateCleanUp();
 
+    /** Returns if DoUpdatePreview() may be called in a worker thread. It must then only depend on the
+     * parameters copied in UpdatePrepare() and must not access data nodes or render windows.
+     * Default implementation returns false.*/
+    virtual bool CanUpdatePreviewAsynchronously() const;
+
+    /** Returns if each pixel of the preview only depends on the corresponding input pixel, so that
+     * DoUpdatePreview() can be used to compute single slices. Default implementation returns false.*/
+    virtual bool IsPreviewPixelWise() const;
+
     /** This function does the real work. Here the preview for a given
      * input image should be computed and stored in the also passed
      * preview image at the passed time step.
@@ -113,6 +158,53 @@ namespace mitk
     TimePointType GetLastTimePointOfUpdate() const;
 
   private:
+    /** Asynchronous computation of the preview, created by StartPreviewJob() */
+    struct PreviewJob
+    {
+      Image::ConstPointer input;
+      /** Receives the computed time steps, initialized like the preview */
+      Image::Pointer staging;
+      /** Indicates if all time steps are computed or only the one of timePoint */
+      bool allTimeSteps = false;
+      TimePointType timePoint = 0.;
+      /** Time step of the preview at timePoint */
+      TimeStepType timeStep = 0;
+      /** Visible slices (dimension, index) at timePoint that are computed first */
+      std::vector<std::pair<unsigned int, unsigned int>> slices;
+      unsigned long generation = 0;
+    };
+
+    /** Result of a preview job: a slice, the staging image of the computed time steps or an error */
+    struct PreviewResult
+    {
+      unsigned long generation = 0;
+      Image::Pointer image;
+      std::vector<TimeStepType> timeSteps;
+      int sliceDimension = -1;
+      unsigned int sliceIndex = 0;
+      std::string error;
+    };
+
+    void UpdatePreviewSynchronously(bool ignoreLazyPreviewSetting);
+    void StartPreviewJob(bool ignoreLazyPreviewSetting);
+    void FinishPreviewUpdate();
+    void CancelPreview();
+    /** Stops and joins the worker thread. Called by Deactivated(), before derived tools are destroyed.*/
+    void StopPreviewThread();
+
+    std::vector<std::pair<unsigned int, unsigned int>> GetVisibleSlices(const Image *inputImage,
+                                                                        const Image *previewImage,
+                                                                        TimePointType timePoint) const;
+
+    void RunPreviewThread();
+    void ExecutePreviewJob(const PreviewJob &job);
+    Image::Pointer ComputePreviewSlice(const Image *inputImage,
+                                       const PixelType &previewPixelType,
+                                       unsigned int dimension,
+                                       unsigned int index);
+    bool IsSuperseded(const PreviewJob &job) const;
+    bool PublishPreviewResult(const PreviewResult &result);
+
     void TransferImageAtTimeStep(const Image* sourceImage, Image* destinationImage, const TimeStepType timeStep);
 
     void CreateResultSegmentationFromPreview();
@@ -145,6 +237,26 @@ namespace mitk
     bool m_IsTimePointChangeAware = true;
 
     TimePointType m_LastTimePointOfUpdate = 0.;
+
+    bool m_AsynchronousPreview = false;
+
+    /** State of the asynchronous update, only used on the GUI thread. An update lasts from the first
+     * UpdatePrepare() to UpdateCleanUp() and includes a further job for each merge of requests.*/
+    bool m_PreviewUpdateActive = false;
+    bool m_PreviewUpdateRequested = false;
+    bool m_RequestedIgnoreLazyPreviewSetting = false;
+    bool m_IgnoreLazyPreviewSetting = false;
+    TimePointType m_TimePointOfPreviewUpdate = 0.;
+    std::string m_PreviewError;
+
+    std::thread m_PreviewThread;
+    mutable std::mutex m_PreviewMutex;
+    std::condition_variable m_PreviewJobChanged;
+    std::unique_ptr<PreviewJob> m_PendingPreviewJob;
+    bool m_PreviewJobRunning = false;
+    bool m_StopPreviewThread = false;
+    unsigned long m_PreviewGeneration = 0;
+    std::vector<PreviewResult> m_PreviewResults;
   };
 
 } // namespace
@@ -23,7 +23,9 @@ mitk::BinaryThresholdBaseTool::BinaryThresholdBaseTool()
   : m_SensibleMinimumThresholdValue(-100),
     m_SensibleMaximumThresholdValue(+100),
     m_CurrentLowerThresholdValue(1),
-    m_CurrentUpperThresholdValue(1)
+    m_CurrentUpperThresholdValue(1),
+    m_PreviewLowerThresholdValue(1),
+    m_PreviewUpperThresholdValue(1)
 {
 }
 
@@ -93,6 +95,14 @@ void mitk::BinaryThresholdBaseTool::InitiateToolByInput()
   }
 }
 
+void mitk::BinaryThresholdBaseTool::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+
+  m_PreviewLowerThresholdValue = m_CurrentLowerThresholdValue;
+  m_PreviewUpperThresholdValue = m_CurrentUpperThresholdValue;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 static void ITKThresholding(const itk::Image<TPixel, VImageDimension> *originalImage,
                             mitk::Image *segmentation,
@@ -121,6 +131,16 @@ void mitk::BinaryThresholdBaseTool::DoUpdatePreview(const Image* inputAtTimeStep
   {
       AccessByItk_n(inputAtTimeStep,
         ITKThresholding,
-        (previewImage, m_CurrentLowerThresholdValue, m_CurrentUpperThresholdValue, timeStep));
+        (previewImage, m_PreviewLowerThresholdValue, m_PreviewUpperThresholdValue, timeStep));
   }
 }
+
+bool mitk::BinaryThresholdBaseTool::CanUpdatePreviewAsynchronously() const
+{
+  return true;
+}
+
+bool mitk::BinaryThresholdBaseTool::IsPreviewPixelWise() const
+{
+  return true;
+}
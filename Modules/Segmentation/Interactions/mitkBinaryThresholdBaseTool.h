@@ -52,14 +52,22 @@ namespace mitk
     itkGetMacro(SensibleMaximumThresholdValue, ScalarType);
 
     void InitiateToolByInput() override;
+    void UpdatePrepare() override;
     void DoUpdatePreview(const Image* inputAtTimeStep, Image* previewImage, TimeStepType timeStep) override;
 
+    bool CanUpdatePreviewAsynchronously() const override;
+    bool IsPreviewPixelWise() const override;
+
   private:
     ScalarType m_SensibleMinimumThresholdValue;
     ScalarType m_SensibleMaximumThresholdValue;
     ScalarType m_CurrentLowerThresholdValue;
     ScalarType m_CurrentUpperThresholdValue;
 
+    /** Threshold values used by DoUpdatePreview(), copied in UpdatePrepare() */
+    ScalarType m_PreviewLowerThresholdValue;
+    ScalarType m_PreviewUpperThresholdValue;
+
     /** Indicates if the tool should behave like a single threshold tool (true)
       or like a upper/lower threshold tool (false)*/
     bool m_LockedUpperThreshold = false;
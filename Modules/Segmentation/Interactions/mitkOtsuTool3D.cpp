@@ -53,14 +53,23 @@ const char* mitk::OtsuTool3D::GetName() const
   return "Otsu";
 }
 
+void mitk::OtsuTool3D::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+
+  m_PreviewNumberOfBins = m_NumberOfBins;
+  m_PreviewNumberOfRegions = m_NumberOfRegions;
+  m_PreviewUseValley = m_UseValley;
+}
+
 mitk::LabelSetImage::Pointer mitk::OtsuTool3D::ComputeMLPreview(const Image* inputAtTimeStep, TimeStepType /*timeStep*/)
 {
-  int numberOfThresholds = m_NumberOfRegions - 1;
+  int numberOfThresholds = m_PreviewNumberOfRegions - 1;
 
   mitk::OtsuSegmentationFilter::Pointer otsuFilter = mitk::OtsuSegmentationFilter::New();
   otsuFilter->SetNumberOfThresholds(numberOfThresholds);
-  otsuFilter->SetValleyEmphasis(m_UseValley);
-  otsuFilter->SetNumberOfBins(m_NumberOfBins);
+  otsuFilter->SetValleyEmphasis(m_PreviewUseValley);
+  otsuFilter->SetNumberOfBins(m_PreviewNumberOfBins);
   otsuFilter->SetInput(inputAtTimeStep);
   otsuFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
 
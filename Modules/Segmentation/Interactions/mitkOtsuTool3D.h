@@ -54,11 +54,17 @@ namespace mitk
     OtsuTool3D() = default;
     ~OtsuTool3D() = default;
 
+    void UpdatePrepare() override;
     LabelSetImage::Pointer ComputeMLPreview(const Image* inputAtTimeStep, TimeStepType timeStep) override;
 
     unsigned int m_NumberOfBins = 128;
     unsigned int m_NumberOfRegions = 2;
     bool m_UseValley = false;
+
+    /** Parameters used by ComputeMLPreview(), copied in UpdatePrepare() */
+    unsigned int m_PreviewNumberOfBins = 128;
+    unsigned int m_PreviewNumberOfRegions = 2;
+    bool m_PreviewUseValley = false;
   }; // class
 } // namespace
 #endif
@@ -33,6 +33,8 @@ found in the LICENSE file.
 // Includes for 3DSurfaceInterpolation
 #include "mitkImageTimeSelector.h"
 #include "mitkImageToContourFilter.h"
+#include "mitkSegmentationInterpolationController.h"
+#include "mitkSegmentationSliceModifiedEvent.h"
 #include "mitkSurfaceInterpolationController.h"
 
 // includes for resling and overwriting
@@ -51,9 +53,227 @@ found in the LICENSE file.
 #include "mitkImageCast.h"
 #include "mitkImageToItk.h"
 #include "mitkLabelSetImage.h"
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkParallelFor.h>
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <set>
 
 #define ROUND(a) ((a) > 0 ? (int)((a) + 0.5) : -(int)(0.5 - (a)))
 
+namespace
+{
+  /// Copying fewer pixels per thread does not outweigh the cost of starting it, e.g. for the small slices of a
+  /// single interpolation. The copy is bound by memory bandwidth anyway.
+  const std::size_t MinimumNumberOfPixelsPerThread = 256 * 256;
+  const unsigned int MaximumNumberOfCopyThreads = 4;
+
+  /// Maps the pixel (u, v) of a slice to the voxel origin + u * uStep + v * vStep of the volume
+  struct SliceToVolumeMapping
+  {
+    int origin[3];
+    int uStep[3];
+    int vStep[3];
+    int normalAxis;
+  };
+
+  /// Derives the mapping from the geometry of the slice. Fails if the slice is not aligned with the voxel grid
+  /// of the volume, does not lie within its plane or exceeds the volume.
+  bool ComputeSliceToVolumeMapping(const mitk::Image *volume,
+                                   const mitk::SegTool2D::SliceInformation &sliceInfo,
+                                   SliceToVolumeMapping &mapping)
+  {
+    const mitk::Image *slice = sliceInfo.slice;
+    if (slice == nullptr || sliceInfo.plane == nullptr || volume->GetDimension() < 3 ||
+        sliceInfo.timestep >= volume->GetTimeSteps() || !(slice->GetPixelType() == volume->GetPixelType()))
+      return false;
+
+    const mitk::BaseGeometry *sliceGeometry = slice->GetGeometry();
+    const mitk::BaseGeometry *volumeGeometry = volume->GetTimeGeometry()->GetGeometryForTimeStep(sliceInfo.timestep);
+
+    // volume indices of the slice pixels (0, 0), (1, 0) and (0, 1)
+    mitk::Point3D sliceIndex, sliceOrigin, volumeIndex[3];
+    for (unsigned int p = 0; p < 3; ++p)
+    {
+      mitk::Point3D world;
+      sliceIndex.Fill(0);
+      if (p > 0)
+        sliceIndex[p - 1] = 1;
+      sliceGeometry->IndexToWorld(sliceIndex, world);
+      volumeGeometry->WorldToIndex(world, volumeIndex[p]);
+      if (p == 0)
+        sliceOrigin = world;
+    }
+
+    mapping.normalAxis = -1;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const double continuous[3] = {
+        volumeIndex[0][i], volumeIndex[1][i] - volumeIndex[0][i], volumeIndex[2][i] - volumeIndex[0][i]};
+      int *discrete[3] = {&mapping.origin[i], &mapping.uStep[i], &mapping.vStep[i]};
+      for (unsigned int p = 0; p < 3; ++p)
+      {
+        *discrete[p] = ROUND(continuous[p]);
+        if (std::abs(continuous[p] - *discrete[p]) > 0.01)
+          return false;
+      }
+
+      if (mapping.uStep[i] == 0 && mapping.vStep[i] == 0)
+        mapping.normalAxis = i;
+    }
+
+    // both slice axes have to advance by one voxel along two different volume axes
+    int uLength = 0, vLength = 0, dot = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      uLength += std::abs(mapping.uStep[i]);
+      vLength += std::abs(mapping.vStep[i]);
+      dot += mapping.uStep[i] * mapping.vStep[i];
+    }
+    if (mapping.normalAxis < 0 || uLength != 1 || vLength != 1 || dot != 0)
+      return false;
+
+    if (sliceInfo.plane->DistanceFromPlane(sliceOrigin) > 0.5 * volumeGeometry->GetSpacing()[mapping.normalAxis])
+      return false;
+
+    // the mapping is affine, so the slice lies within the volume if its corners do
+    const int width = slice->GetDimension(0);
+    const int height = slice->GetDimension(1);
+    for (int corner = 0; corner < 4; ++corner)
+    {
+      const int u = (corner & 1) ? width - 1 : 0;
+      const int v = (corner & 2) ? height - 1 : 0;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        const int index = mapping.origin[i] + u * mapping.uStep[i] + v * mapping.vStep[i];
+        if (index < 0 || index >= static_cast<int>(volume->GetDimension(i)))
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /// Computes the mappings of all slices, if they can be written concurrently, i.e. all of them are aligned with
+  /// the voxel grid, have the same orientation and no two of them write to the same voxels.
+  bool ComputeConcurrentSliceMappings(const mitk::Image *volume,
+                                      const std::vector<mitk::SegTool2D::SliceInformation> &sliceList,
+                                      std::vector<SliceToVolumeMapping> &mappings)
+  {
+    std::set<std::pair<unsigned int, int>> writtenSlices;
+    mappings.resize(sliceList.size());
+
+    for (std::size_t i = 0; i < sliceList.size(); ++i)
+    {
+      if (!ComputeSliceToVolumeMapping(volume, sliceList[i], mappings[i]) ||
+          mappings[i].normalAxis != mappings[0].normalAxis)
+        return false;
+
+      if (!writtenSlices.emplace(sliceList[i].timestep, mappings[i].origin[mappings[i].normalAxis]).second)
+        return false;
+    }
+
+    return true;
+  }
+
+  /// Copies the slices into the volume in parallel and keeps the overwritten content in originalSlices
+  void CopySlicesIntoVolume(mitk::Image *volume,
+                            const std::vector<mitk::SegTool2D::SliceInformation> &sliceList,
+                            const std::vector<SliceToVolumeMapping> &mappings,
+                            std::vector<mitk::Image::Pointer> &originalSlices)
+  {
+    // all accessors are acquired up front, the threads only copy memory
+    std::vector<std::unique_ptr<mitk::ImageReadAccessor>> sliceAccessors;
+    std::vector<std::unique_ptr<mitk::ImageWriteAccessor>> originalAccessors;
+    for (const auto &sliceInfo : sliceList)
+    {
+      auto originalSlice = mitk::Image::New();
+      originalSlice->Initialize(sliceInfo.slice);
+      originalSlices.push_back(originalSlice);
+
+      sliceAccessors.emplace_back(new mitk::ImageReadAccessor(sliceInfo.slice));
+      originalAccessors.emplace_back(new mitk::ImageWriteAccessor(originalSlice));
+    }
+
+    mitk::ImageWriteAccessor volumeAccessor(volume);
+    auto *volumeData = static_cast<char *>(volumeAccessor.GetData());
+
+    const std::size_t pixelSize = volume->GetPixelType().GetSize();
+    const std::size_t strides[3] = {pixelSize,
+                                    pixelSize * volume->GetDimension(0),
+                                    pixelSize * volume->GetDimension(0) * volume->GetDimension(1)};
+    const std::size_t volumeSize = strides[2] * volume->GetDimension(2);
+
+    std::size_t numberOfPixels = 0;
+    for (const auto &sliceInfo : sliceList)
+      numberOfPixels += static_cast<std::size_t>(sliceInfo.slice->GetDimension(0)) * sliceInfo.slice->GetDimension(1);
+
+    const auto numberOfThreads = static_cast<unsigned int>(std::max<std::size_t>(
+      1,
+      std::min<std::size_t>({numberOfPixels / MinimumNumberOfPixelsPerThread,
+                             MaximumNumberOfCopyThreads,
+                             itk::MultiThreader::GetGlobalDefaultNumberOfThreads()})));
+
+    mitk::ParallelFor(sliceList.size(), [&](std::size_t i) {
+      const SliceToVolumeMapping &mapping = mappings[i];
+      const auto *slice = static_cast<const char *>(sliceAccessors[i]->GetData());
+      auto *originalSlice = static_cast<char *>(originalAccessors[i]->GetData());
+      char *timeStepData = volumeData + sliceList[i].timestep * volumeSize;
+
+      const unsigned int width = sliceList[i].slice->GetDimension(0);
+      const unsigned int height = sliceList[i].slice->GetDimension(1);
+      std::size_t sliceOffset = 0;
+
+      for (unsigned int v = 0; v < height; ++v)
+      {
+        for (unsigned int u = 0; u < width; ++u, sliceOffset += pixelSize)
+        {
+          std::size_t volumeOffset = 0;
+          for (unsigned int d = 0; d < 3; ++d)
+            volumeOffset += (mapping.origin[d] + u * mapping.uStep[d] + v * mapping.vStep[d]) * strides[d];
+
+          std::memcpy(originalSlice + sliceOffset, timeStepData + volumeOffset, pixelSize);
+          std::memcpy(timeStepData + volumeOffset, slice + sliceOffset, pixelSize);
+        }
+      }
+    }, numberOfThreads);
+  }
+
+  /// Overwrites the part of the volume cut by the plane of the slice, using the same reslicing as the extraction.
+  /// Returns the written slice.
+  mitk::Image::Pointer OverwriteSliceByReslicing(mitk::Image *volume,
+                                                 const mitk::SegTool2D::SliceInformation &sliceInfo)
+  {
+    // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
+    // reslicer
+    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+    // Set the slice as 'input'
+    reslice->SetInputSlice(sliceInfo.slice->GetVtkImageData());
+
+    // set overwrite mode to true to write back to the image volume
+    reslice->SetOverwriteMode(true);
+    reslice->Modified();
+
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(volume);
+    extractor->SetTimeStep(sliceInfo.timestep);
+    extractor->SetWorldGeometry(sliceInfo.plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(volume->GetGeometry(sliceInfo.timestep));
+
+    extractor->Modified();
+    extractor->Update();
+
+    return extractor->GetOutput();
+  }
+}
+
 bool mitk::SegTool2D::m_SurfaceInterpolationEnabled = true;
 
 mitk::SegTool2D::SegTool2D(const char *type, const us::Module *interactorModule)
@@ -343,11 +563,17 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const std::vector<SegTool2D::S
   timeSelector->Update();
   Image::Pointer dimRefImg = timeSelector->GetOutput();
 
+  if (writeSliceToVolume)
+  {
+    WriteSlicesToVolume(image, sliceList);
+
+    // also mark its node as modified (T27308)
+    workingNode->Modified();
+  }
+
   for (unsigned int i = 0; i < sliceList.size(); ++i)
   {
     SliceInformation currentSliceInfo = sliceList.at(i);
-    if (writeSliceToVolume)
-      this->WriteSliceToVolume(currentSliceInfo);
     if (m_SurfaceInterpolationEnabled && dimRefImg->GetDimension() == 3)
     {
       currentSliceInfo.slice->DisconnectPipeline();
@@ -368,67 +594,94 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
   DataNode *workingNode(m_ToolManager->GetWorkingData(0));
   auto *image = dynamic_cast<Image *>(workingNode->GetData());
 
-  /*============= BEGIN undo/redo feature block ========================*/
-  // Create undo operation by caching the not yet modified slices
-  mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, image, sliceInfo.timestep);
-  auto *undoOperation =
-    new DiffSliceOperation(image,
-                           originalSlice,
-                           dynamic_cast<SlicedGeometry3D *>(originalSlice->GetGeometry()),
-                           sliceInfo.timestep,
-                           sliceInfo.plane);
-  /*============= END undo/redo feature block ========================*/
-
-  // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
-  // reslicer
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+  WriteSlicesToVolume(image, {sliceInfo});
 
-  // Set the slice as 'input'
-  reslice->SetInputSlice(sliceInfo.slice->GetVtkImageData());
+  // also mark its node as modified (T27308). Can be removed if T27307
+  // is properly solved
+  if (workingNode != nullptr) workingNode->Modified();
+}
 
-  // set overwrite mode to true to write back to the image volume
-  reslice->SetOverwriteMode(true);
-  reslice->Modified();
+void mitk::SegTool2D::WriteSlicesToVolume(Image *workingImage,
+                                          const std::vector<SliceInformation> &sliceList,
+                                          const std::string &undoDescription)
+{
+  if (workingImage == nullptr || sliceList.empty())
+    return;
 
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(image);
-  extractor->SetTimeStep(sliceInfo.timestep);
-  extractor->SetWorldGeometry(sliceInfo.plane);
-  extractor->SetVtkOutputRequest(false);
-  extractor->SetResliceTransformByGeometry(image->GetGeometry(sliceInfo.timestep));
+  // the content of the slices before and after writing, for undo/redo and for observers
+  std::vector<Image::Pointer> originalSlices;
+  std::vector<Image::Pointer> writtenSlices;
+  originalSlices.reserve(sliceList.size());
+  writtenSlices.reserve(sliceList.size());
 
-  extractor->Modified();
-  extractor->Update();
+  // a single slice gains nothing from the threads and keeps the reslicing path
+  std::vector<SliceToVolumeMapping> mappings;
+  if (sliceList.size() > 1 && ComputeConcurrentSliceMappings(workingImage, sliceList, mappings))
+  {
+    CopySlicesIntoVolume(workingImage, sliceList, mappings, originalSlices);
+    for (const auto &sliceInfo : sliceList)
+      writtenSlices.push_back(sliceInfo.slice->Clone());
+  }
+  else
+  {
+    for (const auto &sliceInfo : sliceList)
+    {
+      originalSlices.push_back(GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep));
+      writtenSlices.push_back(OverwriteSliceByReslicing(workingImage, sliceInfo));
+    }
+  }
 
   // the image was modified within the pipeline, but not marked so
-  image->Modified();
-  image->GetVtkImageData()->Modified();
+  std::set<unsigned int> timeSteps;
+  for (const auto &sliceInfo : sliceList)
+    timeSteps.insert(sliceInfo.timestep);
 
-  // also mark its node as modified (T27308). Can be removed if T27307
-  // is properly solved
-  if (workingNode != nullptr) workingNode->Modified();
+  // the 2D interpolation updates its slice counts from the slice events below instead of scanning the image again
+  auto *interpolator = SegmentationInterpolationController::InterpolatorForImage(workingImage);
+  if (interpolator)
+    interpolator->BlockModified(true);
+
+  workingImage->Modified();
+  for (auto timeStep : timeSteps)
+    workingImage->GetVtkImageData(timeStep)->Modified();
+
+  if (interpolator)
+    interpolator->BlockModified(false);
+
+  // allow observers to update derived data with the changed slices only
+  for (std::size_t i = 0; i < sliceList.size(); ++i)
+    workingImage->InvokeEvent(SegmentationSliceModifiedEvent(originalSlices[i], sliceList[i].slice, sliceList[i].timestep));
 
   /*============= BEGIN undo/redo feature block ========================*/
-  // specify the undo operation with the edited slice
-  auto *doOperation =
-    new DiffSliceOperation(image,
-                           extractor->GetOutput(),
-                           dynamic_cast<SlicedGeometry3D *>(sliceInfo.slice->GetGeometry()),
-                           sliceInfo.timestep,
-                           sliceInfo.plane);
-
-  // create an operation event for the undo stack
-  OperationEvent *undoStackItem =
-    new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
-
-  // add it to the undo controller
+  // all slices share the object event id, so they are undone and redone as one step
+  for (std::size_t i = 0; i < sliceList.size(); ++i)
+  {
+    auto *doOperation =
+      new DiffSliceOperation(workingImage,
+                             writtenSlices[i],
+                             dynamic_cast<SlicedGeometry3D *>(sliceList[i].slice->GetGeometry()),
+                             sliceList[i].timestep,
+                             sliceList[i].plane);
+
+    // the original slice differs from the written one by the edit only, so it is stored as delta
+    auto *undoOperation =
+      new DiffSliceOperation(workingImage,
+                             originalSlices[i],
+                             dynamic_cast<SlicedGeometry3D *>(originalSlices[i]->GetGeometry()),
+                             sliceList[i].timestep,
+                             sliceList[i].plane,
+                             doOperation);
+
+    // create an operation event for the undo stack
+    OperationEvent *undoStackItem =
+      new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, undoDescription);
+
+    // add it to the undo controller, which deletes the operations
+    UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+  }
+
   UndoStackItem::IncCurrObjectEventId();
   UndoStackItem::IncCurrGroupEventId();
-  UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
-
-  // clear the pointers as the operation are stored in the undocontroller and also deleted from there
-  undoOperation = nullptr;
-  doOperation = nullptr;
   /*============= END undo/redo feature block ========================*/
 }
 
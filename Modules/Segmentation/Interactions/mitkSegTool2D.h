@@ -56,6 +56,36 @@ namespace mitk
   public:
     mitkClassMacro(SegTool2D, Tool);
 
+    struct SliceInformation
+    {
+      mitk::Image::Pointer slice;
+      mitk::PlaneGeometry *plane;
+      unsigned int timestep;
+
+      SliceInformation() {}
+      SliceInformation(mitk::Image *slice, mitk::PlaneGeometry *plane, unsigned int timestep)
+      {
+        this->slice = slice;
+        this->plane = plane;
+        this->timestep = timestep;
+      }
+    };
+
+    /**
+      \brief Writes a list of slices into a segmentation and registers the change as a single undo step.
+
+      Slices that are aligned with the voxel grid of the segmentation, share their orientation and do not overlap
+      are copied into the volume directly, by a few threads if they contain enough pixels. Otherwise the slices are written one after another by reslicing, just
+      like WriteSliceToVolume does. A SegmentationSliceModifiedEvent is invoked on the segmentation for every slice.
+
+      \param workingImage the segmentation to write into.
+      \param sliceList the slices with their planes and time steps. The slices need the pixel type of workingImage.
+      \param undoDescription the description of the undo step.
+    */
+    static void WriteSlicesToVolume(Image *workingImage,
+                                    const std::vector<SliceInformation> &sliceList,
+                                    const std::string &undoDescription = "Segmentation");
+
     /**
       \brief Calculates for a given Image and PlaneGeometry, which slice of the image (in index corrdinates) is meant by
       the plane.
@@ -98,21 +128,6 @@ namespace mitk
     SegTool2D(const char *, const us::Module *interactorModule = nullptr); // purposely hidden
     ~SegTool2D() override;
 
-    struct SliceInformation
-    {
-      mitk::Image::Pointer slice;
-      mitk::PlaneGeometry *plane;
-      unsigned int timestep;
-
-      SliceInformation() {}
-      SliceInformation(mitk::Image *slice, mitk::PlaneGeometry *plane, unsigned int timestep)
-      {
-        this->slice = slice;
-        this->plane = plane;
-        this->timestep = timestep;
-      }
-    };
-
     /**
     * \brief Filters events that cannot be handle by 2D segmentation tools
     *
@@ -144,10 +159,10 @@ namespace mitk
     * \return 'nullptr' if SegTool2D is either unable to determine which slice was affected, or if there was some problem
     *         getting the image data at that position.
     */
-    Image::Pointer GetAffectedImageSliceAs2DImage(const PlaneGeometry *planeGeometry,
-                                                  const Image *image,
-                                                  unsigned int timeStep,
-                                                  unsigned int component = 0);
+    static Image::Pointer GetAffectedImageSliceAs2DImage(const PlaneGeometry *planeGeometry,
+                                                         const Image *image,
+                                                         unsigned int timeStep,
+                                                         unsigned int component = 0);
 
     /**
       \brief Extract the slice of the currently selected working image that the user just scribbles on.
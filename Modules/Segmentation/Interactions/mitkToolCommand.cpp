@@ -13,12 +13,15 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include "mitkProgressBar.h"
 
-mitk::ToolCommand::ToolCommand() : m_ProgressValue(0), m_StopProcessing(false)
+mitk::ToolCommand::ToolCommand() : m_ProgressValue(0), m_StopProcessing(false), m_ThreadId(std::this_thread::get_id())
 {
 }
 
 void mitk::ToolCommand::Execute(itk::Object *, const itk::EventObject &event)
 {
+  if (std::this_thread::get_id() != m_ThreadId)
+    return;
+
   if (typeid(event) == typeid(itk::IterationEvent))
   {
     // MITK_INFO << "IterationEvent";
@@ -17,11 +17,17 @@ found in the LICENSE file.
 #include "mitkCommon.h"
 #include <MitkSegmentationExports.h>
 
+#include <thread>
+
 namespace mitk
 {
   /**
   * \brief A command to get tool process feedback.
   *
+  * Progress events are only forwarded to the ProgressBar if they are invoked by the thread that created
+  * the command, since the progress bar must not be used from other threads (e.g. by filters that compute
+  * a preview asynchronously).
+  *
   * \sa ProgressBar
   *
   */
@@ -76,6 +82,7 @@ namespace mitk
   private:
     double m_ProgressValue;
     bool m_StopProcessing;
+    std::thread::id m_ThreadId;
   };
 
 } // namespace mitk
@@ -75,6 +75,14 @@ const char *mitk::WatershedTool::GetName() const
   return "Watershed";
 }
 
+void mitk::WatershedTool::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+
+  m_PreviewThreshold = m_Threshold;
+  m_PreviewLevel = m_Level;
+}
+
 mitk::LabelSetImage::Pointer mitk::WatershedTool::ComputeMLPreview(const Image* inputAtTimeStep, TimeStepType /*timeStep*/)
 {
   mitk::LabelSetImage::Pointer labelSetOutput;
@@ -143,8 +151,8 @@ void mitk::WatershedTool::ITKWatershed(const itk::Image<TPixel, VImageDimension>
     m_WatershedFilter = watershed.GetPointer();
   }
 
-  watershed->SetThreshold(m_Threshold);
-  watershed->SetLevel(m_Level);
+  watershed->SetThreshold(m_PreviewThreshold);
+  watershed->SetLevel(m_PreviewLevel);
   watershed->Update();
 
   // then make sure, that the output has the desired pixel type
@@ -57,6 +57,7 @@ namespace mitk
     WatershedTool() = default;
     ~WatershedTool() = default;
 
+    void UpdatePrepare() override;
     LabelSetImage::Pointer ComputeMLPreview(const Image* inputAtTimeStep, TimeStepType timeStep) override;
 
     /** \brief Threshold parameter of the ITK Watershed Image Filter. See ITK Documentation for more information. */
@@ -64,6 +65,10 @@ namespace mitk
     /** \brief Threshold parameter of the ITK Watershed Image Filter. See ITK Documentation for more information. */
     double m_Level = 0.0;
 
+    /** \brief Parameters used by ComputeMLPreview(), copied in UpdatePrepare(). */
+    double m_PreviewThreshold = 0.0;
+    double m_PreviewLevel = 0.0;
+
 private:
     /** \brief Creates and runs an ITK filter pipeline consisting of the filters: GradientMagnitude-, Watershed- and
      * CastImageFilter.
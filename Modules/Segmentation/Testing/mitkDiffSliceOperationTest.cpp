@@ -0,0 +1,177 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkDiffSliceOperation.h>
+#include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkPlaneGeometry.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+  const unsigned int Size = 64;
+}
+
+class mitkDiffSliceOperationTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDiffSliceOperationTestSuite);
+  MITK_TEST(GetSlice_WithoutReference_RestoresSlice);
+  MITK_TEST(GetSlice_WithReference_RestoresSliceFromDelta);
+  MITK_TEST(GetSlice_ReferenceWithOtherPixelType_RestoresSlice);
+  MITK_TEST(ShutdownCompression_LaterOperations_CompressImmediately);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Volume;
+  mitk::PlaneGeometry::Pointer m_Plane;
+
+  /** Operations are deleted through their base class, like in an OperationEvent */
+  std::vector<std::unique_ptr<mitk::Operation>> m_Operations;
+
+  /** Creates a slice whose values hardly compress, with the square [begin, end) set to value */
+  template <typename TPixel>
+  static mitk::Image::Pointer CreateSlice(unsigned int begin, unsigned int end, TPixel value)
+  {
+    unsigned int dimensions[] = {Size, Size};
+
+    auto slice = mitk::Image::New();
+    slice->Initialize(mitk::MakeScalarPixelType<TPixel>(), 2, dimensions);
+
+    mitk::ImagePixelWriteAccessor<TPixel, 2> accessor(slice);
+    for (unsigned int y = 0; y < Size; ++y)
+    {
+      for (unsigned int x = 0; x < Size; ++x)
+      {
+        const unsigned int i = y * Size + x;
+        const bool inSquare = x >= begin && x < end && y >= begin && y < end;
+        accessor.GetData()[i] = inSquare ? value : static_cast<TPixel>((i * 2654435761u) >> 24);
+      }
+    }
+
+    return slice;
+  }
+
+  template <typename TPixel>
+  static void CheckSlice(mitk::Image *expected, mitk::Image *actual)
+  {
+    CPPUNIT_ASSERT(actual != nullptr);
+    CPPUNIT_ASSERT(expected->GetPixelType() == actual->GetPixelType());
+
+    mitk::ImagePixelReadAccessor<TPixel, 2> expectedAccessor(expected);
+    mitk::ImagePixelReadAccessor<TPixel, 2> actualAccessor(actual);
+
+    for (unsigned int i = 0; i < Size * Size; ++i)
+      CPPUNIT_ASSERT_EQUAL(expectedAccessor.GetData()[i], actualAccessor.GetData()[i]);
+  }
+
+  mitk::DiffSliceOperation *CreateOperation(mitk::Image *slice,
+                                            const mitk::DiffSliceOperation *referenceOperation = nullptr)
+  {
+    auto *operation =
+      new mitk::DiffSliceOperation(m_Volume,
+                                   slice,
+                                   dynamic_cast<mitk::SlicedGeometry3D *>(slice->GetGeometry()),
+                                   0,
+                                   m_Plane,
+                                   referenceOperation);
+
+    m_Operations.emplace_back(operation);
+    return operation;
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[] = {Size, Size, 4};
+
+    m_Volume = mitk::Image::New();
+    m_Volume->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    m_Plane = mitk::PlaneGeometry::New();
+    m_Plane->InitializeStandardPlane(m_Volume->GetGeometry(), mitk::PlaneGeometry::Axial, 1);
+  }
+
+  void tearDown() override
+  {
+    m_Operations.clear();
+    m_Plane = nullptr;
+    m_Volume = nullptr;
+  }
+
+  void GetSlice_WithoutReference_RestoresSlice()
+  {
+    auto slice = CreateSlice<unsigned short>(0, 0, 0);
+    auto *operation = this->CreateOperation(slice);
+
+    CheckSlice<unsigned short>(slice, operation->GetSlice());
+    CPPUNIT_ASSERT(!operation->IsMemoryUsagePending());
+  }
+
+  void GetSlice_WithReference_RestoresSliceFromDelta()
+  {
+    // the edit overwrites a square of the slice, like a segmentation tool
+    auto originalSlice = CreateSlice<unsigned short>(0, 0, 0);
+    auto editedSlice = CreateSlice<unsigned short>(10, 30, 1);
+
+    auto *doOperation = this->CreateOperation(editedSlice);
+    auto *undoOperation = this->CreateOperation(originalSlice, doOperation);
+
+    CheckSlice<unsigned short>(originalSlice, undoOperation->GetSlice());
+    CheckSlice<unsigned short>(editedSlice, doOperation->GetSlice());
+
+    // the delta holds the edited square only, not the slice
+    const std::size_t sliceSize = Size * Size * sizeof(unsigned short);
+    CPPUNIT_ASSERT(undoOperation->GetMemoryUsage() < sizeof(mitk::DiffSliceOperation) + sliceSize / 4);
+    CPPUNIT_ASSERT(undoOperation->GetMemoryUsage() < doOperation->GetMemoryUsage());
+
+    // a delta to a delta is not supported, the slice is compressed on its own instead
+    auto *chainedOperation = this->CreateOperation(editedSlice, undoOperation);
+    CheckSlice<unsigned short>(editedSlice, chainedOperation->GetSlice());
+  }
+
+  void GetSlice_ReferenceWithOtherPixelType_RestoresSlice()
+  {
+    auto referenceSlice = CreateSlice<unsigned short>(10, 30, 1);
+    auto slice = CreateSlice<unsigned char>(0, 0, 0);
+
+    auto *referenceOperation = this->CreateOperation(referenceSlice);
+    auto *operation = this->CreateOperation(slice, referenceOperation);
+
+    CheckSlice<unsigned char>(slice, operation->GetSlice());
+  }
+
+  void ShutdownCompression_LaterOperations_CompressImmediately()
+  {
+    auto originalSlice = CreateSlice<unsigned short>(0, 0, 0);
+    auto editedSlice = CreateSlice<unsigned short>(5, 20, 2);
+
+    auto *pendingOperation = this->CreateOperation(editedSlice);
+    mitk::DiffSliceOperation::ShutdownCompression();
+    CPPUNIT_ASSERT_MESSAGE("Testing that queued slices are compressed before the shutdown returns",
+                           !pendingOperation->IsMemoryUsagePending());
+
+    auto *operation = this->CreateOperation(originalSlice, pendingOperation);
+    CPPUNIT_ASSERT(!operation->IsMemoryUsagePending());
+    CheckSlice<unsigned short>(originalSlice, operation->GetSlice());
+    CheckSlice<unsigned short>(editedSlice, pendingOperation->GetSlice());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDiffSliceOperation)
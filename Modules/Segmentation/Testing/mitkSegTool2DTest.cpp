@@ -0,0 +1,240 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkRotationOperation.h>
+#include <mitkSegTool2D.h>
+#include <mitkSegmentationSliceModifiedEvent.h>
+#include <mitkSliceNavigationController.h>
+#include <mitkTool.h>
+#include <mitkUndoController.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+  /** Large enough for the aligned slices to be copied by several threads */
+  const unsigned int Size = 256;
+  const unsigned int NumberOfSlices = 8;
+}
+
+class mitkSegTool2DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSegTool2DTestSuite);
+  MITK_TEST(WriteSlicesToVolume_AlignedSlices_WritesAllSlices);
+  MITK_TEST(WriteSlicesToVolume_ObliqueSlice_WritesByReslicing);
+  MITK_TEST(WriteSlicesToVolume_Undo_RestoresAllSlicesInOneStep);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::Tool::DefaultSegmentationDataType PixelType;
+
+  mitk::Image::Pointer m_Segmentation;
+  mitk::SliceNavigationController::Pointer m_NavigationController;
+  mitk::UndoController m_UndoController;
+  unsigned int m_NumberOfSliceModifiedEvents;
+
+  /** The slice information refers to the planes without keeping them */
+  std::vector<mitk::PlaneGeometry::Pointer> m_Planes;
+
+  mitk::PlaneGeometry::Pointer GetAxialPlane(unsigned int slice)
+  {
+    mitk::Point3D index;
+    index[0] = 0;
+    index[1] = 0;
+    index[2] = slice;
+
+    mitk::Point3D pointMM;
+    m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(index, pointMM);
+    m_NavigationController->SelectSliceByPoint(pointMM);
+    return m_NavigationController->GetCurrentPlaneGeometry()->Clone();
+  }
+
+  mitk::PlaneGeometry::Pointer GetObliquePlane()
+  {
+    auto plane = this->GetAxialPlane(NumberOfSlices / 2);
+
+    mitk::Vector3D rotationVector = plane->GetAxisVector(0);
+    rotationVector.Normalize();
+
+    mitk::RotationOperation rotation(mitk::OpROTATE, plane->GetCenter(), rotationVector, 30.0);
+    plane->ExecuteOperation(&rotation);
+
+    return plane;
+  }
+
+  /** Extracts the slice of the segmentation at plane and fills it with value */
+  mitk::Image::Pointer CreateSlice(const mitk::PlaneGeometry *plane, PixelType value)
+  {
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New();
+    extractor->SetInput(m_Segmentation);
+    extractor->SetTimeStep(0);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(0));
+    extractor->Update();
+
+    mitk::Image::Pointer slice = extractor->GetOutput();
+    slice->DisconnectPipeline();
+
+    mitk::ImagePixelWriteAccessor<PixelType, 2> accessor(slice);
+    const auto numberOfPixels = slice->GetDimension(0) * slice->GetDimension(1);
+    for (unsigned int i = 0; i < numberOfPixels; ++i)
+      accessor.GetData()[i] = value;
+
+    return slice;
+  }
+
+  std::vector<mitk::SegTool2D::SliceInformation> CreateAlignedSlices(const std::vector<unsigned int> &slices)
+  {
+    std::vector<mitk::SegTool2D::SliceInformation> sliceList;
+    for (auto slice : slices)
+    {
+      auto plane = this->GetAxialPlane(slice);
+      m_Planes.push_back(plane);
+      sliceList.emplace_back(this->CreateSlice(plane, static_cast<PixelType>(slice + 1)), plane, 0);
+    }
+
+    return sliceList;
+  }
+
+  /** Checks that the given slices are filled with their index + 1 and all other slices are empty */
+  void CheckAlignedSlices(const std::vector<unsigned int> &slices)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 3> accessor(m_Segmentation);
+    itk::Index<3> index;
+
+    for (unsigned int z = 0; z < NumberOfSlices; ++z)
+    {
+      const bool written = std::find(slices.begin(), slices.end(), z) != slices.end();
+      const PixelType expectedValue = written ? static_cast<PixelType>(z + 1) : 0;
+      index[2] = z;
+
+      for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(Size); ++index[1])
+      {
+        for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(Size); ++index[0])
+        {
+          if (expectedValue != accessor.GetPixelByIndex(index))
+            CPPUNIT_FAIL("Unexpected pixel value in slice " + std::to_string(z));
+        }
+      }
+    }
+  }
+
+  void OnSliceModified() { ++m_NumberOfSliceModifiedEvents; }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[] = {Size, Size, NumberOfSlices};
+
+    m_Segmentation = mitk::Image::New();
+    m_Segmentation->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, dimensions);
+
+    {
+      mitk::ImagePixelWriteAccessor<PixelType, 3> accessor(m_Segmentation);
+      std::fill(accessor.GetData(), accessor.GetData() + Size * Size * NumberOfSlices, 0);
+    }
+
+    m_NavigationController = mitk::SliceNavigationController::New();
+    m_NavigationController->SetInputWorldTimeGeometry(m_Segmentation->GetTimeGeometry());
+    m_NavigationController->Update(mitk::SliceNavigationController::Axial);
+
+    m_NumberOfSliceModifiedEvents = 0;
+    auto command = itk::SimpleMemberCommand<mitkSegTool2DTestSuite>::New();
+    command->SetCallbackFunction(this, &mitkSegTool2DTestSuite::OnSliceModified);
+    m_Segmentation->AddObserver(mitk::SegmentationSliceModifiedEvent(), command);
+
+    mitk::UndoController::GetCurrentUndoModel()->Clear();
+  }
+
+  void tearDown() override
+  {
+    mitk::UndoController::GetCurrentUndoModel()->Clear();
+    m_Planes.clear();
+    m_NavigationController = nullptr;
+    m_Segmentation = nullptr;
+  }
+
+  void WriteSlicesToVolume_AlignedSlices_WritesAllSlices()
+  {
+    const std::vector<unsigned int> slices = {1, 2, 4, 7};
+    mitk::SegTool2D::WriteSlicesToVolume(m_Segmentation, this->CreateAlignedSlices(slices));
+
+    this->CheckAlignedSlices(slices);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(slices.size()), m_NumberOfSliceModifiedEvents);
+  }
+
+  void WriteSlicesToVolume_ObliqueSlice_WritesByReslicing()
+  {
+    // an oblique slice cannot be copied into the volume, so all slices of the list are written by reslicing
+    auto obliquePlane = this->GetObliquePlane();
+    auto sliceList = this->CreateAlignedSlices({0});
+    sliceList.emplace_back(this->CreateSlice(obliquePlane, 10), obliquePlane, 0);
+
+    mitk::SegTool2D::WriteSlicesToVolume(m_Segmentation, sliceList);
+
+    CPPUNIT_ASSERT_EQUAL(2u, m_NumberOfSliceModifiedEvents);
+
+    mitk::ImagePixelReadAccessor<PixelType, 3> accessor(m_Segmentation);
+
+    // the plane is rotated around the center of the middle slice, which is written therefore
+    itk::Index<3> center = {{Size / 2, Size / 2, NumberOfSlices / 2}};
+    CPPUNIT_ASSERT_EQUAL(PixelType(10), accessor.GetPixelByIndex(center));
+
+    // far from its center, the rotated plane lies outside of the volume
+    itk::Index<3> corner = {{0, 0, NumberOfSlices - 1}};
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), accessor.GetPixelByIndex(corner));
+
+    // the aligned slice of the list is written as well
+    itk::Index<3> alignedPixel = {{Size / 2, Size / 2, 0}};
+    CPPUNIT_ASSERT_EQUAL(PixelType(1), accessor.GetPixelByIndex(alignedPixel));
+  }
+
+  void WriteSlicesToVolume_Undo_RestoresAllSlicesInOneStep()
+  {
+    auto *undoModel = mitk::UndoController::GetCurrentUndoModel();
+
+    const std::vector<unsigned int> firstSlices = {3};
+    mitk::SegTool2D::WriteSlicesToVolume(m_Segmentation, this->CreateAlignedSlices(firstSlices));
+
+    const std::vector<unsigned int> batchSlices = {0, 5, 6};
+    mitk::SegTool2D::WriteSlicesToVolume(m_Segmentation, this->CreateAlignedSlices(batchSlices));
+
+    const std::vector<unsigned int> allSlices = {0, 3, 5, 6};
+    this->CheckAlignedSlices(allSlices);
+
+    // the slices of one call share their object event id, so a single undo reverts all of them
+    CPPUNIT_ASSERT(undoModel->Undo());
+    this->CheckAlignedSlices(firstSlices);
+
+    CPPUNIT_ASSERT(undoModel->Redo());
+    this->CheckAlignedSlices(allSlices);
+
+    CPPUNIT_ASSERT(undoModel->Undo());
+    CPPUNIT_ASSERT(undoModel->Undo());
+    this->CheckAlignedSlices({});
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSegTool2D)
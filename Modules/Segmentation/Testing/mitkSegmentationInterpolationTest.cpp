@@ -20,20 +20,72 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImagePixelReadAccessor.h>
 #include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkSegmentationInterpolationController.h>
+#include <mitkSegmentationSliceModifiedEvent.h>
 #include <mitkSliceNavigationController.h>
 #include <mitkTool.h>
 #include <mitkVtkImageOverwrite.h>
 
+#include <algorithm>
+
 class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkSegmentationInterpolationTestSuite);
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Frontal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(SliceModifiedEvent_MultiLabelSegmentation_UpdatesLabelCounts);
+  MITK_TEST(Interpolate_MultiLabelSegmentation_InterpolatesSingleLabel);
   CPPUNIT_TEST_SUITE_END();
 
 private:
+  typedef mitk::Tool::DefaultSegmentationDataType PixelType;
+
+  const mitk::PlaneGeometry *GetAxialPlane(mitk::SliceNavigationController *navigationController)
+  {
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::SliceNavigationController::Axial);
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    return navigationController->GetCurrentPlaneGeometry();
+  }
+
+  mitk::Image::Pointer ExtractSlice(const mitk::PlaneGeometry *plane)
+  {
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New();
+    extractor->SetInput(m_SegmentationImage);
+    extractor->SetTimeStep(0);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
+    extractor->Update();
+
+    mitk::Image::Pointer slice = extractor->GetOutput();
+    slice->DisconnectPipeline();
+    return slice;
+  }
+
+  void SetPixels(const std::vector<itk::Index<3>> &indices, PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<PixelType, 3> writeAccessor(m_SegmentationImage);
+    for (const auto &index : indices)
+      writeAccessor.SetPixelByIndexSafe(index, value);
+  }
+
+  void CheckLabelCounts()
+  {
+    const unsigned int z = m_CenterPoint[2];
+    CPPUNIT_ASSERT_EQUAL(3u, m_InterpolationController->GetNumberOfPixelsInSlice(2, z, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(2u, m_InterpolationController->GetNumberOfPixelsInSlice(2, z, 0, 2));
+    CPPUNIT_ASSERT_EQUAL(2u, m_InterpolationController->GetNumberOfPixelsInSlice(1, 20, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(1u, m_InterpolationController->GetNumberOfPixelsInSlice(0, 12, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(2u, m_InterpolationController->GetNumberOfPixelsInSlice(1, 40, 0, 2));
+    CPPUNIT_ASSERT_EQUAL(0u, m_InterpolationController->GetNumberOfPixelsInSlice(1, 40, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(0u, m_InterpolationController->GetNumberOfPixelsInSlice(2, z + 1, 0, 1));
+  }
+
   // The tests all do the same, only in different directions
   void testRoutine(mitk::SliceNavigationController::ViewDirection viewDirection)
   {
@@ -199,6 +251,87 @@ public:
     mitk::SliceNavigationController::ViewDirection viewDirection = mitk::SliceNavigationController::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void SliceModifiedEvent_MultiLabelSegmentation_UpdatesLabelCounts()
+  {
+    const auto z = m_CenterPoint[2];
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+    CPPUNIT_ASSERT_EQUAL(0u, m_InterpolationController->GetNumberOfPixelsInSlice(2, z, 0, 1));
+
+    auto navigationController = mitk::SliceNavigationController::New();
+    auto plane = GetAxialPlane(navigationController);
+
+    // write a slice like SegTool2D does
+    auto previousSlice = ExtractSlice(plane);
+    SetPixels({{{10, 20, z}}, {{11, 20, z}}, {{12, 21, z}}}, 1);
+    SetPixels({{{30, 40, z}}, {{31, 40, z}}}, 2);
+    auto currentSlice = ExtractSlice(plane);
+
+    m_InterpolationController->BlockModified(true);
+    m_SegmentationImage->Modified();
+    m_InterpolationController->BlockModified(false);
+    m_SegmentationImage->InvokeEvent(mitk::SegmentationSliceModifiedEvent(previousSlice, currentSlice, 0));
+
+    CheckLabelCounts();
+
+    // a slice without its previous content is scanned again
+    m_SegmentationImage->InvokeEvent(mitk::SegmentationSliceModifiedEvent(nullptr, currentSlice, 0));
+    CheckLabelCounts();
+
+    // the whole image is scanned again after an unreported change
+    m_SegmentationImage->Modified();
+    CheckLabelCounts();
+
+    // overwriting label 2 by label 1
+    previousSlice = currentSlice;
+    SetPixels({{{30, 40, z}}}, 1);
+    currentSlice = ExtractSlice(plane);
+    m_InterpolationController->BlockModified(true);
+    m_SegmentationImage->Modified();
+    m_InterpolationController->BlockModified(false);
+    m_SegmentationImage->InvokeEvent(mitk::SegmentationSliceModifiedEvent(previousSlice, currentSlice, 0));
+
+    CPPUNIT_ASSERT_EQUAL(4u, m_InterpolationController->GetNumberOfPixelsInSlice(2, z, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(1u, m_InterpolationController->GetNumberOfPixelsInSlice(2, z, 0, 2));
+    CPPUNIT_ASSERT_EQUAL(1u, m_InterpolationController->GetNumberOfPixelsInSlice(0, 30, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(0u, m_InterpolationController->GetNumberOfPixelsInSlice(0, 30, 0, 2));
+  }
+
+  void Interpolate_MultiLabelSegmentation_InterpolatesSingleLabel()
+  {
+    const auto center = m_CenterPoint;
+
+    // label 2: 3x3 square below and single pixel above the center slice, label 1 within the center slice
+    std::vector<itk::Index<3>> square;
+    for (int i = -1; i <= 1; ++i)
+    {
+      for (int j = -1; j <= 1; ++j)
+        square.push_back({{center[0] + i, center[1] + j, center[2] - 1}});
+    }
+    SetPixels(square, 2);
+    SetPixels({{{center[0] + 1, center[1] + 1, center[2] + 1}}}, 2);
+    SetPixels({{{50, 50, center[2]}}}, 1);
+
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+
+    auto navigationController = mitk::SliceNavigationController::New();
+    auto plane = GetAxialPlane(navigationController);
+
+    CPPUNIT_ASSERT_MESSAGE("Slice with a segmentation is interpolated.",
+                           m_InterpolationController->Interpolate(2, center[2], plane, 0).IsNull());
+    CPPUNIT_ASSERT_MESSAGE("Absent label is interpolated.",
+                           m_InterpolationController->Interpolate(2, center[2], plane, 0, 3).IsNull());
+
+    auto interpolation = m_InterpolationController->Interpolate(2, center[2], plane, 0, 2);
+    CPPUNIT_ASSERT(interpolation.IsNotNull());
+
+    // the 2x2 square in between, without the pixel of label 1
+    mitk::ImageReadAccessor readAccess(interpolation);
+    const auto *pixels = static_cast<const PixelType *>(readAccess.GetData());
+    const unsigned int numberOfPixels = interpolation->GetDimension(0) * interpolation->GetDimension(1);
+    CPPUNIT_ASSERT_EQUAL(4l, static_cast<long>(std::count(pixels, pixels + numberOfPixels, PixelType(1))));
+    CPPUNIT_ASSERT_EQUAL(0l, static_cast<long>(std::count(pixels, pixels + numberOfPixels, PixelType(2))));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
@@ -164,5 +164,6 @@ void QmitkBinaryThresholdToolGUI::BusyStateChanged(bool value)
     QApplication::restoreOverrideCursor();
   }
 
-  m_ThresholdSlider->setEnabled(!value);
+  // The slider stays enabled, since the preview is computed asynchronously and merges
+  // the threshold changes of a slider drag into a single computation.
 }
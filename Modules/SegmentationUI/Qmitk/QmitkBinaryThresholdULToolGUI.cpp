@@ -159,5 +159,6 @@ void QmitkBinaryThresholdULToolGUI::BusyStateChanged(bool value)
     QApplication::restoreOverrideCursor();
   }
 
-  m_DoubleThresholdSlider->setEnabled(!value);
+  // The slider stays enabled, since the preview is computed asynchronously and merges
+  // the threshold changes of a slider drag into a single computation.
 }
@@ -191,4 +191,10 @@ void QmitkOtsuTool3DGUI::BusyStateChanged(bool value)
   m_Controls.m_CheckProcessAll->setEnabled(!value);
   m_Controls.m_CheckCreateNew->setEnabled(!value);
   m_Controls.previewButton->setEnabled(!value);
+
+  if (!value)
+  {
+    // the preview is computed asynchronously, so a new ML preview is only available when the tool is done
+    m_Controls.m_selectionListWidget->SetLabelSetImage(m_OtsuTool3DTool->GetMLPreview());
+  }
 }
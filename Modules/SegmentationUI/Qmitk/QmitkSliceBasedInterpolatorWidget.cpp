@@ -568,6 +568,10 @@ void QmitkSliceBasedInterpolatorWidget::AcceptAllInterpolations(mitk::SliceNavig
 
   mitk::Point3D origin = reslicePlane->GetOrigin();
 
+  // the slice information only refers to the planes, so they are kept here
+  std::vector<mitk::PlaneGeometry::Pointer> planes;
+  std::vector<mitk::SegTool2D::SliceInformation> sliceList;
+
   for (unsigned int idx = 0; idx < zslices; ++idx)
   {
     // Transforming the current origin of the reslice plane
@@ -591,41 +595,28 @@ void QmitkSliceBasedInterpolatorWidget::AcceptAllInterpolations(mitk::SliceNavig
       AccessFixedDimensionByItk_2(
         sliceImage, WritePreviewOnWorkingImage, 2, interpolation, m_WorkingImage->GetActiveLabel()->GetValue());
 
-      // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
-      // reslicer
-      vtkSmartPointer<mitkVtkImageOverwrite> overwrite = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-      overwrite->SetInputSlice(sliceImage->GetVtkImageData());
-      // set overwrite mode to true to write back to the image volume
-      overwrite->SetOverwriteMode(true);
-      overwrite->Modified();
-
-      mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(overwrite);
-      extractor->SetInput(m_WorkingImage);
-      extractor->SetTimeStep(timeStep);
-      extractor->SetWorldGeometry(reslicePlane);
-      extractor->SetVtkOutputRequest(true);
-      extractor->SetResliceTransformByGeometry(m_WorkingImage->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
-
-      extractor->Modified();
-
-      try
-      {
-        extractor->Update();
-      }
-      catch (itk::ExceptionObject &excep)
-      {
-        MITK_ERROR << "Exception caught: " << excep.GetDescription();
-        return;
-      }
-
-      m_WorkingImage->Modified();
-
-      mitk::RenderingManager::GetInstance()->RequestUpdateAll(mitk::RenderingManager::REQUEST_UPDATE_2DWINDOWS);
+      // the plane is shifted for the next slice, so every slice gets its own copy
+      planes.push_back(reslicePlane->Clone());
+      sliceList.emplace_back(sliceImage, planes.back(), timeStep);
     }
 
     mitk::ProgressBar::GetInstance()->Progress();
   }
 
+  // the slices are written at once and undone as a single step
+  if (!sliceList.empty())
+  {
+    try
+    {
+      mitk::SegTool2D::WriteSlicesToVolume(m_WorkingImage, sliceList, "Slice Interpolation");
+    }
+    catch (itk::ExceptionObject &excep)
+    {
+      MITK_ERROR << "Exception caught: " << excep.GetDescription();
+      return;
+    }
+  }
+
   m_SliceInterpolatorController->SetWorkingImage(m_WorkingImage);
 
   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
@@ -15,13 +15,10 @@ found in the LICENSE file.
 #include "QmitkSelectableGLWidget.h"
 #include "QmitkStdMultiWidget.h"
 
-#include "mitkApplyDiffImageOperation.h"
 #include "mitkColorProperty.h"
 #include "mitkCoreObjectFactory.h"
-#include "mitkDiffImageApplier.h"
 #include "mitkInteractionConst.h"
 #include "mitkLevelWindowProperty.h"
-#include "mitkOperationEvent.h"
 #include "mitkOverwriteSliceImageFilter.h"
 #include "mitkProgressBar.h"
 #include "mitkProperties.h"
@@ -30,14 +27,9 @@ found in the LICENSE file.
 #include "mitkSliceNavigationController.h"
 #include "mitkSurfaceToImageFilter.h"
 #include "mitkToolManager.h"
-#include "mitkUndoController.h"
-#include <mitkExtractSliceFilter.h>
 #include <mitkImageReadAccessor.h>
-#include <mitkImageTimeSelector.h>
-#include <mitkImageWriteAccessor.h>
 #include <mitkPlaneProposer.h>
 #include <mitkUnstructuredGridClusteringFilter.h>
-#include <mitkVtkImageOverwrite.h>
 
 #include <itkCommand.h>
 
@@ -49,6 +41,7 @@ found in the LICENSE file.
 #include <QVBoxLayout>
 
 #include <vtkPolyVertex.h>
+#include <vtkSmartPointer.h>
 #include <vtkUnstructuredGrid.h>
 
 //#define ROUND(a)     ((a)>0 ? (int)((a)+0.5) : -(int)(0.5-(a)))
@@ -137,6 +130,12 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
   command2->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged);
   SurfaceInterpolationInfoChangedObserverTag = m_SurfaceInterpolator->AddObserver(itk::ModifiedEvent(), command2);
 
+  itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::Pointer command3 =
+    itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::New();
+  command3->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationResultPublished);
+  SurfaceInterpolationFinishedObserverTag =
+    m_SurfaceInterpolator->AddObserver(mitk::SurfaceInterpolationFinishedEvent(), command3);
+
   // feedback node and its visualization properties
   m_FeedbackNode = mitk::DataNode::New();
   mitk::CoreObjectFactory::GetInstance()->SetDefaultProperties(m_FeedbackNode);
@@ -183,12 +182,6 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
     QWidget::layout()->setContentsMargins(0, 0, 0, 0);
   }
 
-  // For running 3D Interpolation in background
-  // create a QFuture and a QFutureWatcher
-
-  connect(&m_Watcher, SIGNAL(started()), this, SLOT(StartUpdateInterpolationTimer()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(OnSurfaceInterpolationFinished()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(StopUpdateInterpolationTimer()));
   m_Timer = new QTimer(this);
   connect(m_Timer, SIGNAL(timeout()), this, SLOT(ChangeSurfaceColor()));
 }
@@ -333,6 +326,8 @@ QmitkSlicesInterpolator::~QmitkSlicesInterpolator()
   // remove observer
   m_Interpolator->RemoveObserver(InterpolationInfoChangedObserverTag);
   m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationInfoChangedObserverTag);
+  m_SurfaceInterpolator->WaitForInterpolation();
+  m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationFinishedObserverTag);
 
   delete m_Timer;
 }
@@ -643,17 +638,6 @@ void QmitkSlicesInterpolator::OnAcceptInterpolationClicked()
 {
   if (m_Segmentation && m_FeedbackNode->GetData())
   {
-    // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
-    // reslicer
-    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-    // Set slice as input
-    mitk::Image::Pointer slice = dynamic_cast<mitk::Image *>(m_FeedbackNode->GetData());
-    reslice->SetInputSlice(slice->GetSliceData()->GetVtkImageAccessor(slice)->GetVtkImageData());
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
-
     const auto timePoint = m_LastSNC->GetSelectedTimePoint();
     if (!m_Segmentation->GetTimeGeometry()->IsValidTimePoint(timePoint))
     {
@@ -661,20 +645,13 @@ void QmitkSlicesInterpolator::OnAcceptInterpolationClicked()
       return;
     }
 
-    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-    extractor->SetInput(m_Segmentation);
+    mitk::Image::Pointer slice = dynamic_cast<mitk::Image *>(m_FeedbackNode->GetData());
+    mitk::PlaneGeometry::Pointer plane = m_LastSNC->GetCurrentPlaneGeometry()->Clone();
     const auto timeStep = m_Segmentation->GetTimeGeometry()->TimePointToTimeStep(timePoint);
-    extractor->SetTimeStep(timeStep);
-    extractor->SetWorldGeometry(m_LastSNC->GetCurrentPlaneGeometry());
-    extractor->SetVtkOutputRequest(true);
-    extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
 
-    extractor->Modified();
-    extractor->Update();
-
-    // the image was modified within the pipeline, but not marked so
-    m_Segmentation->Modified();
-    m_Segmentation->GetVtkImageData()->Modified();
+    // writes the slice like the segmentation tools do, including undo and the update of the interpolation
+    mitk::SegTool2D::WriteSlicesToVolume(
+      m_Segmentation, {mitk::SegTool2D::SliceInformation(slice, plane, timeStep)}, "Confirm interpolation");
 
     m_FeedbackNode->SetData(nullptr);
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
@@ -685,13 +662,11 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
 {
   /*
    * What exactly is done here:
-   * 1. We create an empty diff image for the current segmentation
-   * 2. All interpolated slices are written into the diff image
-   * 3. Then the diffimage is applied to the original segmentation
+   * 1. All slices of the current orientation are interpolated
+   * 2. The interpolated slices are written into the segmentation at once, as a single undo step
    */
   if (m_Segmentation)
   {
-    mitk::Image::Pointer image3D = m_Segmentation;
     unsigned int timeStep(0);
     const auto timePoint = slicer->GetSelectedTimePoint();
     if (m_Segmentation->GetDimension() == 4)
@@ -703,38 +678,8 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
       }
 
       timeStep = m_Segmentation->GetTimeGeometry()->TimePointToTimeStep(timePoint);
-      mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-      timeSelector->SetInput(m_Segmentation);
-      timeSelector->SetTimeNr(timeStep);
-      timeSelector->Update();
-      image3D = timeSelector->GetOutput();
     }
-    // create a empty diff image for the undo operation
-    mitk::Image::Pointer diffImage = mitk::Image::New();
-    diffImage->Initialize(image3D);
-
-    // Create scope for ImageWriteAccessor so that the accessor is destroyed
-    // after the image is initialized. Otherwise later image access will lead to an error
-    {
-      mitk::ImageWriteAccessor imAccess(diffImage);
-
-      // Set all pixels to zero
-      mitk::PixelType pixelType(mitk::MakeScalarPixelType<mitk::Tool::DefaultSegmentationDataType>());
-
-      // For legacy purpose support former pixel type of segmentations (before multilabel)
-      if (m_Segmentation->GetImageDescriptor()->GetChannelDescriptor().GetPixelType().GetComponentType() ==
-          itk::ImageIOBase::UCHAR)
-      {
-        pixelType = mitk::MakeScalarPixelType<unsigned char>();
-      }
 
-      memset(imAccess.GetData(),
-             0,
-             (pixelType.GetBpe() >> 3) * diffImage->GetDimension(0) * diffImage->GetDimension(1) *
-               diffImage->GetDimension(2));
-    }
-
-    // Since we need to shift the plane it must be clone so that the original plane isn't altered
     mitk::PlaneGeometry::Pointer reslicePlane = slicer->GetCurrentPlaneGeometry()->Clone();
 
     int sliceDimension(-1);
@@ -745,7 +690,10 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     mitk::ProgressBar::GetInstance()->AddStepsToDo(zslices);
 
     mitk::Point3D origin = reslicePlane->GetOrigin();
-    unsigned int totalChangedSlices(0);
+
+    // the slice information only refers to the planes, so they are kept here
+    std::vector<mitk::PlaneGeometry::Pointer> planes;
+    std::vector<mitk::SegTool2D::SliceInformation> sliceList;
 
     for (unsigned int sliceIndex = 0; sliceIndex < zslices; ++sliceIndex)
     {
@@ -755,58 +703,24 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
       origin[sliceDimension] = sliceIndex;
       m_Segmentation->GetSlicedGeometry()->IndexToWorld(origin, origin);
       reslicePlane->SetOrigin(origin);
-      // Set the slice as 'input'
+
       mitk::Image::Pointer interpolation =
         m_Interpolator->Interpolate(sliceDimension, sliceIndex, reslicePlane, timeStep);
 
       if (interpolation.IsNotNull()) // we don't check if interpolation is necessary/sensible - but m_Interpolator does
       {
-        // Setting up the reslicing pipeline which allows us to write the interpolation results back into
-        // the image volume
-        vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-        // set overwrite mode to true to write back to the image volume
-        reslice->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
-        reslice->SetOverwriteMode(true);
-        reslice->Modified();
-
-        mitk::ExtractSliceFilter::Pointer diffslicewriter = mitk::ExtractSliceFilter::New(reslice);
-        diffslicewriter->SetInput(diffImage);
-        diffslicewriter->SetTimeStep(0);
-        diffslicewriter->SetWorldGeometry(reslicePlane);
-        diffslicewriter->SetVtkOutputRequest(true);
-        diffslicewriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
-
-        diffslicewriter->Modified();
-        diffslicewriter->Update();
-        ++totalChangedSlices;
+        // the plane is shifted for the next slice, so every slice gets its own copy
+        planes.push_back(reslicePlane->Clone());
+        sliceList.emplace_back(interpolation, planes.back(), timeStep);
       }
       mitk::ProgressBar::GetInstance()->Progress();
     }
-    mitk::RenderingManager::GetInstance()->RequestUpdateAll();
 
-    if (totalChangedSlices > 0)
+    if (!sliceList.empty())
     {
-      // store undo stack items
-      if (true)
-      {
-        // create do/undo operations
-        mitk::ApplyDiffImageOperation *doOp =
-          new mitk::ApplyDiffImageOperation(mitk::OpTEST, m_Segmentation, diffImage, timeStep);
-        mitk::ApplyDiffImageOperation *undoOp =
-          new mitk::ApplyDiffImageOperation(mitk::OpTEST, m_Segmentation, diffImage, timeStep);
-        undoOp->SetFactor(-1.0);
-        std::stringstream comment;
-        comment << "Confirm all interpolations (" << totalChangedSlices << ")";
-        mitk::OperationEvent *undoStackItem =
-          new mitk::OperationEvent(mitk::DiffImageApplier::GetInstanceForUndo(), doOp, undoOp, comment.str());
-        mitk::OperationEvent::IncCurrGroupEventId();
-        mitk::OperationEvent::IncCurrObjectEventId();
-        mitk::UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
-
-        // acutally apply the changes here to the original image
-        mitk::DiffImageApplier::GetInstanceForUndo()->ExecuteOperation(doOp);
-      }
+      std::stringstream comment;
+      comment << "Confirm all interpolations (" << sliceList.size() << ")";
+      mitk::SegTool2D::WriteSlicesToVolume(m_Segmentation, sliceList, comment.str());
     }
 
     m_FeedbackNode->SetData(nullptr);
@@ -1097,7 +1011,9 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
 
 void QmitkSlicesInterpolator::Run3DInterpolation()
 {
-  m_SurfaceInterpolator->Interpolate();
+  // Supersedes a running interpolation, the result is published by OnSurfaceInterpolationResultPublished()
+  this->StartUpdateInterpolationTimer();
+  m_SurfaceInterpolator->InterpolateAsync();
 }
 
 void QmitkSlicesInterpolator::StartUpdateInterpolationTimer()
@@ -1174,13 +1090,9 @@ void QmitkSlicesInterpolator::On3DInterpolationActivated(bool on)
             ret = msgBox.exec();
           }
 
-          if (m_Watcher.isRunning())
-            m_Watcher.waitForFinished();
-
           if (ret == QMessageBox::Yes)
           {
-            m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-            m_Watcher.setFuture(m_Future);
+            this->Run3DInterpolation();
           }
           else
           {
@@ -1243,13 +1155,17 @@ void QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged(const itk::Event
 {
   if (m_3DInterpolationEnabled)
   {
-    if (m_Watcher.isRunning())
-      m_Watcher.waitForFinished();
-    m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-    m_Watcher.setFuture(m_Future);
+    this->Run3DInterpolation();
   }
 }
 
+void QmitkSlicesInterpolator::OnSurfaceInterpolationResultPublished(const itk::EventObject & /*e*/)
+{
+  // Called from the interpolation thread of the controller
+  QMetaObject::invokeMethod(this, "OnSurfaceInterpolationFinished", Qt::QueuedConnection);
+  QMetaObject::invokeMethod(this, "StopUpdateInterpolationTimer", Qt::QueuedConnection);
+}
+
 void QmitkSlicesInterpolator::SetCurrentContourListID()
 {
   // New ContourList = hide current interpolation
@@ -1304,10 +1220,7 @@ void QmitkSlicesInterpolator::SetCurrentContourListID()
 
         if (m_3DInterpolationEnabled)
         {
-          if (m_Watcher.isRunning())
-            m_Watcher.waitForFinished();
-          m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-          m_Watcher.setFuture(m_Future);
+          this->Run3DInterpolation();
         }
       }
     }
@@ -1362,10 +1275,7 @@ void QmitkSlicesInterpolator::OnSliceNavigationControllerDeleted(const itk::Obje
 
 void QmitkSlicesInterpolator::WaitForFutures()
 {
-  if (m_Watcher.isRunning())
-  {
-    m_Watcher.waitForFinished();
-  }
+  m_SurfaceInterpolator->WaitForInterpolation();
 
   if (m_PlaneWatcher.isRunning())
   {
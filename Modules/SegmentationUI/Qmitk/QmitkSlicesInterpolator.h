@@ -114,6 +114,12 @@ public:
   */
   void OnSurfaceInterpolationInfoChanged(const itk::EventObject &);
 
+  /**
+    Just public because it is called by itk::Commands. You should not need to call this.
+    Called from the interpolation thread of the mitk::SurfaceInterpolationController.
+  */
+  void OnSurfaceInterpolationResultPublished(const itk::EventObject &);
+
   /**
    * @brief Set the visibility of the 3d interpolation
    */
@@ -249,6 +255,7 @@ private:
 
   unsigned int InterpolationInfoChangedObserverTag;
   unsigned int SurfaceInterpolationInfoChangedObserverTag;
+  unsigned int SurfaceInterpolationFinishedObserverTag;
 
   QGroupBox *m_GroupBoxEnableExclusiveInterpolationMode;
   QComboBox *m_CmbInterpolation;
@@ -278,8 +285,6 @@ private:
 
   mitk::DataStorage::Pointer m_DataStorage;
 
-  QFuture<void> m_Future;
-  QFutureWatcher<void> m_Watcher;
   QTimer *m_Timer;
 
   QFuture<void> m_PlaneFuture;
@@ -12,10 +12,14 @@ found in the LICENSE file.
 
 #include "QmitkToolGUI.h"
 
+#include <mitkAutoSegmentationWithPreviewTool.h>
+
 #include <iostream>
 
 QmitkToolGUI::~QmitkToolGUI()
 {
+  this->ConnectAsynchronousPreview(false);
+
   m_ReferenceCount = 0; // otherwise ITK will complain in LightObject's destructor
 }
 
@@ -36,7 +40,47 @@ void QmitkToolGUI::SetReferenceCount(int)
 
 void QmitkToolGUI::SetTool(mitk::Tool *tool)
 {
+  this->ConnectAsynchronousPreview(false);
+
   m_Tool = tool;
 
+  this->ConnectAsynchronousPreview(true);
+
   emit(NewToolAssociated(tool));
 }
+
+void QmitkToolGUI::ConnectAsynchronousPreview(bool connect)
+{
+  auto previewTool = dynamic_cast<mitk::AutoSegmentationWithPreviewTool *>(m_Tool.GetPointer());
+
+  if (nullptr == previewTool)
+    return;
+
+  if (connect)
+  {
+    previewTool->AsynchronousPreviewUpdated +=
+      mitk::MessageDelegate<QmitkToolGUI>(this, &QmitkToolGUI::OnAsynchronousPreviewUpdated);
+    previewTool->SetAsynchronousPreview(true);
+  }
+  else
+  {
+    // completes a running computation, so that no results are left for this GUI
+    previewTool->SetAsynchronousPreview(false);
+    previewTool->AsynchronousPreviewUpdated -=
+      mitk::MessageDelegate<QmitkToolGUI>(this, &QmitkToolGUI::OnAsynchronousPreviewUpdated);
+  }
+}
+
+void QmitkToolGUI::OnAsynchronousPreviewUpdated()
+{
+  // The results have to be transferred into the preview by the GUI thread
+  QMetaObject::invokeMethod(this, "ApplyAsynchronousPreview", Qt::QueuedConnection);
+}
+
+void QmitkToolGUI::ApplyAsynchronousPreview()
+{
+  auto previewTool = dynamic_cast<mitk::AutoSegmentationWithPreviewTool *>(m_Tool.GetPointer());
+
+  if (nullptr != previewTool)
+    previewTool->ApplyAsynchronousPreview();
+}
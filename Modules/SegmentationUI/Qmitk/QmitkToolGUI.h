@@ -53,10 +53,20 @@ public slots:
 
 protected slots:
 
+private slots:
+
+  void ApplyAsynchronousPreview();
+
 protected:
   mitk::Tool::Pointer m_Tool;
 
   virtual void BusyStateChanged(bool){};
+
+private:
+  /** Called from the worker thread of an auto segmentation tool, see mitk::AutoSegmentationWithPreviewTool */
+  void OnAsynchronousPreviewUpdated();
+
+  void ConnectAsynchronousPreview(bool connect);
 };
 
 #endif
@@ -14,11 +14,14 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImagePixelReadAccessor.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
 #include <vtkDebugLeaks.h>
 
+#include <limits>
+
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkCreateDistanceImageFromSurfaceFilterTestSuite);
@@ -26,6 +29,7 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestCreateDistanceImageForTubeWithTwoLevelSolver);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -84,6 +88,76 @@ public:
                            mitk::Equal(*(liverDistanceImageReference), *(liverDistanceImage), 0.0001, true));
   }
 
+  mitk::Image::Pointer CreateDistanceImageForTube(unsigned int maximumNumberOfDenseCenters)
+  {
+    std::vector<mitk::Surface::Pointer> contours;
+
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      std::stringstream s;
+      s << "SurfaceInterpolation/InterpolateWithHoles/ContourWithHoles_" << i << ".vtk";
+      contours.push_back(mitk::IOUtil::Load<mitk::Surface>(GetTestDataFilePath(s.str())));
+    }
+
+    mitk::Image::Pointer segmentationImage =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("SurfaceInterpolation/Reference/SegmentationWithHoles.nrrd"));
+
+    auto normalsFilter = mitk::ComputeContourSetNormalsFilter::New();
+    auto interpolateSurfaceFilter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    interpolateSurfaceFilter->SetMaximumNumberOfDenseCenters(maximumNumberOfDenseCenters);
+
+    normalsFilter->SetSegmentationBinaryImage(segmentationImage);
+    itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+    AccessFixedDimensionByItk_1(segmentationImage, GetImageBase, 3, itkImage);
+    interpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
+
+    for (unsigned int j = 0; j < contours.size(); j++)
+    {
+      normalsFilter->SetInput(j, contours.at(j));
+      interpolateSurfaceFilter->SetInput(j, normalsFilter->GetOutput(j));
+    }
+
+    interpolateSurfaceFilter->Update();
+    return interpolateSurfaceFilter->GetOutput();
+  }
+
+  // The two level solver approximates the exact interpolation, so the interpolated shapes must nearly agree.
+  // The shapes are compared by their Dice coefficient, since the background dominates the image.
+  void TestCreateDistanceImageForTubeWithTwoLevelSolver()
+  {
+    mitk::Image::Pointer exactDistanceImage = CreateDistanceImageForTube(std::numeric_limits<unsigned int>::max());
+    mitk::Image::Pointer distanceImage = CreateDistanceImageForTube(300);
+
+    CPPUNIT_ASSERT(mitk::Equal(*exactDistanceImage->GetGeometry(), *distanceImage->GetGeometry(), mitk::eps, true));
+
+    mitk::ImagePixelReadAccessor<double, 3> exactAccessor(exactDistanceImage);
+    mitk::ImagePixelReadAccessor<double, 3> accessor(distanceImage);
+
+    const unsigned int numberOfPixels =
+      distanceImage->GetDimension(0) * distanceImage->GetDimension(1) * distanceImage->GetDimension(2);
+
+    unsigned int numberOfExactInsidePixels = 0;
+    unsigned int numberOfInsidePixels = 0;
+    unsigned int numberOfCommonInsidePixels = 0;
+    for (unsigned int i = 0; i < numberOfPixels; ++i)
+    {
+      const bool exactInside = exactAccessor.GetData()[i] < 0;
+      const bool inside = accessor.GetData()[i] < 0;
+
+      numberOfExactInsidePixels += exactInside;
+      numberOfInsidePixels += inside;
+      numberOfCommonInsidePixels += exactInside && inside;
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that the exact interpolation has an inside", numberOfExactInsidePixels > 0);
+
+    const double dice =
+      2.0 * numberOfCommonInsidePixels / static_cast<double>(numberOfExactInsidePixels + numberOfInsidePixels);
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that the shapes of the two level solver and the exact one have a Dice coefficient of at least 0.98",
+                           dice >= 0.98);
+  }
+
   void TestCreateDistanceImageForTube()
   {
     // That's the number of available contours with holes in MITK-Data
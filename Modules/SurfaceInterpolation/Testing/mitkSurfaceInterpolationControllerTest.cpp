@@ -20,6 +20,9 @@ found in the LICENSE file.
 #include "mitkImagePixelWriteAccessor.h"
 #include "mitkImageTimeSelector.h"
 
+#include <algorithm>
+#include <atomic>
+
 class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkSurfaceInterpolationControllerTestSuite);
@@ -41,6 +44,7 @@ class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 
   MITK_TEST(TestAddNewContour);
   MITK_TEST(TestRemoveContour);
+  MITK_TEST(TestInterpolateAsync);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -512,6 +516,90 @@ public:
         mitk::Equal(*(surf_1->GetVtkPolyData()), *(remainingContour->GetVtkPolyData()), 0.000001, true) && success);
   }
 
+  /** Counts the finished events, which are invoked from the interpolation thread */
+  struct FinishedEventCounter
+  {
+    std::atomic<unsigned int> count;
+
+    FinishedEventCounter() : count(0) {}
+    void OnInterpolationFinished() { ++count; }
+  };
+
+  mitk::Surface::Pointer createCircularContour(double z)
+  {
+    double center[3] = {10.0, 10.0, z};
+    double normal[3] = {0.0, 0.0, 1.0};
+    vtkSmartPointer<vtkRegularPolygonSource> p_source = vtkSmartPointer<vtkRegularPolygonSource>::New();
+    p_source->SetNumberOfSides(40);
+    p_source->SetCenter(center);
+    p_source->SetRadius(5);
+    p_source->SetNormal(normal);
+    p_source->GeneratePolylineOff();
+    p_source->Update();
+    mitk::Surface::Pointer surf = mitk::Surface::New();
+    surf->SetVtkPolyData(p_source->GetOutput());
+    return surf;
+  }
+
+  void TestInterpolateAsync()
+  {
+    // Create empty segmentation image
+    unsigned int dimensions1[] = {20, 20, 20};
+    mitk::Image::Pointer segmentation_1 = createImage(dimensions1);
+    {
+      mitk::ImagePixelWriteAccessor<unsigned char, 3> accessor(segmentation_1);
+      std::fill_n(accessor.GetData(), 20 * 20 * 20, 0);
+    }
+    m_Controller->SetCurrentInterpolationSession(segmentation_1);
+    m_Controller->SetMinSpacing(1.0);
+    m_Controller->SetMaxSpacing(1.0);
+
+    FinishedEventCounter counter;
+    itk::SimpleMemberCommand<FinishedEventCounter>::Pointer command =
+      itk::SimpleMemberCommand<FinishedEventCounter>::New();
+    command->SetCallbackFunction(&counter, &FinishedEventCounter::OnInterpolationFinished);
+    unsigned long tag = m_Controller->AddObserver(mitk::SurfaceInterpolationFinishedEvent(), command);
+
+    // Start an interpolation for each added contour, only the last one has to be published
+    for (double z = 5.0; z < 16.0; z += 3.0)
+    {
+      m_Controller->AddNewContour(createCircularContour(z));
+      m_Controller->InterpolateAsync();
+    }
+    m_Controller->WaitForInterpolation();
+
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of contours!", m_Controller->GetNumberOfContours() == 4);
+    CPPUNIT_ASSERT_MESSAGE("No finished event was invoked!", counter.count >= 1);
+    CPPUNIT_ASSERT_MESSAGE("Interpolation result is missing!", m_Controller->GetInterpolationResult().IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Interpolation result is empty!",
+                           m_Controller->GetInterpolationResult()->GetVtkPolyData()->GetNumberOfPoints() > 0);
+    CPPUNIT_ASSERT_MESSAGE("Published result does not belong to the latest contours!",
+                           m_Controller->GetContoursAsSurface()->GetVtkPolyData()->GetNumberOfPolys() == 4);
+
+    // Adding a parallel contour reuses the cached reductions and yields the same result as a new computation
+    m_Controller->AddNewContour(createCircularContour(17.0));
+    m_Controller->Interpolate();
+    mitk::Surface::Pointer incrementalResult = m_Controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("Interpolation result is missing!", incrementalResult.IsNotNull());
+
+    // Changing the spacing invalidates the cache, so the second interpolation reduces all contours again
+    m_Controller->SetMinSpacing(2.0);
+    m_Controller->Interpolate();
+    m_Controller->SetMinSpacing(1.0);
+    m_Controller->Interpolate();
+    mitk::Surface::Pointer result = m_Controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("Interpolation result is missing!", result.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE(
+      "Incremental interpolation differs!",
+      mitk::Equal(*(result->GetVtkPolyData()), *(incrementalResult->GetVtkPolyData()), 0.000001, true));
+
+    // Changing the session cancels the result
+    m_Controller->RemoveInterpolationSession(segmentation_1);
+    CPPUNIT_ASSERT_MESSAGE("Interpolation result was not reset!", m_Controller->GetInterpolationResult().IsNull());
+
+    m_Controller->RemoveObserver(tag);
+  }
+
   bool AssertImagesEqual4D(mitk::Image *img1, mitk::Image *img2)
   {
     mitk::ImageTimeSelector::Pointer selector1 = mitk::ImageTimeSelector::New();
@@ -20,9 +20,51 @@ found in the LICENSE file.
 #include "vtkSmartPointer.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkNeighborhoodIterator.h"
 
-#include <queue>
+#include <mitkParallelFor.h>
+
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCore>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <set>
+
+namespace
+{
+  /** Support radius of the compactly supported functions in multiples of the distance image spacing */
+  const double SupportRadiusInSpacings = 6.0;
+
+  /** Number of chunks the rows of the sparse system are distributed to, each with its own triplet list */
+  const unsigned int NumberOfRowChunks = 64;
+
+  /** Fronts of the narrow band with fewer candidates are not distributed to several threads */
+  const std::size_t MinimumNumberOfParallelCandidates = 256;
+
+  /** Wendland's C2 function, positive definite in 3D, for the distance divided by the support radius */
+  inline double Wendland(double r)
+  {
+    if (r >= 1.0)
+      return 0.0;
+
+    const double s = 1.0 - r;
+    return s * s * s * s * (4.0 * r + 1.0);
+  }
+
+  /** Dense interpolation matrix for Phi(r) = r, with r is the euclidian distance between two centers */
+  void FillDenseSolutionMatrix(const mitk::CreateDistanceImageFromSurfaceFilter::CenterList &centers,
+                               Eigen::MatrixXd &matrix)
+  {
+    const auto numberOfCenters = centers.size();
+    matrix.resize(numberOfCenters, numberOfCenters);
+
+    mitk::ParallelFor(numberOfCenters, [&](std::size_t i) {
+      for (std::size_t j = 0; j < numberOfCenters; ++j)
+        matrix(i, j) = (centers[i] - centers[j]).two_norm();
+    });
+  }
+}
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,8 +147,12 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_SupportRadius(0.0),
+    m_MaximumNumberOfDenseCenters(3000),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0)
 {
+  m_CenterGridSize[0] = m_CenterGridSize[1] = m_CenterGridSize[2] = 0;
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 5;
@@ -125,12 +171,24 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   this->CreateEmptyDistanceImage();
 
   // First of all we have to build the equation-system from the existing contour-edge-points
-  this->CreateSolutionMatrixAndFunctionValues();
+  this->CreateCentersAndFunctionValues();
 
-  if (this->m_UseProgressBar)
-    mitk::ProgressBar::GetInstance()->Progress(1);
+  if (m_Centers.size() <= m_MaximumNumberOfDenseCenters)
+  {
+    this->CreateSolutionMatrix();
+
+    if (this->m_UseProgressBar)
+      mitk::ProgressBar::GetInstance()->Progress(1);
+
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  }
+  else
+  {
+    if (this->m_UseProgressBar)
+      mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+    this->SolveTwoLevelSystem();
+  }
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
@@ -143,6 +201,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   m_Centers.clear();
   m_Normals.clear();
+  m_CoarseCenters.clear();
+  m_CenterGridCells.clear();
+  m_SolutionMatrix.resize(0, 0);
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -168,6 +229,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   PointType currentPoint;
   PointType normal;
 
+  // the contours share their edge points, a set keeps the removal of the duplicates O(N log N)
+  std::set<std::array<double, 3>> uniquePoints;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto currentSurface = this->GetInput(i);
@@ -199,9 +263,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (uniquePoints.insert({{p[0], p[1], p[2]}}).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -218,7 +280,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   }     // end for all outputs
 }
 
-void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunctionValues()
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateCentersAndFunctionValues()
 {
   // For we can now calculate the exact size of the centers we initialize the data structures
   unsigned int numberOfCenters = m_Centers.size();
@@ -260,30 +322,132 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
 
     m_FunctionValues[numberOfCenters * 2 + i] = m_DistanceImageSpacing;
   }
+}
 
-  // Now we have created all centers and all function values. Next step is to create the solution matrix
-  numberOfCenters = m_Centers.size();
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrix()
+{
+  // Calculate the RBF values. Currently using Phi(r) = r with r is the euclidian distance between two points
+  FillDenseSolutionMatrix(m_Centers, m_SolutionMatrix);
+  m_Weights.resize(m_Centers.size());
+}
 
-  m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveTwoLevelSystem()
+{
+  const std::size_t numberOfCenters = m_Centers.size();
+  const std::size_t numberOfContourPoints = numberOfCenters / 3;
 
-  m_Weights.resize(numberOfCenters);
+  // The coarse level interpolates every n-th contour point with its inner and outer point. The contour points are
+  // ordered along the contours, so all contours are covered evenly.
+  const std::size_t stride =
+    (3 * numberOfContourPoints + m_MaximumNumberOfDenseCenters - 1) / std::max(3u, m_MaximumNumberOfDenseCenters);
 
-  PointType p1;
-  PointType p2;
-  double norm;
+  m_CoarseCenters.clear();
+  std::vector<double> coarseFunctionValues;
 
-  for (unsigned int i = 0; i < numberOfCenters; i++)
+  for (std::size_t level = 0; level < 3; ++level)
+  {
+    for (std::size_t i = 0; i < numberOfContourPoints; i += stride)
+    {
+      m_CoarseCenters.push_back(m_Centers[level * numberOfContourPoints + i]);
+      coarseFunctionValues.push_back(m_FunctionValues[level * numberOfContourPoints + i]);
+    }
+  }
+
+  Eigen::MatrixXd coarseMatrix;
+  FillDenseSolutionMatrix(m_CoarseCenters, coarseMatrix);
+  m_CoarseWeights =
+    coarseMatrix.partialPivLu().solve(Eigen::Map<Eigen::VectorXd>(coarseFunctionValues.data(), coarseFunctionValues.size()));
+
+  // The fine level interpolates the residual of the coarse level at all centers with compactly supported functions,
+  // which results in a sparse, symmetric positive definite system.
+  m_SupportRadius = SupportRadiusInSpacings * m_DistanceImageSpacing;
+  this->CreateCenterGrid();
+
+  Eigen::VectorXd residuals(numberOfCenters);
+  std::vector<std::vector<Eigen::Triplet<double>>> chunkTriplets(NumberOfRowChunks);
+  const std::size_t rowsPerChunk = (numberOfCenters + NumberOfRowChunks - 1) / NumberOfRowChunks;
+
+  mitk::ParallelFor(NumberOfRowChunks, [&](std::size_t chunk) {
+    const std::size_t firstRow = chunk * rowsPerChunk;
+    const std::size_t lastRow = std::min(numberOfCenters, firstRow + rowsPerChunk);
+
+    for (std::size_t i = firstRow; i < lastRow; ++i)
+    {
+      const PointType &center = m_Centers[i];
+
+      double coarseValue = 0.0;
+      for (std::size_t j = 0; j < m_CoarseCenters.size(); ++j)
+        coarseValue += (center - m_CoarseCenters[j]).two_norm() * m_CoarseWeights[j];
+
+      residuals[i] = m_FunctionValues[i] - coarseValue;
+
+      int cell[3];
+      for (int d = 0; d < 3; ++d)
+        cell[d] = static_cast<int>((center[d] - m_CenterGridOrigin[d]) / m_SupportRadius);
+
+      for (int z = std::max(0, cell[2] - 1); z <= std::min(m_CenterGridSize[2] - 1, cell[2] + 1); ++z)
+        for (int y = std::max(0, cell[1] - 1); y <= std::min(m_CenterGridSize[1] - 1, cell[1] + 1); ++y)
+          for (int x = std::max(0, cell[0] - 1); x <= std::min(m_CenterGridSize[0] - 1, cell[0] + 1); ++x)
+            for (auto j : m_CenterGridCells[(z * m_CenterGridSize[1] + y) * m_CenterGridSize[0] + x])
+            {
+              const double value = Wendland((center - m_Centers[j]).two_norm() / m_SupportRadius);
+              if (value > 0.0)
+                chunkTriplets[chunk].emplace_back(static_cast<int>(i), static_cast<int>(j), value);
+            }
+    }
+  });
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (auto &chunk : chunkTriplets)
+  {
+    triplets.insert(triplets.end(), chunk.begin(), chunk.end());
+    std::vector<Eigen::Triplet<double>>().swap(chunk);
+  }
+
+  Eigen::SparseMatrix<double> solutionMatrix(numberOfCenters, numberOfCenters);
+  solutionMatrix.setFromTriplets(triplets.begin(), triplets.end());
+  std::vector<Eigen::Triplet<double>>().swap(triplets);
+
+  Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> solver;
+  solver.setTolerance(1e-8);
+  solver.compute(solutionMatrix);
+  m_Weights = solver.solve(residuals);
+
+  if (solver.info() != Eigen::Success)
   {
-    for (unsigned int j = 0; j < numberOfCenters; j++)
+    MITK_WARN << "mitk::CreateDistanceImageFromSurfaceFilter: The sparse interpolation did not converge after "
+              << solver.iterations() << " iterations (estimated error " << solver.error() << ").";
+  }
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateCenterGrid()
+{
+  m_CenterGridOrigin = m_Centers.front();
+  PointType maximum = m_Centers.front();
+
+  for (const auto &center : m_Centers)
+  {
+    for (int d = 0; d < 3; ++d)
     {
-      // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidian distance between two points
-      p1 = m_Centers.at(i);
-      p2 = m_Centers.at(j);
-      p1 = p1 - p2;
-      norm = p1.two_norm();
-      m_SolutionMatrix(i, j) = norm;
+      m_CenterGridOrigin[d] = std::min(m_CenterGridOrigin[d], center[d]);
+      maximum[d] = std::max(maximum[d], center[d]);
     }
   }
+
+  for (int d = 0; d < 3; ++d)
+    m_CenterGridSize[d] = static_cast<int>((maximum[d] - m_CenterGridOrigin[d]) / m_SupportRadius) + 1;
+
+  m_CenterGridCells.assign(static_cast<std::size_t>(m_CenterGridSize[0]) * m_CenterGridSize[1] * m_CenterGridSize[2],
+                           std::vector<unsigned int>());
+
+  for (unsigned int i = 0; i < m_Centers.size(); ++i)
+  {
+    int cell[3];
+    for (int d = 0; d < 3; ++d)
+      cell[d] = static_cast<int>((m_Centers[i][d] - m_CenterGridOrigin[d]) / m_SupportRadius);
+
+    m_CenterGridCells[(cell[2] * m_CenterGridSize[1] + cell[1]) * m_CenterGridSize[0] + cell[0]].push_back(i);
+  }
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
@@ -300,9 +464,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   */
 
   typedef itk::ImageRegionIteratorWithIndex<DistanceImageType> ImageIterator;
-  typedef itk::NeighborhoodIterator<DistanceImageType> NeighborhoodImageIterator;
 
-  std::queue<DistanceImageType::IndexType> narrowbandPoints;
   PointType currentPoint = m_Centers.at(0);
   double distance = this->CalculateDistanceValue(currentPoint);
 
@@ -316,49 +478,72 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   DistanceImageType::IndexType currentIndex;
   m_DistanceImageITK->TransformPhysicalPointToIndex(currentPointAsPoint, currentIndex);
 
-  assert(
-    m_DistanceImageITK->GetLargestPossibleRegion().IsInside(currentIndex)); // we are quite certain this should hold
+  const DistanceImageType::RegionType region = m_DistanceImageITK->GetLargestPossibleRegion();
+  assert(region.IsInside(currentIndex)); // we are quite certain this should hold
 
-  narrowbandPoints.push(currentIndex);
   m_DistanceImageITK->SetPixel(currentIndex, distance);
 
-  NeighborhoodImageIterator::RadiusType radius;
-  radius.Fill(1);
-  NeighborhoodImageIterator nIt(radius, m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
-  unsigned int relativeNbIdx[] = {4, 10, 12, 14, 16, 22};
+  // The narrowband grows in layers. The neighbors of a layer are evaluated concurrently, the distance function only
+  // depends on the position. Each pixel is evaluated at most once, as its distance does not change.
+  std::vector<bool> isEvaluated(region.GetNumberOfPixels(), false);
+  isEvaluated[m_DistanceImageITK->ComputeOffset(currentIndex)] = true;
+
+  std::vector<DistanceImageType::IndexType> narrowbandPoints(1, currentIndex);
+  std::vector<DistanceImageType::IndexType> candidates;
+  std::vector<double> distances;
 
-  bool isInBounds = false;
   while (!narrowbandPoints.empty())
   {
-    nIt.SetLocation(narrowbandPoints.front());
-    narrowbandPoints.pop();
+    candidates.clear();
 
-    unsigned int *relativeNb = &relativeNbIdx[0];
-    for (int i = 0; i < 6; i++)
+    for (const auto &index : narrowbandPoints)
     {
-      nIt.GetPixel(*relativeNb, isInBounds);
-      if (isInBounds && nIt.GetPixel(*relativeNb) == m_DistanceImageDefaultBufferValue)
+      for (unsigned int dim = 0; dim < 3; ++dim)
       {
-        currentIndex = nIt.GetIndex(*relativeNb);
+        for (int direction = -1; direction <= 1; direction += 2)
+        {
+          currentIndex = index;
+          currentIndex[dim] += direction;
+
+          if (!region.IsInside(currentIndex))
+            continue;
+
+          const auto offset = m_DistanceImageITK->ComputeOffset(currentIndex);
+          if (!isEvaluated[offset])
+          {
+            isEvaluated[offset] = true;
+            candidates.push_back(currentIndex);
+          }
+        }
+      }
+    }
 
-        // Transform the currently checked point from index-coordinates to
-        // world-coordinates
-        m_DistanceImageITK->TransformIndexToPhysicalPoint(currentIndex, currentPointAsPoint);
+    distances.resize(candidates.size());
+    // Small fronts are evaluated in the calling thread, starting the threads would take longer
+    const unsigned int maximumNumberOfThreads = candidates.size() < MinimumNumberOfParallelCandidates ? 1 : 0;
 
-        // create a vnl_vector
-        currentPoint[0] = currentPointAsPoint[0];
-        currentPoint[1] = currentPointAsPoint[1];
-        currentPoint[2] = currentPointAsPoint[2];
+    mitk::ParallelFor(candidates.size(), [&](std::size_t i) {
+      // Transform the currently checked point from index-coordinates to world-coordinates
+      DistanceImageType::PointType candidatePoint;
+      m_DistanceImageITK->TransformIndexToPhysicalPoint(candidates[i], candidatePoint);
 
-        // and check the distance
-        distance = this->CalculateDistanceValue(currentPoint);
-        if (std::fabs(distance) <= m_DistanceImageSpacing * 2)
-        {
-          nIt.SetPixel(*relativeNb, distance);
-          narrowbandPoints.push(currentIndex);
-        }
+      PointType candidate;
+      candidate[0] = candidatePoint[0];
+      candidate[1] = candidatePoint[1];
+      candidate[2] = candidatePoint[2];
+
+      distances[i] = this->CalculateDistanceValue(candidate);
+    }, maximumNumberOfThreads);
+
+    narrowbandPoints.clear();
+
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+      if (std::fabs(distances[i]) <= m_DistanceImageSpacing * 2)
+      {
+        m_DistanceImageITK->SetPixel(candidates[i], distances[i]);
+        narrowbandPoints.push_back(candidates[i]);
       }
-      relativeNb++;
     }
   }
 
@@ -419,24 +604,32 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
-double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(const PointType &p) const
 {
   double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
 
-  CenterList::iterator centerIter;
-
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
+  if (m_CoarseCenters.empty())
   {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
+    for (std::size_t i = 0; i < m_Centers.size(); ++i)
+      distanceValue += (p - m_Centers[i]).two_norm() * m_Weights[i];
+
+    return distanceValue;
   }
+
+  for (std::size_t i = 0; i < m_CoarseCenters.size(); ++i)
+    distanceValue += (p - m_CoarseCenters[i]).two_norm() * m_CoarseWeights[i];
+
+  // only the centers in the neighboring grid cells are within the support radius
+  int cell[3];
+  for (int d = 0; d < 3; ++d)
+    cell[d] = static_cast<int>(std::floor((p[d] - m_CenterGridOrigin[d]) / m_SupportRadius));
+
+  for (int z = std::max(0, cell[2] - 1); z <= std::min(m_CenterGridSize[2] - 1, cell[2] + 1); ++z)
+    for (int y = std::max(0, cell[1] - 1); y <= std::min(m_CenterGridSize[1] - 1, cell[1] + 1); ++y)
+      for (int x = std::max(0, cell[0] - 1); x <= std::min(m_CenterGridSize[0] - 1, cell[0] + 1); ++x)
+        for (auto i : m_CenterGridCells[(z * m_CenterGridSize[1] + y) * m_CenterGridSize[0] + x])
+          distanceValue += Wendland((p - m_Centers[i]).two_norm() / m_SupportRadius) * m_Weights[i];
+
   return distanceValue;
 }
 
@@ -99,6 +99,19 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the number of centers (the contour points and the inner and outer points derived from them) up to
+           which the interpolation is solved exactly with a dense LU decomposition. Default is 3000.
+
+           Larger inputs are interpolated in two levels: a dense solution for an evenly subsampled part of the
+           contour points captures the overall shape, and compactly supported Wendland functions on all points
+           refine it near the contours. Their sparse system is solved with conjugate gradients, so the memory
+           grows linearly instead of quadratically and the solving time no longer cubically with the number of
+           contour points.
+    */
+    itkSetMacro(MaximumNumberOfDenseCenters, unsigned int);
+    itkGetMacro(MaximumNumberOfDenseCenters, unsigned int);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -127,8 +140,22 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
-    void CreateSolutionMatrixAndFunctionValues();
-    double CalculateDistanceValue(PointType p);
+    void CreateSolutionMatrix();
+    void CreateCentersAndFunctionValues();
+
+    /**
+    * \brief Solves the interpolation for many centers, see SetMaximumNumberOfDenseCenters().
+    *
+    * Fills m_CoarseCenters and m_CoarseWeights with the dense solution for the subsampled centers, and m_Weights
+    * with the weights of the compactly supported functions that interpolate the remaining residual at all centers.
+    */
+    void SolveTwoLevelSystem();
+
+    /** \brief Sorts the centers into a uniform grid with the support radius as cell size */
+    void CreateCenterGrid();
+
+    /** \brief Evaluates the interpolated distance function, may be called concurrently */
+    double CalculateDistanceValue(const PointType &p) const;
 
     void FillDistanceImage();
 
@@ -162,6 +189,17 @@ namespace mitk
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
+    // Coarse level of the two level interpolation, empty if the exact dense solution is used
+    CenterList m_CoarseCenters;
+    Eigen::VectorXd m_CoarseWeights;
+
+    // Lookup of the centers within the support radius of the compactly supported functions
+    double m_SupportRadius;
+    PointType m_CenterGridOrigin;
+    int m_CenterGridSize[3];
+    std::vector<std::vector<unsigned int>> m_CenterGridCells;
+    unsigned int m_MaximumNumberOfDenseCenters;
+
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
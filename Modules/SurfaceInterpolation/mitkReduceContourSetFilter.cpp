@@ -23,6 +23,7 @@ mitk::ReduceContourSetFilter::ReduceContourSetFilter()
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 1;
   m_NumberOfPointsAfterReduction = 0;
+  m_NumberOfReducedInputs = 0;
 
   mitk::Surface::Pointer output = mitk::Surface::New();
   this->SetNthOutput(0, output.GetPointer());
@@ -48,6 +49,9 @@ void mitk::ReduceContourSetFilter::GenerateData()
   unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
   unsigned int numberOfOutputs(0);
 
+  if (m_NumberOfReducedInputs != 0 && m_NumberOfReducedInputs < numberOfInputs)
+    numberOfInputs = m_NumberOfReducedInputs;
+
   vtkSmartPointer<vtkPolyData> newPolyData;
   vtkSmartPointer<vtkCellArray> newPolygons;
   vtkSmartPointer<vtkPoints> newPoints;
@@ -75,6 +75,15 @@ namespace mitk
 
     itkGetMacro(NumberOfPointsAfterReduction, unsigned int);
 
+    /**
+      \brief Restricts the reduction to the first n inputs, 0 (default) reduces all inputs
+
+      The remaining inputs are only used to detect polygons of the reduced inputs which are intersections with
+      the planes of other contours. This allows to update the reduction of single contours of a contour set.
+    */
+    itkSetMacro(NumberOfReducedInputs, unsigned int);
+    itkGetConstMacro(NumberOfReducedInputs, unsigned int);
+
     // Resets the filter, i.e. removes all inputs and outputs
     void Reset();
 
@@ -128,6 +137,8 @@ namespace mitk
 
     unsigned int m_NumberOfPointsAfterReduction;
 
+    unsigned int m_NumberOfReducedInputs;
+
   }; // class
 
 } // namespace
@@ -19,6 +19,16 @@ found in the LICENSE file.
 //#include "vtkXMLPolyDataWriter.h"
 #include "vtkPolyDataWriter.h"
 
+// Check whether the normals of the given contours are parallel but not necessarily of the same orientation
+bool ContoursParallel(const mitk::SurfaceInterpolationController::ContourPositionInformation &leftHandSide,
+                      const mitk::SurfaceInterpolationController::ContourPositionInformation &rightHandSide)
+{
+  double lengthLHS = leftHandSide.contourNormal.GetNorm();
+  double lengthRHS = rightHandSide.contourNormal.GetNorm();
+  double dot = leftHandSide.contourNormal * rightHandSide.contourNormal;
+  return mitk::Equal(fabs(lengthLHS * lengthRHS), fabs(dot), 0.001);
+}
+
 // Check whether the given contours are coplanar
 bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInformation leftHandSide,
                       mitk::SurfaceInterpolationController::ContourPositionInformation rightHandSide)
@@ -42,18 +52,8 @@ bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInfor
   n[2] = rightHandSide.contourNormal[2];
   double dot = vtkMath::Dot(n, vec);
 
-  double n2[3];
-  n2[0] = leftHandSide.contourNormal[0];
-  n2[1] = leftHandSide.contourNormal[1];
-  n2[2] = leftHandSide.contourNormal[2];
-
   // The normals of both contours have to be parallel but not of the same orientation
-  double lengthLHS = leftHandSide.contourNormal.GetNorm();
-  double lengthRHS = rightHandSide.contourNormal.GetNorm();
-  double dot2 = vtkMath::Dot(n, n2);
-  bool contoursParallel = mitk::Equal(fabs(lengthLHS * lengthRHS), fabs(dot2), 0.001);
-
-  if (mitk::Equal(dot, 0.0, 0.001) && contoursParallel)
+  if (mitk::Equal(dot, 0.0, 0.001) && ContoursParallel(leftHandSide, rightHandSide))
     return true;
   else
     return false;
@@ -74,21 +74,16 @@ mitk::SurfaceInterpolationController::ContourPositionInformation CreateContourPo
 }
 
 mitk::SurfaceInterpolationController::SurfaceInterpolationController()
-  : m_SelectedSegmentation(nullptr), m_CurrentTimePoint(0.)
+  : m_MinSpacing(-1.0),
+    m_MaxSpacing(-1.0),
+    m_DistanceImageVolume(50000),
+    m_DistanceImageSpacing(0.0),
+    m_Generation(0),
+    m_JobRunning(false),
+    m_StopInterpolationThread(false),
+    m_SelectedSegmentation(nullptr),
+    m_CurrentTimePoint(0.)
 {
-  m_DistanceImageSpacing = 0.0;
-  m_ReduceFilter = ReduceContourSetFilter::New();
-  m_NormalsFilter = ComputeContourSetNormalsFilter::New();
-  m_InterpolateSurfaceFilter = CreateDistanceImageFromSurfaceFilter::New();
-  // m_TimeSelector = ImageTimeSelector::New();
-
-  m_ReduceFilter->SetUseProgressBar(false);
-  //  m_ReduceFilter->SetProgressStepSize(1);
-  m_NormalsFilter->SetUseProgressBar(true);
-  m_NormalsFilter->SetProgressStepSize(1);
-  m_InterpolateSurfaceFilter->SetUseProgressBar(true);
-  m_InterpolateSurfaceFilter->SetProgressStepSize(7);
-
   m_Contours = Surface::New();
 
   m_PolyData = vtkSmartPointer<vtkPolyData>::New();
@@ -96,11 +91,21 @@ mitk::SurfaceInterpolationController::SurfaceInterpolationController()
   m_PolyData->SetPoints(points);
 
   m_InterpolationResult = nullptr;
-  m_CurrentNumberOfReducedContours = 0;
 }
 
 mitk::SurfaceInterpolationController::~SurfaceInterpolationController()
 {
+  {
+    std::lock_guard<std::mutex> lock(m_JobMutex);
+    m_StopInterpolationThread = true;
+    m_PendingJob.reset();
+    ++m_Generation;
+  }
+  m_JobChanged.notify_all();
+
+  if (m_InterpolationThread.joinable())
+    m_InterpolationThread.join();
+
   // Removing all observers
   auto dataIter = m_SegmentationObserverTags.begin();
   for (; dataIter != m_SegmentationObserverTags.end(); ++dataIter)
@@ -177,14 +182,11 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
   // Don't save a new empty contour
   if (pos == -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
-    m_ReduceFilter->SetInput(m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size(),
-                             newContour);
     m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].push_back(contourInfo);
   }
   else if (pos != -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
     m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].at(pos) = contourInfo;
-    m_ReduceFilter->SetInput(pos, newContour);
   }
   else if (newContour->GetVtkPolyData()->GetNumberOfPoints() == 0)
   {
@@ -262,88 +264,293 @@ unsigned int mitk::SurfaceInterpolationController::GetNumberOfContours()
 
 void mitk::SurfaceInterpolationController::Interpolate()
 {
+  this->InterpolateAsync();
+  this->WaitForInterpolation();
+}
+
+void mitk::SurfaceInterpolationController::InterpolateAsync()
+{
+  // Without a valid session the interpolation finishes immediately without a result
+  if (!m_SelectedSegmentation)
+  {
+    this->CancelInterpolation();
+    this->InvokeEvent(SurfaceInterpolationFinishedEvent());
+    return;
+  }
+
   if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
   {
     MITK_WARN << "No interpolation possible, currently selected timepoint is not in the time bounds of currently selected segmentation. Time point: " << m_CurrentTimePoint;
-    m_InterpolationResult = nullptr;
+    this->CancelInterpolation();
+    this->InvokeEvent(SurfaceInterpolationFinishedEvent());
     return;
   }
   const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
 
-  m_ReduceFilter->Update();
-
-  m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-  if (m_CurrentNumberOfReducedContours == 1)
-  {
-    vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-    if (tmp == nullptr)
-    {
-      m_CurrentNumberOfReducedContours = 0;
-    }
-  }
+  // The job works on a snapshot, so the contours may be changed while it is running
+  std::unique_ptr<InterpolationJob> job(new InterpolationJob);
+  job->contours = m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep];
+  job->timeStep = currentTimeStep;
+  job->minSpacing = m_MinSpacing;
+  job->maxSpacing = m_MaxSpacing;
+  job->distanceImageVolume = m_DistanceImageVolume;
 
   mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
   timeSelector->SetInput(m_SelectedSegmentation);
   timeSelector->SetTimeNr(currentTimeStep);
   timeSelector->SetChannelNr(0);
   timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
 
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-  for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
+  // The time step image shares the pixel data of the segmentation, which is edited while the job is running
+  job->segmentation = timeSelector->GetOutput()->Clone();
+
+  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+  AccessFixedDimensionByItk_1(job->segmentation, GetImageBase, 3, itkImage);
+  job->referenceImage = itkImage;
+
   {
-    mitk::Surface::Pointer reducedContour = m_ReduceFilter->GetOutput(i);
-    reducedContour->DisconnectPipeline();
-    m_NormalsFilter->SetInput(i, reducedContour);
-    m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
+    std::lock_guard<std::mutex> lock(m_JobMutex);
+    job->generation = ++m_Generation;
+    m_PendingJob = std::move(job);
+
+    if (!m_InterpolationThread.joinable())
+      m_InterpolationThread = std::thread(&SurfaceInterpolationController::RunInterpolationThread, this);
   }
+  m_JobChanged.notify_all();
+}
+
+void mitk::SurfaceInterpolationController::WaitForInterpolation()
+{
+  std::unique_lock<std::mutex> lock(m_JobMutex);
+  m_JobChanged.wait(lock, [this]() { return m_StopInterpolationThread || (!m_PendingJob && !m_JobRunning); });
+}
 
-  if (m_CurrentNumberOfReducedContours < 2)
+void mitk::SurfaceInterpolationController::CancelInterpolation()
+{
   {
-    // If no interpolation is possible reset the interpolation result
+    std::lock_guard<std::mutex> jobLock(m_JobMutex);
+    ++m_Generation;
+    m_PendingJob.reset();
+
+    std::lock_guard<std::mutex> resultLock(m_ResultMutex);
     m_InterpolationResult = nullptr;
+  }
+  m_JobChanged.notify_all();
+}
+
+void mitk::SurfaceInterpolationController::RunInterpolationThread()
+{
+  std::unique_lock<std::mutex> lock(m_JobMutex);
+
+  while (true)
+  {
+    m_JobChanged.wait(lock, [this]() { return m_StopInterpolationThread || m_PendingJob; });
+
+    if (m_StopInterpolationThread)
+      return;
+
+    std::unique_ptr<InterpolationJob> job = std::move(m_PendingJob);
+    m_JobRunning = true;
+    lock.unlock();
+
+    try
+    {
+      this->ExecuteInterpolationJob(*job);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "Surface interpolation failed: " << e.what();
+    }
+
+    job.reset();
+
+    lock.lock();
+    m_JobRunning = false;
+    m_JobChanged.notify_all();
+  }
+}
+
+bool mitk::SurfaceInterpolationController::IsSuperseded(const InterpolationJob &job) const
+{
+  std::lock_guard<std::mutex> lock(m_JobMutex);
+  return job.generation != m_Generation;
+}
+
+bool mitk::SurfaceInterpolationController::UpdateContourCache(const InterpolationJob &job)
+{
+  // Only the contours of the job are kept, the cache entries of removed or replaced contours are dropped
+  ContourCache contourCache;
+
+  for (std::size_t i = 0; i < job.contours.size(); ++i)
+  {
+    if (this->IsSuperseded(job))
+      return false;
+
+    Surface::ConstPointer contour = job.contours[i].contour.GetPointer();
+
+    // The reduction drops polygons lying in the plane of another contour. Coplanar contours are merged on
+    // insertion and parallel ones are at least one slice apart, so only contours in other planes matter.
+    std::vector<Surface::ConstPointer> intersectingContours;
+    for (std::size_t j = 0; j < job.contours.size(); ++j)
+    {
+      if (j != i && !ContoursParallel(job.contours[i], job.contours[j]))
+        intersectingContours.push_back(job.contours[j].contour.GetPointer());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_CacheMutex);
+      auto cachedContour = m_ContourCache.find(contour);
+      if (cachedContour != m_ContourCache.end() && cachedContour->second.minSpacing == job.minSpacing &&
+          cachedContour->second.maxSpacing == job.maxSpacing &&
+          cachedContour->second.intersectingContours == intersectingContours)
+      {
+        contourCache.insert(*cachedContour);
+        continue;
+      }
+    }
+
+    CachedContour cachedContour;
+    cachedContour.contour = contour;
+    cachedContour.minSpacing = job.minSpacing;
+    cachedContour.maxSpacing = job.maxSpacing;
+    cachedContour.intersectingContours = intersectingContours;
+
+    ReduceContourSetFilter::Pointer reduceFilter = ReduceContourSetFilter::New();
+    reduceFilter->SetMinSpacing(job.minSpacing);
+    reduceFilter->SetMaxSpacing(job.maxSpacing);
+    reduceFilter->SetNumberOfReducedInputs(1);
+    reduceFilter->SetInput(0, contour);
+    for (unsigned int j = 0; j < intersectingContours.size(); ++j)
+      reduceFilter->SetInput(j + 1, intersectingContours[j]);
+    reduceFilter->Update();
+
+    cachedContour.numberOfPointsAfterReduction = reduceFilter->GetNumberOfPointsAfterReduction();
+
+    Surface::Pointer reducedContour = reduceFilter->GetOutput(0);
+    if (reducedContour->GetVtkPolyData()->GetNumberOfPolys() > 0)
+    {
+      reducedContour->DisconnectPipeline();
+
+      ComputeContourSetNormalsFilter::Pointer normalsFilter = ComputeContourSetNormalsFilter::New();
+      normalsFilter->SetSegmentationBinaryImage(job.segmentation);
+      if (job.maxSpacing > 0)
+        normalsFilter->SetMaxSpacing(job.maxSpacing);
+      normalsFilter->SetInput(0, reducedContour);
+      normalsFilter->Update();
+
+      cachedContour.reducedContour = normalsFilter->GetOutput(0);
+      cachedContour.reducedContour->DisconnectPipeline();
+    }
+
+    contourCache[contour] = cachedContour;
+  }
+
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  m_ContourCache.swap(contourCache);
+  return true;
+}
+
+void mitk::SurfaceInterpolationController::ExecuteInterpolationJob(const InterpolationJob &job)
+{
+  if (!this->UpdateContourCache(job))
     return;
+
+  Surface::Pointer contours = Surface::New();
+  if (!job.contours.empty())
+  {
+    vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
+    for (const auto &contourInfo : job.contours)
+      polyDataAppender->AddInputData(contourInfo.contour->GetVtkPolyData());
+    polyDataAppender->Update();
+    contours->SetVtkPolyData(polyDataAppender->GetOutput());
   }
 
-  // Setting up progress bar
-  mitk::ProgressBar::GetInstance()->AddStepsToDo(10);
+  CreateDistanceImageFromSurfaceFilter::Pointer interpolateSurfaceFilter = CreateDistanceImageFromSurfaceFilter::New();
+  interpolateSurfaceFilter->SetReferenceImage(job.referenceImage);
+  interpolateSurfaceFilter->SetDistanceImageVolume(job.distanceImageVolume);
+
+  unsigned int numberOfReducedContours = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+    for (const auto &contourInfo : job.contours)
+    {
+      const CachedContour &cachedContour = m_ContourCache.at(contourInfo.contour.GetPointer());
+      if (cachedContour.reducedContour.IsNotNull())
+        interpolateSurfaceFilter->SetInput(numberOfReducedContours++, cachedContour.reducedContour);
+    }
+  }
+
+  if (numberOfReducedContours < 2)
+  {
+    // If no interpolation is possible reset the interpolation result
+    this->PublishInterpolationResult(job, nullptr, contours, nullptr, 0.0);
+    return;
+  }
+
+  interpolateSurfaceFilter->Update();
+
+  if (this->IsSuperseded(job))
+    return;
+
+  Image::Pointer distanceImage = interpolateSurfaceFilter->GetOutput();
+  distanceImage->DisconnectPipeline();
 
   // create a surface from the distance-image
   mitk::ImageToSurfaceFilter::Pointer imageToSurfaceFilter = mitk::ImageToSurfaceFilter::New();
-  imageToSurfaceFilter->SetInput(m_InterpolateSurfaceFilter->GetOutput());
+  imageToSurfaceFilter->SetInput(distanceImage);
   imageToSurfaceFilter->SetThreshold(0);
   imageToSurfaceFilter->SetSmooth(true);
   imageToSurfaceFilter->SetSmoothIteration(20);
   imageToSurfaceFilter->Update();
 
   mitk::Surface::Pointer interpolationResult = mitk::Surface::New();
-  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), currentTimeStep);
-  m_InterpolationResult = interpolationResult;
+  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), job.timeStep);
 
-  m_DistanceImageSpacing = m_InterpolateSurfaceFilter->GetDistanceImageSpacing();
+  this->PublishInterpolationResult(
+    job, interpolationResult, contours, distanceImage, interpolateSurfaceFilter->GetDistanceImageSpacing());
+}
 
-  vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
-  for (unsigned int i = 0; i < m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size(); i++)
+bool mitk::SurfaceInterpolationController::PublishInterpolationResult(const InterpolationJob &job,
+                                                                      Surface::Pointer interpolationResult,
+                                                                      Surface::Pointer contours,
+                                                                      Image::Pointer distanceImage,
+                                                                      double distanceImageSpacing)
+{
   {
-    polyDataAppender->AddInputData(
-      m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].at(i).contour->GetVtkPolyData());
-  }
-  polyDataAppender->Update();
-  m_Contours->SetVtkPolyData(polyDataAppender->GetOutput());
+    std::lock_guard<std::mutex> jobLock(m_JobMutex);
+    if (job.generation != m_Generation)
+      return false;
 
-  // Last progress step
-  mitk::ProgressBar::GetInstance()->Progress(20);
+    std::lock_guard<std::mutex> resultLock(m_ResultMutex);
+    m_InterpolationResult = interpolationResult;
+    m_Contours = contours;
 
-  m_InterpolationResult->DisconnectPipeline();
+    if (distanceImage.IsNotNull())
+    {
+      m_DistanceImage = distanceImage;
+      m_DistanceImageSpacing = distanceImageSpacing;
+    }
+  }
+
+  this->InvokeEvent(SurfaceInterpolationFinishedEvent());
+  return true;
 }
 
 mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetInterpolationResult()
 {
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
   return m_InterpolationResult;
 }
 
-mitk::Surface *mitk::SurfaceInterpolationController::GetContoursAsSurface()
+double mitk::SurfaceInterpolationController::GetDistanceImageSpacing() const
+{
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
+  return m_DistanceImageSpacing;
+}
+
+mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetContoursAsSurface()
 {
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
   return m_Contours;
 }
 
@@ -354,18 +561,17 @@ void mitk::SurfaceInterpolationController::SetDataStorage(DataStorage::Pointer d
 
 void mitk::SurfaceInterpolationController::SetMinSpacing(double minSpacing)
 {
-  m_ReduceFilter->SetMinSpacing(minSpacing);
+  m_MinSpacing = minSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetMaxSpacing(double maxSpacing)
 {
-  m_ReduceFilter->SetMaxSpacing(maxSpacing);
-  m_NormalsFilter->SetMaxSpacing(maxSpacing);
+  m_MaxSpacing = maxSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetDistanceImageVolume(unsigned int distImgVolume)
 {
-  m_InterpolateSurfaceFilter->SetDistanceImageVolume(distImgVolume);
+  m_DistanceImageVolume = distImgVolume;
 }
 
 mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentation()
@@ -373,14 +579,35 @@ mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentatio
   return m_SelectedSegmentation;
 }
 
-mitk::Image *mitk::SurfaceInterpolationController::GetImage()
+mitk::Image::Pointer mitk::SurfaceInterpolationController::GetImage()
 {
-  return m_InterpolateSurfaceFilter->GetOutput();
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
+  return m_DistanceImage;
 }
 
 double mitk::SurfaceInterpolationController::EstimatePortionOfNeededMemory()
 {
-  double numberOfPointsAfterReduction = m_ReduceFilter->GetNumberOfPointsAfterReduction() * 3;
+  // Contours which have not been reduced yet are estimated by their number of points
+  double numberOfPointsAfterReduction = 0.0;
+  if (m_SelectedSegmentation && m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
+  {
+    const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
+    const ContourPositionInformationVec2D &contours = m_ListOfInterpolationSessions[m_SelectedSegmentation];
+
+    if (currentTimeStep < contours.size())
+    {
+      std::lock_guard<std::mutex> lock(m_CacheMutex);
+      for (const auto &contourInfo : contours[currentTimeStep])
+      {
+        auto cachedContour = m_ContourCache.find(contourInfo.contour.GetPointer());
+        numberOfPointsAfterReduction += cachedContour != m_ContourCache.end()
+                                          ? cachedContour->second.numberOfPointsAfterReduction
+                                          : contourInfo.contour->GetVtkPolyData()->GetNumberOfPoints();
+      }
+    }
+  }
+
+  numberOfPointsAfterReduction *= 3;
   double sizeOfPoints = pow(numberOfPointsAfterReduction, 2) * sizeof(double);
   double totalMem = mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam();
   double percentage = sizeOfPoints / totalMem;
@@ -411,6 +638,7 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
 
   if (currentSegmentationImage.IsNull())
   {
+    this->CancelInterpolation();
     m_SelectedSegmentation = nullptr;
     return;
   }
@@ -425,8 +653,6 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
     ContourPositionInformationVec2D newList;
     m_ListOfInterpolationSessions.insert(
       std::pair<mitk::Image *, ContourPositionInformationVec2D>(m_SelectedSegmentation, newList));
-    m_InterpolationResult = nullptr;
-    m_CurrentNumberOfReducedContours = 0;
 
     itk::MemberCommand<SurfaceInterpolationController>::Pointer command =
       itk::MemberCommand<SurfaceInterpolationController>::New();
@@ -473,16 +699,6 @@ bool mitk::SurfaceInterpolationController::ReplaceInterpolationSession(mitk::Ima
   if (m_SelectedSegmentation == oldSession)
     m_SelectedSegmentation = newSession;
 
-  const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
-
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(currentTimeStep);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-
   this->RemoveInterpolationSession(oldSession);
   return true;
 }
@@ -498,7 +714,7 @@ void mitk::SurfaceInterpolationController::RemoveInterpolationSession(mitk::Imag
   {
     if (m_SelectedSegmentation == segmentationImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
+      this->CancelInterpolation();
       m_SelectedSegmentation = nullptr;
     }
     m_ListOfInterpolationSessions.erase(segmentationImage);
@@ -514,6 +730,8 @@ void mitk::SurfaceInterpolationController::RemoveInterpolationSession(mitk::Imag
 
 void mitk::SurfaceInterpolationController::RemoveAllInterpolationSessions()
 {
+  this->CancelInterpolation();
+
   // Removing all observers
   auto dataIter = m_SegmentationObserverTags.begin();
   while (dataIter != m_SegmentationObserverTags.end())
@@ -644,7 +862,7 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
   {
     if (m_SelectedSegmentation == tempImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
+      this->CancelInterpolation();
       m_SelectedSegmentation = nullptr;
     }
     m_SegmentationObserverTags.erase(tempImage);
@@ -654,12 +872,8 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
 
 void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
 {
-  // If session has changed reset the pipeline
-  m_ReduceFilter->Reset();
-  m_NormalsFilter->Reset();
-  m_InterpolateSurfaceFilter->Reset();
-
-  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+  // If session has changed the running interpolation is outdated
+  this->CancelInterpolation();
 
   if (m_SelectedSegmentation)
   {
@@ -668,16 +882,6 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
       MITK_WARN << "Interpolation cannot be reinitialized. Currently selected timepoint is not in the time bounds of the currently selected segmentation. Time point: " << m_CurrentTimePoint;
       return;
     }
-    const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
-
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(m_SelectedSegmentation);
-    timeSelector->SetTimeNr(currentTimeStep);
-    timeSelector->SetChannelNr(0);
-    timeSelector->Update();
-    mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_1(refSegImage, GetImageBase, 3, itkImage);
-    m_InterpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
 
     unsigned int numTimeSteps = m_SelectedSegmentation->GetTimeSteps();
     unsigned int size = m_ListOfInterpolationSessions[m_SelectedSegmentation].size();
@@ -686,34 +890,6 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
       m_ListOfInterpolationSessions[m_SelectedSegmentation].resize(numTimeSteps);
     }
 
-    if (currentTimeStep < numTimeSteps)
-    {
-      unsigned int numContours = m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size();
-      for (unsigned int c = 0; c < numContours; ++c)
-      {
-        m_ReduceFilter->SetInput(c,
-                                 m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep][c].contour);
-      }
-
-      m_ReduceFilter->Update();
-
-      m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-      if (m_CurrentNumberOfReducedContours == 1)
-      {
-        vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-        if (tmp == nullptr)
-        {
-          m_CurrentNumberOfReducedContours = 0;
-        }
-      }
-
-      for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
-      {
-        m_NormalsFilter->SetInput(i, m_ReduceFilter->GetOutput(i));
-        m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
-      }
-    }
-
     Modified();
   }
 }
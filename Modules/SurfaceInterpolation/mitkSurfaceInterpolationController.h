@@ -43,15 +43,36 @@ found in the LICENSE file.
 
 #include "mitkProgressBar.h"
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
+  /**
+   * \brief Invoked by the SurfaceInterpolationController when a new interpolation result has been published.
+   *
+   * The event is invoked from the interpolation thread, observers have to forward it to the UI thread.
+   */
+  itkEventMacro(SurfaceInterpolationFinishedEvent, itk::AnyEvent);
+
+  /**
+   * \brief Interpolates a 3D surface from the contours drawn into the slices of a segmentation.
+   *
+   * The interpolation runs in a background thread, see InterpolateAsync(). The reduced contours and their
+   * normals are cached per contour, so adding a contour only reduces the new contour and the contours
+   * whose planes it intersects again. A job which is superseded by a newer one or by a change of the
+   * interpolation session is cancelled between its stages and its result is discarded.
+   */
   class MITKSURFACEINTERPOLATION_EXPORT SurfaceInterpolationController : public itk::Object
   {
   public:
     mitkClassMacroItkParent(SurfaceInterpolationController, itk::Object);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
-    itkGetMacro(DistanceImageSpacing, double);
+
+    double GetDistanceImageSpacing() const;
 
     struct ContourPositionInformation
     {
@@ -116,10 +137,24 @@ namespace mitk
     unsigned int GetNumberOfContours();
 
     /**
-     * Interpolates the 3D surface from the given extracted contours
+     * Interpolates the 3D surface from the given extracted contours and waits for the result
      */
     void Interpolate();
 
+    /**
+     * @brief Starts the interpolation of the 3D surface from the given extracted contours in the background
+     *
+     * A pending or running interpolation is superseded. When the result is published the controller invokes a
+     * SurfaceInterpolationFinishedEvent, after which GetInterpolationResult() returns the new surface. Without a
+     * valid session the event is invoked immediately and the result is reset.
+     */
+    void InterpolateAsync();
+
+    /**
+     * @brief Blocks until the pending and running interpolations are finished
+     */
+    void WaitForInterpolation();
+
     mitk::Surface::Pointer GetInterpolationResult();
 
     /**
@@ -146,7 +181,10 @@ namespace mitk
      */
     mitk::Image::Pointer GetCurrentSegmentation();
 
-    Surface *GetContoursAsSurface();
+    /**
+     * @brief Returns the contours the last interpolation result was computed from, merged into one surface
+     */
+    Surface::Pointer GetContoursAsSurface();
 
     void SetDataStorage(DataStorage::Pointer ds);
 
@@ -197,7 +235,10 @@ namespace mitk
      */
     void ReinitializeInterpolation(mitk::Surface::Pointer contours);
 
-    mitk::Image *GetImage();
+    /**
+     * @brief Returns the distance image of the last interpolation result
+     */
+    mitk::Image::Pointer GetImage();
 
     /**
      * Estimates the memory which is needed to build up the equationsystem for the interpolation.
@@ -216,19 +257,70 @@ namespace mitk
     void GetImageBase(itk::Image<TPixel, VImageDimension> *input, itk::ImageBase<3>::Pointer &result);
 
   private:
+    /** \brief Snapshot of the state an interpolation is computed from */
+    struct InterpolationJob
+    {
+      unsigned long generation;
+      ContourPositionInformationList contours;
+      Image::Pointer segmentation;
+      itk::ImageBase<3>::Pointer referenceImage;
+      unsigned int timeStep;
+      double minSpacing;
+      double maxSpacing;
+      unsigned int distanceImageVolume;
+    };
+
+    /** \brief Reduced contour with normals, cached per contour */
+    struct CachedContour
+    {
+      /** Keeps the contour alive, so its address is not reused while it is a key of the cache */
+      Surface::ConstPointer contour;
+      double minSpacing;
+      double maxSpacing;
+      /** The contours whose planes may intersect the contour and were considered by the reduction */
+      std::vector<Surface::ConstPointer> intersectingContours;
+      /** The reduced contour with its normals or nullptr if the reduction removed all polygons */
+      Surface::Pointer reducedContour;
+      unsigned int numberOfPointsAfterReduction;
+    };
+
+    typedef std::map<const Surface *, CachedContour> ContourCache;
+
     void ReinitializeInterpolation();
 
     void OnSegmentationDeleted(const itk::Object *caller, const itk::EventObject &event);
 
     void AddToInterpolationPipeline(ContourPositionInformation contourInfo);
 
-    ReduceContourSetFilter::Pointer m_ReduceFilter;
-    ComputeContourSetNormalsFilter::Pointer m_NormalsFilter;
-    CreateDistanceImageFromSurfaceFilter::Pointer m_InterpolateSurfaceFilter;
+    /** \brief Supersedes the pending and running interpolations and clears the result */
+    void CancelInterpolation();
 
-    Surface::Pointer m_Contours;
+    void RunInterpolationThread();
+
+    void ExecuteInterpolationJob(const InterpolationJob &job);
+
+    /** \brief Updates the cache for the contours of the job, returns false if the job has been superseded */
+    bool UpdateContourCache(const InterpolationJob &job);
 
+    bool IsSuperseded(const InterpolationJob &job) const;
+
+    /** \brief Publishes the result if the job is still current, returns false otherwise */
+    bool PublishInterpolationResult(const InterpolationJob &job,
+                                    Surface::Pointer interpolationResult,
+                                    Surface::Pointer contours,
+                                    Image::Pointer distanceImage,
+                                    double distanceImageSpacing);
+
+    double m_MinSpacing;
+    double m_MaxSpacing;
+    unsigned int m_DistanceImageVolume;
+
+    /** Guarded by m_ResultMutex */
+    Surface::Pointer m_Contours;
+    Image::Pointer m_DistanceImage;
     double m_DistanceImageSpacing;
+    mitk::Surface::Pointer m_InterpolationResult;
+    mutable std::mutex m_ResultMutex;
 
     vtkSmartPointer<vtkPolyData> m_PolyData;
 
@@ -236,9 +328,18 @@ namespace mitk
 
     ContourListMap m_ListOfInterpolationSessions;
 
-    mitk::Surface::Pointer m_InterpolationResult;
-
-    unsigned int m_CurrentNumberOfReducedContours;
+    /** Guarded by m_JobMutex */
+    std::unique_ptr<InterpolationJob> m_PendingJob;
+    unsigned long m_Generation;
+    bool m_JobRunning;
+    bool m_StopInterpolationThread;
+    mutable std::mutex m_JobMutex;
+    std::condition_variable m_JobChanged;
+    std::thread m_InterpolationThread;
+
+    /** Updated by the interpolation thread, guarded by m_CacheMutex */
+    ContourCache m_ContourCache;
+    std::mutex m_CacheMutex;
 
     mitk::Image *m_SelectedSegmentation;
 
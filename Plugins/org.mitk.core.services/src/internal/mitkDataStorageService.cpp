@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDataStorageService.h"
 
 #include "mitkDataStorageReference.h"
+#include "mitkImageMemoryManager.h"
 #include "mitkStandaloneDataStorage.h"
 
 namespace mitk {
@@ -27,6 +28,10 @@ IDataStorageReference::Pointer DataStorageService::CreateDataStorage(const QStri
 {
 
   StandaloneDataStorage::Pointer dataStorage = mitk::StandaloneDataStorage::New();
+
+  // the images of the application are kept within the memory budget (see the general preferences)
+  ImageMemoryManager::GetInstance()->AddDataStorage(dataStorage);
+
   DataStorageReference::Pointer ref(new DataStorageReference(dataStorage.GetPointer()));
   ref->SetLabel(label);
   m_DataStorageReferences.insert(ref);
@@ -70,6 +75,7 @@ void DataStorageService::AddDataStorageReference(IDataStorageReference::Pointer
 {
   if (dataStorageRef.IsNull() || dataStorageRef->IsDefault()) return;
 
+  ImageMemoryManager::GetInstance()->AddDataStorage(dataStorageRef->GetDataStorage());
   m_DataStorageReferences.insert(dataStorageRef);
 }
 
@@ -14,12 +14,26 @@ found in the LICENSE file.
 
 #include "QmitkDataNodeGlobalReinitAction.h"
 
+#include <mitkImageMemoryManager.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkUndoController.h>
+
 #include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
 
 #include <berryIPreferencesService.h>
 #include <berryPlatform.h>
 
+#include <algorithm>
+
+namespace
+{
+  const QString UndoMemoryLimitKey = "undo memory limit in MB";
+  const QString ImageMemoryBudgetKey = "image memory budget in MB";
+  const std::size_t MB = 1024 * 1024;
+}
+
 QmitkGeneralPreferencePage::QmitkGeneralPreferencePage()
   : m_MainControl(nullptr)
 {
@@ -41,9 +55,23 @@ void QmitkGeneralPreferencePage::CreateQtControl(QWidget* parent)
   m_GlobalReinitOnNodeDelete = new QCheckBox;
   m_GlobalReinitOnNodeVisibilityChanged = new QCheckBox;
 
+  m_UndoMemoryLimit = new QSpinBox;
+  m_UndoMemoryLimit->setRange(0, 1024 * 1024);
+  m_UndoMemoryLimit->setSuffix(" MB");
+  m_UndoMemoryLimit->setSpecialValueText("Unlimited");
+  m_UndoMemoryLimit->setToolTip("The oldest undo steps are dropped if the undo history needs more memory.");
+
+  m_ImageMemoryBudget = new QSpinBox;
+  m_ImageMemoryBudget->setRange(0, 1024 * 1024);
+  m_ImageMemoryBudget->setSuffix(" MB");
+  m_ImageMemoryBudget->setSpecialValueText("Unlimited");
+  m_ImageMemoryBudget->setToolTip("If the loaded images need more memory, the least recently used ones are moved to temporary files until they are accessed again. Hidden images are moved first.");
+
   auto formLayout = new QFormLayout;
   formLayout->addRow("&Call global reinit if node is deleted", m_GlobalReinitOnNodeDelete);
   formLayout->addRow("&Call global reinit if node visibility is changed", m_GlobalReinitOnNodeVisibilityChanged);
+  formLayout->addRow("&Memory limit of the undo history", m_UndoMemoryLimit);
+  formLayout->addRow("Memory &budget of the images", m_ImageMemoryBudget);
 
   m_MainControl->setLayout(formLayout);
   Update();
@@ -59,6 +87,12 @@ bool QmitkGeneralPreferencePage::PerformOk()
   m_GeneralPreferencesNode->PutBool("Call global reinit if node is deleted", m_GlobalReinitOnNodeDelete->isChecked());
   m_GeneralPreferencesNode->PutBool("Call global reinit if node visibility is changed", m_GlobalReinitOnNodeVisibilityChanged->isChecked());
 
+  m_GeneralPreferencesNode->PutInt(UndoMemoryLimitKey, m_UndoMemoryLimit->value());
+  ApplyUndoMemoryLimit();
+
+  m_GeneralPreferencesNode->PutInt(ImageMemoryBudgetKey, m_ImageMemoryBudget->value());
+  ApplyImageMemoryBudget();
+
   return true;
 }
 
@@ -71,4 +105,36 @@ void QmitkGeneralPreferencePage::Update()
 {
   m_GlobalReinitOnNodeDelete->setChecked(m_GeneralPreferencesNode->GetBool("Call global reinit if node is deleted", true));
   m_GlobalReinitOnNodeVisibilityChanged->setChecked(m_GeneralPreferencesNode->GetBool("Call global reinit if node visibility is changed", false));
+
+  m_UndoMemoryLimit->setValue(m_GeneralPreferencesNode->GetInt(UndoMemoryLimitKey, 0));
+  m_ImageMemoryBudget->setValue(m_GeneralPreferencesNode->GetInt(ImageMemoryBudgetKey, 0));
+}
+
+void QmitkGeneralPreferencePage::ApplyUndoMemoryLimit()
+{
+  berry::IPreferencesService* prefService = berry::Platform::GetPreferencesService();
+  if (nullptr == prefService)
+    return;
+
+  auto generalPreferencesNode = prefService->GetSystemPreferences()->Node(QmitkDataNodeGlobalReinitAction::ACTION_ID);
+  const int limitInMB = generalPreferencesNode->GetInt(UndoMemoryLimitKey, 0);
+  const std::size_t limit = static_cast<std::size_t>(std::max(0, limitInMB)) * MB;
+
+  // the undo model is created by the first undo controller, which usually happens after the start of this plugin
+  mitk::LimitedLinearUndo::SetDefaultUndoMemoryLimit(limit);
+
+  if (auto undoModel = dynamic_cast<mitk::LimitedLinearUndo*>(mitk::UndoController::GetCurrentUndoModel()))
+    undoModel->SetUndoMemoryLimit(limit);
+}
+
+void QmitkGeneralPreferencePage::ApplyImageMemoryBudget()
+{
+  berry::IPreferencesService* prefService = berry::Platform::GetPreferencesService();
+  if (nullptr == prefService)
+    return;
+
+  // the images are evicted in the background, so a lower budget does not block the application
+  auto generalPreferencesNode = prefService->GetSystemPreferences()->Node(QmitkDataNodeGlobalReinitAction::ACTION_ID);
+  const int budgetInMB = generalPreferencesNode->GetInt(ImageMemoryBudgetKey, 0);
+  mitk::ImageMemoryManager::GetInstance()->SetMemoryBudget(static_cast<std::size_t>(std::max(0, budgetInMB)) * MB);
 }
@@ -18,6 +18,7 @@ found in the LICENSE file.
 
 class QWidget;
 class QCheckBox;
+class QSpinBox;
 
 class QmitkGeneralPreferencePage : public QObject, public berry::IQtPreferencePage
 {
@@ -58,12 +59,24 @@ public:
   */
   void Update() override;
 
+  /**
+  * @brief Applies the undo memory limit of the preferences to new undo models and the current one.
+  */
+  static void ApplyUndoMemoryLimit();
+
+  /**
+  * @brief Applies the image memory budget of the preferences to the mitk::ImageMemoryManager of the application.
+  */
+  static void ApplyImageMemoryBudget();
+
 protected:
 
     QWidget* m_MainControl;
 
     QCheckBox* m_GlobalReinitOnNodeDelete;
     QCheckBox* m_GlobalReinitOnNodeVisibilityChanged;
+    QSpinBox* m_UndoMemoryLimit;
+    QSpinBox* m_ImageMemoryBudget;
 
     berry::IPreferences::Pointer m_GeneralPreferencesNode;
 };
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <berryPlatform.h>
 #include "mitkPluginActivator.h"
 
+#include <mitkDICOMGDCMTagScanner.h>
+
 #include <QLabel>
 #include <QPushButton>
 #include <QFormLayout>
@@ -28,6 +30,9 @@ found in the LICENSE file.
 #include <QLineEdit>
 #include <QFileDialog>
 
+static const QString DicomPreferencesNode = "/org.mitk.views.dicomreader";
+static const QString TagIndexKey = "tag index";
+
 static QString CreateDefaultPath()
 {
   QString path = mitk::PluginActivator::getContext()->getDataFile("").absolutePath();
@@ -52,7 +57,7 @@ void QmitkDicomPreferencePage::CreateQtControl(QWidget* parent)
 {
   berry::IPreferencesService* prefService = berry::Platform::GetPreferencesService();
 
-  m_DicomPreferencesNode = prefService->GetSystemPreferences()->Node("/org.mitk.views.dicomreader");
+  m_DicomPreferencesNode = prefService->GetSystemPreferences()->Node(DicomPreferencesNode);
 
   m_MainControl = new QWidget(parent);
 
@@ -71,6 +76,11 @@ void QmitkDicomPreferencePage::CreateQtControl(QWidget* parent)
   displayOptionsLayout->addWidget(m_PathDefault);
 
   formLayout->addRow("Local database path:",displayOptionsLayout);
+
+  m_TagIndex = new QCheckBox(m_MainControl);
+  m_TagIndex->setToolTip("Keeps the DICOM tags of loaded files in an index, so that the files do not have to be parsed again when they are loaded the next time. The index contains patient information.");
+  formLayout->addRow("Keep an index of DICOM tags:", m_TagIndex);
+
   m_MainControl->setLayout(formLayout);
 
   connect(m_PathDefault, SIGNAL(clicked()), this, SLOT(DefaultButtonPushed()));
@@ -91,6 +101,8 @@ void QmitkDicomPreferencePage::PerformCancel()
 bool QmitkDicomPreferencePage::PerformOk()
 {
   m_DicomPreferencesNode->Put("default dicom path",m_PathEdit->text());
+  m_DicomPreferencesNode->PutBool(TagIndexKey, m_TagIndex->isChecked());
+  ApplyTagIndex();
   return true;
 }
 
@@ -98,6 +110,20 @@ void QmitkDicomPreferencePage::Update()
 {
   QString path = m_DicomPreferencesNode->Get("default dicom path", CreateDefaultPath());
   m_PathEdit->setText(path);
+  m_TagIndex->setChecked(m_DicomPreferencesNode->GetBool(TagIndexKey, false));
+}
+
+void QmitkDicomPreferencePage::ApplyTagIndex()
+{
+  berry::IPreferencesService* prefService = berry::Platform::GetPreferencesService();
+  if (nullptr == prefService)
+    return;
+
+  // the index contains patient information, so it is only kept in the data directory of the plugin
+  const bool useIndex = prefService->GetSystemPreferences()->Node(DicomPreferencesNode)->GetBool(TagIndexKey, false);
+  const QString indexFile = useIndex ? mitk::PluginActivator::getContext()->getDataFile("dicomtagindex").absoluteFilePath() : QString();
+
+  mitk::DICOMGDCMTagScanner::SetDefaultIndexFile(indexFile.toStdString());
 }
 
 void QmitkDicomPreferencePage::DefaultButtonPushed()
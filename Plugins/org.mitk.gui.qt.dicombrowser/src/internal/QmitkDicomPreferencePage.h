@@ -56,6 +56,11 @@ public:
     ///
     void Update() override;
 
+    ///
+    /// \brief Sets the default index file of mitk::DICOMGDCMTagScanner according to the preferences.
+    ///
+    static void ApplyTagIndex();
+
 protected:
     QWidget* m_MainControl;
     berry::IPreferences::Pointer m_DicomPreferencesNode;
@@ -63,6 +68,7 @@ protected:
     QLineEdit* m_PathEdit;
     QPushButton* m_PathSelect;
     QPushButton* m_PathDefault;
+    QCheckBox* m_TagIndex;
 
 protected slots:
     void DefaultButtonPushed();
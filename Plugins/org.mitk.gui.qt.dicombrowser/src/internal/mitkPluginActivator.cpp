@@ -25,6 +25,8 @@ void PluginActivator::start(ctkPluginContext* context)
   BERRY_REGISTER_EXTENSION_CLASS(QmitkDicomBrowser, context)
   BERRY_REGISTER_EXTENSION_CLASS(QmitkDicomPreferencePage, context)
   pluginContext = context;
+
+  QmitkDicomPreferencePage::ApplyTagIndex();
 }
 
 void PluginActivator::stop(ctkPluginContext* context)